@@ -14,6 +14,7 @@
 
 #include <mlpack/core/cv/meta_info_extractor.hpp>
 #include <mlpack/core/cv/cv_base.hpp>
+#include <mlpack/core/data/split_data.hpp>
 
 namespace mlpack {
 namespace cv {
@@ -44,6 +45,11 @@ namespace cv {
  * the @c Shuffle() function.  Shuffling is performed at construction time if
  * the parameter @c shuffle is set to @c true in the constructor.
  *
+ * If OpenMP is enabled, the folds are trained in parallel.  Each fold trained
+ * at once holds its own model, so the number of folds trained at once can be
+ * limited with @c MaxThreads() to save memory.  The training subsets are
+ * aliases of the data held by this object, so they are not copied.
+ *
  * @tparam MLAlgorithm A machine learning algorithm.
  * @tparam Metric A metric to assess the quality of a trained model.
  * @tparam MatType The type of data.
@@ -177,9 +183,47 @@ class KFoldCV
   template<typename... MLAlgorithmArgs>
   double Evaluate(const MLAlgorithmArgs& ...args);
 
+  /**
+   * Run k-fold cross-validation, and store the model of the last fold in the
+   * given pointer instead of this object.  This may be called by several
+   * threads at once.
+   *
+   * @param model Pointer to store the model of the last fold in.
+   * @param args Arguments for MLAlgorithm (in addition to the passed
+   *     ones in the constructor).
+   */
+  template<typename... MLAlgorithmArgs>
+  double Evaluate(std::unique_ptr<MLAlgorithm>& model,
+                  const MLAlgorithmArgs& ...args);
+
+  /**
+   * Run k-fold cross-validation, training the model of each fold on only the
+   * given fraction of its training subset (the first points of it), and store
+   * the model of the last fold in the given pointer.  The validation subsets
+   * are not changed, so the results for different hyper-parameters with the
+   * same fraction can be compared.  This may be called by several threads at
+   * once.
+   *
+   * @param model Pointer to store the model of the last fold in.
+   * @param fraction Fraction of each training subset to train on, in (0, 1].
+   * @param args Arguments for MLAlgorithm (in addition to the passed
+   *     ones in the constructor).
+   */
+  template<typename... MLAlgorithmArgs>
+  double EvaluateSubsample(std::unique_ptr<MLAlgorithm>& model,
+                           const double fraction,
+                           const MLAlgorithmArgs& ...args);
+
   //! Access and modify a model from the last run of k-fold cross-validation.
   MLAlgorithm& Model();
 
+  //! Get the maximum number of folds trained at once (0 means as many as
+  //! there are OpenMP threads).
+  size_t MaxThreads() const { return maxThreads; }
+  //! Modify the maximum number of folds trained at once (0 means as many as
+  //! there are OpenMP threads).
+  size_t& MaxThreads() { return maxThreads; }
+
  private:
   //! A short alias for CVBase.
   using Base = CVBase<MLAlgorithm, MatType, PredictionsType, WeightsType>;
@@ -225,6 +269,9 @@ class KFoldCV
   //! A pointer to a model from the last run of k-fold cross-validation.
   std::unique_ptr<MLAlgorithm> modelPtr;
 
+  //! The maximum number of folds trained at once.
+  size_t maxThreads;
+
   /**
    * Assert the k parameter and data consistency and initialize fields required
    * for running k-fold cross-validation.
@@ -253,13 +300,22 @@ class KFoldCV
   template<typename DataType>
   void InitKFoldCVMat(const DataType& source, DataType& destination);
 
+  /**
+   * Permute the points of the given matrix (initialized by InitKFoldCVMat())
+   * in place with the given order, and then refresh its repeated bins.
+   */
+  template<typename DataType>
+  void PermuteKFoldCVMat(DataType& m, const arma::uvec& order);
+
   /**
    * Train and run evaluation in the case of non-weighted learning.
    */
   template<typename... MLAlgorithmArgs,
            bool Enabled = !Base::MIE::SupportsWeights,
            typename = typename std::enable_if<Enabled>::type>
-  double TrainAndEvaluate(const MLAlgorithmArgs& ...mlAlgorithmArgs);
+  double TrainAndEvaluate(std::unique_ptr<MLAlgorithm>& model,
+                          const double fraction,
+                          const MLAlgorithmArgs& ...mlAlgorithmArgs);
 
   /**
    * Train and run evaluation in the case of supporting weighted learning.
@@ -268,7 +324,12 @@ class KFoldCV
            bool Enabled = Base::MIE::SupportsWeights,
            typename = typename std::enable_if<Enabled>::type,
            typename = void>
-  double TrainAndEvaluate(const MLAlgorithmArgs& ...mlAlgorithmArgs);
+  double TrainAndEvaluate(std::unique_ptr<MLAlgorithm>& model,
+                          const double fraction,
+                          const MLAlgorithmArgs& ...mlAlgorithmArgs);
+
+  //! Get the number of threads to train the folds with.
+  int NumThreads() const;
 
   /**
    * Calculate the index of the first column of the ith validation subset.
@@ -279,18 +340,28 @@ class KFoldCV
   inline size_t ValidationSubsetFirstCol(const size_t i);
 
   /**
-   * Get the ith training subset from a variable of a matrix type.
+   * Calculate the number of points of the given fraction of the ith training
+   * subset (at least one).
+   */
+  inline size_t TrainingSubsetSize(const size_t i, const double fraction);
+
+  /**
+   * Get the given fraction of the ith training subset from a variable of a
+   * matrix type.
    */
   template<typename ElementType>
   inline arma::Mat<ElementType> GetTrainingSubset(arma::Mat<ElementType>& m,
-                                                  const size_t i);
+                                                  const size_t i,
+                                                  const double fraction = 1.0);
 
   /**
-   * Get the ith training subset from a variable of a row type.
+   * Get the given fraction of the ith training subset from a variable of a
+   * row type.
    */
   template<typename ElementType>
   inline arma::Row<ElementType> GetTrainingSubset(arma::Row<ElementType>& r,
-                                                  const size_t i);
+                                                  const size_t i,
+                                                  const double fraction = 1.0);
 
   /**
    * Get the ith validation subset from a variable of a matrix type.
@@ -12,6 +12,12 @@
 #ifndef MLPACK_CORE_CV_K_FOLD_CV_IMPL_HPP
 #define MLPACK_CORE_CV_K_FOLD_CV_IMPL_HPP
 
+#include <exception>
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace cv {
 
@@ -135,7 +141,8 @@ KFoldCV<MLAlgorithm,
                               const PredictionsType& ys,
                               const bool shuffle) :
     base(std::move(base)),
-    k(k)
+    k(k),
+    maxThreads(0)
 {
   if (k < 2)
     throw std::invalid_argument("KFoldCV: k should not be less than 2");
@@ -166,7 +173,8 @@ KFoldCV<MLAlgorithm,
                               const WeightsType& weights,
                               const bool shuffle) :
     base(std::move(base)),
-    k(k)
+    k(k),
+    maxThreads(0)
 {
   Base::AssertWeightsConsistency(xs, weights);
 
@@ -191,7 +199,47 @@ double KFoldCV<MLAlgorithm,
                PredictionsType,
                WeightsType>::Evaluate(const MLAlgorithmArgs&... args)
 {
-  return TrainAndEvaluate(args...);
+  return TrainAndEvaluate(modelPtr, 1.0, args...);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... MLAlgorithmArgs>
+double KFoldCV<MLAlgorithm,
+               Metric,
+               MatType,
+               PredictionsType,
+               WeightsType>::Evaluate(std::unique_ptr<MLAlgorithm>& model,
+                                      const MLAlgorithmArgs&... args)
+{
+  return TrainAndEvaluate(model, 1.0, args...);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... MLAlgorithmArgs>
+double KFoldCV<MLAlgorithm,
+               Metric,
+               MatType,
+               PredictionsType,
+               WeightsType>::EvaluateSubsample(
+    std::unique_ptr<MLAlgorithm>& model,
+    const double fraction,
+    const MLAlgorithmArgs&... args)
+{
+  if (fraction <= 0.0 || fraction > 1.0)
+  {
+    throw std::invalid_argument("KFoldCV::EvaluateSubsample(): fraction "
+        "should be in (0, 1]");
+  }
+
+  return TrainAndEvaluate(model, fraction, args...);
 }
 
 template<typename MLAlgorithm,
@@ -232,6 +280,32 @@ void KFoldCV<MLAlgorithm,
       source.cols(0, source.n_cols - lastBinSize - 1));
 }
 
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename DataType>
+void KFoldCV<MLAlgorithm,
+             Metric,
+             MatType,
+             PredictionsType,
+             WeightsType>::PermuteKFoldCVMat(DataType& m,
+                                             const arma::uvec& order)
+{
+  typedef typename DataType::elem_type ElementType;
+
+  // Permute the original points through an alias, so that the repeated bins
+  // at the end are left alone.
+  const size_t n = order.n_elem;
+  arma::Mat<ElementType> points(m.colptr(0), m.n_rows, n, false, true);
+  data::PermuteCols(points, order);
+
+  // The repeated bins are a copy of the first points.
+  if (m.n_cols > n)
+    m.cols(n, m.n_cols - 1) = m.cols(0, m.n_cols - n - 1);
+}
+
 template<typename MLAlgorithm,
          typename Metric,
          typename MatType,
@@ -242,20 +316,39 @@ double KFoldCV<MLAlgorithm,
                 Metric,
                 MatType,
                 PredictionsType,
-                WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
+                WeightsType>::TrainAndEvaluate(
+    std::unique_ptr<MLAlgorithm>& model,
+    const double fraction,
+    const MLAlgorithmArgs&... args)
 {
   arma::vec evaluations(k);
 
-  for (size_t i = 0; i < k; ++i)
+  // Exceptions can't leave an OpenMP region, so the first one is thrown again
+  // once all the folds are done.
+  std::exception_ptr exception;
+  #pragma omp parallel for schedule(dynamic) num_threads(NumThreads())
+  for (omp_size_t i = 0; i < (omp_size_t) k; ++i)
   {
-    MLAlgorithm&& model  = base.Train(GetTrainingSubset(xs, i),
-        GetTrainingSubset(ys, i), args...);
-    evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
-        GetValidationSubset(ys, i));
-    if (i == k - 1)
-      modelPtr.reset(new MLAlgorithm(std::move(model)));
+    try
+    {
+      MLAlgorithm&& foldModel = base.Train(GetTrainingSubset(xs, i, fraction),
+          GetTrainingSubset(ys, i, fraction), args...);
+      evaluations(i) = Metric::Evaluate(foldModel, GetValidationSubset(xs, i),
+          GetValidationSubset(ys, i));
+      if ((size_t) i == k - 1)
+        model.reset(new MLAlgorithm(std::move(foldModel)));
+    }
+    catch (...)
+    {
+      #pragma omp critical(KFoldCVException)
+      if (!exception)
+        exception = std::current_exception();
+    }
   }
 
+  if (exception)
+    std::rethrow_exception(exception);
+
   return arma::mean(evaluations);
 }
 
@@ -269,26 +362,66 @@ double KFoldCV<MLAlgorithm,
                 Metric,
                 MatType,
                 PredictionsType,
-                WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
+                WeightsType>::TrainAndEvaluate(
+    std::unique_ptr<MLAlgorithm>& model,
+    const double fraction,
+    const MLAlgorithmArgs&... args)
 {
   arma::vec evaluations(k);
 
-  for (size_t i = 0; i < k; ++i)
+  // Exceptions can't leave an OpenMP region, so the first one is thrown again
+  // once all the folds are done.
+  std::exception_ptr exception;
+  #pragma omp parallel for schedule(dynamic) num_threads(NumThreads())
+  for (omp_size_t i = 0; i < (omp_size_t) k; ++i)
   {
-    MLAlgorithm&& model = (weights.n_elem > 0) ?
-        base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
-            GetTrainingSubset(weights, i), args...) :
-        base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
-            args...);
-    evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
-        GetValidationSubset(ys, i));
-    if (i == k - 1)
-      modelPtr.reset(new MLAlgorithm(std::move(model)));
+    try
+    {
+      MLAlgorithm&& foldModel = (weights.n_elem > 0) ?
+          base.Train(GetTrainingSubset(xs, i, fraction),
+              GetTrainingSubset(ys, i, fraction),
+              GetTrainingSubset(weights, i, fraction), args...) :
+          base.Train(GetTrainingSubset(xs, i, fraction),
+              GetTrainingSubset(ys, i, fraction), args...);
+      evaluations(i) = Metric::Evaluate(foldModel, GetValidationSubset(xs, i),
+          GetValidationSubset(ys, i));
+      if ((size_t) i == k - 1)
+        model.reset(new MLAlgorithm(std::move(foldModel)));
+    }
+    catch (...)
+    {
+      #pragma omp critical(KFoldCVException)
+      if (!exception)
+        exception = std::current_exception();
+    }
   }
 
+  if (exception)
+    std::rethrow_exception(exception);
+
   return arma::mean(evaluations);
 }
 
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+int KFoldCV<MLAlgorithm,
+            Metric,
+            MatType,
+            PredictionsType,
+            WeightsType>::NumThreads() const
+{
+  #ifdef HAS_OPENMP
+    const int threads = (maxThreads == 0) ? omp_get_max_threads() :
+        (int) maxThreads;
+    return std::max(std::min(threads, (int) k), 1);
+  #else
+    return 1;
+  #endif
+}
+
 template<typename MLAlgorithm,
          typename Metric,
          typename MatType,
@@ -301,14 +434,13 @@ void KFoldCV<MLAlgorithm,
              PredictionsType,
              WeightsType>::Shuffle()
 {
-  MatType xsOrig = xs.cols(0, (k - 1) * binSize + lastBinSize - 1);
-  PredictionsType ysOrig = ys.cols(0, (k - 1) * binSize + lastBinSize - 1);
-
-  // Now shuffle the data.
-  math::ShuffleData(xsOrig, ysOrig, xsOrig, ysOrig);
+  // Shuffle the data in place, so that it is not copied.
+  const size_t n = (k - 1) * binSize + lastBinSize;
+  const arma::uvec order = arma::shuffle(arma::linspace<arma::uvec>(0, n - 1,
+      n));
 
-  InitKFoldCVMat(xsOrig, xs);
-  InitKFoldCVMat(ysOrig, ys);
+  PermuteKFoldCVMat(xs, order);
+  PermuteKFoldCVMat(ys, order);
 }
 
 template<typename MLAlgorithm,
@@ -323,22 +455,15 @@ void KFoldCV<MLAlgorithm,
              PredictionsType,
              WeightsType>::Shuffle()
 {
-  MatType xsOrig = xs.cols(0, (k - 1) * binSize + lastBinSize - 1);
-  PredictionsType ysOrig = ys.cols(0, (k - 1) * binSize + lastBinSize - 1);
-  WeightsType weightsOrig;
-  if (weights.n_elem > 0)
-    weightsOrig = weights.cols(0, (k - 1) * binSize + lastBinSize - 1);
+  // Shuffle the data in place, so that it is not copied.
+  const size_t n = (k - 1) * binSize + lastBinSize;
+  const arma::uvec order = arma::shuffle(arma::linspace<arma::uvec>(0, n - 1,
+      n));
 
-  // Now shuffle the data.
+  PermuteKFoldCVMat(xs, order);
+  PermuteKFoldCVMat(ys, order);
   if (weights.n_elem > 0)
-    math::ShuffleData(xsOrig, ysOrig, weightsOrig, xsOrig, ysOrig, weightsOrig);
-  else
-    math::ShuffleData(xsOrig, ysOrig, xsOrig, ysOrig);
-
-  InitKFoldCVMat(xsOrig, xs);
-  InitKFoldCVMat(ysOrig, ys);
-  if (weights.n_elem > 0)
-    InitKFoldCVMat(weightsOrig, weights);
+    PermuteKFoldCVMat(weights, order);
 }
 
 template<typename MLAlgorithm,
@@ -356,6 +481,29 @@ size_t KFoldCV<MLAlgorithm,
   return (i == 0) ? binSize * (k - 1) : binSize * (i - 1);
 }
 
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+size_t KFoldCV<MLAlgorithm,
+               Metric,
+               MatType,
+               PredictionsType,
+               WeightsType>::TrainingSubsetSize(const size_t i,
+                                                const double fraction)
+{
+  // If this is not the first fold, we have to handle it a little bit
+  // differently, since the last fold may contain slightly more than 'binSize'
+  // points.
+  const size_t subsetSize = (i != 0) ? lastBinSize + (k - 2) * binSize :
+      (k - 1) * binSize;
+  if (fraction >= 1.0)
+    return subsetSize;
+
+  return std::max((size_t) std::ceil(fraction * subsetSize), (size_t) 1);
+}
+
 template<typename MLAlgorithm,
          typename Metric,
          typename MatType,
@@ -368,16 +516,11 @@ arma::Mat<ElementType> KFoldCV<MLAlgorithm,
                                PredictionsType,
                                WeightsType>::GetTrainingSubset(
     arma::Mat<ElementType>& m,
-    const size_t i)
+    const size_t i,
+    const double fraction)
 {
-  // If this is not the first fold, we have to handle it a little bit
-  // differently, since the last fold may contain slightly more than 'binSize'
-  // points.
-  const size_t subsetSize = (i != 0) ? lastBinSize + (k - 2) * binSize :
-      (k - 1) * binSize;
-
-  return arma::Mat<ElementType>(m.colptr(binSize * i), m.n_rows, subsetSize,
-      false, true);
+  return arma::Mat<ElementType>(m.colptr(binSize * i), m.n_rows,
+      TrainingSubsetSize(i, fraction), false, true);
 }
 
 template<typename MLAlgorithm,
@@ -392,15 +535,11 @@ arma::Row<ElementType> KFoldCV<MLAlgorithm,
                                PredictionsType,
                                WeightsType>::GetTrainingSubset(
     arma::Row<ElementType>& r,
-    const size_t i)
+    const size_t i,
+    const double fraction)
 {
-  // If this is not the first fold, we have to handle it a little bit
-  // differently, since the last fold may contain slightly more than 'binSize'
-  // points.
-  const size_t subsetSize = (i != 0) ? lastBinSize + (k - 2) * binSize :
-      (k - 1) * binSize;
-
-  return arma::Row<ElementType>(r.colptr(binSize * i), subsetSize, false, true);
+  return arma::Row<ElementType>(r.colptr(binSize * i),
+      TrainingSubsetSize(i, fraction), false, true);
 }
 
 template<typename MLAlgorithm,
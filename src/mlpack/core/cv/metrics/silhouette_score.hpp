@@ -36,6 +36,13 @@ namespace cv {
  * @f}
  *
  * The Overall Silhouette Score is the mean of individual silhoutte scores.
+ *
+ * When the distances are not precomputed, they are computed in tiles of
+ * BlockSize by BlockSize points, and only the sums of the distances of each
+ * point to each cluster are kept, so the memory used does not grow with the
+ * square of the number of points.  The blocks of points are scored in
+ * parallel if OpenMP is enabled.  For large datasets, the overall score can
+ * also be estimated from the scores of a random sample of the points.
  */
 class SilhouetteScore
 {
@@ -53,6 +60,24 @@ class SilhouetteScore
                         const arma::Row<size_t>& labels,
                         const Metric& metric);
 
+  /**
+   * Estimate the overall silhouette score by the mean silhouette score of a
+   * random sample of the points.  The score of each sampled point is exact,
+   * so this takes time linear in the number of points.  If the sample size is
+   * 0 or at least the number of points, the exact overall score is returned.
+   *
+   * @param X Column-major data used for clustering.
+   * @param labels Labels assigned to data by clustering.
+   * @param metric Metric to be used to calculate dissimilarity.
+   * @param sampleSize Number of points to sample.
+   * @return (double) estimated silhouette score.
+   */
+  template<typename DataType, typename Metric>
+  static double Overall(const DataType& X,
+                        const arma::Row<size_t>& labels,
+                        const Metric& metric,
+                        const size_t sampleSize);
+
   /**
    * Find the individual silhouette scores for precomputted dissimilarites.
    *
@@ -78,6 +103,22 @@ class SilhouetteScore
                                    const arma::Row<size_t>& labels,
                                    const Metric& metric);
 
+  /**
+   * Find the silhouette scores of the given points only.  The distances to
+   * all the points are used, but they are not stored.
+   *
+   * @param X Column-major data used for clustering.
+   * @param labels Labels assigned to data by clustering.
+   * @param points Indices of the points to score.
+   * @param metric Metric to be used to calculate dissimilarity.
+   * @return (arma::rowvec) silhouette score of each given point.
+   */
+  template<typename DataType, typename Metric>
+  static arma::rowvec SamplesScore(const DataType& X,
+                                   const arma::Row<size_t>& labels,
+                                   const arma::uvec& points,
+                                   const Metric& metric);
+
   /**
    * Find mean distance of element from a given cluster.
    *
@@ -97,6 +138,9 @@ class SilhouetteScore
    * to maximize the metric.
    */
   static const bool NeedsMinimization = false;
+
+  //! The number of points in each side of the tiles of distances.
+  static const size_t BlockSize = 256;
 };
 
 } // namespace cv
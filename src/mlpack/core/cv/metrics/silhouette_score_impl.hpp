@@ -26,6 +26,20 @@ double SilhouetteScore::Overall(const DataType& X,
   return arma::mean(SamplesScore(X, labels, metric));
 }
 
+template<typename DataType, typename Metric>
+double SilhouetteScore::Overall(const DataType& X,
+                                const arma::Row<size_t>& labels,
+                                const Metric& metric,
+                                const size_t sampleSize)
+{
+  AssertSizes(X, labels, "SilhouetteScore::Overall()");
+  if (sampleSize == 0 || sampleSize >= X.n_cols)
+    return arma::mean(SamplesScore(X, labels, metric));
+
+  const arma::uvec points = arma::randperm(X.n_cols, sampleSize);
+  return arma::mean(SamplesScore(X, labels, points, metric));
+}
+
 template<typename DataType>
 arma::rowvec SilhouetteScore::SamplesScore(const DataType& distances,
                                            const arma::Row<size_t>& labels)
@@ -77,8 +91,88 @@ arma::rowvec SilhouetteScore::SamplesScore(const DataType& X,
                                            const Metric& metric)
 {
   AssertSizes(X, labels, "SilhouetteScore::SamplesScore()");
-  DataType distances = PairwiseDistances(X, metric);
-  return SamplesScore(distances, labels);
+  if (X.n_cols == 0)
+    return arma::rowvec();
+
+  return SamplesScore(X, labels, arma::regspace<arma::uvec>(0,
+      X.n_cols - 1), metric);
+}
+
+template<typename DataType, typename Metric>
+arma::rowvec SilhouetteScore::SamplesScore(const DataType& X,
+                                           const arma::Row<size_t>& labels,
+                                           const arma::uvec& points,
+                                           const Metric& metric)
+{
+  AssertSizes(X, labels, "SilhouetteScore::SamplesScore()");
+
+  // Map the labels to the clusters 0, ..., k - 1.
+  const arma::Row<size_t> clusterLabels = arma::unique(labels);
+  arma::Row<size_t> clusters(labels.n_elem);
+  arma::vec clusterSizes(clusterLabels.n_elem, arma::fill::zeros);
+  for (size_t j = 0; j < labels.n_elem; ++j)
+  {
+    clusters[j] = std::lower_bound(clusterLabels.begin(), clusterLabels.end(),
+        labels[j]) - clusterLabels.begin();
+    ++clusterSizes[clusters[j]];
+  }
+
+  arma::rowvec sampleScores(points.n_elem);
+  const size_t numBlocks = (points.n_elem + BlockSize - 1) / BlockSize;
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+  {
+    const size_t begin = b * BlockSize;
+    const size_t end = std::min(begin + BlockSize, (size_t) points.n_elem);
+
+    // Sum the distances of each point of the block to each cluster, one tile
+    // of reference points at a time.
+    arma::mat sums(clusterLabels.n_elem, end - begin, arma::fill::zeros);
+    for (size_t refBegin = 0; refBegin < X.n_cols; refBegin += BlockSize)
+    {
+      const size_t refEnd = std::min(refBegin + BlockSize,
+          (size_t) X.n_cols);
+      for (size_t i = begin; i < end; ++i)
+      {
+        for (size_t j = refBegin; j < refEnd; ++j)
+        {
+          if (j != points[i])
+          {
+            sums(clusters[j], i - begin) += metric.Evaluate(
+                X.col(points[i]), X.col(j));
+          }
+        }
+      }
+    }
+
+    for (size_t i = begin; i < end; ++i)
+    {
+      const size_t cluster = clusters[points[i]];
+      const double intraClusterDistance = (clusterSizes[cluster] == 1) ? 0.0 :
+          sums(cluster, i - begin) / (clusterSizes[cluster] - 1);
+      if (intraClusterDistance == 0)
+      {
+        // s(i) = 0, as when i is the only element in the cluster.
+        sampleScores[i] = 0.0;
+        continue;
+      }
+
+      double minInterClusterDistance = DBL_MAX;
+      for (size_t c = 0; c < clusterLabels.n_elem; ++c)
+      {
+        if (c != cluster)
+        {
+          minInterClusterDistance = std::min(minInterClusterDistance,
+              sums(c, i - begin) / clusterSizes[c]);
+        }
+      }
+
+      sampleScores[i] = (minInterClusterDistance - intraClusterDistance) /
+          std::max(intraClusterDistance, minInterClusterDistance);
+    }
+  }
+
+  return sampleScores;
 }
 
 double SilhouetteScore::MeanDistanceFromCluster(const arma::colvec& distances,
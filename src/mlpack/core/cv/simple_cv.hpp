@@ -208,6 +208,35 @@ class SimpleCV
   template<typename... MLAlgorithmArgs>
   double Evaluate(const MLAlgorithmArgs&... args);
 
+  /**
+   * Train on the training set and assess performance on the validation set by
+   * using the class Metric, and store the trained model in the given pointer
+   * instead of this object.  This may be called by several threads at once.
+   *
+   * @param model Pointer to store the trained model in.
+   * @param args Arguments for the given MLAlgorithm taken by its constructor
+   *     (in addition to the passed ones in the SimpleCV constructor).
+   */
+  template<typename... MLAlgorithmArgs>
+  double Evaluate(std::unique_ptr<MLAlgorithm>& model,
+                  const MLAlgorithmArgs&... args);
+
+  /**
+   * Train on the given fraction of the training set (the first points of it)
+   * and assess performance on the whole validation set by using the class
+   * Metric, and store the trained model in the given pointer.  This may be
+   * called by several threads at once.
+   *
+   * @param model Pointer to store the trained model in.
+   * @param fraction Fraction of the training set to train on, in (0, 1].
+   * @param args Arguments for the given MLAlgorithm taken by its constructor
+   *     (in addition to the passed ones in the SimpleCV constructor).
+   */
+  template<typename... MLAlgorithmArgs>
+  double EvaluateSubsample(std::unique_ptr<MLAlgorithm>& model,
+                           const double fraction,
+                           const MLAlgorithmArgs&... args);
+
   //! Access and modify the last trained model.
   MLAlgorithm& Model();
 
@@ -269,6 +298,12 @@ class SimpleCV
    */
   size_t CalculateAndAssertNumberOfTrainingPoints(const double validationSize);
 
+  /**
+   * Calculate the number of points of the given fraction of the training set
+   * (at least one).
+   */
+  size_t NumberOfSubsamplePoints(const double fraction) const;
+
   /**
    * Get the specified submatrix without coping the data.
    */
@@ -291,7 +326,9 @@ class SimpleCV
   template<typename... MLAlgorithmArgs,
            bool Enabled = !Base::MIE::SupportsWeights,
            typename = typename std::enable_if<Enabled>::type>
-  double TrainAndEvaluate(const MLAlgorithmArgs&... args);
+  double TrainAndEvaluate(std::unique_ptr<MLAlgorithm>& model,
+                          const double fraction,
+                          const MLAlgorithmArgs&... args);
 
   /**
    * Train and run evaluation in the case of supporting weighted learning.
@@ -300,7 +337,9 @@ class SimpleCV
            bool Enabled = Base::MIE::SupportsWeights,
            typename = typename std::enable_if<Enabled>::type,
            typename = void>
-  double TrainAndEvaluate(const MLAlgorithmArgs&... args);
+  double TrainAndEvaluate(std::unique_ptr<MLAlgorithm>& model,
+                          const double fraction,
+                          const MLAlgorithmArgs&... args);
 };
 
 } // namespace cv
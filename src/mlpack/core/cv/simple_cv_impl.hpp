@@ -194,7 +194,47 @@ double SimpleCV<MLAlgorithm,
                 PredictionsType,
                 WeightsType>::Evaluate(const MLAlgorithmArgs&... args)
 {
-  return TrainAndEvaluate(args...);
+  return TrainAndEvaluate(modelPtr, 1.0, args...);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... MLAlgorithmArgs>
+double SimpleCV<MLAlgorithm,
+                Metric,
+                MatType,
+                PredictionsType,
+                WeightsType>::Evaluate(std::unique_ptr<MLAlgorithm>& model,
+                                       const MLAlgorithmArgs&... args)
+{
+  return TrainAndEvaluate(model, 1.0, args...);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... MLAlgorithmArgs>
+double SimpleCV<MLAlgorithm,
+                Metric,
+                MatType,
+                PredictionsType,
+                WeightsType>::EvaluateSubsample(
+    std::unique_ptr<MLAlgorithm>& model,
+    const double fraction,
+    const MLAlgorithmArgs&... args)
+{
+  if (fraction <= 0.0 || fraction > 1.0)
+  {
+    throw std::invalid_argument("SimpleCV::EvaluateSubsample(): fraction "
+        "should be in (0, 1]");
+  }
+
+  return TrainAndEvaluate(model, fraction, args...);
 }
 
 template<typename MLAlgorithm,
@@ -243,6 +283,22 @@ size_t SimpleCV<MLAlgorithm,
   return trainingPoints;
 }
 
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+size_t SimpleCV<MLAlgorithm,
+                Metric,
+                MatType,
+                PredictionsType,
+                WeightsType>::NumberOfSubsamplePoints(const double fraction)
+    const
+{
+  return std::max((size_t) std::ceil(fraction * trainingXs.n_cols),
+      (size_t) 1);
+}
+
 template<typename MLAlgorithm,
          typename Metric,
          typename MatType,
@@ -291,11 +347,23 @@ double SimpleCV<MLAlgorithm,
                 Metric,
                 MatType,
                 PredictionsType,
-                WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
+                WeightsType>::TrainAndEvaluate(
+    std::unique_ptr<MLAlgorithm>& model,
+    const double fraction,
+    const MLAlgorithmArgs&... args)
 {
-  modelPtr.reset(new MLAlgorithm(base.Train(trainingXs, trainingYs, args...)));
+  if (fraction < 1.0)
+  {
+    const size_t lastCol = NumberOfSubsamplePoints(fraction) - 1;
+    model.reset(new MLAlgorithm(base.Train(GetSubset(trainingXs, 0, lastCol),
+        GetSubset(trainingYs, 0, lastCol), args...)));
+  }
+  else
+  {
+    model.reset(new MLAlgorithm(base.Train(trainingXs, trainingYs, args...)));
+  }
 
-  return Metric::Evaluate(*modelPtr, validationXs, validationYs);
+  return Metric::Evaluate(*model, validationXs, validationYs);
 }
 
 template<typename MLAlgorithm,
@@ -308,16 +376,34 @@ double SimpleCV<MLAlgorithm,
                 Metric,
                 MatType,
                 PredictionsType,
-                WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
+                WeightsType>::TrainAndEvaluate(
+    std::unique_ptr<MLAlgorithm>& model,
+    const double fraction,
+    const MLAlgorithmArgs&... args)
 {
-  if (trainingWeights.n_elem > 0)
-    modelPtr.reset(new MLAlgorithm(
+  if (fraction < 1.0)
+  {
+    const size_t lastCol = NumberOfSubsamplePoints(fraction) - 1;
+    if (trainingWeights.n_elem > 0)
+      model.reset(new MLAlgorithm(base.Train(GetSubset(trainingXs, 0, lastCol),
+          GetSubset(trainingYs, 0, lastCol),
+          GetSubset(trainingWeights, 0, lastCol), args...)));
+    else
+      model.reset(new MLAlgorithm(base.Train(GetSubset(trainingXs, 0, lastCol),
+          GetSubset(trainingYs, 0, lastCol), args...)));
+  }
+  else if (trainingWeights.n_elem > 0)
+  {
+    model.reset(new MLAlgorithm(
         base.Train(trainingXs, trainingYs, trainingWeights, args...)));
+  }
   else
-    modelPtr.reset(new MLAlgorithm(
+  {
+    model.reset(new MLAlgorithm(
         base.Train(trainingXs, trainingYs, args...)));
+  }
 
-  return Metric::Evaluate(*modelPtr, validationXs, validationYs);
+  return Metric::Evaluate(*model, validationXs, validationYs);
 }
 
 } // namespace cv
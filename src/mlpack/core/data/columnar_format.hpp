@@ -0,0 +1,127 @@
+/**
+ * @file core/data/columnar_format.hpp
+ *
+ * Definitions shared by the loader and saver of mlpack's native binary dataset
+ * format.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_COLUMNAR_FORMAT_HPP
+#define MLPACK_CORE_DATA_COLUMNAR_FORMAT_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * The native dataset format (extension ".mlc") stores a matrix together with
+ * the DatasetInfo it was loaded with, so that it can be loaded again without
+ * any parsing.  All values are stored in the byte order of the machine that
+ * wrote the file.  The file starts with a header:
+ *
+ *  - the 8 bytes "MLPKCOLS", a uint32_t version and the uint32_t 0x01020304
+ *    (to detect files written with a different byte order);
+ *  - the element type of the matrix (a ColumnarType) and a flag that is 1 if
+ *    the data is compressed, as uint8_t, followed by two bytes of padding;
+ *  - the number of rows (dimensions), the number of columns (points) and the
+ *    number of points in each chunk, as uint64_t;
+ *  - the Datatype of each dimension, as uint8_t;
+ *  - for each categorical dimension, the number of mappings, followed by the
+ *    length and characters of each mapped string, in order of their mapped
+ *    value.
+ *
+ * The data follows, starting at the next multiple of ColumnarAlignment bytes.
+ * Uncompressed data is the column-major matrix itself, so that it can be used
+ * directly from a memory-mapped file.  Compressed data is split into chunks of
+ * points, preceded by a table of numChunks + 1 uint64_t chunk offsets
+ * (relative to the end of the table).  Each chunk starts with one ColumnarType
+ * per dimension, followed by the values of each dimension in that type; each
+ * dimension of each chunk uses the smallest type that holds its values exactly.
+ * If the ColumnarRunLength bit is set in the type of a dimension, its values
+ * are run-length encoded instead: the number of runs as uint32_t, the length
+ * of each run as uint32_t, and then the value of each run in that type.
+ */
+enum class ColumnarType : uint8_t
+{
+  U8 = 0,
+  U16 = 1,
+  U32 = 2,
+  U64 = 3,
+  S32 = 4,
+  S64 = 5,
+  F32 = 6,
+  F64 = 7
+};
+
+//! Identifies the native dataset format.
+static const char ColumnarMagic[8] = { 'M', 'L', 'P', 'K', 'C', 'O', 'L', 'S' };
+//! Current version of the native dataset format.
+static const uint32_t ColumnarVersion = 1;
+//! Used to detect a file written with a different byte order.
+static const uint32_t ColumnarByteOrder = 0x01020304;
+//! The data starts at a multiple of this many bytes.
+static const size_t ColumnarAlignment = 64;
+//! Default number of points in each compressed chunk.
+static const size_t ColumnarChunkSize = 65536;
+//! Set in the type of a dimension of a chunk whose values are run-length
+//! encoded.
+static const uint8_t ColumnarRunLength = 0x80;
+
+/**
+ * Get the ColumnarType that stores elements of type eT.  A
+ * std::invalid_argument is thrown if there is no such type.
+ */
+template<typename eT>
+ColumnarType ColumnarTypeOf()
+{
+  if (std::is_floating_point<eT>::value && sizeof(eT) == 4)
+    return ColumnarType::F32;
+  else if (std::is_floating_point<eT>::value && sizeof(eT) == 8)
+    return ColumnarType::F64;
+  else if (std::is_integral<eT>::value && std::is_signed<eT>::value &&
+      sizeof(eT) == 4)
+    return ColumnarType::S32;
+  else if (std::is_integral<eT>::value && std::is_signed<eT>::value &&
+      sizeof(eT) == 8)
+    return ColumnarType::S64;
+  else if (std::is_integral<eT>::value && std::is_unsigned<eT>::value)
+  {
+    switch (sizeof(eT))
+    {
+      case 1: return ColumnarType::U8;
+      case 2: return ColumnarType::U16;
+      case 4: return ColumnarType::U32;
+      case 8: return ColumnarType::U64;
+    }
+  }
+
+  throw std::invalid_argument("element type cannot be stored in the native "
+      "dataset format");
+}
+
+//! Get the size in bytes of an element of the given type.
+inline size_t ColumnarTypeSize(const ColumnarType type)
+{
+  switch (type)
+  {
+    case ColumnarType::U8: return 1;
+    case ColumnarType::U16: return 2;
+    case ColumnarType::U32: return 4;
+    case ColumnarType::U64: return 8;
+    case ColumnarType::S32: return 4;
+    case ColumnarType::S64: return 8;
+    case ColumnarType::F32: return 4;
+    case ColumnarType::F64: return 8;
+  }
+
+  throw std::invalid_argument("unknown element type in native dataset format");
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,178 @@
+/**
+ * @file core/data/image_batch_loader.hpp
+ *
+ * Definition of ImageBatchLoader, which decodes minibatches of images in the
+ * background.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_IMAGE_BATCH_LOADER_HPP
+#define MLPACK_CORE_DATA_IMAGE_BATCH_LOADER_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include "load.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * ImageBatchLoader iterates over a list of image files in minibatches, so
+ * that datasets of images that do not fit in memory can be used for
+ * training.  Each batch is held as a matrix with one image per column, in the
+ * same layout as data::Load() gives for a vector of files.  While a batch is
+ * used, the next one is already decoded by a background worker thread, which
+ * lives as long as the loader and uses several threads when OpenMP is
+ * available, so the time to decode the images is hidden behind the time to
+ * train on them.
+ *
+ * Every image is decoded to the size given in the ImageInfo; when resize is
+ * true, images of a different size are resized, and otherwise they cause an
+ * error.  BatchIndices() gives the indices of the files in the current batch,
+ * to select the matching labels.  For instance, to train an FFN for a number
+ * of epochs, with one optimizer pass over each batch:
+ *
+ * @code
+ * ImageBatchLoader<> loader(files, ImageInfo(64, 64, 3), 256, true);
+ *
+ * // Each call to Train() makes one pass over a batch of 256 images.  The
+ * // optimizer keeps its state (such as the moment estimates of Adam) from one
+ * // batch to the next, so the batches are steps of one training run.
+ * ens::Adam optimizer(0.001, 32, 0.9, 0.999, 1e-8, 256);
+ * optimizer.ResetPolicy() = false;
+ *
+ * arma::mat batch;
+ * for (size_t epoch = 0; epoch < epochs; ++epoch)
+ * {
+ *   while (loader.Next(batch))
+ *     model.Train(batch, labels.cols(loader.BatchIndices()), optimizer);
+ *
+ *   loader.Reset();
+ * }
+ * @endcode
+ *
+ * Any error while decoding a batch is thrown by the call to Next() that
+ * returns it.
+ *
+ * @tparam eT Type of the elements of the batches.
+ */
+template<typename eT = double>
+class ImageBatchLoader
+{
+ public:
+  /**
+   * Create the loader, and start decoding the first batch.
+   *
+   * @param files Image files to iterate over.
+   * @param info Size of the images.  If the width or height is 0, the size of
+   *     the first image is used.
+   * @param batchSize Number of images in each batch (the last batch of an
+   *     epoch may be smaller).
+   * @param shuffle If true, visit the files in a new random order every epoch.
+   * @param resize If true, resize images of a different size.
+   */
+  ImageBatchLoader(const std::vector<std::string>& files,
+                   const ImageInfo& info,
+                   const size_t batchSize,
+                   const bool shuffle = false,
+                   const bool resize = true);
+
+  //! Stop the worker thread, after it finishes the batch it is decoding.
+  ~ImageBatchLoader();
+
+  // The worker thread refers to the loader, so it can't be copied.
+  ImageBatchLoader(const ImageBatchLoader&) = delete;
+  ImageBatchLoader& operator=(const ImageBatchLoader&) = delete;
+
+  /**
+   * Get the next batch of the epoch, and start decoding the one after it.
+   * Returns false (and leaves batch unchanged) once the epoch is over.
+   *
+   * @param batch Matrix to store the batch in.
+   */
+  bool Next(arma::Mat<eT>& batch);
+
+  /**
+   * Start a new epoch.  If shuffle is true, the files are visited in a new
+   * order.
+   */
+  void Reset();
+
+  //! Get the indices of the files in the last batch returned by Next().
+  const arma::uvec& BatchIndices() const { return batchIndices; }
+
+  //! Get the size of the images.
+  const ImageInfo& Info() const { return info; }
+
+  //! Get the number of images in each batch.
+  size_t BatchSize() const { return batchSize; }
+
+  //! Get the number of batches in each epoch.
+  size_t NumBatches() const
+  {
+    return (files.size() + batchSize - 1) / batchSize;
+  }
+
+ private:
+  //! Start decoding the batch at the current position, if there is one.
+  void Prefetch();
+
+  //! Wait until the worker has decoded the requested batch.
+  void Wait();
+
+  //! Decode each requested batch, until the loader is destroyed.
+  void Work();
+
+  //! The image files.
+  std::vector<std::string> files;
+  //! The size of the images.
+  ImageInfo info;
+  //! The number of images in each batch.
+  size_t batchSize;
+  //! Whether the files are shuffled every epoch.
+  bool shuffle;
+  //! Whether images of a different size are resized.
+  bool resize;
+
+  //! The order in which the files are visited in this epoch.
+  arma::uvec order;
+  //! The position in order of the next batch to decode.
+  size_t position;
+  //! Whether a batch was requested and not yet returned by Next().
+  bool hasPending;
+  //! The indices of the files of the requested batch.
+  arma::uvec pendingIndices;
+  //! The requested batch, once it is decoded.
+  arma::Mat<eT> pendingBatch;
+  //! The error thrown while decoding the requested batch, if any.
+  std::exception_ptr pendingError;
+
+  //! Protects the flags shared with the worker thread.
+  std::mutex mutex;
+  //! Signals a change of the flags shared with the worker thread.
+  std::condition_variable condition;
+  //! Whether the worker should decode the requested batch.
+  bool requested;
+  //! Whether the requested batch is decoded.
+  bool ready;
+  //! Whether the worker should stop.
+  bool stop;
+  //! The worker thread that decodes the batches.
+  std::thread worker;
+  //! The indices of the files of the last batch returned.
+  arma::uvec batchIndices;
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "image_batch_loader_impl.hpp"
+
+#endif
@@ -0,0 +1,183 @@
+/**
+ * @file core/data/image_batch_loader_impl.hpp
+ *
+ * Implementation of ImageBatchLoader.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_IMAGE_BATCH_LOADER_IMPL_HPP
+#define MLPACK_CORE_DATA_IMAGE_BATCH_LOADER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "image_batch_loader.hpp"
+
+namespace mlpack {
+namespace data {
+
+template<typename eT>
+ImageBatchLoader<eT>::ImageBatchLoader(const std::vector<std::string>& files,
+                                       const ImageInfo& info,
+                                       const size_t batchSize,
+                                       const bool shuffle,
+                                       const bool resize) :
+    files(files),
+    info(info),
+    batchSize(batchSize),
+    shuffle(shuffle),
+    resize(resize),
+    position(0),
+    hasPending(false),
+    requested(false),
+    ready(false),
+    stop(false)
+{
+  if (files.empty())
+  {
+    throw std::invalid_argument("ImageBatchLoader: vector of image files is "
+        "empty");
+  }
+
+  if (batchSize == 0)
+  {
+    throw std::invalid_argument("ImageBatchLoader: batch size must be "
+        "positive");
+  }
+
+  // Take the size of the first image if no size is given.
+  if (this->info.Width() == 0 || this->info.Height() == 0)
+  {
+    arma::Mat<unsigned char> image;
+    LoadImage(files[0], image, this->info, true);
+  }
+
+  order = arma::regspace<arma::uvec>(0, files.size() - 1);
+  if (shuffle)
+    order = arma::shuffle(order);
+
+  worker = std::thread(&ImageBatchLoader::Work, this);
+  Prefetch();
+}
+
+template<typename eT>
+ImageBatchLoader<eT>::~ImageBatchLoader()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+  }
+
+  condition.notify_all();
+  worker.join();
+}
+
+template<typename eT>
+bool ImageBatchLoader<eT>::Next(arma::Mat<eT>& batch)
+{
+  if (!hasPending)
+    return false;
+
+  Wait();
+  hasPending = false;
+
+  // An error ends the epoch, like the end of the files does.
+  if (pendingError)
+  {
+    std::exception_ptr error = pendingError;
+    pendingError = nullptr;
+    std::rethrow_exception(error);
+  }
+
+  batch = std::move(pendingBatch);
+  batchIndices = std::move(pendingIndices);
+
+  Prefetch();
+  return true;
+}
+
+template<typename eT>
+void ImageBatchLoader<eT>::Reset()
+{
+  // The batch that is being decoded is no longer needed, but it still refers
+  // to the file order.
+  if (hasPending)
+    Wait();
+
+  pendingError = nullptr;
+  if (shuffle)
+    order = arma::shuffle(order);
+
+  position = 0;
+  Prefetch();
+}
+
+template<typename eT>
+void ImageBatchLoader<eT>::Prefetch()
+{
+  hasPending = false;
+  if (position >= files.size())
+    return;
+
+  // The worker is idle, so the request can be set up without the lock.
+  const size_t end = std::min(position + batchSize, files.size());
+  pendingIndices = order.subvec(position, end - 1);
+  position = end;
+  hasPending = true;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    requested = true;
+    ready = false;
+  }
+
+  condition.notify_all();
+}
+
+template<typename eT>
+void ImageBatchLoader<eT>::Wait()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  condition.wait(lock, [this]() { return ready; });
+}
+
+template<typename eT>
+void ImageBatchLoader<eT>::Work()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true)
+  {
+    condition.wait(lock, [this]() { return requested || stop; });
+    if (stop)
+      return;
+
+    // Decode without holding the lock; the other members of the request are
+    // not used by the loader until the batch is ready.
+    lock.unlock();
+    arma::Mat<eT> batch;
+    std::exception_ptr error;
+    try
+    {
+      batch.set_size(info.Width() * info.Height() * info.Channels(),
+          pendingIndices.n_elem);
+      DecodeImages(files, pendingIndices, batch, 0, info, resize);
+    }
+    catch (...)
+    {
+      error = std::current_exception();
+    }
+
+    lock.lock();
+    pendingBatch = std::move(batch);
+    pendingError = error;
+    requested = false;
+    ready = true;
+    condition.notify_all();
+  }
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
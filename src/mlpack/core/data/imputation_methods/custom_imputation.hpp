@@ -71,6 +71,36 @@ class CustomImputation
     }
   }
 
+  /**
+   * Impute all of the given dimensions at once, in one parallel pass over the
+   * points.  The result is the same as imputing each dimension on its own.
+   *
+   * @param input Matrix that contains the mapped values.
+   * @param mappedValues Value that the user wants to get rid of, for each of
+   *     the dimensions.
+   * @param dimensions Indices of the dimensions to impute.
+   * @param columnMajor State of whether the input matrix is columnMajor or not.
+   */
+  void Impute(arma::Mat<T>& input,
+              const std::vector<T>& mappedValues,
+              const std::vector<size_t>& dimensions,
+              const bool columnMajor = true)
+  {
+    const size_t numPoints = columnMajor ? input.n_cols : input.n_rows;
+
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) numPoints; ++i)
+    {
+      for (size_t k = 0; k < dimensions.size(); ++k)
+      {
+        T& value = columnMajor ? input(dimensions[k], i) :
+            input(i, dimensions[k]);
+        if (value == mappedValues[k] || std::isnan(value))
+          value = customValue;
+      }
+    }
+  }
+
  private:
   //! A user-defined value that the user wants to replace missing values with.
   T customValue;
@@ -96,6 +96,81 @@ class MeanImputation
       input(target.first, target.second) = mean;
     }
   }
+
+  /**
+   * Impute all of the given dimensions at once.  The sums of the valid
+   * elements of every dimension are computed in one parallel pass over the
+   * points, and the missing values are replaced in a second parallel pass.
+   * The result is the same as imputing each dimension on its own.
+   *
+   * @param input Matrix that contains the mapped values.
+   * @param mappedValues Value that the user wants to get rid of, for each of
+   *     the dimensions.
+   * @param dimensions Indices of the dimensions to impute.
+   * @param columnMajor State of whether the input matrix is columnMajor or not.
+   */
+  void Impute(arma::Mat<T>& input,
+              const std::vector<T>& mappedValues,
+              const std::vector<size_t>& dimensions,
+              const bool columnMajor = true)
+  {
+    const size_t numDimensions = dimensions.size();
+    const size_t numPoints = columnMajor ? input.n_cols : input.n_rows;
+    std::vector<double> sums(numDimensions, 0.0);
+    std::vector<size_t> elems(numDimensions, 0);
+
+    #pragma omp parallel
+    {
+      std::vector<double> threadSums(numDimensions, 0.0);
+      std::vector<size_t> threadElems(numDimensions, 0);
+
+      #pragma omp for schedule(static)
+      for (omp_size_t i = 0; i < (omp_size_t) numPoints; ++i)
+      {
+        for (size_t k = 0; k < numDimensions; ++k)
+        {
+          const T& value = columnMajor ? input(dimensions[k], i) :
+              input(i, dimensions[k]);
+          if (!(value == mappedValues[k] || std::isnan(value)))
+          {
+            threadSums[k] += value;
+            ++threadElems[k];
+          }
+        }
+      }
+
+      #pragma omp critical
+      {
+        for (size_t k = 0; k < numDimensions; ++k)
+        {
+          sums[k] += threadSums[k];
+          elems[k] += threadElems[k];
+        }
+      }
+    }
+
+    std::vector<double> means(numDimensions);
+    for (size_t k = 0; k < numDimensions; ++k)
+    {
+      if (elems[k] == 0)
+        Log::Fatal << "it is impossible to calculate mean; no valid elements "
+            << "in the dimension" << std::endl;
+
+      means[k] = sums[k] / elems[k];
+    }
+
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) numPoints; ++i)
+    {
+      for (size_t k = 0; k < numDimensions; ++k)
+      {
+        T& value = columnMajor ? input(dimensions[k], i) :
+            input(i, dimensions[k]);
+        if (value == mappedValues[k] || std::isnan(value))
+          value = means[k];
+      }
+    }
+  }
 }; // class MeanImputation
 
 } // namespace data
@@ -13,18 +13,43 @@
 #define MLPACK_CORE_DATA_IMPUTE_STRATEGIES_MEDIAN_IMPUTATION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/quantile_sketch.hpp>
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
 
 namespace mlpack {
 namespace data {
 /**
  * This is a class implementation of simple median imputation.
  * replace missing value with middle or average of middle values
+ *
+ * Optionally, the median can be estimated with a math::QuantileSketch
+ * instead.  This takes memory proportional to the sketch size instead of the
+ * number of points, and when many dimensions are imputed at once the sketches
+ * are built in one parallel pass over the points and then merged.
+ *
  * @tparam T Type of armadillo matrix
  */
 template <typename T>
 class MedianImputation
 {
  public:
+  /**
+   * Create the MedianImputation object.
+   *
+   * @param approximate If true, estimate the medians with a quantile sketch.
+   * @param sketchSize Size of the sketch (only used if approximate is true).
+   */
+  MedianImputation(const bool approximate = false,
+                   const size_t sketchSize = 200) :
+      approximate(approximate),
+      sketchSize(sketchSize)
+  {
+    // Nothing to do.
+  }
+
   /**
    * Impute function searches through the input looking for mappedValue and
    * replaces it with the median of the given dimension. The result is
@@ -40,6 +65,13 @@ class MedianImputation
               const size_t dimension,
               const bool columnMajor = true)
   {
+    if (approximate)
+    {
+      Impute(input, std::vector<T>(1, mappedValue),
+          std::vector<size_t>(1, dimension), columnMajor);
+      return;
+    }
+
     using PairType = std::pair<size_t, size_t>;
     // dimensions and indexes are saved as pairs inside this vector.
     std::vector<PairType> targets;
@@ -85,6 +117,164 @@ class MedianImputation
        input(target.first, target.second) = median;
     }
   }
+
+  /**
+   * Impute all of the given dimensions at once.  The dimensions are processed
+   * in parallel, and each median is found by selection instead of sorting.
+   * The result is the same as imputing each dimension on its own.  If the
+   * medians are approximate, the points are processed in parallel instead.
+   *
+   * @param input Matrix that contains the mapped values.
+   * @param mappedValues Value that the user wants to get rid of, for each of
+   *     the dimensions.
+   * @param dimensions Indices of the dimensions to impute.
+   * @param columnMajor State of whether the input matrix is columnMajor or not.
+   */
+  void Impute(arma::Mat<T>& input,
+              const std::vector<T>& mappedValues,
+              const std::vector<size_t>& dimensions,
+              const bool columnMajor = true)
+  {
+    if (approximate)
+    {
+      ApproximateImpute(input, mappedValues, dimensions, columnMajor);
+      return;
+    }
+
+    const size_t numDimensions = dimensions.size();
+    const size_t numPoints = columnMajor ? input.n_cols : input.n_rows;
+    // Dimensions without valid elements are reported after the parallel loop.
+    std::vector<char> noElems(numDimensions, 0);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t k = 0; k < (omp_size_t) numDimensions; ++k)
+    {
+      const size_t dimension = dimensions[k];
+      std::vector<double> elemsToKeep;
+      elemsToKeep.reserve(numPoints);
+      for (size_t i = 0; i < numPoints; ++i)
+      {
+        const T& value = columnMajor ? input(dimension, i) :
+            input(i, dimension);
+        if (!(value == mappedValues[k] || std::isnan(value)))
+          elemsToKeep.push_back(value);
+      }
+
+      if (elemsToKeep.empty())
+      {
+        noElems[k] = 1;
+        continue;
+      }
+
+      // Take the middle element, or the average of the two middle elements,
+      // as arma::median() does.
+      const size_t half = elemsToKeep.size() / 2;
+      std::nth_element(elemsToKeep.begin(), elemsToKeep.begin() + half,
+          elemsToKeep.end());
+      double median = elemsToKeep[half];
+      if (elemsToKeep.size() % 2 == 0)
+      {
+        const double lower = *std::max_element(elemsToKeep.begin(),
+            elemsToKeep.begin() + half);
+        median = lower + (median - lower) / 2.0;
+      }
+
+      for (size_t i = 0; i < numPoints; ++i)
+      {
+        T& value = columnMajor ? input(dimension, i) : input(i, dimension);
+        if (value == mappedValues[k] || std::isnan(value))
+          value = median;
+      }
+    }
+
+    for (size_t k = 0; k < numDimensions; ++k)
+    {
+      if (noElems[k])
+        Log::Fatal << "it is impossible to calculate median; no valid elements "
+            << "in the dimension" << std::endl;
+    }
+  }
+
+  //! Get whether the medians are estimated with a quantile sketch.
+  bool Approximate() const { return approximate; }
+  //! Modify whether the medians are estimated with a quantile sketch.
+  bool& Approximate() { return approximate; }
+
+  //! Get the size of the quantile sketch.
+  size_t SketchSize() const { return sketchSize; }
+  //! Modify the size of the quantile sketch.
+  size_t& SketchSize() { return sketchSize; }
+
+ private:
+  /**
+   * Impute the given dimensions with medians estimated by quantile sketches.
+   * The points are split into shards, one sketch per dimension is built for
+   * each shard in parallel, and the sketches of the shards are merged.
+   */
+  void ApproximateImpute(arma::Mat<T>& input,
+                         const std::vector<T>& mappedValues,
+                         const std::vector<size_t>& dimensions,
+                         const bool columnMajor)
+  {
+    const size_t numDimensions = dimensions.size();
+    const size_t numPoints = columnMajor ? input.n_cols : input.n_rows;
+    size_t numShards = 1;
+    #ifdef HAS_OPENMP
+      numShards = omp_get_max_threads();
+    #endif
+    numShards = std::max((size_t) 1, std::min(numShards, numPoints));
+
+    std::vector<std::vector<math::QuantileSketch<double>>> sketches(numShards,
+        std::vector<math::QuantileSketch<double>>(numDimensions,
+        math::QuantileSketch<double>(sketchSize)));
+
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t s = 0; s < (omp_size_t) numShards; ++s)
+    {
+      const size_t begin = s * numPoints / numShards;
+      const size_t end = (s + 1) * numPoints / numShards;
+      for (size_t i = begin; i < end; ++i)
+      {
+        for (size_t k = 0; k < numDimensions; ++k)
+        {
+          const T& value = columnMajor ? input(dimensions[k], i) :
+              input(i, dimensions[k]);
+          if (!(value == mappedValues[k] || std::isnan(value)))
+            sketches[s][k].Insert(value);
+        }
+      }
+    }
+
+    std::vector<double> medians(numDimensions);
+    for (size_t k = 0; k < numDimensions; ++k)
+    {
+      for (size_t s = 1; s < numShards; ++s)
+        sketches[0][k].Merge(sketches[s][k]);
+
+      if (sketches[0][k].Count() == 0)
+        Log::Fatal << "it is impossible to calculate median; no valid elements "
+            << "in the dimension" << std::endl;
+
+      medians[k] = sketches[0][k].Quantile(0.5);
+    }
+
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) numPoints; ++i)
+    {
+      for (size_t k = 0; k < numDimensions; ++k)
+      {
+        T& value = columnMajor ? input(dimensions[k], i) :
+            input(i, dimensions[k]);
+        if (value == mappedValues[k] || std::isnan(value))
+          value = medians[k];
+      }
+    }
+  }
+
+  //! Whether the medians are estimated with a quantile sketch.
+  bool approximate;
+  //! The size of the quantile sketch.
+  size_t sketchSize;
 }; // class MedianImputation
 
 } // namespace data
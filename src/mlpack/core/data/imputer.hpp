@@ -65,6 +65,30 @@ class Imputer
     strategy.Impute(input, mappedValue, dimension, columnMajor);
   }
 
+  /**
+  * Given an input dataset, replace missing values of all of the given
+  * dimensions with given imputation strategy.  The strategy handles every
+  * dimension in one parallel pass where it can, so this is faster than
+  * imputing each dimension on its own.  This function does not produce output
+  * matrix, but overwrites the result into the input matrix.
+  *
+  * @param input Input dataset to apply imputation.
+  * @param missingValue User defined missing value; it can be anything.
+  * @param dimensions Dimensions to apply the imputation.
+  */
+  void Impute(arma::Mat<T>& input,
+              const std::string& missingValue,
+              const std::vector<size_t>& dimensions)
+  {
+    std::vector<T> mappedValues(dimensions.size());
+    for (size_t k = 0; k < dimensions.size(); ++k)
+    {
+      mappedValues[k] = static_cast<T>(mapper.UnmapValue(missingValue,
+          dimensions[k]));
+    }
+    strategy.Impute(input, mappedValues, dimensions, columnMajor);
+  }
+
   //! Get the strategy.
   const StrategyType& Strategy() const { return strategy; }
 
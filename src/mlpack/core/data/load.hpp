@@ -21,6 +21,7 @@
 #include "format.hpp"
 #include "dataset_mapper.hpp"
 #include "image_info.hpp"
+#include "memory_mapped_file.hpp"
 
 namespace mlpack {
 namespace data /** Functions to load and save matrices and models. */ {
@@ -247,6 +248,9 @@ bool Load(const std::string& filename,
  * - TSV (raw_ascii), denoted by .tsv, .csv, or .txt
  * - ASCII (raw_ascii), denoted by .txt
  *
+ * ARFF files (.arff) and files in mlpack's native dataset format (.mlc; see
+ * Save()) can also be loaded.
+ *
  * If the file extension is not one of those types, an error will be given.
  * This is preferable to Armadillo's default behavior of loading an unknown
  * filetype as raw_binary, which can have very confusing effects.
@@ -353,6 +357,58 @@ bool Load(const std::string& filename,
           const bool fatal = false,
           format f = format::autodetect);
 
+/**
+ * Load a matrix saved in mlpack's native dataset format (see Save()) from a
+ * memory-mapped file, along with its DatasetMapper.  If the data was saved
+ * without compression and with the element type of the matrix, no data is
+ * copied: the matrix is made an alias of the mapped file contents, so loading
+ * is nearly instant and pages are only read when they are used.  The
+ * MemoryMappedFile must then outlive the matrix, unless the matrix is resized
+ * (which gives it its own memory).  Changes made to the matrix are not written
+ * back to the file.
+ * Otherwise, the data is converted into memory owned by the matrix.
+ *
+ * The matrix is not transposed; each point is a column, as it was when saved.
+ *
+ * @code
+ * data::MemoryMappedFile file("train.mlc");
+ * arma::mat dataset;
+ * data::DatasetInfo info;
+ * data::Load(file, dataset, info);
+ * @endcode
+ *
+ * @param file Mapped file to load.
+ * @param matrix Matrix to load contents of file into.
+ * @param info DatasetMapper object to populate with mappings and data types.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure of load.
+ */
+template<typename eT, typename PolicyType>
+bool Load(MemoryMappedFile& file,
+          arma::Mat<eT>& matrix,
+          DatasetMapper<PolicyType>& info,
+          const bool fatal = false);
+
+/**
+ * Load a sparse dataset and its labels from a file in the LibSVM (or SVMlight)
+ * format, denoted by .svm or .libsvm.  Each point is a column of the matrix,
+ * and the dimensionality is the largest index in the file.  See LoadLibSVM()
+ * for details of the format.  If the parameter 'fatal' is set to true, a
+ * std::runtime_error exception will be thrown if the dataset does not load
+ * successfully.
+ *
+ * @param filename Name of file to load.
+ * @param matrix Sparse matrix to load the points into.
+ * @param labels Row to load the label of each point into.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure of load.
+ */
+template<typename eT, typename LabelType>
+bool Load(const std::string& filename,
+          arma::SpMat<eT>& matrix,
+          arma::Row<LabelType>& labels,
+          const bool fatal = false);
+
 /**
  * Image load/save interfaces.
  */
@@ -373,19 +429,27 @@ bool Load(const std::string& filename,
           const bool fatal = false);
 
 /**
- * Load the image file into the given matrix.
+ * Load the image files into the given matrix, one image per column.  The
+ * images are decoded in parallel, straight into the columns of the matrix.
+ *
+ * If resize is false, the size of the images is taken from the first image,
+ * and every image must have that size.  If resize is true, every image is
+ * resized to the width and height given in info (or to the size of the first
+ * image, if info has no width or height) with bilinear interpolation.
  *
  * @param files A vector consisting of filenames.
  * @param matrix Matrix to save the image from.
  * @param info An object of ImageInfo class.
  * @param fatal If an error should be reported as fatal (default false).
+ * @param resize If true, resize images of a different size (default false).
  * @return Boolean value indicating success or failure of load.
  */
 template<typename eT>
 bool Load(const std::vector<std::string>& files,
           arma::Mat<eT>& matrix,
           ImageInfo& info,
-          const bool fatal = false);
+          const bool fatal = false,
+          const bool resize = false);
 
 // Implementation found in load_image.cpp.
 bool LoadImage(const std::string& filename,
@@ -393,6 +457,26 @@ bool LoadImage(const std::string& filename,
                ImageInfo& info,
                const bool fatal = false);
 
+/**
+ * Decode an image into the given memory, which must hold info.Width() *
+ * info.Height() * info.Channels() elements.  The image is converted to
+ * info.Channels() channels.  If the image has a different size, it is resized
+ * with bilinear interpolation if resize is true, and an error is thrown
+ * otherwise.  A std::runtime_error is thrown if the image cannot be loaded.
+ * Several images can be decoded at the same time from different threads.
+ *
+ * Implementation found in load_image.cpp.
+ *
+ * @param filename Name of the image file.
+ * @param memory Memory to decode the image into.
+ * @param info Size and number of channels to decode the image with.
+ * @param resize Whether an image of a different size should be resized.
+ */
+void DecodeImage(const std::string& filename,
+                 unsigned char* memory,
+                 const ImageInfo& info,
+                 const bool resize);
+
 } // namespace data
 } // namespace mlpack
 
@@ -402,5 +486,9 @@ bool LoadImage(const std::string& filename,
 #include "load_vec_impl.hpp"
 // Include implementation of Load() for images.
 #include "load_image_impl.hpp"
+// Include implementation of Load() for the native dataset format.
+#include "load_columnar_impl.hpp"
+// Include implementation of Load() for LibSVM files.
+#include "load_libsvm.hpp"
 
 #endif
@@ -54,6 +54,27 @@ void LoadARFF(const std::string& filename,
               arma::Mat<eT>& matrix,
               DatasetMapper<PolicyType>& info);
 
+/**
+ * Load an ARFF dataset into a sparse matrix, using the DatasetInfo structure
+ * for mapping.  The data section may mix dense lines and sparse lines of the
+ * form "{index value, index value, ...}", where indices start at 0 and values
+ * that are not listed are zero.  The file is read only once, and the sparse
+ * matrix is assembled as it is read, so the data is never held in dense form.
+ * An exception will be thrown upon failure.
+ *
+ * Note that a categorical value that is left out of a sparse line is zero, so
+ * it takes the first category of its dimension.
+ *
+ * @param filename Name of ARFF file to load.
+ * @param matrix Sparse matrix to load data into.
+ * @param info DatasetInfo object; can be default-constructed or pre-existing
+ *     from another call to LoadARFF().
+ */
+template<typename eT, typename PolicyType>
+void LoadARFF(const std::string& filename,
+              arma::SpMat<eT>& matrix,
+              DatasetMapper<PolicyType>& info);
+
 } // namespace data
 } // namespace mlpack
 
@@ -21,26 +21,24 @@
 namespace mlpack {
 namespace data {
 
+/**
+ * Read the header of an ARFF file, up to and including the @data line, and set
+ * up the types and the pre-specified categories of each dimension in info.
+ *
+ * @param ifs Stream to read from.
+ * @param info DatasetMapper to set up; it can be empty or pre-existing.
+ * @param categoryStrings Filled with the pre-specified categories of each
+ *     categorical dimension that has them.
+ * @return Number of lines in the header.
+ */
 template<typename eT, typename PolicyType>
-void LoadARFF(const std::string& filename,
-              arma::Mat<eT>& matrix,
-              DatasetMapper<PolicyType>& info)
+size_t ReadARFFHeader(std::ifstream& ifs,
+                      DatasetMapper<PolicyType>& info,
+                      std::map<size_t, std::vector<std::string>>&
+                          categoryStrings)
 {
-  // First, open the file.
-  std::ifstream ifs;
-  ifs.open(filename, std::ios::in | std::ios::binary);
-
-  // if file is not open throw an error (file not found).
-  if (!ifs.is_open())
-  {
-    Log::Fatal << "Cannot open file '" << filename << "'. " << std::endl;
-  }
-
   std::string line;
   size_t dimensionality = 0;
-  // We'll store a vector of strings representing categories to be mapped, if
-  // needed.
-  std::map<size_t, std::vector<std::string>> categoryStrings;
   std::vector<bool> types;
   size_t headerLines = 0;
   while (ifs.good())
@@ -176,16 +174,205 @@ void LoadARFF(const std::string& filename,
     }
   }
 
-  // We need to find out how many lines of data are in the file.
+  return headerLines;
+}
+
+/**
+ * Parse a single value of an ARFF file, mapping it if the dimension is
+ * categorical.  An exception is thrown if the value does not match the type of
+ * the dimension.
+ *
+ * @param str Token to parse.
+ * @param col Dimension of the token.
+ * @param lineNumber Line of the token, for error messages.
+ * @param info DatasetMapper to map categorical values with.
+ * @param categoryStrings Pre-specified categories of each dimension.
+ */
+template<typename eT, typename PolicyType>
+eT ParseARFFValue(const std::string& str,
+                  const size_t col,
+                  const size_t lineNumber,
+                  DatasetMapper<PolicyType>& info,
+                  const std::map<size_t, std::vector<std::string>>&
+                      categoryStrings)
+{
+  // What should this token be?
+  if (info.Type(col) == Datatype::categorical)
+  {
+    // Strip spaces before mapping.
+    std::string token = str;
+    boost::trim(token);
+    const size_t currentNumMappings = info.NumMappings(col);
+    const eT result = info.template MapString<eT>(token, col);
+
+    // If the set of categories was pre-specified, then we must crash if
+    // this was not one of those categories.
+    if (categoryStrings.count(col) > 0 &&
+        currentNumMappings < info.NumMappings(col))
+    {
+      std::stringstream error;
+      error << "Parse error at line " << lineNumber << " token " << col
+          << ": category \"" << token << "\" not in the set of known"
+          << " categories for this dimension (";
+      for (size_t i = 0; i < categoryStrings.at(col).size() - 1; ++i)
+        error << "\"" << categoryStrings.at(col)[i] << "\", ";
+      error << "\"" << categoryStrings.at(col).back() << "\").";
+      throw std::runtime_error(error.str());
+    }
+
+    return result;
+  }
+
+  // Attempt to read as numeric.
+  std::stringstream token(str);
+  eT val = eT(0);
+  token >> val;
+
+  if (token.fail())
+  {
+    // Check for NaN or inf.
+    if (!IsNaNInf(val, token.str()))
+    {
+      // Okay, it's not NaN or inf.  If it's '?', we issue a specific
+      // error, otherwise we issue a general error.
+      std::stringstream error;
+      std::string tokenStr = token.str();
+      boost::trim(tokenStr);
+      if (tokenStr == "?")
+        error << "Missing values ('?') not supported, ";
+      else
+        error << "Parse error ";
+      error << "at line " << lineNumber << " token " << col << ": \""
+          << tokenStr << "\".";
+      throw std::runtime_error(error.str());
+    }
+  }
+
+  // If we made it to here, we have a value.
+  return val;
+}
+
+/**
+ * Split a line of an ARFF file into the index and the value token of each of
+ * its entries, sorted by index.  Sparse lines ("{index value, ...}") only list
+ * their nonzero entries; dense lines list every value in order.
+ *
+ * @param line Line to split (with whitespace removed from either side).
+ * @param lineNumber Line number, for error messages.
+ * @param dimensionality Number of dimensions of the data.
+ * @param entries Filled with the index and the value token of each entry.
+ */
+inline void SplitARFFLine(const std::string& line,
+                          const size_t lineNumber,
+                          const size_t dimensionality,
+                          std::vector<std::pair<size_t, std::string>>& entries)
+{
+  typedef boost::tokenizer<boost::escaped_list_separator<char>> Tokenizer;
+  boost::escaped_list_separator<char> sep("\\", ",", "\"");
+  entries.clear();
+
+  if (line[0] != '{')
+  {
+    Tokenizer tok(line, sep);
+    for (Tokenizer::iterator it = tok.begin(); it != tok.end(); ++it)
+    {
+      // Check that we are not too many columns in.
+      if (entries.size() >= dimensionality)
+      {
+        std::stringstream error;
+        error << "Too many columns in line " << lineNumber << ".";
+        throw std::runtime_error(error.str());
+      }
+
+      entries.push_back(std::make_pair(entries.size(), *it));
+    }
+
+    return;
+  }
+
+  if (line[line.size() - 1] != '}')
+  {
+    std::stringstream error;
+    error << "Sparse data at line " << lineNumber << " is missing a closing "
+        << "'}'.";
+    throw std::runtime_error(error.str());
+  }
+
+  const std::string contents = line.substr(1, line.size() - 2);
+  Tokenizer tok(contents, sep);
+  for (Tokenizer::iterator it = tok.begin(); it != tok.end(); ++it)
+  {
+    std::string entry = *it;
+    boost::trim(entry);
+    if (entry.empty())
+      continue;
+
+    // Each entry is an index followed by whitespace and a value.
+    const size_t split = entry.find_first_of(" \t");
+    std::stringstream indexStream(entry.substr(0, split));
+    size_t index = 0;
+    indexStream >> index;
+    if (split == std::string::npos || indexStream.fail() ||
+        !indexStream.eof() || index >= dimensionality)
+    {
+      std::stringstream error;
+      error << "Invalid sparse entry \"" << entry << "\" at line "
+          << lineNumber << ".";
+      throw std::runtime_error(error.str());
+    }
+
+    entries.push_back(std::make_pair(index, entry.substr(split + 1)));
+  }
+
+  std::sort(entries.begin(), entries.end(),
+      [](const std::pair<size_t, std::string>& a,
+         const std::pair<size_t, std::string>& b)
+      {
+        return a.first < b.first;
+      });
+  for (size_t i = 1; i < entries.size(); ++i)
+  {
+    if (entries[i].first == entries[i - 1].first)
+    {
+      std::stringstream error;
+      error << "Index " << entries[i].first << " is given twice at line "
+          << lineNumber << ".";
+      throw std::runtime_error(error.str());
+    }
+  }
+}
+
+template<typename eT, typename PolicyType>
+void LoadARFF(const std::string& filename,
+              arma::Mat<eT>& matrix,
+              DatasetMapper<PolicyType>& info)
+{
+  // First, open the file.
+  std::ifstream ifs;
+  ifs.open(filename, std::ios::in | std::ios::binary);
+
+  // if file is not open throw an error (file not found).
+  if (!ifs.is_open())
+  {
+    Log::Fatal << "Cannot open file '" << filename << "'. " << std::endl;
+  }
+
+  // Read the header and set up info.
+  std::map<size_t, std::vector<std::string>> categoryStrings;
+  const size_t headerLines = ReadARFFHeader<eT>(ifs, info, categoryStrings);
+  const size_t dimensionality = info.Dimensionality();
+
+  // We need to find out how many lines of data are in the file.  Empty lines
+  // and comments are skipped, as they are in the header.
+  std::string line;
   std::streampos pos = ifs.tellg();
   size_t row = 0;
-  while (ifs.good())
+  while (std::getline(ifs, line, '\n'))
   {
-    std::getline(ifs, line, '\n');
-    ++row;
+    boost::trim(line);
+    if (!line.empty() && line[0] != '%')
+      ++row;
   }
-  // Uncount the EOF row.
-  --row;
 
   // Since we've hit the EOF, we have to call clear() so we can seek again.
   ifs.clear();
@@ -196,102 +383,94 @@ void LoadARFF(const std::string& filename,
 
   // Now we are looking at the @data section.
   row = 0;
-  while (ifs.good())
+  size_t lineNumber = headerLines;
+  std::vector<std::pair<size_t, std::string>> entries;
+  while (std::getline(ifs, line, '\n'))
   {
-    std::getline(ifs, line, '\n');
     boost::trim(line);
-    // Each line of the @data section must be a CSV (except sparse data, which
-    // we will handle later).  So now we can tokenize the
-    // CSV and parse it.  The '?' representing a missing value is not allowed,
-    // so if that occurs we throw an exception.  We also throw an exception if
-    // any piece of data does not match its type (categorical or numeric).
-
-    // If the first character is {, it is sparse data, and we can just say this
-    // is not handled for now...
-    if (line[0] == '{')
-      throw std::runtime_error("cannot yet parse sparse ARFF data");
+    ++lineNumber;
 
-    // Tokenize the line.
-    typedef boost::tokenizer<boost::escaped_list_separator<char>> Tokenizer;
-    boost::escaped_list_separator<char> sep("\\", ",", "\"");
-    Tokenizer tok(line, sep);
+    // Skip empty lines and comments.
+    if (line.empty() || line[0] == '%')
+      continue;
 
-    size_t col = 0;
-    std::stringstream token;
-    for (Tokenizer::iterator it = tok.begin(); it != tok.end(); ++it)
+    // Each line of the @data section must be a CSV, or a sparse line listing
+    // only the nonzero values.  The '?' representing a missing value is not
+    // allowed, so if that occurs we throw an exception.  We also throw an
+    // exception if any piece of data does not match its type (categorical or
+    // numeric).
+    SplitARFFLine(line, lineNumber, dimensionality, entries);
+
+    // Values that a sparse line leaves out are zero.
+    if (line[0] == '{')
+      matrix.col(row).zeros();
+
+    for (size_t i = 0; i < entries.size(); ++i)
     {
-      // Check that we are not too many columns in.
-      if (col >= matrix.n_rows)
-      {
-        std::stringstream error;
-        error << "Too many columns in line " << (headerLines + row) << ".";
-        throw std::runtime_error(error.str());
-      }
+      // We load transposed.
+      matrix(entries[i].first, row) = ParseARFFValue<eT>(entries[i].second,
+          entries[i].first, lineNumber, info, categoryStrings);
+    }
 
-      // What should this token be?
-      if (info.Type(col) == Datatype::categorical)
-      {
-        // Strip spaces before mapping.
-        std::string token = *it;
-        boost::trim(token);
-        const size_t currentNumMappings = info.NumMappings(col);
-        const eT result = info.template MapString<eT>(token, col);
-
-        // If the set of categories was pre-specified, then we must crash if
-        // this was not one of those categories.
-        if (categoryStrings.count(col) > 0 &&
-            currentNumMappings < info.NumMappings(col))
-        {
-          std::stringstream error;
-          error << "Parse error at line " << (headerLines + row) << " token "
-              << col << ": category \"" << token << "\" not in the set of known"
-              << " categories for this dimension (";
-          for (size_t i = 0; i < categoryStrings.at(col).size() - 1; ++i)
-            error << "\"" << categoryStrings.at(col)[i] << "\", ";
-          error << "\"" << categoryStrings.at(col).back() << "\").";
-          throw std::runtime_error(error.str());
-        }
+    ++row;
+  }
+}
 
-        // We load transposed.
-        matrix(col, row) = result;
-      }
-      else if (info.Type(col) == Datatype::numeric)
-      {
-        // Attempt to read as numeric.
-        token.clear();
-        token.str(*it);
+template<typename eT, typename PolicyType>
+void LoadARFF(const std::string& filename,
+              arma::SpMat<eT>& matrix,
+              DatasetMapper<PolicyType>& info)
+{
+  // First, open the file.
+  std::ifstream ifs;
+  ifs.open(filename, std::ios::in | std::ios::binary);
+
+  // if file is not open throw an error (file not found).
+  if (!ifs.is_open())
+  {
+    Log::Fatal << "Cannot open file '" << filename << "'. " << std::endl;
+  }
 
-        eT val = eT(0);
-        token >> val;
+  // Read the header and set up info.
+  std::map<size_t, std::vector<std::string>> categoryStrings;
+  const size_t headerLines = ReadARFFHeader<eT>(ifs, info, categoryStrings);
+  const size_t dimensionality = info.Dimensionality();
 
-        if (token.fail())
-        {
-          // Check for NaN or inf.
-          if (!IsNaNInf(val, token.str()))
-          {
-            // Okay, it's not NaN or inf.  If it's '?', we issue a specific
-            // error, otherwise we issue a general error.
-            std::stringstream error;
-            std::string tokenStr = token.str();
-            boost::trim(tokenStr);
-            if (tokenStr == "?")
-              error << "Missing values ('?') not supported, ";
-            else
-              error << "Parse error ";
-            error << "at line " << (headerLines + row) << " token " << col
-                << ": \"" << tokenStr << "\".";
-            throw std::runtime_error(error.str());
-          }
-        }
+  // Points are stored in order, so the compressed sparse column form of the
+  // matrix can be built while reading the file, one point at a time.
+  std::vector<arma::uword> rowIndices;
+  std::vector<arma::uword> colPtrs(1, 0);
+  std::vector<eT> values;
 
-        // If we made it to here, we have a value.
-        matrix(col, row) = val; // We load transposed.
-      }
+  std::string line;
+  size_t lineNumber = headerLines;
+  std::vector<std::pair<size_t, std::string>> entries;
+  while (std::getline(ifs, line, '\n'))
+  {
+    boost::trim(line);
+    ++lineNumber;
+
+    // Skip empty lines and comments.
+    if (line.empty() || line[0] == '%')
+      continue;
 
-      ++col;
+    SplitARFFLine(line, lineNumber, dimensionality, entries);
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+      const eT value = ParseARFFValue<eT>(entries[i].second, entries[i].first,
+          lineNumber, info, categoryStrings);
+      if (value != eT(0))
+      {
+        rowIndices.push_back(entries[i].first);
+        values.push_back(value);
+      }
     }
-    ++row;
+
+    colPtrs.push_back(rowIndices.size());
   }
+
+  matrix = arma::SpMat<eT>(arma::uvec(rowIndices), arma::uvec(colPtrs),
+      arma::Col<eT>(values), dimensionality, colPtrs.size() - 1);
 }
 
 } // namespace data
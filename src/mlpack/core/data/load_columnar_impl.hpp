@@ -0,0 +1,334 @@
+/**
+ * @file core/data/load_columnar_impl.hpp
+ *
+ * Implementation of Load() for the native dataset format.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LOAD_COLUMNAR_IMPL_HPP
+#define MLPACK_CORE_DATA_LOAD_COLUMNAR_IMPL_HPP
+
+// In case it hasn't already been included.
+#include "load.hpp"
+#include "columnar_format.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Read a value from the header of a file in the native dataset format, and
+ * advance the position.  A std::runtime_error is thrown if the file is too
+ * short.
+ */
+template<typename T>
+T ReadColumnarValue(const char* data, const size_t size, size_t& position)
+{
+  if (size - position < sizeof(T))
+    throw std::runtime_error("native dataset file is truncated");
+
+  T value;
+  std::memcpy(&value, data + position, sizeof(T));
+  position += sizeof(T);
+  return value;
+}
+
+//! Convert n values stored as StorageType, writing them stride elements apart.
+template<typename StorageType, typename eT>
+void ReadColumnarValues(const char* data,
+                        const size_t n,
+                        eT* output,
+                        const size_t stride)
+{
+  for (size_t i = 0; i < n; ++i)
+  {
+    StorageType value;
+    std::memcpy(&value, data + i * sizeof(StorageType), sizeof(StorageType));
+    output[i * stride] = (eT) value;
+  }
+}
+
+//! Convert n values stored with the given type, writing them stride elements
+//! apart.
+template<typename eT>
+void ReadColumnarValues(const ColumnarType type,
+                        const char* data,
+                        const size_t n,
+                        eT* output,
+                        const size_t stride)
+{
+  switch (type)
+  {
+    case ColumnarType::U8:
+      ReadColumnarValues<uint8_t>(data, n, output, stride);
+      break;
+    case ColumnarType::U16:
+      ReadColumnarValues<uint16_t>(data, n, output, stride);
+      break;
+    case ColumnarType::U32:
+      ReadColumnarValues<uint32_t>(data, n, output, stride);
+      break;
+    case ColumnarType::U64:
+      ReadColumnarValues<uint64_t>(data, n, output, stride);
+      break;
+    case ColumnarType::S32:
+      ReadColumnarValues<int32_t>(data, n, output, stride);
+      break;
+    case ColumnarType::S64:
+      ReadColumnarValues<int64_t>(data, n, output, stride);
+      break;
+    case ColumnarType::F32:
+      ReadColumnarValues<float>(data, n, output, stride);
+      break;
+    case ColumnarType::F64:
+      ReadColumnarValues<double>(data, n, output, stride);
+      break;
+  }
+}
+
+/**
+ * Load a matrix and its DatasetMapper from the contents of a file in the native
+ * dataset format.  If alias is true and the data is stored uncompressed with
+ * the element type of the matrix, the matrix is made an alias of the data;
+ * otherwise the data is converted into memory owned by the matrix.  The
+ * categorical mappings are restored by mapping each stored string in order.
+ * A std::runtime_error is thrown if the contents are not valid.
+ */
+template<typename eT, typename PolicyType>
+void LoadColumnar(char* data,
+                  const size_t size,
+                  arma::Mat<eT>& matrix,
+                  DatasetMapper<PolicyType>& info,
+                  const bool alias)
+{
+  if (size < 8 || std::memcmp(data, ColumnarMagic, 8) != 0)
+    throw std::runtime_error("not a native dataset file");
+
+  size_t position = 8;
+  if (ReadColumnarValue<uint32_t>(data, size, position) > ColumnarVersion)
+  {
+    throw std::runtime_error("native dataset file was written by a newer "
+        "version of mlpack");
+  }
+
+  if (ReadColumnarValue<uint32_t>(data, size, position) != ColumnarByteOrder)
+  {
+    throw std::runtime_error("native dataset file was written on a machine "
+        "with a different byte order");
+  }
+
+  const uint8_t typeCode = ReadColumnarValue<uint8_t>(data, size, position);
+  if (typeCode > (uint8_t) ColumnarType::F64)
+    throw std::runtime_error("native dataset file has an unknown element type");
+  const ColumnarType type = (ColumnarType) typeCode;
+  const size_t typeSize = ColumnarTypeSize(type);
+
+  const bool compressed = (ReadColumnarValue<uint8_t>(data, size, position) !=
+      0);
+  ReadColumnarValue<uint16_t>(data, size, position);
+  const size_t rows = ReadColumnarValue<uint64_t>(data, size, position);
+  const size_t cols = ReadColumnarValue<uint64_t>(data, size, position);
+  const size_t chunkSize = ReadColumnarValue<uint64_t>(data, size, position);
+  if (chunkSize == 0 || size - position < rows ||
+      (cols != 0 && rows > std::numeric_limits<size_t>::max() / cols))
+    throw std::runtime_error("native dataset file is corrupt");
+
+  // Restore the types and mappings of each dimension.
+  info.SetDimensionality(rows);
+  for (size_t d = 0; d < rows; ++d)
+  {
+    info.Type(d) = (ReadColumnarValue<uint8_t>(data, size, position) != 0) ?
+        Datatype::categorical : Datatype::numeric;
+  }
+
+  for (size_t d = 0; d < rows; ++d)
+  {
+    if (info.Type(d) != Datatype::categorical)
+      continue;
+
+    const size_t numMappings = ReadColumnarValue<uint64_t>(data, size,
+        position);
+    for (size_t i = 0; i < numMappings; ++i)
+    {
+      const size_t length = ReadColumnarValue<uint64_t>(data, size, position);
+      if (size - position < length)
+        throw std::runtime_error("native dataset file is truncated");
+
+      info.template MapString<size_t>(std::string(data + position, length), d);
+      position += length;
+    }
+  }
+
+  // The data starts at the next aligned position.
+  position = ((position + ColumnarAlignment - 1) / ColumnarAlignment) *
+      ColumnarAlignment;
+  if (position > size)
+    throw std::runtime_error("native dataset file is truncated");
+
+  if (!compressed)
+  {
+    if ((size - position) / typeSize < rows * cols)
+      throw std::runtime_error("native dataset file is truncated");
+
+    char* values = data + position;
+    if (alias && type == ColumnarTypeOf<eT>())
+    {
+      // Move an alias of the data into the matrix.  Armadillo only takes over
+      // the memory of an alias that is not strict when it is moved.
+      matrix = std::move(arma::Mat<eT>((eT*) values, rows, cols, false,
+          false));
+      return;
+    }
+
+    matrix.set_size(rows, cols);
+
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) cols; ++i)
+    {
+      ReadColumnarValues(type, values + i * rows * typeSize, rows,
+          matrix.colptr(i), 1);
+    }
+
+    return;
+  }
+
+  // Read the table of chunk offsets.
+  const size_t numChunks = (cols + chunkSize - 1) / chunkSize;
+  if ((size - position) / sizeof(uint64_t) < numChunks + 1)
+    throw std::runtime_error("native dataset file is truncated");
+
+  std::vector<uint64_t> offsets(numChunks + 1);
+  std::memcpy(offsets.data(), data + position, offsets.size() *
+      sizeof(uint64_t));
+  const char* chunks = data + position + offsets.size() * sizeof(uint64_t);
+  const size_t chunksSize = size - position - offsets.size() *
+      sizeof(uint64_t);
+
+  // Decompress each chunk in parallel.  Errors can't be thrown from inside the
+  // parallel region, so they are recorded for each chunk.
+  matrix.set_size(rows, cols);
+  std::vector<char> corrupt(numChunks, 0);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+  {
+    const size_t begin = c * chunkSize;
+    const size_t points = std::min(chunkSize, cols - begin);
+    if (offsets[c] > offsets[c + 1] || offsets[c + 1] > chunksSize ||
+        offsets[c + 1] - offsets[c] < rows)
+    {
+      corrupt[c] = 1;
+      continue;
+    }
+
+    // Decode each dimension, checking that it fits in the chunk.
+    const char* chunk = chunks + offsets[c];
+    const size_t chunkBytes = offsets[c + 1] - offsets[c];
+    size_t chunkPosition = rows;
+    for (size_t d = 0; d < rows && !corrupt[c]; ++d)
+    {
+      const uint8_t code = (uint8_t) chunk[d];
+      const uint8_t storageCode = (uint8_t) (code & ~ColumnarRunLength);
+      if (storageCode > (uint8_t) ColumnarType::F64)
+      {
+        corrupt[c] = 1;
+        break;
+      }
+
+      const ColumnarType storageType = (ColumnarType) storageCode;
+      const size_t storageSize = ColumnarTypeSize(storageType);
+      if (!(code & ColumnarRunLength))
+      {
+        if ((chunkBytes - chunkPosition) / storageSize < points)
+        {
+          corrupt[c] = 1;
+          break;
+        }
+
+        ReadColumnarValues(storageType, chunk + chunkPosition, points,
+            matrix.colptr(begin) + d, rows);
+        chunkPosition += points * storageSize;
+        continue;
+      }
+
+      // The values are run-length encoded.
+      uint32_t numRuns = 0;
+      if (chunkBytes - chunkPosition >= sizeof(uint32_t))
+      {
+        std::memcpy(&numRuns, chunk + chunkPosition, sizeof(uint32_t));
+        chunkPosition += sizeof(uint32_t);
+      }
+
+      if (numRuns == 0 || numRuns > points || (chunkBytes - chunkPosition) /
+          (sizeof(uint32_t) + storageSize) < numRuns)
+      {
+        corrupt[c] = 1;
+        break;
+      }
+
+      const char* lengths = chunk + chunkPosition;
+      const char* runValues = lengths + numRuns * sizeof(uint32_t);
+      size_t i = 0;
+      for (size_t r = 0; r < numRuns; ++r)
+      {
+        uint32_t length;
+        std::memcpy(&length, lengths + r * sizeof(uint32_t), sizeof(uint32_t));
+        if (length > points - i)
+        {
+          corrupt[c] = 1;
+          break;
+        }
+
+        eT value;
+        ReadColumnarValues(storageType, runValues + r * storageSize, 1, &value,
+            1);
+        for (size_t j = 0; j < length; ++j, ++i)
+          matrix(d, begin + i) = value;
+      }
+
+      if (i != points)
+        corrupt[c] = 1;
+      chunkPosition += numRuns * (sizeof(uint32_t) + storageSize);
+    }
+
+    if (chunkPosition != chunkBytes)
+      corrupt[c] = 1;
+  }
+
+  if (std::find(corrupt.begin(), corrupt.end(), 1) != corrupt.end())
+    throw std::runtime_error("native dataset file is corrupt");
+}
+
+template<typename eT, typename PolicyType>
+bool Load(MemoryMappedFile& file,
+          arma::Mat<eT>& matrix,
+          DatasetMapper<PolicyType>& info,
+          const bool fatal)
+{
+  Timer::Start("loading_data");
+
+  try
+  {
+    LoadColumnar(file.Data(), file.Size(), matrix, info, true);
+  }
+  catch (std::exception& e)
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << e.what() << std::endl;
+    else
+      Log::Warn << e.what() << std::endl;
+
+    return false;
+  }
+
+  Timer::Stop("loading_data");
+  return true;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -11,12 +11,23 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include "load_csv.hpp"
+#include "parse_float.hpp"
 
 using namespace boost::spirit;
 
 namespace mlpack {
 namespace data {
 
+namespace {
+
+//! Whether a character is removed by boost::trim() in the "C" locale.
+inline bool IsSpace(const char c)
+{
+  return (c == ' ') || (c >= '\t' && c <= '\r');
+}
+
+} // anonymous namespace
+
 LoadCSV::LoadCSV(const std::string& file) :
   extension(Extension(file)),
   filename(file),
@@ -52,6 +63,8 @@ LoadCSV::LoadCSV(const std::string& file) :
 
   if (extension == "csv")
   {
+    delimiter = ',';
+
     // Extract a single comma as the delimiter, catching whitespace on either
     // side.
     delimiterRule = qi::raw[(*qi::char_(" ") >> qi::char_(",") >>
@@ -59,12 +72,16 @@ LoadCSV::LoadCSV(const std::string& file) :
   }
   else if (extension == "txt")
   {
+    delimiter = ' ';
+
     // This one is a little more difficult, we need to catch any number of
     // spaces more than one.
     delimiterRule = qi::raw[+qi::char_(" ")];
   }
   else // TSV.
   {
+    delimiter = '\t';
+
     // Catch a tab character, possibly with whitespace on either side.
     delimiterRule = qi::raw[(*qi::char_(" ") >> qi::char_("\t") >>
         *qi::char_(" "))];
@@ -83,5 +100,98 @@ void LoadCSV::CheckOpen()
   inFile.unsetf(std::ios::skipws);
 }
 
+void LoadCSV::SplitLine(const char* begin,
+                        const char* end,
+                        std::vector<Field>& fields) const
+{
+  fields.clear();
+
+  // Remove whitespace from either side.
+  while (begin < end && IsSpace(*begin))
+    ++begin;
+  while (end > begin && IsSpace(*(end - 1)))
+    --end;
+
+  const char* pos = begin;
+  while (true)
+  {
+    const char* fieldBegin = pos;
+    const char* fieldEnd = NULL;
+
+    // Match quoted strings as: "string" or 'string', where a doubled quote is
+    // an escaped quote.  If the quote is never closed, this is not a quoted
+    // string.
+    if (pos < end && (*pos == '"' || *pos == '\''))
+    {
+      const char quote = *pos;
+      for (const char* c = pos + 1; c < end; ++c)
+      {
+        if (*c == quote)
+        {
+          if (c + 1 < end && *(c + 1) == quote)
+          {
+            ++c;
+            continue;
+          }
+
+          fieldEnd = c + 1;
+          break;
+        }
+      }
+    }
+
+    if (fieldEnd == NULL)
+    {
+      // Match all characters up to the delimiter or a line break; commas are
+      // not allowed in fields of text files either.
+      while (pos < end && *pos != delimiter && *pos != '\r' && *pos != '\n' &&
+          !(delimiter == ' ' && *pos == ','))
+        ++pos;
+      fieldEnd = pos;
+    }
+    pos = fieldEnd;
+
+    // Remove whitespace from either side of the field.
+    while (fieldBegin < fieldEnd && IsSpace(*fieldBegin))
+      ++fieldBegin;
+    while (fieldEnd > fieldBegin && IsSpace(*(fieldEnd - 1)))
+      --fieldEnd;
+    fields.push_back(Field(fieldBegin, fieldEnd));
+
+    // Now match the delimiter.  For text files this is any number of spaces;
+    // otherwise it is a single delimiter with optional spaces on either side.
+    if (delimiter == ' ')
+    {
+      if (pos == end || *pos != ' ')
+        break;
+      while (pos < end && *pos == ' ')
+        ++pos;
+    }
+    else
+    {
+      const char* next = pos;
+      while (next < end && *next == ' ')
+        ++next;
+      if (next == end || *next != delimiter)
+        break;
+
+      ++next;
+      while (next < end && *next == ' ')
+        ++next;
+      pos = next;
+    }
+  }
+}
+
+bool LoadCSV::ParseNumber(const char* begin, const char* end, double& value)
+{
+  return ParseFloat(begin, end, value);
+}
+
+bool LoadCSV::ParseNumber(const char* begin, const char* end, float& value)
+{
+  return ParseFloat(begin, end, value);
+}
+
 } // namespace data
 } // namespace mlpack
@@ -20,10 +20,12 @@
 
 #include <set>
 #include <string>
+#include <unordered_map>
 
 #include "extension.hpp"
 #include "format.hpp"
 #include "dataset_mapper.hpp"
+#include "memory_mapped_file.hpp"
 
 namespace mlpack {
 namespace data {
@@ -32,6 +34,10 @@ namespace data {
  *Load the csv file.This class use boost::spirit
  *to implement the parser, please refer to following link
  *http://theboostcpplibraries.com/boost.spirit for quick review.
+ *
+ * When a transposed matrix of floats or doubles is loaded with a DatasetInfo
+ * (that is, with IncrementPolicy), the file is instead memory-mapped and split
+ * into chunks of whole lines that are parsed in parallel.
  */
 class LoadCSV
 {
@@ -207,6 +213,22 @@ class LoadCSV
  private:
   using iter_type = boost::iterator_range<std::string::iterator>;
 
+  //! A field of a line, as a range of characters in the mapped file.
+  using Field = std::pair<const char*, const char*>;
+
+  /**
+   * The parallel parser reproduces the behavior of IncrementPolicy, including
+   * the stream extraction it uses to decide whether a value is numeric, so it
+   * is only used for that policy and floating-point matrices.
+   */
+  template<typename T, typename PolicyType>
+  struct ParallelParsable
+  {
+    static const bool value =
+        std::is_same<PolicyType, IncrementPolicy>::value &&
+        (std::is_same<T, double>::value || std::is_same<T, float>::value);
+  };
+
   /**
    * Check whether or not the file has successfully opened; throw an exception
    * if not.
@@ -290,7 +312,8 @@ class LoadCSV
    * @param infoSet DatasetMapper to load with.
    */
   template<typename T, typename PolicyType>
-  void TransposeParse(arma::Mat<T>& inout, DatasetMapper<PolicyType>& infoSet)
+  typename std::enable_if<!ParallelParsable<T, PolicyType>::value>::type
+  TransposeParse(arma::Mat<T>& inout, DatasetMapper<PolicyType>& infoSet)
   {
     using namespace boost::spirit;
 
@@ -357,11 +380,237 @@ class LoadCSV
     }
   }
 
+  /**
+   * Parse a transposed matrix in parallel.  The file is memory-mapped and split
+   * into chunks of whole lines, and each chunk is parsed by a different thread
+   * directly into the matrix.  Values in categorical dimensions are first
+   * mapped with a dictionary local to each chunk; the dictionaries are then
+   * merged into infoSet in file order, so the mappings are the same as those
+   * the serial parser would give.
+   *
+   * @param inout Matrix to load into.
+   * @param infoSet DatasetMapper to load with.
+   */
+  template<typename T, typename PolicyType>
+  typename std::enable_if<ParallelParsable<T, PolicyType>::value>::type
+  TransposeParse(arma::Mat<T>& inout, DatasetMapper<PolicyType>& infoSet)
+  {
+    MemoryMappedFile file(filename);
+    const char* data = file.Data();
+
+    // Each line is a column of the matrix.
+    std::vector<size_t> chunkBounds, chunkFirstLine;
+    const size_t cols = file.SplitLines(chunkBounds, chunkFirstLine);
+    const size_t numChunks = chunkBounds.size() - 1;
+    if (cols == 0)
+    {
+      inout.set_size(0, 0);
+      return;
+    }
+
+    // The number of fields on the first line is the dimensionality.
+    std::vector<Field> fields;
+    const char* firstLineEnd = (const char*) std::memchr(data, '\n',
+        file.Size());
+    SplitLine(data, (firstLineEnd == NULL) ? data + file.Size() : firstLineEnd,
+        fields);
+    const size_t rows = fields.size();
+
+    infoSet.SetDimensionality(rows);
+    inout.set_size(rows, cols);
+
+    // First pass: parse all numeric values, and find out which dimensions are
+    // categorical.  If any value in a dimension is not numeric, every value in
+    // that dimension has to be mapped.
+    const bool forceAllMappings = ForcesAllMappings(infoSet.Policy());
+    std::vector<std::vector<char>> chunkCategorical(numChunks,
+        std::vector<char>(rows, forceAllMappings));
+    std::vector<size_t> badLine(numChunks, cols);
+    std::vector<size_t> badLineSize(numChunks, 0);
+
+    #pragma omp parallel for schedule(dynamic) private(fields)
+    for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+    {
+      std::vector<char>& categorical = chunkCategorical[c];
+      const char* line = data + chunkBounds[c];
+      const char* chunkEnd = data + chunkBounds[c + 1];
+      for (size_t col = chunkFirstLine[c]; line < chunkEnd; ++col)
+      {
+        const char* lineEnd = (const char*) std::memchr(line, '\n',
+            chunkEnd - line);
+        if (lineEnd == NULL)
+          lineEnd = chunkEnd;
+
+        SplitLine(line, lineEnd, fields);
+        if (fields.size() != rows)
+        {
+          badLine[c] = col;
+          badLineSize[c] = fields.size();
+          break;
+        }
+
+        for (size_t row = 0; row < rows; ++row)
+        {
+          if (!categorical[row] && !ParseNumber(fields[row].first,
+              fields[row].second, inout(row, col)))
+            categorical[row] = true;
+        }
+
+        line = lineEnd + 1;
+      }
+    }
+
+    // Report the first malformed line, as the serial parser would.
+    const size_t firstBadChunk = std::min_element(badLine.begin(),
+        badLine.end()) - badLine.begin();
+    if (badLine[firstBadChunk] != cols)
+    {
+      std::ostringstream oss;
+      oss << "LoadCSV::TransposeParse(): wrong number of dimensions ("
+          << badLineSize[firstBadChunk] << ") on line "
+          << badLine[firstBadChunk] << "; should be " << rows
+          << " dimensions.";
+      throw std::runtime_error(oss.str());
+    }
+
+    std::vector<size_t> categoricalDims;
+    for (size_t row = 0; row < rows; ++row)
+    {
+      for (size_t c = 0; c < numChunks; ++c)
+      {
+        if (chunkCategorical[c][row])
+        {
+          categoricalDims.push_back(row);
+          break;
+        }
+      }
+    }
+
+    if (categoricalDims.empty())
+      return;
+
+    // Second pass: map the values in categorical dimensions to indices that
+    // are local to each chunk, in order of first appearance in the chunk.
+    const size_t numCategorical = categoricalDims.size();
+    std::vector<std::vector<std::vector<std::string>>> chunkStrings(numChunks,
+        std::vector<std::vector<std::string>>(numCategorical));
+    std::vector<std::vector<size_t>> chunkIndices(numChunks);
+
+    #pragma omp parallel for schedule(dynamic) private(fields)
+    for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+    {
+      std::vector<std::unordered_map<std::string, size_t>> dictionaries(
+          numCategorical);
+      std::vector<size_t>& indices = chunkIndices[c];
+      indices.reserve((chunkFirstLine[c + 1] - chunkFirstLine[c]) *
+          numCategorical);
+
+      const char* line = data + chunkBounds[c];
+      const char* chunkEnd = data + chunkBounds[c + 1];
+      while (line < chunkEnd)
+      {
+        const char* lineEnd = (const char*) std::memchr(line, '\n',
+            chunkEnd - line);
+        if (lineEnd == NULL)
+          lineEnd = chunkEnd;
+
+        SplitLine(line, lineEnd, fields);
+        for (size_t i = 0; i < numCategorical; ++i)
+        {
+          const Field& field = fields[categoricalDims[i]];
+          std::string str(field.first, field.second);
+          auto result = dictionaries[i].insert(std::make_pair(str,
+              dictionaries[i].size()));
+          if (result.second)
+            chunkStrings[c][i].push_back(std::move(str));
+
+          indices.push_back(result.first->second);
+        }
+
+        line = lineEnd + 1;
+      }
+    }
+
+    // Merge the dictionaries into infoSet, in file order.
+    std::vector<std::vector<std::vector<size_t>>> chunkMappings(numChunks,
+        std::vector<std::vector<size_t>>(numCategorical));
+    for (size_t i = 0; i < numCategorical; ++i)
+      infoSet.Type(categoricalDims[i]) = Datatype::categorical;
+
+    for (size_t c = 0; c < numChunks; ++c)
+    {
+      for (size_t i = 0; i < numCategorical; ++i)
+      {
+        for (const std::string& str : chunkStrings[c][i])
+        {
+          chunkMappings[c][i].push_back(infoSet.template MapString<size_t>(str,
+              categoricalDims[i]));
+        }
+      }
+    }
+
+    // Finally, translate the local indices into the merged mappings.
+    #pragma omp parallel for
+    for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+    {
+      const std::vector<size_t>& indices = chunkIndices[c];
+      for (size_t j = 0; j < indices.size(); ++j)
+      {
+        const size_t col = chunkFirstLine[c] + j / numCategorical;
+        const size_t i = j % numCategorical;
+        inout(categoricalDims[i], col) = T(chunkMappings[c][i][indices[j]]);
+      }
+    }
+  }
+
+  /**
+   * Split a line into fields, following the same rules as the Spirit parser:
+   * whitespace is removed from either side of the line and of each field, and
+   * quoted fields may contain delimiters.  As with the Spirit parser, anything
+   * that cannot be parsed at the end of the line is ignored.
+   *
+   * @param begin Start of the line.
+   * @param end End of the line (not including the newline).
+   * @param fields Filled with the fields of the line.
+   */
+  void SplitLine(const char* begin,
+                 const char* end,
+                 std::vector<Field>& fields) const;
+
+  /**
+   * Parse a number, accepting exactly what a stream extraction (as used by
+   * IncrementPolicy) would.  Returns false if the field is not a number.
+   *
+   * @param begin Start of the field.
+   * @param end End of the field.
+   * @param value Filled with the number.
+   */
+  static bool ParseNumber(const char* begin, const char* end, double& value);
+
+  //! Parse a number as a float; see the overload for doubles.
+  static bool ParseNumber(const char* begin, const char* end, float& value);
+
+  //! Get whether a policy maps every value, even numeric ones.
+  static bool ForcesAllMappings(const IncrementPolicy& policy)
+  {
+    return policy.ForceAllMappings();
+  }
+
+  //! Other policies are not used by the parallel parser.
+  template<typename PolicyType>
+  static bool ForcesAllMappings(const PolicyType& /* policy */)
+  {
+    return false;
+  }
+
   //! Spirit rule for parsing.
   boost::spirit::qi::rule<std::string::iterator, iter_type()> stringRule;
   //! Spirit rule for delimiters (i.e. ',' for CSVs).
   boost::spirit::qi::rule<std::string::iterator, iter_type()> delimiterRule;
 
+  //! Delimiter between fields, used by the parallel parser.
+  char delimiter;
+
   //! Extension (type) of file.
   std::string extension;
   //! Name of file.
@@ -96,6 +96,111 @@ bool LoadImage(const std::string& filename,
   return true;
 }
 
+namespace {
+
+/**
+ * Resize an image with interleaved channels using bilinear interpolation,
+ * sampling at the centers of the output pixels.
+ */
+void ResizeImage(const unsigned char* input,
+                 const size_t width,
+                 const size_t height,
+                 const size_t channels,
+                 unsigned char* output,
+                 const size_t newWidth,
+                 const size_t newHeight)
+{
+  const double xScale = (double) width / newWidth;
+  const double yScale = (double) height / newHeight;
+  for (size_t y = 0; y < newHeight; ++y)
+  {
+    const double sy = std::min(std::max((y + 0.5) * yScale - 0.5, 0.0),
+        (double) (height - 1));
+    const size_t y0 = (size_t) sy;
+    const size_t y1 = std::min(y0 + 1, height - 1);
+    const double dy = sy - y0;
+
+    for (size_t x = 0; x < newWidth; ++x)
+    {
+      const double sx = std::min(std::max((x + 0.5) * xScale - 0.5, 0.0),
+          (double) (width - 1));
+      const size_t x0 = (size_t) sx;
+      const size_t x1 = std::min(x0 + 1, width - 1);
+      const double dx = sx - x0;
+
+      for (size_t c = 0; c < channels; ++c)
+      {
+        const double top = (1 - dx) * input[(y0 * width + x0) * channels + c] +
+            dx * input[(y0 * width + x1) * channels + c];
+        const double bottom = (1 - dx) *
+            input[(y1 * width + x0) * channels + c] +
+            dx * input[(y1 * width + x1) * channels + c];
+        output[(y * newWidth + x) * channels + c] =
+            (unsigned char) ((1 - dy) * top + dy * bottom + 0.5);
+      }
+    }
+  }
+}
+
+} // namespace
+
+void DecodeImage(const std::string& filename,
+                 unsigned char* memory,
+                 const ImageInfo& info,
+                 const bool resize)
+{
+  if (!ImageFormatSupported(filename))
+  {
+    std::ostringstream oss;
+    oss << "Load(): file type " << Extension(filename) << " of '" << filename
+        << "' not supported.";
+    throw std::runtime_error(oss.str());
+  }
+
+  if (info.Channels() < 1 || info.Channels() > 4)
+  {
+    std::ostringstream oss;
+    oss << "Load(): images can only be loaded with 1 to 4 channels, not "
+        << info.Channels() << ".";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // stb_image converts the image to the requested number of channels.
+  int tempWidth, tempHeight, tempChannels;
+  unsigned char* image = stbi_load(filename.c_str(), &tempWidth, &tempHeight,
+      &tempChannels, (int) info.Channels());
+
+  if (!image)
+  {
+    std::ostringstream oss;
+    oss << "Load(): failed to load image '" << filename << "': "
+        << stbi_failure_reason();
+    throw std::runtime_error(oss.str());
+  }
+
+  const size_t width = tempWidth;
+  const size_t height = tempHeight;
+  if (width == info.Width() && height == info.Height())
+  {
+    std::memcpy(memory, image, width * height * info.Channels());
+  }
+  else if (resize)
+  {
+    ResizeImage(image, width, height, info.Channels(), memory, info.Width(),
+        info.Height());
+  }
+  else
+  {
+    free(image);
+    std::ostringstream oss;
+    oss << "Load(): image '" << filename << "' is " << width << "x" << height
+        << ", but " << info.Width() << "x" << info.Height() << " was expected.";
+    throw std::runtime_error(oss.str());
+  }
+
+  free(image);
+}
+
 } // namespace data
 } // namespace mlpack
 
@@ -123,6 +228,15 @@ bool LoadImage(const std::string& /* filename */,
   return false;
 }
 
+void DecodeImage(const std::string& /* filename */,
+                 unsigned char* /* memory */,
+                 const ImageInfo& /* info */,
+                 const bool /* resize */)
+{
+  throw std::runtime_error("Load(): mlpack was not compiled with STB support, "
+      "so images cannot be loaded!");
+}
+
 } // namespace data
 } // namespace mlpack
 
@@ -1,96 +1,176 @@
-/**
+/**
  * @file core/data/load_image_impl.hpp
- * @author Mehul Kumar Nirala
- *
- * An image loading utility implementation.
- *
- * mlpack is free software; you may redistribute it and/or modify it under the
- * terms of the 3-clause BSD license.  You should have received a copy of the
- * 3-clause BSD license along with mlpack.  If not, see
- * http://www.opensource.org/licenses/BSD-3-Clause for more information.
- */
-
-#ifndef MLPACK_CORE_DATA_LOAD_IMAGE_IMPL_HPP
-#define MLPACK_CORE_DATA_LOAD_IMAGE_IMPL_HPP
-
-// In case it hasn't been included yet.
-#include "load.hpp"
-
-namespace mlpack {
-namespace data {
-
-// Image loading API.
-template<typename eT>
-bool Load(const std::string& filename,
-          arma::Mat<eT>& matrix,
-          ImageInfo& info,
-          const bool fatal)
-{
-  Timer::Start("loading_image");
-
-  // STB loads into unsigned char matrices, so we may have to convert once
-  // loaded.
-  arma::Mat<unsigned char> tempMatrix;
-  const bool result = LoadImage(filename, tempMatrix, info, fatal);
-
-  // If fatal is true, then the program will have already thrown an exception.
-  if (!result)
-  {
-    Timer::Stop("loading_image");
-    return false;
-  }
-
-  matrix = arma::conv_to<arma::Mat<eT>>::from(tempMatrix);
-  Timer::Stop("loading_image");
-  return true;
-}
-
-// Image loading API for multiple files.
-template<typename eT>
-bool Load(const std::vector<std::string>& files,
-          arma::Mat<eT>& matrix,
-          ImageInfo& info,
-          const bool fatal)
-{
-  if (files.size() == 0)
-  {
-    std::ostringstream oss;
-    oss << "Load(): vector of image files is empty." << std::endl;
-
-    if (fatal)
-      Log::Fatal << oss.str();
-    else
-      Log::Warn << oss.str();
-
-    return false;
-  }
-
-  arma::Mat<unsigned char> img;
-  bool status = LoadImage(files[0], img, info, fatal);
-
-  if (!status)
-    return false;
-
-  // Decide matrix dimension using the image height and width.
-  arma::Mat<unsigned char> tmpMatrix(
-      info.Width() * info.Height() * info.Channels(), files.size());
-  tmpMatrix.col(0) = img;
-
-  for (size_t i = 1; i < files.size() ; ++i)
-  {
-    arma::Mat<unsigned char> colImg(tmpMatrix.colptr(i), tmpMatrix.n_rows, 1,
-        false, true);
-    status = LoadImage(files[i], colImg, info, fatal);
-
-    if (!status)
-      return false;
-  }
-
-  matrix = arma::conv_to<arma::Mat<eT>>::from(tmpMatrix);
-  return true;
-}
-
-} // namespace data
-} // namespace mlpack
-
-#endif
+ * @author Mehul Kumar Nirala
+ *
+ * An image loading utility implementation.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef MLPACK_CORE_DATA_LOAD_IMAGE_IMPL_HPP
+#define MLPACK_CORE_DATA_LOAD_IMAGE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "load.hpp"
+
+namespace mlpack {
+namespace data {
+
+// Image loading API.
+template<typename eT>
+bool Load(const std::string& filename,
+          arma::Mat<eT>& matrix,
+          ImageInfo& info,
+          const bool fatal)
+{
+  Timer::Start("loading_image");
+
+  // STB loads into unsigned char matrices, so we may have to convert once
+  // loaded.
+  arma::Mat<unsigned char> tempMatrix;
+  const bool result = LoadImage(filename, tempMatrix, info, fatal);
+
+  // If fatal is true, then the program will have already thrown an exception.
+  if (!result)
+  {
+    Timer::Stop("loading_image");
+    return false;
+  }
+
+  matrix = arma::conv_to<arma::Mat<eT>>::from(tempMatrix);
+  Timer::Stop("loading_image");
+  return true;
+}
+
+/**
+ * Decode the given images into consecutive columns of matrix, in parallel,
+ * starting at column firstColumn.  The matrix must already have the right
+ * size.  A std::runtime_error is thrown if any image cannot be loaded.
+ */
+template<typename eT>
+void DecodeImages(const std::vector<std::string>& files,
+                  const arma::uvec& indices,
+                  arma::Mat<eT>& matrix,
+                  const size_t firstColumn,
+                  const ImageInfo& info,
+                  const bool resize)
+{
+  // Exceptions can't leave the parallel region, so the error for each image
+  // is kept.
+  std::vector<std::string> errors(indices.n_elem);
+
+  #pragma omp parallel
+  {
+    // Images are decoded straight into the output when it holds bytes, and
+    // through a buffer otherwise.
+    std::vector<unsigned char> buffer;
+    if (!std::is_same<eT, unsigned char>::value)
+      buffer.resize(matrix.n_rows);
+
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) indices.n_elem; ++i)
+    {
+      eT* column = matrix.colptr(firstColumn + i);
+      try
+      {
+        if (std::is_same<eT, unsigned char>::value)
+        {
+          DecodeImage(files[indices[i]], (unsigned char*) column, info,
+              resize);
+        }
+        else
+        {
+          DecodeImage(files[indices[i]], buffer.data(), info, resize);
+          std::copy(buffer.begin(), buffer.end(), column);
+        }
+      }
+      catch (std::exception& e)
+      {
+        errors[i] = e.what();
+      }
+    }
+  }
+
+  for (size_t i = 0; i < errors.size(); ++i)
+  {
+    if (!errors[i].empty())
+      throw std::runtime_error(errors[i]);
+  }
+}
+
+// Image loading API for multiple files.
+template<typename eT>
+bool Load(const std::vector<std::string>& files,
+          arma::Mat<eT>& matrix,
+          ImageInfo& info,
+          const bool fatal,
+          const bool resize)
+{
+  if (files.size() == 0)
+  {
+    std::ostringstream oss;
+    oss << "Load(): vector of image files is empty." << std::endl;
+
+    if (fatal)
+      Log::Fatal << oss.str();
+    else
+      Log::Warn << oss.str();
+
+    return false;
+  }
+
+  // Unless every image is resized to a given size, the first image decides
+  // the size of the output.  LoadImage() gives it with the number of channels
+  // it asks for (1 or 3); if the file has that many channels, the image is
+  // used as it is instead of being decoded again.
+  arma::Mat<unsigned char> first;
+  if (!resize || info.Width() == 0 || info.Height() == 0)
+  {
+    const size_t requestedChannels = (info.Channels() == 1) ? 1 : 3;
+    if (!LoadImage(files[0], first, info, fatal))
+      return false;
+    if (info.Channels() != requestedChannels)
+      first.reset();
+  }
+
+  Timer::Start("loading_image");
+  matrix.set_size(info.Width() * info.Height() * info.Channels(),
+      files.size());
+
+  size_t decoded = 0;
+  if (first.n_elem == matrix.n_rows)
+  {
+    std::copy(first.begin(), first.end(), matrix.colptr(0));
+    decoded = 1;
+  }
+
+  try
+  {
+    if (decoded < files.size())
+    {
+      DecodeImages(files, arma::regspace<arma::uvec>(decoded,
+          files.size() - 1), matrix, decoded, info, resize);
+    }
+  }
+  catch (std::exception& e)
+  {
+    Timer::Stop("loading_image");
+    if (fatal)
+      Log::Fatal << e.what() << std::endl;
+    else
+      Log::Warn << e.what() << std::endl;
+
+    return false;
+  }
+
+  Timer::Stop("loading_image");
+  return true;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -380,6 +380,35 @@ bool Load(const std::string& filename,
       return false;
     }
   }
+  else if (extension == "mlc")
+  {
+    Log::Info << "Loading '" << filename << "' as native mlpack dataset.  "
+        << std::flush;
+    try
+    {
+      // The data is converted into the matrix, so the file can be unmapped
+      // afterwards.
+      MemoryMappedFile file(filename);
+      LoadColumnar(file.Data(), file.Size(), matrix, info, false);
+
+      // The matrix is stored with one point per column, so un-transpose if
+      // necessary...
+      if (!transpose)
+      {
+        return inplace_transpose(matrix, fatal);
+      }
+    }
+    catch (std::exception& e)
+    {
+      Timer::Stop("loading_data");
+      if (fatal)
+        Log::Fatal << e.what() << std::endl;
+      else
+        Log::Warn << e.what() << std::endl;
+
+      return false;
+    }
+  }
   else
   {
     // The type is unknown.
@@ -0,0 +1,60 @@
+/**
+ * @file core/data/load_libsvm.hpp
+ *
+ * Load a sparse dataset in the LibSVM (or SVMlight) format.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LOAD_LIBSVM_HPP
+#define MLPACK_CORE_DATA_LOAD_LIBSVM_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "memory_mapped_file.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A utility function to load a sparse dataset in the LibSVM (or SVMlight)
+ * format, where each line holds one point:
+ *
+ * @code
+ * <label> <index>:<value> <index>:<value> ... # optional comment
+ * @endcode
+ *
+ * Indices start at 1 and are stored in dimension (index - 1) of the matrix;
+ * the indices of a line do not need to be sorted, but may not repeat.  Empty
+ * lines and lines that only hold a comment are skipped, and SVMlight "qid:"
+ * entries are ignored.  The file is memory-mapped and split into chunks of
+ * lines that are parsed in parallel; the compressed sparse column form of the
+ * matrix is then assembled directly, so the data is never held in dense form.
+ * An exception will be thrown upon failure.
+ *
+ * Labels are converted to LabelType as they are read, and an exception is
+ * thrown if a label is out of the range of LabelType.  Labels such as -1 and
+ * +1 should therefore be loaded with a signed or floating-point LabelType;
+ * for classification, data::NormalizeLabels() can then map them to 0, 1, ...
+ *
+ * @param filename Name of LibSVM file to load.
+ * @param matrix Sparse matrix to load data into; each point is a column.
+ * @param labels Row to load the label of each point into.
+ * @param dimensionality Number of dimensions of the data.  If 0 (the default),
+ *     the largest index in the file is used; otherwise an exception is thrown
+ *     if any index is larger.
+ */
+template<typename eT, typename LabelType>
+void LoadLibSVM(const std::string& filename,
+                arma::SpMat<eT>& matrix,
+                arma::Row<LabelType>& labels,
+                const size_t dimensionality = 0);
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "load_libsvm_impl.hpp"
+
+#endif
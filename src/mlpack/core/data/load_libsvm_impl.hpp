@@ -0,0 +1,327 @@
+/**
+ * @file core/data/load_libsvm_impl.hpp
+ *
+ * Implementation of the LibSVM (and SVMlight) loader.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LOAD_LIBSVM_IMPL_HPP
+#define MLPACK_CORE_DATA_LOAD_LIBSVM_IMPL_HPP
+
+// In case it hasn't already been included.
+#include "load_libsvm.hpp"
+#include "extension.hpp"
+#include "parse_float.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Convert a label to an integer LabelType.  Returns false if the label is out
+ * of the range of LabelType, such as a negative label for an unsigned type.
+ */
+template<typename LabelType>
+inline typename std::enable_if<std::is_integral<LabelType>::value, bool>::type
+ConvertLibSVMLabel(const double label, LabelType& result)
+{
+  // The largest value of a 64-bit type is rounded up to 2^64 (or 2^63) as a
+  // double, so it is an exclusive bound.
+  if (!(label >= (double) std::numeric_limits<LabelType>::lowest() &&
+        label < (double) std::numeric_limits<LabelType>::max() + 1.0))
+    return false;
+
+  result = (LabelType) label;
+  return true;
+}
+
+//! Convert a label to a floating-point LabelType.
+template<typename LabelType>
+inline typename std::enable_if<!std::is_integral<LabelType>::value, bool>::type
+ConvertLibSVMLabel(const double label, LabelType& result)
+{
+  result = (LabelType) label;
+  return true;
+}
+
+/**
+ * Parse a positive integer index between begin and end.  Returns false if the
+ * whole range is not an index.
+ */
+inline bool ParseLibSVMIndex(const char* begin,
+                             const char* end,
+                             size_t& index)
+{
+  if (begin == end)
+    return false;
+
+  index = 0;
+  for (const char* c = begin; c != end; ++c)
+  {
+    if (*c < '0' || *c > '9' ||
+        index > (std::numeric_limits<size_t>::max() - 9) / 10)
+      return false;
+
+    index = 10 * index + (*c - '0');
+  }
+
+  return (index > 0);
+}
+
+//! Throw the error for a line of a LibSVM file.
+inline void LibSVMError(const size_t line, const std::string& message)
+{
+  std::ostringstream oss;
+  oss << "LoadLibSVM(): " << message << " on line " << line << ".";
+  throw std::runtime_error(oss.str());
+}
+
+/**
+ * Parse the lines between begin and end, appending the label, the number of
+ * nonzero values, and the (zero-based) row index and value of each nonzero of
+ * each point.  An exception is thrown if a line is not valid.
+ *
+ * @param firstLine Index of the first line, for error messages.
+ * @param maxIndex Set to the largest index (one-based) that was seen.
+ */
+template<typename eT, typename LabelType>
+void ParseLibSVMChunk(const char* begin,
+                      const char* end,
+                      const size_t firstLine,
+                      std::vector<LabelType>& labels,
+                      std::vector<arma::uword>& counts,
+                      std::vector<arma::uword>& rowIndices,
+                      std::vector<eT>& values,
+                      size_t& maxIndex)
+{
+  std::vector<std::pair<arma::uword, eT>> entries;
+  size_t line = firstLine;
+  while (begin < end)
+  {
+    const char* newline = (const char*) std::memchr(begin, '\n', end - begin);
+    const char* lineEnd = (newline == NULL) ? end : newline;
+    const char* next = (newline == NULL) ? end : newline + 1;
+    ++line;
+
+    // Everything after a '#' is a comment.
+    const char* comment = (const char*) std::memchr(begin, '#',
+        lineEnd - begin);
+    if (comment != NULL)
+      lineEnd = comment;
+
+    bool haveLabel = false;
+    entries.clear();
+    const char* c = begin;
+    while (true)
+    {
+      // Find the next token.
+      while (c < lineEnd && std::isspace((unsigned char) *c))
+        ++c;
+      if (c == lineEnd)
+        break;
+
+      const char* tokenEnd = c;
+      while (tokenEnd < lineEnd &&
+             !std::isspace((unsigned char) *tokenEnd))
+        ++tokenEnd;
+
+      if (!haveLabel)
+      {
+        double value;
+        LabelType label;
+        if (!ParseFloat(c, tokenEnd, value))
+          LibSVMError(line, "invalid label");
+        if (!ConvertLibSVMLabel(value, label))
+          LibSVMError(line, "label out of the range of the label type");
+
+        labels.push_back(label);
+        haveLabel = true;
+      }
+      else
+      {
+        const char* colon = (const char*) std::memchr(c, ':', tokenEnd - c);
+        if (colon == NULL)
+          LibSVMError(line, "entry without ':'");
+
+        // SVMlight query ids are not features.
+        if (colon - c == 3 && std::strncmp(c, "qid", 3) == 0)
+        {
+          c = tokenEnd;
+          continue;
+        }
+
+        size_t index;
+        double value;
+        if (!ParseLibSVMIndex(c, colon, index))
+          LibSVMError(line, "invalid index (indices start at 1)");
+        if (!ParseFloat(colon + 1, tokenEnd, value))
+          LibSVMError(line, "invalid value");
+
+        maxIndex = std::max(maxIndex, index);
+        entries.push_back(std::make_pair(index - 1, (eT) value));
+      }
+
+      c = tokenEnd;
+    }
+
+    begin = next;
+    if (!haveLabel)
+      continue;
+
+    // Indices are usually given in order already.
+    if (!std::is_sorted(entries.begin(), entries.end()))
+      std::sort(entries.begin(), entries.end());
+
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+      if (i > 0 && entries[i].first == entries[i - 1].first)
+        LibSVMError(line, "repeated index");
+
+      rowIndices.push_back(entries[i].first);
+      values.push_back(entries[i].second);
+    }
+
+    counts.push_back(entries.size());
+  }
+}
+
+template<typename eT, typename LabelType>
+void LoadLibSVM(const std::string& filename,
+                arma::SpMat<eT>& matrix,
+                arma::Row<LabelType>& labels,
+                const size_t dimensionality)
+{
+  MemoryMappedFile file(filename);
+  const char* data = file.Data();
+
+  std::vector<size_t> bounds, firstLine;
+  file.SplitLines(bounds, firstLine);
+  const size_t numChunks = bounds.size() - 1;
+
+  // Parse each chunk in parallel.  Exceptions can't leave the parallel region,
+  // so the error of each chunk is kept and the first one is thrown afterwards.
+  std::vector<std::vector<LabelType>> chunkLabels(numChunks);
+  std::vector<std::vector<arma::uword>> chunkCounts(numChunks);
+  std::vector<std::vector<arma::uword>> chunkRowIndices(numChunks);
+  std::vector<std::vector<eT>> chunkValues(numChunks);
+  std::vector<size_t> chunkMaxIndex(numChunks, 0);
+  std::vector<std::string> chunkErrors(numChunks);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+  {
+    try
+    {
+      ParseLibSVMChunk(data + bounds[c], data + bounds[c + 1], firstLine[c],
+          chunkLabels[c], chunkCounts[c], chunkRowIndices[c], chunkValues[c],
+          chunkMaxIndex[c]);
+    }
+    catch (std::exception& e)
+    {
+      chunkErrors[c] = e.what();
+    }
+  }
+
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    if (!chunkErrors[c].empty())
+      throw std::runtime_error(chunkErrors[c]);
+  }
+
+  // Find where the points and nonzeros of each chunk start.
+  std::vector<size_t> pointOffsets(numChunks + 1, 0);
+  std::vector<size_t> nonzeroOffsets(numChunks + 1, 0);
+  size_t maxIndex = 0;
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    pointOffsets[c + 1] = pointOffsets[c] + chunkLabels[c].size();
+    nonzeroOffsets[c + 1] = nonzeroOffsets[c] + chunkValues[c].size();
+    maxIndex = std::max(maxIndex, chunkMaxIndex[c]);
+  }
+
+  if (dimensionality != 0 && maxIndex > dimensionality)
+  {
+    std::ostringstream oss;
+    oss << "LoadLibSVM(): index " << maxIndex << " is larger than the given "
+        << "dimensionality (" << dimensionality << ").";
+    throw std::invalid_argument(oss.str());
+  }
+
+  const size_t numPoints = pointOffsets[numChunks];
+  const size_t numNonzeros = nonzeroOffsets[numChunks];
+
+  // Assemble the compressed sparse column arrays.
+  arma::uvec rowIndices(numNonzeros);
+  arma::uvec colPtrs(numPoints + 1);
+  arma::Col<eT> values(numNonzeros);
+  labels.set_size(numPoints);
+  colPtrs[0] = 0;
+
+  #pragma omp parallel for
+  for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+  {
+    std::copy(chunkRowIndices[c].begin(), chunkRowIndices[c].end(),
+        rowIndices.begin() + nonzeroOffsets[c]);
+    std::copy(chunkValues[c].begin(), chunkValues[c].end(),
+        values.begin() + nonzeroOffsets[c]);
+    std::copy(chunkLabels[c].begin(), chunkLabels[c].end(),
+        labels.begin() + pointOffsets[c]);
+
+    size_t position = nonzeroOffsets[c];
+    for (size_t i = 0; i < chunkCounts[c].size(); ++i)
+    {
+      position += chunkCounts[c][i];
+      colPtrs[pointOffsets[c] + i + 1] = position;
+    }
+  }
+
+  matrix = arma::SpMat<eT>(rowIndices, colPtrs, values,
+      (dimensionality == 0) ? maxIndex : dimensionality, numPoints);
+}
+
+template<typename eT, typename LabelType>
+bool Load(const std::string& filename,
+          arma::SpMat<eT>& matrix,
+          arma::Row<LabelType>& labels,
+          const bool fatal)
+{
+  Timer::Start("loading_data");
+
+  const std::string extension = Extension(filename);
+  try
+  {
+    if (extension != "svm" && extension != "libsvm")
+    {
+      std::ostringstream oss;
+      oss << "Unable to determine format to load from extension '"
+          << extension << "'; only LibSVM files (.svm, .libsvm) can be loaded "
+          << "with labels.  Load of '" << filename << "' failed.";
+      throw std::runtime_error(oss.str());
+    }
+
+    LoadLibSVM(filename, matrix, labels);
+  }
+  catch (std::exception& e)
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << e.what() << std::endl;
+    else
+      Log::Warn << e.what() << std::endl;
+
+    return false;
+  }
+
+  Log::Info << "Size is " << matrix.n_rows << " x " << matrix.n_cols
+      << ".\n";
+
+  Timer::Stop("loading_data");
+  return true;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -142,6 +142,9 @@ class IncrementPolicy
     }
   }
 
+  //! Get whether all inputs are mapped, even if they are numeric.
+  bool ForceAllMappings() const { return forceAllMappings; }
+
  private:
   // Whether or not we should map all tokens.
   bool forceAllMappings;
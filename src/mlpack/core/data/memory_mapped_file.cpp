@@ -0,0 +1,153 @@
+/**
+ * @file core/data/memory_mapped_file.cpp
+ *
+ * Implementation of MemoryMappedFile.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "memory_mapped_file.hpp"
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+MemoryMappedFile::MemoryMappedFile(const std::string& filename) :
+    data(NULL),
+    size(0)
+{
+#ifndef _WIN32
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    std::ostringstream oss;
+    oss << "Cannot open file '" << filename << "'. " << std::endl;
+    throw std::runtime_error(oss.str());
+  }
+
+  struct stat info;
+  if (fstat(fd, &info) != 0)
+  {
+    close(fd);
+    std::ostringstream oss;
+    oss << "Cannot determine the size of file '" << filename << "'. "
+        << std::endl;
+    throw std::runtime_error(oss.str());
+  }
+
+  size = (size_t) info.st_size;
+
+  // An empty file cannot be mapped, but there is nothing to read anyway.
+  if (size > 0)
+  {
+    void* mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd,
+        0);
+    if (mapping == MAP_FAILED)
+    {
+      close(fd);
+      std::ostringstream oss;
+      oss << "Cannot map file '" << filename << "' into memory. " << std::endl;
+      throw std::runtime_error(oss.str());
+    }
+
+    data = (char*) mapping;
+  }
+
+  // The mapping stays valid after the descriptor is closed.
+  close(fd);
+#else
+  std::ifstream stream(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!stream.is_open())
+  {
+    std::ostringstream oss;
+    oss << "Cannot open file '" << filename << "'. " << std::endl;
+    throw std::runtime_error(oss.str());
+  }
+
+  stream.seekg(0, std::ios::end);
+  size = (size_t) stream.tellg();
+  stream.seekg(0, std::ios::beg);
+
+  buffer.resize(size);
+  if (size > 0 && !stream.read(buffer.data(), size))
+  {
+    std::ostringstream oss;
+    oss << "Cannot read file '" << filename << "'. " << std::endl;
+    throw std::runtime_error(oss.str());
+  }
+
+  data = buffer.data();
+#endif
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+#ifndef _WIN32
+  if (data != NULL)
+    munmap(data, size);
+#endif
+}
+
+size_t MemoryMappedFile::SplitLines(std::vector<size_t>& bounds,
+                                    std::vector<size_t>& firstLine) const
+{
+  // Use a few chunks per thread so that the work is balanced, but don't split
+  // small files at all.
+  size_t numChunks = 1;
+  #ifdef HAS_OPENMP
+    numChunks = 4 * omp_get_max_threads();
+  #endif
+  numChunks = std::max((size_t) 1, std::min(numChunks, size / 65536));
+
+  bounds.resize(numChunks + 1);
+  bounds[0] = 0;
+  bounds[numChunks] = size;
+  for (size_t c = 1; c < numChunks; ++c)
+  {
+    // Move the boundary forward to the start of the next line.
+    size_t pos = std::max(c * (size / numChunks), bounds[c - 1]);
+    if (pos > 0 && data[pos - 1] != '\n')
+    {
+      const char* newline = (const char*) std::memchr(data + pos, '\n',
+          size - pos);
+      pos = (newline == NULL) ? size : (newline - data + 1);
+    }
+
+    bounds[c] = pos;
+  }
+
+  // Count the lines in each chunk.  A final line without a newline still
+  // counts, as it does for std::getline().
+  std::vector<size_t> lines(numChunks);
+  #pragma omp parallel for
+  for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+  {
+    const char* begin = data + bounds[c];
+    const char* end = data + bounds[c + 1];
+    lines[c] = std::count(begin, end, '\n');
+    if (end > begin && *(end - 1) != '\n')
+      ++lines[c];
+  }
+
+  firstLine.resize(numChunks + 1);
+  firstLine[0] = 0;
+  for (size_t c = 0; c < numChunks; ++c)
+    firstLine[c + 1] = firstLine[c] + lines[c];
+
+  return firstLine[numChunks];
+}
+
+} // namespace data
+} // namespace mlpack
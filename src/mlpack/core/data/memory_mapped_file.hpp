@@ -0,0 +1,87 @@
+/**
+ * @file core/data/memory_mapped_file.hpp
+ *
+ * A view of the contents of a file.  On POSIX systems the file is
+ * memory-mapped, so that large datasets can be used without first being copied
+ * into a buffer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MEMORY_MAPPED_FILE_HPP
+#define MLPACK_CORE_DATA_MEMORY_MAPPED_FILE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Give access to the full contents of a file.  On POSIX systems the file is
+ * mapped into memory with mmap(), and pages are read in lazily by the operating
+ * system as they are accessed; this means that several threads can parse
+ * different parts of the file at the same time, and that a matrix stored in
+ * the file can be used in place.  On Windows, the file is read into a buffer
+ * instead.
+ *
+ * The mapping is private: the contents may be modified, but the changes are
+ * never written back to the file.  The contents are not null-terminated.  The
+ * object cannot be copied.
+ */
+class MemoryMappedFile
+{
+ public:
+  /**
+   * Open and map the given file.  A std::runtime_error is thrown if the file
+   * cannot be opened or mapped.
+   *
+   * @param filename Name of the file to map.
+   */
+  MemoryMappedFile(const std::string& filename);
+
+  //! Unmap the file.
+  ~MemoryMappedFile();
+
+  // Copying a mapping is not allowed.
+  MemoryMappedFile(const MemoryMappedFile&) = delete;
+  MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+  //! Get a pointer to the contents of the file.
+  const char* Data() const { return data; }
+  //! Modify the contents of the file (the file itself is not changed).
+  char* Data() { return data; }
+  //! Get the size of the file in bytes.
+  size_t Size() const { return size; }
+
+  /**
+   * Split the file into chunks of whole lines, so that they can be parsed in
+   * parallel.  There are a few chunks per thread, but small files are not
+   * split.
+   *
+   * @param bounds Filled with the offset of the start of each chunk, followed
+   *     by the size of the file.
+   * @param firstLine Filled with the index of the first line of each chunk,
+   *     followed by the total number of lines.
+   * @return Number of lines in the file.
+   */
+  size_t SplitLines(std::vector<size_t>& bounds,
+                    std::vector<size_t>& firstLine) const;
+
+ private:
+  //! Pointer to the contents of the file.
+  char* data;
+  //! Size of the file in bytes.
+  size_t size;
+
+#ifdef _WIN32
+  //! Holds the contents of the file, since it is not mapped on Windows.
+  std::vector<char> buffer;
+#endif
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,174 @@
+/**
+ * @file core/data/minibatch_function.hpp
+ *
+ * Definition of MinibatchFunction, which lets ensmallen optimizers train on
+ * the batches of a minibatch source.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MINIBATCH_FUNCTION_HPP
+#define MLPACK_CORE_DATA_MINIBATCH_FUNCTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <functional>
+#include "minibatch_source.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * MinibatchFunction is a separable differentiable function (in the sense of
+ * ensmallen) whose data comes from a minibatch source (see
+ * minibatch_source.hpp) instead of a matrix held in memory.  Shuffle() only
+ * shuffles the order of the source, and each call to Evaluate(), Gradient()
+ * or EvaluateWithGradient() for a batch loads just the points of that batch.
+ * Any optimizer can be used without changes; the objective and gradient over
+ * all points (as used by L-BFGS, for instance) are summed over batches.
+ *
+ * For each batch, the objective of the model is built on the batch by the
+ * given builder, and evaluated on all of its points.  The builder is given
+ * the total number of points, so that it can scale any regularization: the
+ * objective of a batch of b points must be b / n of the regularization plus
+ * the loss of its points, as for the separable functions of mlpack.  For
+ * instance, for logistic regression with L2-regularization lambda:
+ *
+ * @code
+ * typedef LogisticRegressionFunction<> FunctionType;
+ * data::MinibatchFunction<SourceType, FunctionType> f(source,
+ *     [lambda](const arma::mat& predictors,
+ *              const arma::Row<size_t>& responses,
+ *              const size_t numPoints)
+ *     {
+ *       return FunctionType(predictors, responses,
+ *           lambda * predictors.n_cols / numPoints);
+ *     });
+ * @endcode
+ *
+ * @tparam SourceType Type of the minibatch source.
+ * @tparam FunctionType Type of the objective function of a batch.
+ */
+template<typename SourceType, typename FunctionType>
+class MinibatchFunction
+{
+ public:
+  //! The type of the predictors of a batch.
+  typedef typename SourceType::PredictorsType PredictorsType;
+  //! The type of the responses of a batch.
+  typedef typename SourceType::ResponsesType ResponsesType;
+  //! The type of the callable that builds the objective of a batch.
+  typedef std::function<FunctionType(const PredictorsType&,
+                                     const ResponsesType&,
+                                     const size_t)> BuilderType;
+
+  /**
+   * Create the function.  The source must outlive the function.
+   *
+   * @param source Source of the batches.
+   * @param builder Callable that builds the objective of a batch from its
+   *     predictors, its responses, and the total number of points.
+   * @param passBatchSize Number of points loaded at once when the objective
+   *     or gradient over all points is computed.
+   */
+  MinibatchFunction(SourceType& source,
+                    BuilderType builder,
+                    const size_t passBatchSize = 4096);
+
+  //! Shuffle the order in which the source visits the points.
+  void Shuffle();
+
+  //! Return the number of separable functions (the number of points).
+  size_t NumFunctions() const { return source.NumPoints(); }
+
+  /**
+   * Evaluate the objective over all points.
+   *
+   * @param parameters Parameters of the model.
+   */
+  double Evaluate(const arma::mat& parameters);
+
+  /**
+   * Evaluate the objective over the given batch of points.
+   *
+   * @param parameters Parameters of the model.
+   * @param begin Position of the first point of the batch.
+   * @param batchSize Number of points in the batch.
+   */
+  double Evaluate(const arma::mat& parameters,
+                  const size_t begin,
+                  const size_t batchSize);
+
+  /**
+   * Compute the gradient of the objective over all points.
+   *
+   * @param parameters Parameters of the model.
+   * @param gradient Matrix to store the gradient in.
+   */
+  void Gradient(const arma::mat& parameters, arma::mat& gradient);
+
+  /**
+   * Compute the gradient of the objective over the given batch of points.
+   *
+   * @param parameters Parameters of the model.
+   * @param begin Position of the first point of the batch.
+   * @param gradient Matrix to store the gradient in.
+   * @param batchSize Number of points in the batch.
+   */
+  void Gradient(const arma::mat& parameters,
+                const size_t begin,
+                arma::mat& gradient,
+                const size_t batchSize);
+
+  /**
+   * Evaluate the objective and compute its gradient over all points.
+   *
+   * @param parameters Parameters of the model.
+   * @param gradient Matrix to store the gradient in.
+   */
+  double EvaluateWithGradient(const arma::mat& parameters,
+                              arma::mat& gradient);
+
+  /**
+   * Evaluate the objective and compute its gradient over the given batch of
+   * points.
+   *
+   * @param parameters Parameters of the model.
+   * @param begin Position of the first point of the batch.
+   * @param gradient Matrix to store the gradient in.
+   * @param batchSize Number of points in the batch.
+   */
+  double EvaluateWithGradient(const arma::mat& parameters,
+                              const size_t begin,
+                              arma::mat& gradient,
+                              const size_t batchSize);
+
+ private:
+  //! Load the given batch, unless it is the one that was loaded last.
+  void LoadBatch(const size_t begin, const size_t batchSize);
+
+  //! The source of the batches.
+  SourceType& source;
+  //! Builds the objective of a batch.
+  BuilderType builder;
+  //! The number of points loaded at once for a pass over all points.
+  size_t passBatchSize;
+
+  //! Whether the last batch is still valid (the order has not changed).
+  bool haveBatch;
+  //! The position of the first point of the last batch.
+  size_t batchBegin;
+  //! The points of the last batch.
+  PredictorsType batchPredictors;
+  //! The responses of the last batch.
+  ResponsesType batchResponses;
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "minibatch_function_impl.hpp"
+
+#endif
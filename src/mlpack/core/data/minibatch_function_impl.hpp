@@ -0,0 +1,145 @@
+/**
+ * @file core/data/minibatch_function_impl.hpp
+ *
+ * Implementation of MinibatchFunction.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MINIBATCH_FUNCTION_IMPL_HPP
+#define MLPACK_CORE_DATA_MINIBATCH_FUNCTION_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "minibatch_function.hpp"
+
+namespace mlpack {
+namespace data {
+
+template<typename SourceType, typename FunctionType>
+MinibatchFunction<SourceType, FunctionType>::MinibatchFunction(
+    SourceType& source,
+    BuilderType builder,
+    const size_t passBatchSize) :
+    source(source),
+    builder(std::move(builder)),
+    passBatchSize(std::max(passBatchSize, (size_t) 1)),
+    haveBatch(false),
+    batchBegin(0)
+{
+  // Nothing to do.
+}
+
+template<typename SourceType, typename FunctionType>
+void MinibatchFunction<SourceType, FunctionType>::Shuffle()
+{
+  source.Shuffle();
+  haveBatch = false;
+}
+
+template<typename SourceType, typename FunctionType>
+double MinibatchFunction<SourceType, FunctionType>::Evaluate(
+    const arma::mat& parameters)
+{
+  double objective = 0.0;
+  for (size_t begin = 0; begin < NumFunctions(); begin += passBatchSize)
+  {
+    objective += Evaluate(parameters, begin,
+        std::min(passBatchSize, NumFunctions() - begin));
+  }
+
+  return objective;
+}
+
+template<typename SourceType, typename FunctionType>
+double MinibatchFunction<SourceType, FunctionType>::Evaluate(
+    const arma::mat& parameters,
+    const size_t begin,
+    const size_t batchSize)
+{
+  LoadBatch(begin, batchSize);
+  const FunctionType function = builder(batchPredictors, batchResponses,
+      NumFunctions());
+  return function.Evaluate(parameters, 0, batchSize);
+}
+
+template<typename SourceType, typename FunctionType>
+void MinibatchFunction<SourceType, FunctionType>::Gradient(
+    const arma::mat& parameters,
+    arma::mat& gradient)
+{
+  gradient.zeros(parameters.n_rows, parameters.n_cols);
+  arma::mat batchGradient;
+  for (size_t begin = 0; begin < NumFunctions(); begin += passBatchSize)
+  {
+    Gradient(parameters, begin, batchGradient,
+        std::min(passBatchSize, NumFunctions() - begin));
+    gradient += batchGradient;
+  }
+}
+
+template<typename SourceType, typename FunctionType>
+void MinibatchFunction<SourceType, FunctionType>::Gradient(
+    const arma::mat& parameters,
+    const size_t begin,
+    arma::mat& gradient,
+    const size_t batchSize)
+{
+  LoadBatch(begin, batchSize);
+  const FunctionType function = builder(batchPredictors, batchResponses,
+      NumFunctions());
+  function.Gradient(parameters, 0, gradient, batchSize);
+}
+
+template<typename SourceType, typename FunctionType>
+double MinibatchFunction<SourceType, FunctionType>::EvaluateWithGradient(
+    const arma::mat& parameters,
+    arma::mat& gradient)
+{
+  double objective = 0.0;
+  gradient.zeros(parameters.n_rows, parameters.n_cols);
+  arma::mat batchGradient;
+  for (size_t begin = 0; begin < NumFunctions(); begin += passBatchSize)
+  {
+    objective += EvaluateWithGradient(parameters, begin, batchGradient,
+        std::min(passBatchSize, NumFunctions() - begin));
+    gradient += batchGradient;
+  }
+
+  return objective;
+}
+
+template<typename SourceType, typename FunctionType>
+double MinibatchFunction<SourceType, FunctionType>::EvaluateWithGradient(
+    const arma::mat& parameters,
+    const size_t begin,
+    arma::mat& gradient,
+    const size_t batchSize)
+{
+  LoadBatch(begin, batchSize);
+  const FunctionType function = builder(batchPredictors, batchResponses,
+      NumFunctions());
+  return function.EvaluateWithGradient(parameters, 0, gradient, batchSize);
+}
+
+template<typename SourceType, typename FunctionType>
+void MinibatchFunction<SourceType, FunctionType>::LoadBatch(
+    const size_t begin,
+    const size_t batchSize)
+{
+  // Some optimizers evaluate the objective and the gradient of the same batch
+  // separately, so the last batch is kept.
+  if (haveBatch && begin == batchBegin && batchPredictors.n_cols == batchSize)
+    return;
+
+  haveBatch = false;
+  source.Batch(begin, batchSize, batchPredictors, batchResponses);
+  batchBegin = begin;
+  haveBatch = true;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,318 @@
+/**
+ * @file core/data/minibatch_source.hpp
+ *
+ * Sources of minibatches of a dataset, for training on data that is not held
+ * in memory as one matrix.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MINIBATCH_SOURCE_HPP
+#define MLPACK_CORE_DATA_MINIBATCH_SOURCE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <future>
+#include "memory_mapped_file.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A minibatch source gives the points of a dataset (and their responses) in
+ * batches.  Every source has the same interface:
+ *
+ * @code
+ * // The types of the batches.
+ * typedef ... PredictorsType;
+ * typedef ... ResponsesType;
+ *
+ * // The number of points and their dimensionality.
+ * size_t NumPoints() const;
+ * size_t Dimensionality() const;
+ *
+ * // Visit the points in a new random order.
+ * void Shuffle();
+ *
+ * // Get the points at positions [begin, begin + batchSize) of the order.
+ * void Batch(const size_t begin,
+ *            const size_t batchSize,
+ *            PredictorsType& batchPredictors,
+ *            ResponsesType& batchResponses);
+ * @endcode
+ *
+ * Shuffling only permutes the order in which points are visited; the data
+ * itself is never moved.  The responses are always held in memory, since they
+ * are usually much smaller than the predictors.
+ *
+ * MatrixSource holds the predictors in a matrix, which may be a memory-mapped
+ * file in mlpack's native format; CSVSource parses the points of a CSV file
+ * when they are needed; and PrefetchSource wraps another source, and loads the
+ * next batch on a background thread while the current one is used.
+ * data::MinibatchFunction uses a source to train a model.
+ */
+
+/**
+ * A source of minibatches from a matrix.  The matrix is not copied; it can be
+ * an in-memory matrix, or a file in mlpack's native format (see data::Save())
+ * that is memory-mapped, so that the operating system only reads the pages
+ * that are used and the dataset may be larger than the memory.
+ *
+ * @tparam MatType Type of the predictors.
+ * @tparam ResponsesMatType Type of the responses (each column is the response
+ *     of one point).
+ */
+template<typename MatType = arma::mat,
+         typename ResponsesMatType = arma::Row<size_t>>
+class MatrixSource
+{
+ public:
+  //! The type of the predictors of a batch.
+  typedef MatType PredictorsType;
+  //! The type of the responses of a batch.
+  typedef ResponsesMatType ResponsesType;
+
+  /**
+   * Create the source from the given data, which must outlive the source.
+   *
+   * @param predictors The points, one per column.
+   * @param responses The response of each point.
+   */
+  MatrixSource(const MatType& predictors, const ResponsesMatType& responses);
+
+  /**
+   * Create the source from a file in mlpack's native format, which is
+   * memory-mapped.  If the file was saved without compression, the points
+   * are read from the mapping as they are needed; otherwise they are
+   * converted into memory.  A std::runtime_error is thrown if the file cannot
+   * be loaded.
+   *
+   * @param filename Name of the file (.mlc).
+   * @param responses The response of each point.
+   */
+  MatrixSource(const std::string& filename,
+               const ResponsesMatType& responses);
+
+  //! Get the number of points.
+  size_t NumPoints() const { return predictors.n_cols; }
+  //! Get the dimensionality of the points.
+  size_t Dimensionality() const { return predictors.n_rows; }
+
+  //! Visit the points in a new random order.
+  void Shuffle();
+
+  /**
+   * Get the points at the given positions of the current order.
+   *
+   * @param begin Position of the first point of the batch.
+   * @param batchSize Number of points in the batch.
+   * @param batchPredictors Matrix to store the points in.
+   * @param batchResponses Matrix to store their responses in.
+   */
+  void Batch(const size_t begin,
+             const size_t batchSize,
+             MatType& batchPredictors,
+             ResponsesMatType& batchResponses) const;
+
+ private:
+  //! The mapped file, if the points are read from one.
+  std::unique_ptr<MemoryMappedFile> file;
+  //! The points.  This is an alias of the given matrix or the file.
+  MatType predictors;
+  //! The responses.  This is an alias of the given responses.
+  ResponsesMatType responses;
+  //! The order in which the points are visited.
+  arma::uvec order;
+};
+
+/**
+ * A source of minibatches from a numeric CSV (or space- or tab-separated)
+ * file with one point per line and no header.  The file is memory-mapped and
+ * the start of each line is found once, in parallel; after that, only the
+ * lines of each batch are parsed, also in parallel.  Points are never held in
+ * memory other than in the batches, so the file may be larger than the
+ * memory.  A std::runtime_error is thrown by Batch() if a line cannot be
+ * parsed.
+ *
+ * @tparam eT Type of the elements of the points.
+ * @tparam ResponsesMatType Type of the responses (each column is the response
+ *     of one point).
+ */
+template<typename eT = double,
+         typename ResponsesMatType = arma::Row<size_t>>
+class CSVSource
+{
+ public:
+  //! The type of the predictors of a batch.
+  typedef arma::Mat<eT> PredictorsType;
+  //! The type of the responses of a batch.
+  typedef ResponsesMatType ResponsesType;
+
+  /**
+   * Map the given file and find its lines.  Empty lines are skipped, and the
+   * dimensionality is the number of fields on the first line.  A
+   * std::runtime_error is thrown if the file cannot be opened, and a
+   * std::invalid_argument if the number of responses does not match the
+   * number of points.
+   *
+   * @param filename Name of the file.
+   * @param responses The response of each point; they are copied.
+   */
+  CSVSource(const std::string& filename, const ResponsesMatType& responses);
+
+  //! Get the number of points.
+  size_t NumPoints() const { return lineStarts.size(); }
+  //! Get the dimensionality of the points.
+  size_t Dimensionality() const { return dimensionality; }
+
+  //! Visit the points in a new random order.
+  void Shuffle();
+
+  /**
+   * Parse the points at the given positions of the current order.
+   *
+   * @param begin Position of the first point of the batch.
+   * @param batchSize Number of points in the batch.
+   * @param batchPredictors Matrix to store the points in.
+   * @param batchResponses Matrix to store their responses in.
+   */
+  void Batch(const size_t begin,
+             const size_t batchSize,
+             arma::Mat<eT>& batchPredictors,
+             ResponsesMatType& batchResponses) const;
+
+ private:
+  /**
+   * Find the next field of a line.  Returns false if there are no more
+   * fields; otherwise the field is [fieldBegin, fieldEnd), and position is
+   * moved past the separator after it.
+   */
+  static bool NextField(const char*& position,
+                        const char* end,
+                        const char*& fieldBegin,
+                        const char*& fieldEnd);
+
+  //! Parse the line between begin and end into the given column.
+  void ParseLine(const char* begin, const char* end, eT* column) const;
+
+  //! The mapped file.
+  MemoryMappedFile file;
+  //! The offset of the start of each line that holds a point.
+  std::vector<size_t> lineStarts;
+  //! The offset of the end of each line that holds a point.
+  std::vector<size_t> lineEnds;
+  //! The number of fields on each line.
+  size_t dimensionality;
+  //! The responses.
+  ResponsesMatType responses;
+  //! The order in which the points are visited.
+  arma::uvec order;
+};
+
+/**
+ * Wrap a minibatch source so that, every time a batch is taken, the batch
+ * that follows it is loaded on a background thread.  Optimizers such as SGD
+ * take the batches of an epoch in order, so the time to load a batch is
+ * hidden behind the time to use the previous one.  The wrapped source must
+ * outlive the PrefetchSource.
+ *
+ * @tparam SourceType Type of the wrapped source.
+ */
+template<typename SourceType>
+class PrefetchSource
+{
+ public:
+  //! The type of the predictors of a batch.
+  typedef typename SourceType::PredictorsType PredictorsType;
+  //! The type of the responses of a batch.
+  typedef typename SourceType::ResponsesType ResponsesType;
+
+  /**
+   * Wrap the given source.
+   *
+   * @param source Source to load the batches from.
+   */
+  PrefetchSource(SourceType& source);
+
+  //! Wait for the batch that is being loaded.
+  ~PrefetchSource();
+
+  // The background task refers to the object, so it can't be copied.
+  PrefetchSource(const PrefetchSource&) = delete;
+  PrefetchSource& operator=(const PrefetchSource&) = delete;
+
+  //! Get the number of points.
+  size_t NumPoints() const { return source.NumPoints(); }
+  //! Get the dimensionality of the points.
+  size_t Dimensionality() const { return source.Dimensionality(); }
+
+  //! Visit the points in a new random order.
+  void Shuffle();
+
+  /**
+   * Get the points at the given positions of the current order, and start
+   * loading the batch of the same size that follows.
+   *
+   * @param begin Position of the first point of the batch.
+   * @param batchSize Number of points in the batch.
+   * @param batchPredictors Matrix to store the points in.
+   * @param batchResponses Matrix to store their responses in.
+   */
+  void Batch(const size_t begin,
+             const size_t batchSize,
+             PredictorsType& batchPredictors,
+             ResponsesType& batchResponses);
+
+ private:
+  //! Wait for the batch that is being loaded, and forget it.
+  void Discard();
+
+  //! The wrapped source.
+  SourceType& source;
+  //! The batch that is being loaded.
+  std::future<void> pending;
+  //! The position of the first point of the batch that is being loaded.
+  size_t nextBegin;
+  //! The size of the batch that is being loaded.
+  size_t nextBatchSize;
+  //! The points of the batch that is being loaded.
+  PredictorsType nextPredictors;
+  //! The responses of the batch that is being loaded.
+  ResponsesType nextResponses;
+};
+
+/**
+ * Indicates whether the given type is a minibatch source.
+ */
+template<typename T>
+struct IsMinibatchSource
+{
+  static const bool value = false;
+};
+
+template<typename MatType, typename ResponsesMatType>
+struct IsMinibatchSource<MatrixSource<MatType, ResponsesMatType>>
+{
+  static const bool value = true;
+};
+
+template<typename eT, typename ResponsesMatType>
+struct IsMinibatchSource<CSVSource<eT, ResponsesMatType>>
+{
+  static const bool value = true;
+};
+
+template<typename SourceType>
+struct IsMinibatchSource<PrefetchSource<SourceType>>
+{
+  static const bool value = true;
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "minibatch_source_impl.hpp"
+
+#endif
@@ -0,0 +1,368 @@
+/**
+ * @file core/data/minibatch_source_impl.hpp
+ *
+ * Implementation of the minibatch sources.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MINIBATCH_SOURCE_IMPL_HPP
+#define MLPACK_CORE_DATA_MINIBATCH_SOURCE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "minibatch_source.hpp"
+
+#include <mlpack/core/math/make_alias.hpp>
+#include "load.hpp"
+
+namespace mlpack {
+namespace data {
+
+//! Throw an error if a batch is not within the points of a source.
+inline void CheckBatch(const size_t begin,
+                       const size_t batchSize,
+                       const size_t numPoints)
+{
+  if (begin + batchSize > numPoints)
+  {
+    std::ostringstream oss;
+    oss << "Batch(): batch of " << batchSize << " points starting at " << begin
+        << " is out of range (there are " << numPoints << " points).";
+    throw std::invalid_argument(oss.str());
+  }
+}
+
+template<typename MatType, typename ResponsesMatType>
+MatrixSource<MatType, ResponsesMatType>::MatrixSource(
+    const MatType& predictors,
+    const ResponsesMatType& responses) :
+    // We promise to be well-behaved... the elements won't be modified.
+    predictors(math::MakeAlias(const_cast<MatType&>(predictors), false)),
+    responses(math::MakeAlias(const_cast<ResponsesMatType&>(responses),
+        false)),
+    order(arma::linspace<arma::uvec>(0, predictors.n_cols - 1,
+        predictors.n_cols))
+{
+  if (responses.n_cols != predictors.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "MatrixSource::MatrixSource(): predictors matrix has "
+        << predictors.n_cols << " points, but responses have "
+        << responses.n_cols << " columns.";
+    throw std::invalid_argument(oss.str());
+  }
+}
+
+template<typename MatType, typename ResponsesMatType>
+MatrixSource<MatType, ResponsesMatType>::MatrixSource(
+    const std::string& filename,
+    const ResponsesMatType& responses) :
+    file(new MemoryMappedFile(filename)),
+    // We promise to be well-behaved... the elements won't be modified.
+    responses(math::MakeAlias(const_cast<ResponsesMatType&>(responses),
+        false))
+{
+  // The points are an alias of the mapping when possible.
+  DatasetInfo info;
+  Load(*file, predictors, info, true);
+
+  if (responses.n_cols != predictors.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "MatrixSource::MatrixSource(): '" << filename << "' has "
+        << predictors.n_cols << " points, but responses have "
+        << responses.n_cols << " columns.";
+    throw std::invalid_argument(oss.str());
+  }
+
+  order = arma::linspace<arma::uvec>(0, predictors.n_cols - 1,
+      predictors.n_cols);
+}
+
+template<typename MatType, typename ResponsesMatType>
+void MatrixSource<MatType, ResponsesMatType>::Shuffle()
+{
+  order = arma::shuffle(order);
+}
+
+template<typename MatType, typename ResponsesMatType>
+void MatrixSource<MatType, ResponsesMatType>::Batch(
+    const size_t begin,
+    const size_t batchSize,
+    MatType& batchPredictors,
+    ResponsesMatType& batchResponses) const
+{
+  CheckBatch(begin, batchSize, predictors.n_cols);
+  if (batchSize == 0)
+  {
+    batchPredictors.set_size(predictors.n_rows, 0);
+    batchResponses.set_size(responses.n_rows, 0);
+    return;
+  }
+
+  const arma::uvec indices = order.subvec(begin, begin + batchSize - 1);
+  batchPredictors = predictors.cols(indices);
+  batchResponses = responses.cols(indices);
+}
+
+template<typename eT, typename ResponsesMatType>
+CSVSource<eT, ResponsesMatType>::CSVSource(
+    const std::string& filename,
+    const ResponsesMatType& responses) :
+    file(filename),
+    dimensionality(0),
+    responses(responses)
+{
+  const char* data = file.Data();
+  std::vector<size_t> bounds, firstLine;
+  file.SplitLines(bounds, firstLine);
+  const size_t numChunks = bounds.size() - 1;
+
+  // Find the lines that hold points in each chunk in parallel.  Whitespace
+  // (including the '\r' of Windows line endings) is trimmed.
+  std::vector<std::vector<size_t>> chunkStarts(numChunks);
+  std::vector<std::vector<size_t>> chunkEnds(numChunks);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+  {
+    const char* begin = data + bounds[c];
+    const char* end = data + bounds[c + 1];
+    while (begin < end)
+    {
+      const char* newline = (const char*) std::memchr(begin, '\n',
+          end - begin);
+      const char* lineEnd = (newline == NULL) ? end : newline;
+      const char* next = (newline == NULL) ? end : newline + 1;
+
+      while (begin < lineEnd && std::isspace((unsigned char) *begin))
+        ++begin;
+      while (lineEnd > begin && std::isspace((unsigned char) *(lineEnd - 1)))
+        --lineEnd;
+
+      if (begin < lineEnd)
+      {
+        chunkStarts[c].push_back(begin - data);
+        chunkEnds[c].push_back(lineEnd - data);
+      }
+
+      begin = next;
+    }
+  }
+
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    lineStarts.insert(lineStarts.end(), chunkStarts[c].begin(),
+        chunkStarts[c].end());
+    lineEnds.insert(lineEnds.end(), chunkEnds[c].begin(), chunkEnds[c].end());
+  }
+
+  if (lineStarts.empty())
+  {
+    std::ostringstream oss;
+    oss << "CSVSource::CSVSource(): '" << filename << "' holds no points.";
+    throw std::runtime_error(oss.str());
+  }
+
+  // The first line decides the dimensionality.
+  const char* position = data + lineStarts[0];
+  const char* fieldBegin;
+  const char* fieldEnd;
+  while (NextField(position, data + lineEnds[0], fieldBegin, fieldEnd))
+    ++dimensionality;
+
+  if (responses.n_cols != lineStarts.size())
+  {
+    std::ostringstream oss;
+    oss << "CSVSource::CSVSource(): '" << filename << "' has "
+        << lineStarts.size() << " points, but responses have "
+        << responses.n_cols << " columns.";
+    throw std::invalid_argument(oss.str());
+  }
+
+  order = arma::linspace<arma::uvec>(0, lineStarts.size() - 1,
+      lineStarts.size());
+}
+
+template<typename eT, typename ResponsesMatType>
+void CSVSource<eT, ResponsesMatType>::Shuffle()
+{
+  order = arma::shuffle(order);
+}
+
+template<typename eT, typename ResponsesMatType>
+void CSVSource<eT, ResponsesMatType>::Batch(
+    const size_t begin,
+    const size_t batchSize,
+    arma::Mat<eT>& batchPredictors,
+    ResponsesMatType& batchResponses) const
+{
+  CheckBatch(begin, batchSize, lineStarts.size());
+  batchPredictors.set_size(dimensionality, batchSize);
+  if (batchSize == 0)
+  {
+    batchResponses.set_size(responses.n_rows, 0);
+    return;
+  }
+
+  // Exceptions can't leave the parallel region, so the error for each line is
+  // kept.
+  const char* data = file.Data();
+  std::vector<std::string> errors(batchSize);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) batchSize; ++i)
+  {
+    const size_t point = order[begin + i];
+    try
+    {
+      ParseLine(data + lineStarts[point], data + lineEnds[point],
+          batchPredictors.colptr(i));
+    }
+    catch (std::exception& e)
+    {
+      std::ostringstream oss;
+      oss << "CSVSource::Batch(): " << e.what() << " (point " << point << ").";
+      errors[i] = oss.str();
+    }
+  }
+
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    if (!errors[i].empty())
+      throw std::runtime_error(errors[i]);
+  }
+
+  batchResponses = responses.cols(order.subvec(begin, begin + batchSize - 1));
+}
+
+template<typename eT, typename ResponsesMatType>
+bool CSVSource<eT, ResponsesMatType>::NextField(const char*& position,
+                                                const char* end,
+                                                const char*& fieldBegin,
+                                                const char*& fieldEnd)
+{
+  while (position < end && (*position == ' ' || *position == '\t'))
+    ++position;
+  if (position == end)
+    return false;
+
+  fieldBegin = position;
+  fieldEnd = position;
+  while (fieldEnd < end && *fieldEnd != ',' && *fieldEnd != ' ' &&
+         *fieldEnd != '\t')
+    ++fieldEnd;
+
+  // Skip the whitespace and the comma after the field.
+  position = fieldEnd;
+  while (position < end && (*position == ' ' || *position == '\t'))
+    ++position;
+  if (position < end && *position == ',')
+    ++position;
+
+  return true;
+}
+
+template<typename eT, typename ResponsesMatType>
+void CSVSource<eT, ResponsesMatType>::ParseLine(const char* begin,
+                                                const char* end,
+                                                eT* column) const
+{
+  const char* fieldBegin;
+  const char* fieldEnd;
+  size_t d = 0;
+  while (NextField(begin, end, fieldBegin, fieldEnd))
+  {
+    if (d == dimensionality)
+      throw std::runtime_error("too many fields");
+
+    // strtod() needs a null-terminated string, so copy the field first.
+    char buffer[64];
+    const size_t length = fieldEnd - fieldBegin;
+    if (length == 0 || length >= sizeof(buffer))
+      throw std::runtime_error("invalid value");
+
+    std::memcpy(buffer, fieldBegin, length);
+    buffer[length] = '\0';
+
+    char* parsed;
+    column[d++] = (eT) std::strtod(buffer, &parsed);
+    if (parsed != buffer + length)
+      throw std::runtime_error("invalid value");
+  }
+
+  if (d != dimensionality)
+    throw std::runtime_error("too few fields");
+}
+
+template<typename SourceType>
+PrefetchSource<SourceType>::PrefetchSource(SourceType& source) :
+    source(source),
+    nextBegin(0),
+    nextBatchSize(0)
+{
+  // Nothing to do.
+}
+
+template<typename SourceType>
+PrefetchSource<SourceType>::~PrefetchSource()
+{
+  Discard();
+}
+
+template<typename SourceType>
+void PrefetchSource<SourceType>::Shuffle()
+{
+  // The batch that is being loaded depends on the old order.
+  Discard();
+  source.Shuffle();
+}
+
+template<typename SourceType>
+void PrefetchSource<SourceType>::Batch(const size_t begin,
+                                       const size_t batchSize,
+                                       PredictorsType& batchPredictors,
+                                       ResponsesType& batchResponses)
+{
+  if (pending.valid() && nextBegin == begin && nextBatchSize == batchSize)
+  {
+    // get() rethrows any error from loading the batch.
+    pending.get();
+    batchPredictors = std::move(nextPredictors);
+    batchResponses = std::move(nextResponses);
+  }
+  else
+  {
+    Discard();
+    source.Batch(begin, batchSize, batchPredictors, batchResponses);
+  }
+
+  // Start loading the batch that follows.
+  const size_t next = begin + batchSize;
+  if (batchSize > 0 && next < source.NumPoints())
+  {
+    nextBegin = next;
+    nextBatchSize = std::min(batchSize, source.NumPoints() - next);
+    pending = std::async(std::launch::async, [this]()
+    {
+      source.Batch(nextBegin, nextBatchSize, nextPredictors, nextResponses);
+    });
+  }
+}
+
+template<typename SourceType>
+void PrefetchSource<SourceType>::Discard()
+{
+  // Any error is ignored, since the batch is not used.
+  if (pending.valid())
+    pending.wait();
+
+  pending = std::future<void>();
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
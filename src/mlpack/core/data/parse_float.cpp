@@ -0,0 +1,90 @@
+/**
+ * @file core/data/parse_float.cpp
+ *
+ * Implementation of ParseFloat().
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "parse_float.hpp"
+
+#include <cerrno>
+
+namespace mlpack {
+namespace data {
+
+namespace {
+
+inline double ToFloat(const char* str, char** end, double /* tag */)
+{
+  return std::strtod(str, end);
+}
+
+inline float ToFloat(const char* str, char** end, float /* tag */)
+{
+  return std::strtof(str, end);
+}
+
+//! Parse a floating-point number the way a stream extraction would.
+template<typename T>
+bool ParseFloatImpl(const char* begin, const char* end, T& value)
+{
+  const size_t length = end - begin;
+  if (length == 0)
+    return false;
+
+  // strtod() accepts more than a stream extraction does (e.g. "inf", "nan" and
+  // hexadecimal numbers), so first check that only digits, signs, decimal
+  // points and exponents are present.
+  for (const char* c = begin; c < end; ++c)
+  {
+    if ((*c < '0' || *c > '9') && *c != '.' && *c != '-' && *c != '+' &&
+        *c != 'e' && *c != 'E')
+      return false;
+  }
+
+  // strtod() needs a null-terminated string; most fields are short.
+  char buffer[64];
+  std::string longField;
+  const char* str = buffer;
+  if (length < sizeof(buffer))
+  {
+    std::memcpy(buffer, begin, length);
+    buffer[length] = '\0';
+  }
+  else
+  {
+    longField.assign(begin, end);
+    str = longField.c_str();
+  }
+
+  char* parsedEnd;
+  errno = 0;
+  const T result = ToFloat(str, &parsedEnd, T());
+
+  // The whole field must be used, and overflow is an extraction failure.
+  if (parsedEnd != str + length)
+    return false;
+  if (errno == ERANGE && std::abs(result) == std::numeric_limits<T>::infinity())
+    return false;
+
+  value = result;
+  return true;
+}
+
+} // anonymous namespace
+
+bool ParseFloat(const char* begin, const char* end, double& value)
+{
+  return ParseFloatImpl(begin, end, value);
+}
+
+bool ParseFloat(const char* begin, const char* end, float& value)
+{
+  return ParseFloatImpl(begin, end, value);
+}
+
+} // namespace data
+} // namespace mlpack
@@ -0,0 +1,38 @@
+/**
+ * @file core/data/parse_float.hpp
+ *
+ * ParseFloat(), which parses a number that is not null-terminated the way a
+ * stream extraction would.  It is shared by the text loaders.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_PARSE_FLOAT_HPP
+#define MLPACK_CORE_DATA_PARSE_FLOAT_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Parse a floating-point number between begin and end, which need not be
+ * null-terminated, accepting exactly what a stream extraction (as used by
+ * IncrementPolicy) would.  Returns false if the whole range is not a number,
+ * or if the number overflows.
+ *
+ * @param begin Start of the number.
+ * @param end End of the number.
+ * @param value Filled with the number.
+ */
+bool ParseFloat(const char* begin, const char* end, double& value);
+
+//! Parse a number as a float; see the overload for doubles.
+bool ParseFloat(const char* begin, const char* end, float& value);
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -19,6 +19,7 @@
 #include <string>
 
 #include "format.hpp"
+#include "dataset_mapper.hpp"
 #include "image_info.hpp"
 
 namespace mlpack {
@@ -122,6 +123,35 @@ bool Save(const std::string& filename,
           const bool fatal = false,
           format f = format::autodetect);
 
+/**
+ * Save a matrix and its DatasetInfo in mlpack's native dataset format, which
+ * must be denoted by the .mlc extension.  The file stores the dimensions of
+ * the matrix, the type of each dimension and the categorical mappings, so that
+ * it can be loaded again with Load() without any parsing.  The matrix is saved
+ * as it is (each point is a column); it is not transposed.
+ *
+ * Uncompressed files can be used in place from a memory-mapped file; see the
+ * Load() overload that takes a MemoryMappedFile.  If 'compress' is true, the
+ * points are instead split into chunks, and each dimension of each chunk is
+ * stored with the smallest type (8, 16 or 32-bit unsigned integers, or floats
+ * for double matrices) that represents its values exactly.  Dimensions with
+ * long runs of equal values are also run-length encoded.  This is lossless,
+ * and is effective for categorical, integer-valued and repetitive data.
+ *
+ * @param filename Name of file to save to.
+ * @param matrix Matrix to save into file.
+ * @param info DatasetInfo holding the types and mappings of each dimension.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @param compress If true, compress the data (default false).
+ * @return Boolean value indicating success or failure of save.
+ */
+template<typename eT>
+bool Save(const std::string& filename,
+          const arma::Mat<eT>& matrix,
+          const DatasetInfo& info,
+          const bool fatal = false,
+          const bool compress = false);
+
 /**
  * Save the image file from the given matrix.
  *
@@ -165,5 +195,7 @@ bool SaveImage(const std::string& filename,
 
 // Include implementation.
 #include "save_impl.hpp"
+// Include implementation of Save() for the native dataset format.
+#include "save_columnar_impl.hpp"
 
 #endif
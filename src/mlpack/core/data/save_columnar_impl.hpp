@@ -0,0 +1,358 @@
+/**
+ * @file core/data/save_columnar_impl.hpp
+ *
+ * Implementation of Save() for the native dataset format.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_SAVE_COLUMNAR_IMPL_HPP
+#define MLPACK_CORE_DATA_SAVE_COLUMNAR_IMPL_HPP
+
+// In case it hasn't already been included.
+#include "save.hpp"
+#include "extension.hpp"
+#include "columnar_format.hpp"
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+//! Append the bytes of a value to a buffer.
+template<typename T>
+void AppendColumnarValue(std::vector<char>& buffer, const T value)
+{
+  const char* bytes = (const char*) &value;
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+/**
+ * Return whether x can be converted to StorageType and back without changing
+ * its value.
+ */
+template<typename StorageType, typename eT>
+bool ColumnarRepresentable(const eT x)
+{
+  // The integer storage types are unsigned, so negative values (including
+  // -0.0) cannot be stored, and floating-point values have to be in range
+  // before they can be converted.
+  if (std::is_integral<StorageType>::value)
+  {
+    if (std::signbit(x))
+      return false;
+
+    const double limit = std::ldexp(1.0, 8 * sizeof(StorageType));
+    if (std::is_floating_point<eT>::value && !((double) x < limit))
+      return false;
+  }
+
+  return (eT) (StorageType) x == x;
+}
+
+/**
+ * Find the smallest type that exactly represents all values of the given
+ * dimension between the given points.
+ */
+template<typename eT>
+ColumnarType NarrowestColumnarType(const arma::Mat<eT>& matrix,
+                                   const size_t dimension,
+                                   const size_t begin,
+                                   const size_t end)
+{
+  bool u8 = true, u16 = true, u32 = true, f32 = std::is_same<eT, double>::value;
+  for (size_t i = begin; i < end && (u32 || f32); ++i)
+  {
+    const eT x = matrix(dimension, i);
+    u8 = u8 && ColumnarRepresentable<uint8_t>(x);
+    u16 = u16 && ColumnarRepresentable<uint16_t>(x);
+    u32 = u32 && ColumnarRepresentable<uint32_t>(x);
+    f32 = f32 && ColumnarRepresentable<float>(x);
+  }
+
+  if (u8)
+    return ColumnarType::U8;
+  else if (u16)
+    return ColumnarType::U16;
+  else if (u32)
+    return ColumnarType::U32;
+  else if (f32)
+    return ColumnarType::F32;
+  else
+    return ColumnarTypeOf<eT>();
+}
+
+//! Return whether two values have the same representation.
+template<typename eT>
+bool ColumnarSameValue(const eT a, const eT b)
+{
+  // Comparing the bytes keeps -0.0 and 0.0 apart, and lets NaNs form runs.
+  return std::memcmp(&a, &b, sizeof(eT)) == 0;
+}
+
+//! Count the runs of equal values of one dimension between the given points.
+template<typename eT>
+size_t CountColumnarRuns(const arma::Mat<eT>& matrix,
+                         const size_t dimension,
+                         const size_t begin,
+                         const size_t end)
+{
+  size_t runs = (begin < end) ? 1 : 0;
+  for (size_t i = begin + 1; i < end; ++i)
+  {
+    if (!ColumnarSameValue(matrix(dimension, i), matrix(dimension, i - 1)))
+      ++runs;
+  }
+
+  return runs;
+}
+
+/**
+ * Append values of one dimension of a matrix to a buffer, as StorageType.  If
+ * runLength is true, the values are run-length encoded.
+ */
+template<typename StorageType, typename eT>
+void AppendColumnarValues(std::vector<char>& buffer,
+                          const arma::Mat<eT>& matrix,
+                          const size_t dimension,
+                          const size_t begin,
+                          const size_t end,
+                          const bool runLength)
+{
+  if (!runLength)
+  {
+    for (size_t i = begin; i < end; ++i)
+      AppendColumnarValue(buffer, (StorageType) matrix(dimension, i));
+    return;
+  }
+
+  AppendColumnarValue(buffer, (uint32_t) CountColumnarRuns(matrix, dimension,
+      begin, end));
+
+  // First the length of each run, then the value of each run.
+  size_t runBegin = begin;
+  for (size_t i = begin + 1; i <= end; ++i)
+  {
+    if (i == end ||
+        !ColumnarSameValue(matrix(dimension, i), matrix(dimension, i - 1)))
+    {
+      AppendColumnarValue(buffer, (uint32_t) (i - runBegin));
+      runBegin = i;
+    }
+  }
+
+  for (size_t i = begin; i < end; ++i)
+  {
+    if (i == begin ||
+        !ColumnarSameValue(matrix(dimension, i), matrix(dimension, i - 1)))
+      AppendColumnarValue(buffer, (StorageType) matrix(dimension, i));
+  }
+}
+
+/**
+ * Compress the given points of a matrix into a chunk of the native dataset
+ * format.  Each dimension is stored with the smallest type that holds its
+ * values exactly, and is run-length encoded if that takes less space.
+ */
+template<typename eT>
+void CompressColumnarChunk(const arma::Mat<eT>& matrix,
+                           const size_t begin,
+                           const size_t end,
+                           std::vector<char>& buffer)
+{
+  std::vector<ColumnarType> types(matrix.n_rows);
+  std::vector<char> runLength(matrix.n_rows);
+  for (size_t d = 0; d < matrix.n_rows; ++d)
+  {
+    types[d] = NarrowestColumnarType(matrix, d, begin, end);
+    const size_t typeSize = ColumnarTypeSize(types[d]);
+    const size_t runs = CountColumnarRuns(matrix, d, begin, end);
+    runLength[d] = (sizeof(uint32_t) + runs * (sizeof(uint32_t) + typeSize) <
+        (end - begin) * typeSize);
+
+    AppendColumnarValue(buffer, (uint8_t) ((uint8_t) types[d] |
+        (runLength[d] ? ColumnarRunLength : 0)));
+  }
+
+  for (size_t d = 0; d < matrix.n_rows; ++d)
+  {
+    switch (types[d])
+    {
+      case ColumnarType::U8:
+        AppendColumnarValues<uint8_t>(buffer, matrix, d, begin, end,
+            runLength[d]);
+        break;
+      case ColumnarType::U16:
+        AppendColumnarValues<uint16_t>(buffer, matrix, d, begin, end,
+            runLength[d]);
+        break;
+      case ColumnarType::U32:
+        AppendColumnarValues<uint32_t>(buffer, matrix, d, begin, end,
+            runLength[d]);
+        break;
+      case ColumnarType::F32:
+        AppendColumnarValues<float>(buffer, matrix, d, begin, end,
+            runLength[d]);
+        break;
+      default:
+        AppendColumnarValues<eT>(buffer, matrix, d, begin, end, runLength[d]);
+        break;
+    }
+  }
+}
+
+template<typename eT>
+bool Save(const std::string& filename,
+          const arma::Mat<eT>& matrix,
+          const DatasetInfo& info,
+          const bool fatal,
+          const bool compress)
+{
+  Timer::Start("saving_data");
+
+  std::ostringstream error;
+  ColumnarType type = ColumnarType::F64;
+  try
+  {
+    type = ColumnarTypeOf<eT>();
+
+    if (Extension(filename) != "mlc")
+    {
+      error << "Save(): only the native dataset format (.mlc) can be saved "
+          << "with a DatasetInfo; cannot save '" << filename << "'.";
+    }
+    else if (info.Dimensionality() != matrix.n_rows)
+    {
+      error << "Save(): the DatasetInfo has " << info.Dimensionality()
+          << " dimensions, but the matrix has " << matrix.n_rows << ".";
+    }
+  }
+  catch (std::invalid_argument& e)
+  {
+    error << "Save(): " << e.what() << ".";
+  }
+
+  std::ofstream stream;
+  if (error.str().empty())
+  {
+    stream.open(filename.c_str(), std::fstream::out | std::fstream::binary);
+    if (!stream.is_open())
+    {
+      error << "Cannot open file '" << filename << "' for writing.  Save "
+          << "failed.";
+    }
+  }
+
+  if (!error.str().empty())
+  {
+    Timer::Stop("saving_data");
+    if (fatal)
+      Log::Fatal << error.str() << std::endl;
+    else
+      Log::Warn << error.str() << std::endl;
+
+    return false;
+  }
+
+  // Assemble the header.
+  std::vector<char> header(ColumnarMagic, ColumnarMagic + 8);
+  AppendColumnarValue(header, ColumnarVersion);
+  AppendColumnarValue(header, ColumnarByteOrder);
+  AppendColumnarValue(header, (uint8_t) type);
+  AppendColumnarValue(header, (uint8_t) compress);
+  AppendColumnarValue(header, (uint16_t) 0);
+  AppendColumnarValue(header, (uint64_t) matrix.n_rows);
+  AppendColumnarValue(header, (uint64_t) matrix.n_cols);
+  AppendColumnarValue(header, (uint64_t) ColumnarChunkSize);
+
+  for (size_t d = 0; d < matrix.n_rows; ++d)
+    AppendColumnarValue(header, (uint8_t) info.Type(d));
+
+  for (size_t d = 0; d < matrix.n_rows; ++d)
+  {
+    if (info.Type(d) != Datatype::categorical)
+      continue;
+
+    const size_t numMappings = info.NumMappings(d);
+    AppendColumnarValue(header, (uint64_t) numMappings);
+    for (size_t i = 0; i < numMappings; ++i)
+    {
+      const std::string& str = info.UnmapString(i, d);
+      AppendColumnarValue(header, (uint64_t) str.size());
+      header.insert(header.end(), str.begin(), str.end());
+    }
+  }
+
+  header.resize(((header.size() + ColumnarAlignment - 1) / ColumnarAlignment) *
+      ColumnarAlignment, 0);
+  stream.write(header.data(), header.size());
+
+  if (!compress)
+  {
+    stream.write((const char*) matrix.memptr(), matrix.n_elem * sizeof(eT));
+  }
+  else
+  {
+    const size_t numChunks = (matrix.n_cols + ColumnarChunkSize - 1) /
+        ColumnarChunkSize;
+
+    // Leave room for the chunk offsets; they are known once the chunks have
+    // been written.
+    const std::streampos tablePosition = stream.tellp();
+    std::vector<uint64_t> offsets(numChunks + 1, 0);
+    stream.write((const char*) offsets.data(), offsets.size() *
+        sizeof(uint64_t));
+
+    // Compress a batch of chunks in parallel, then write them in order.
+    size_t batchSize = 1;
+    #ifdef HAS_OPENMP
+      batchSize = omp_get_max_threads();
+    #endif
+    std::vector<std::vector<char>> buffers(batchSize);
+    for (size_t batch = 0; batch < numChunks; batch += batchSize)
+    {
+      const size_t batchEnd = std::min(batch + batchSize, numChunks);
+
+      #pragma omp parallel for schedule(dynamic)
+      for (omp_size_t c = batch; c < (omp_size_t) batchEnd; ++c)
+      {
+        const size_t begin = c * ColumnarChunkSize;
+        const size_t end = std::min(begin + ColumnarChunkSize,
+            (size_t) matrix.n_cols);
+        buffers[c - batch].clear();
+        CompressColumnarChunk(matrix, begin, end, buffers[c - batch]);
+      }
+
+      for (size_t c = batch; c < batchEnd; ++c)
+      {
+        stream.write(buffers[c - batch].data(), buffers[c - batch].size());
+        offsets[c + 1] = offsets[c] + buffers[c - batch].size();
+      }
+    }
+
+    stream.seekp(tablePosition);
+    stream.write((const char*) offsets.data(), offsets.size() *
+        sizeof(uint64_t));
+  }
+
+  const bool success = !stream.fail();
+  Timer::Stop("saving_data");
+  if (!success)
+  {
+    if (fatal)
+      Log::Fatal << "Save to '" << filename << "' failed." << std::endl;
+    else
+      Log::Warn << "Save to '" << filename << "' failed." << std::endl;
+  }
+
+  return success;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
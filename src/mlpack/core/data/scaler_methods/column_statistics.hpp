@@ -0,0 +1,212 @@
+/**
+ * @file core/data/scaler_methods/column_statistics.hpp
+ *
+ * ColumnStatistics, which computes the mean, variance, minimum and maximum of
+ * each dimension of a dataset in one parallel pass, and TransformColumns(),
+ * which applies an elementwise transform in parallel.  These are used by the
+ * scalers.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_SCALER_METHODS_COLUMN_STATISTICS_HPP
+#define MLPACK_CORE_DATA_SCALER_METHODS_COLUMN_STATISTICS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Compute the mean, variance, minimum and maximum of each dimension (row) of a
+ * column-major dataset in a single pass over the data.  The points are split
+ * into contiguous shards which are processed in parallel; each shard
+ * accumulates sums of deviations from its first point (which keeps the
+ * variance accurate when the mean is large), and the shards are then merged
+ * with the pairwise update of Chan et al.
+ *
+ * @code
+ * ColumnStatistics stats(dataset);
+ * arma::vec mean = stats.Mean();
+ * arma::vec stddev = stats.StdDev(1); // Same as arma::stddev(dataset, 1, 1).
+ * @endcode
+ */
+class ColumnStatistics
+{
+ public:
+  /**
+   * Compute the statistics of each dimension of the given dataset, which may
+   * be any dense Armadillo matrix or expression.  As with arma::mean(), the
+   * statistics of a dataset without points are empty.
+   *
+   * @param dataset Dataset to compute the statistics of.
+   */
+  template<typename MatType>
+  ColumnStatistics(const MatType& dataset) : numPoints(dataset.n_cols)
+  {
+    if (numPoints == 0)
+      return;
+
+    // Subviews and expressions are evaluated into a matrix first.
+    typedef typename MatType::elem_type eT;
+    typedef typename std::conditional<std::is_base_of<arma::Mat<eT>,
+        MatType>::value, const arma::Mat<eT>&, const arma::Mat<eT>>::type
+        InputType;
+    InputType input(dataset);
+
+    const size_t dimensions = input.n_rows;
+    size_t numShards = 1;
+    #ifdef HAS_OPENMP
+      numShards = 4 * omp_get_max_threads();
+    #endif
+    numShards = std::max((size_t) 1, std::min(numShards, numPoints));
+
+    arma::mat shardMean(dimensions, numShards);
+    arma::mat shardM2(dimensions, numShards);
+    arma::mat shardMin(dimensions, numShards);
+    arma::mat shardMax(dimensions, numShards);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t s = 0; s < (omp_size_t) numShards; ++s)
+    {
+      const size_t begin = s * numPoints / numShards;
+      const size_t end = (s + 1) * numPoints / numShards;
+      const eT* shift = input.colptr(begin);
+
+      double* mean = shardMean.colptr(s);
+      double* m2 = shardM2.colptr(s);
+      double* min = shardMin.colptr(s);
+      double* max = shardMax.colptr(s);
+      for (size_t d = 0; d < dimensions; ++d)
+      {
+        mean[d] = 0.0;
+        m2[d] = 0.0;
+        min[d] = shift[d];
+        max[d] = shift[d];
+      }
+
+      for (size_t i = begin; i < end; ++i)
+      {
+        const eT* point = input.colptr(i);
+        for (size_t d = 0; d < dimensions; ++d)
+        {
+          const double delta = (double) point[d] - (double) shift[d];
+          mean[d] += delta;
+          m2[d] += delta * delta;
+          min[d] = std::min(min[d], (double) point[d]);
+          max[d] = std::max(max[d], (double) point[d]);
+        }
+      }
+
+      // Turn the sums of deviations into the mean and the sum of squared
+      // deviations from the mean.
+      const double n = (double) (end - begin);
+      for (size_t d = 0; d < dimensions; ++d)
+      {
+        m2[d] = std::max(0.0, m2[d] - mean[d] * mean[d] / n);
+        mean[d] = shift[d] + mean[d] / n;
+      }
+    }
+
+    mean = shardMean.col(0);
+    m2 = shardM2.col(0);
+    min = shardMin.col(0);
+    max = shardMax.col(0);
+    double count = (double) (numPoints / numShards);
+    for (size_t s = 1; s < numShards; ++s)
+    {
+      const double n = (double) ((s + 1) * numPoints / numShards -
+          s * numPoints / numShards);
+      const arma::vec delta = shardMean.col(s) - mean;
+      mean += delta * (n / (count + n));
+      m2 += shardM2.col(s) + arma::square(delta) * (count * n / (count + n));
+      min = arma::min(min, shardMin.col(s));
+      max = arma::max(max, shardMax.col(s));
+      count += n;
+    }
+  }
+
+  //! Get the mean of each dimension.
+  const arma::vec& Mean() const { return mean; }
+  //! Get the minimum of each dimension.
+  const arma::vec& Min() const { return min; }
+  //! Get the maximum of each dimension.
+  const arma::vec& Max() const { return max; }
+  //! Get the number of points.
+  size_t NumPoints() const { return numPoints; }
+
+  /**
+   * Get the variance of each dimension.  As for arma::var(), if normType is 0
+   * the variance is normalized by n - 1, and if it is 1, by n.
+   *
+   * @param normType Type of normalization.
+   */
+  arma::vec Variance(const size_t normType = 0) const
+  {
+    const double n = (normType == 0 && numPoints > 1) ?
+        (double) (numPoints - 1) : (double) numPoints;
+    return m2 / n;
+  }
+
+  /**
+   * Get the standard deviation of each dimension.  As for arma::stddev(), if
+   * normType is 0 the variance is normalized by n - 1, and if it is 1, by n.
+   *
+   * @param normType Type of normalization.
+   */
+  arma::vec StdDev(const size_t normType = 0) const
+  {
+    return arma::sqrt(Variance(normType));
+  }
+
+ private:
+  //! The number of points.
+  size_t numPoints;
+  //! The mean of each dimension.
+  arma::vec mean;
+  //! The sum of squared deviations from the mean of each dimension.
+  arma::vec m2;
+  //! The minimum of each dimension.
+  arma::vec min;
+  //! The maximum of each dimension.
+  arma::vec max;
+};
+
+/**
+ * Apply the given elementwise transform to each element of the input matrix,
+ * and store the results in the output matrix.  The points are processed in
+ * parallel.  The transform is called as f(value, dimension), and the input
+ * and the output may be the same matrix.
+ *
+ * @param input Matrix to transform.
+ * @param output Matrix to store the transformed elements in.
+ * @param f Elementwise transform.
+ */
+template<typename eT, typename FunctionType>
+void TransformColumns(const arma::Mat<eT>& input,
+                      arma::Mat<eT>& output,
+                      const FunctionType& f)
+{
+  if (&input != &output)
+    output.set_size(input.n_rows, input.n_cols);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) input.n_cols; ++i)
+  {
+    const eT* in = input.colptr(i);
+    eT* out = output.colptr(i);
+    for (size_t d = 0; d < input.n_rows; ++d)
+      out[d] = (eT) f(in[d], d);
+  }
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
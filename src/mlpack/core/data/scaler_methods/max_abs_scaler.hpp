@@ -13,6 +13,7 @@
 #define MLPACK_CORE_DATA_MAX_ABS_SCALE_HPP
 
 #include <mlpack/prereqs.hpp>
+#include "column_statistics.hpp"
 
 namespace mlpack {
 namespace data {
@@ -54,8 +55,9 @@ class MaxAbsScaler
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMin = arma::min(input, 1);
-    itemMax = arma::max(input, 1);
+    const ColumnStatistics stats(input);
+    itemMin = stats.Min();
+    itemMax = stats.Max();
     scale = arma::max(arma::abs(itemMin), arma::abs(itemMax));
     // Handling zeros in scale vector.
     scale.for_each([](arma::vec::elem_type& val) { val =
@@ -76,8 +78,9 @@ class MaxAbsScaler
       throw std::runtime_error("Call Fit() before Transform(), please"
         " refer to the documentation.");
     }
-    output.copy_size(input);
-    output = input.each_col() / scale;
+    const arma::vec& s = scale;
+    TransformColumns(input, output, [&](const double x, const size_t d)
+        { return x / s[d]; });
   }
 
   /**
@@ -89,8 +92,9 @@ class MaxAbsScaler
   template<typename MatType>
   void InverseTransform(const MatType& input, MatType& output)
   {
-    output.copy_size(input);
-    output = input.each_col() % scale;
+    const arma::vec& s = scale;
+    TransformColumns(input, output, [&](const double x, const size_t d)
+        { return x * s[d]; });
   }
 
   //! Get the Min row vector.
@@ -13,6 +13,7 @@
 #define MLPACK_CORE_DATA_MEAN_NORMALIZATION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include "column_statistics.hpp"
 
 namespace mlpack {
 namespace data {
@@ -54,9 +55,10 @@ class MeanNormalization
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMean = arma::mean(input, 1);
-    itemMin = arma::min(input, 1);
-    itemMax = arma::max(input, 1);
+    const ColumnStatistics stats(input);
+    itemMean = stats.Mean();
+    itemMin = stats.Min();
+    itemMax = stats.Max();
     scale = itemMax - itemMin;
     // Handling zeros in scale vector.
     scale.for_each([](arma::vec::elem_type& val) { val =
@@ -77,8 +79,10 @@ class MeanNormalization
       throw std::runtime_error("Call Fit() before Transform(), please"
         " refer to the documentation.");
     }
-    output.copy_size(input);
-    output = (input.each_col() - itemMean).each_col() / scale;
+    const arma::vec& mean = itemMean;
+    const arma::vec& s = scale;
+    TransformColumns(input, output, [&](const double x, const size_t d)
+        { return (x - mean[d]) / s[d]; });
   }
 
   /**
@@ -90,8 +94,10 @@ class MeanNormalization
   template<typename MatType>
   void InverseTransform(const MatType& input, MatType& output)
   {
-    output.copy_size(input);
-    output = (input.each_col() % scale).each_col() + itemMean;
+    const arma::vec& mean = itemMean;
+    const arma::vec& s = scale;
+    TransformColumns(input, output, [&](const double x, const size_t d)
+        { return x * s[d] + mean[d]; });
   }
 
   //! Get the Mean row vector.
@@ -13,6 +13,7 @@
 #define MLPACK_CORE_DATA_SCALE_HPP
 
 #include <mlpack/prereqs.hpp>
+#include "column_statistics.hpp"
 
 namespace mlpack {
 namespace data {
@@ -73,8 +74,9 @@ class MinMaxScaler
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMin = arma::min(input, 1);
-    itemMax = arma::max(input, 1);
+    const ColumnStatistics stats(input);
+    itemMin = stats.Min();
+    itemMax = stats.Max();
     scale = itemMax - itemMin;
     // Handle zeros in scale vector.
     scale.for_each([](arma::vec::elem_type& val) { val =
@@ -99,8 +101,10 @@ class MinMaxScaler
       throw std::runtime_error("Call Fit() before Transform(), please"
           " refer to the documentation.");
     }
-    output.copy_size(input);
-    output = (input.each_col() % scale).each_col() + scalerowmin;
+    const arma::vec& s = scale;
+    const arma::vec& rowMin = scalerowmin;
+    TransformColumns(input, output, [&](const double x, const size_t d)
+        { return x * s[d] + rowMin[d]; });
   }
 
   /**
@@ -112,8 +116,10 @@ class MinMaxScaler
   template<typename MatType>
   void InverseTransform(const MatType& input, MatType& output)
   {
-    output.copy_size(input);
-    output = (input.each_col() - scalerowmin).each_col() / scale;
+    const arma::vec& s = scale;
+    const arma::vec& rowMin = scalerowmin;
+    TransformColumns(input, output, [&](const double x, const size_t d)
+        { return (x - rowMin[d]) / s[d]; });
   }
 
   //! Get the Min row vector.
@@ -13,6 +13,7 @@
 #define MLPACK_CORE_DATA_STANDARD_SCALE_HPP
 
 #include <mlpack/prereqs.hpp>
+#include "column_statistics.hpp"
 
 namespace mlpack {
 namespace data {
@@ -55,8 +56,9 @@ class StandardScaler
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMean = arma::mean(input, 1);
-    itemStdDev = arma::stddev(input, 1, 1);
+    const ColumnStatistics stats(input);
+    itemMean = stats.Mean();
+    itemStdDev = stats.StdDev(1);
     // Handle zeros in scale vector.
     itemStdDev.for_each([](arma::vec::elem_type& val) { val =
         (val == 0) ? 1 : val; });
@@ -76,8 +78,10 @@ class StandardScaler
       throw std::runtime_error("Call Fit() before Transform(), please"
         " refer to the documentation.");
     }
-    output.copy_size(input);
-    output = (input.each_col() - itemMean).each_col() / itemStdDev;
+    const arma::vec& mean = itemMean;
+    const arma::vec& stddev = itemStdDev;
+    TransformColumns(input, output, [&](const double x, const size_t d)
+        { return (x - mean[d]) / stddev[d]; });
   }
 
   /**
@@ -89,8 +93,10 @@ class StandardScaler
   template<typename MatType>
   void InverseTransform(const MatType& input, MatType& output)
   {
-    output.copy_size(input);
-    output = (input.each_col() % itemStdDev).each_col() + itemMean;
+    const arma::vec& mean = itemMean;
+    const arma::vec& stddev = itemStdDev;
+    TransformColumns(input, output, [&](const double x, const size_t d)
+        { return x * stddev[d] + mean[d]; });
   }
 
   //! Get the mean row vector.
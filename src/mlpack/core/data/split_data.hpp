@@ -224,6 +224,226 @@ Split(const arma::Mat<T>& input,
                          std::move(testData));
 }
 
+/**
+ * Permute the columns of the given matrix in place, so that column i of the
+ * result is column order[i] of the original matrix.  The permutation is
+ * applied by following its cycles, so apart from the matrix only one column
+ * and one bit per column are held in memory.  To permute several matrices the
+ * same way (for instance a dataset and its labels), call this on each of them
+ * with the same order.
+ *
+ * @param data Matrix to permute the columns of.
+ * @param order Permutation of the column indices.
+ */
+template<typename T>
+void PermuteCols(arma::Mat<T>& data, const arma::uvec& order)
+{
+  if (order.n_elem != data.n_cols)
+  {
+    throw std::invalid_argument("PermuteCols(): the permutation has "
+        + std::to_string(order.n_elem) + " elements, but the matrix has "
+        + std::to_string(data.n_cols) + " columns!");
+  }
+
+  const size_t n = data.n_rows;
+  std::vector<T> buffer(n);
+  std::vector<bool> done(data.n_cols, false);
+  for (size_t start = 0; start < data.n_cols; ++start)
+  {
+    if (done[start])
+      continue;
+
+    // Walk the cycle that starts here; each column is filled from the column
+    // it takes its value from, and the last one is filled from the buffer.
+    std::copy(data.colptr(start), data.colptr(start) + n, buffer.begin());
+    size_t i = start;
+    while (order[i] != start)
+    {
+      std::copy(data.colptr(order[i]), data.colptr(order[i]) + n,
+          data.colptr(i));
+      done[i] = true;
+      i = order[i];
+    }
+    std::copy(buffer.begin(), buffer.end(), data.colptr(i));
+    done[i] = true;
+  }
+}
+
+/**
+ * Split the indices of the given number of points into a training set and a
+ * test set.  Nothing is copied: the indices can be used as views of the
+ * dataset (for instance input.cols(trainIndices)), so that the training and
+ * test sets are only materialized if and when they are needed.
+ *
+ * @code
+ * arma::uvec trainIndices, testIndices;
+ * SplitIndices(input.n_cols, trainIndices, testIndices, 0.3);
+ * arma::mat testData = input.cols(testIndices);
+ * @endcode
+ *
+ * @param numPoints Number of points in the dataset.
+ * @param trainIndices Vector to store the indices of the training set into.
+ * @param testIndices Vector to store the indices of the test set into.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *       sample is visited in linear order. (Default true).
+ */
+inline void SplitIndices(const size_t numPoints,
+                         arma::uvec& trainIndices,
+                         arma::uvec& testIndices,
+                         const double testRatio,
+                         const bool shuffleData = true)
+{
+  const size_t testSize = static_cast<size_t>(numPoints * testRatio);
+  const size_t trainSize = numPoints - testSize;
+
+  arma::uvec order = arma::linspace<arma::uvec>(0, numPoints - 1, numPoints);
+  if (shuffleData)
+    order = arma::shuffle(order);
+
+  trainIndices = order.head(trainSize);
+  testIndices = order.tail(testSize);
+}
+
+/**
+ * Split the indices of the points of a labeled dataset into a training set
+ * and a test set, stratified by label: each class is split with the given
+ * test ratio, so that both sets have the class proportions of the dataset.
+ * As with SplitIndices(), nothing is copied.
+ *
+ * @param inputLabel Labels of the points.
+ * @param trainIndices Vector to store the indices of the training set into.
+ * @param testIndices Vector to store the indices of the test set into.
+ * @param testRatio Percentage of each class to use for test set (between 0
+ *       and 1).
+ * @param shuffleData If true, the points of each class are shuffled before
+ *       they are split, and both sets are shuffled; otherwise, the first
+ *       points of each class go to the training set, and both sets keep the
+ *       order of the dataset. (Default true).
+ */
+template<typename U>
+void StratifiedSplitIndices(const arma::Row<U>& inputLabel,
+                            arma::uvec& trainIndices,
+                            arma::uvec& testIndices,
+                            const double testRatio,
+                            const bool shuffleData = true)
+{
+  // Group the points by label, keeping the order of the dataset in each
+  // group.
+  std::vector<arma::uword> order(inputLabel.n_elem);
+  for (size_t i = 0; i < order.size(); ++i)
+    order[i] = i;
+  std::stable_sort(order.begin(), order.end(),
+      [&inputLabel](const arma::uword a, const arma::uword b)
+      { return inputLabel[a] < inputLabel[b]; });
+
+  std::vector<arma::uword> train, test;
+  size_t begin = 0;
+  while (begin < order.size())
+  {
+    size_t end = begin + 1;
+    while (end < order.size() &&
+        !(inputLabel[order[begin]] < inputLabel[order[end]]))
+      ++end;
+
+    arma::uvec group(order.data() + begin, end - begin);
+    if (shuffleData)
+      group = arma::shuffle(group);
+
+    const size_t testSize = static_cast<size_t>(group.n_elem * testRatio);
+    const size_t trainSize = group.n_elem - testSize;
+    train.insert(train.end(), group.begin(), group.begin() + trainSize);
+    test.insert(test.end(), group.begin() + trainSize, group.end());
+    begin = end;
+  }
+
+  trainIndices = arma::uvec(train);
+  testIndices = arma::uvec(test);
+  if (shuffleData)
+  {
+    trainIndices = arma::shuffle(trainIndices);
+    testIndices = arma::shuffle(testIndices);
+  }
+  else
+  {
+    trainIndices = arma::sort(trainIndices);
+    testIndices = arma::sort(testIndices);
+  }
+}
+
+/**
+ * Given an input dataset and labels, split them into a training set and a
+ * test set in place: the columns are permuted (see PermuteCols()) so that the
+ * training set comes first, followed by the test set, and the number of
+ * training points is returned.  Unlike Split(), this does not copy the
+ * dataset, so it is suited to datasets that take most of the memory.  The
+ * two sets can then be used without copies:
+ *
+ * @code
+ * const size_t trainSize = SplitInPlace(input, label, 0.3, true, true);
+ * arma::mat trainData(input.colptr(0), input.n_rows, trainSize, false, true);
+ * arma::mat testData(input.colptr(trainSize), input.n_rows,
+ *     input.n_cols - trainSize, false, true);
+ * @endcode
+ *
+ * @param input Input dataset to split.
+ * @param inputLabel Input labels to split.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *       sample is visited in linear order. (Default true).
+ * @param stratifyData If true, each class is split with the given ratio (see
+ *       StratifiedSplitIndices()). (Default false).
+ * @return Number of points in the training set.
+ */
+template<typename T, typename U>
+size_t SplitInPlace(arma::Mat<T>& input,
+                    arma::Row<U>& inputLabel,
+                    const double testRatio,
+                    const bool shuffleData = true,
+                    const bool stratifyData = false)
+{
+  arma::uvec trainIndices, testIndices;
+  if (stratifyData)
+  {
+    StratifiedSplitIndices(inputLabel, trainIndices, testIndices, testRatio,
+        shuffleData);
+  }
+  else
+  {
+    SplitIndices(input.n_cols, trainIndices, testIndices, testRatio,
+        shuffleData);
+  }
+
+  const arma::uvec order = arma::join_cols(trainIndices, testIndices);
+  PermuteCols(input, order);
+  PermuteCols(inputLabel, order);
+  return trainIndices.n_elem;
+}
+
+/**
+ * Given an input dataset, split it into a training set and a test set in
+ * place: the columns are permuted so that the training set comes first,
+ * followed by the test set, and the number of training points is returned.
+ *
+ * @param input Input dataset to split.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *       sample is visited in linear order. (Default true).
+ * @return Number of points in the training set.
+ */
+template<typename T>
+size_t SplitInPlace(arma::Mat<T>& input,
+                    const double testRatio,
+                    const bool shuffleData = true)
+{
+  arma::uvec trainIndices, testIndices;
+  SplitIndices(input.n_cols, trainIndices, testIndices, testRatio,
+      shuffleData);
+
+  PermuteCols(input, arma::join_cols(trainIndices, testIndices));
+  return trainIndices.n_elem;
+}
+
 } // namespace data
 } // namespace mlpack
 
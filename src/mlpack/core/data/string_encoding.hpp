@@ -99,6 +99,10 @@ class StringEncoding
    * writes it in the column-major order. If the output type is 2D std::vector
    * then the function writes it in the row major order.
    *
+   * Policies that only depend on token counts (such as bag of words and
+   * tf-idf) encode into arma::sp_mat in parallel, without a dense
+   * intermediate.
+   *
    * @tparam OutputType Type of the output container. The function supports
    *                    the following types: arma::mat, arma::sp_mat,
    *                    std::vector<std::vector<>>.
@@ -169,7 +173,9 @@ class StringEncoding
   void EncodeHelper(const std::vector<std::string>& input,
                     OutputType& output,
                     const TokenizerType& tokenizer,
-                    PolicyType& policy);
+                    PolicyType& policy,
+                    typename std::enable_if<!StringEncodingPolicyTraits<
+                        PolicyType>::dictionaryFreeEncoding>::type* = 0);
 
   /**
    * A helper function to encode the given text and write the result to
@@ -202,6 +208,89 @@ class StringEncoding
                     typename std::enable_if<StringEncodingPolicyTraits<
                         PolicyType>::onePassEncoding>::type* = 0);
 
+  /**
+   * A helper function to encode the given text into a sparse matrix in
+   * parallel. This is an optimized overload for policies whose encoded values
+   * only depend on token counts. The encoder writes data in the column-major
+   * order.
+   *
+   * The strings are split into contiguous shards that are tokenized in
+   * parallel, each into its own dictionary and token counts. The shard
+   * dictionaries are then merged into the dictionary in order, so the labels
+   * are the same as if the strings were encoded one by one, and the sparse
+   * matrix is assembled directly from the counts. The tokenizer must be safe
+   * to call from several threads at once.
+   *
+   * @tparam TokenizerType Type of the tokenizer.
+   * @tparam PolicyType The type of the encoding policy. It has to be
+   *                    equal to EncodingPolicyType.
+   * @tparam ElemType Type of the output values.
+   *
+   * @param input Corpus of text to encode.
+   * @param output Output sparse matrix to store the result.
+   * @param tokenizer The tokenizer object.
+   * @param policy The policy object.
+   */
+  template<typename TokenizerType, typename PolicyType, typename ElemType>
+  void EncodeHelper(const std::vector<std::string>& input,
+                    arma::SpMat<ElemType>& output,
+                    const TokenizerType& tokenizer,
+                    PolicyType& policy,
+                    typename std::enable_if<StringEncodingPolicyTraits<
+                        PolicyType>::countBasedEncoding>::type* = 0);
+
+  /**
+   * A helper function to encode the given text for policies that encode each
+   * token without the dictionary (such as feature hashing). The strings are
+   * encoded in parallel. The encoder writes data in the column-major order or
+   * in the row-major order depending on the output data type, and the
+   * tokenizer must be safe to call from several threads at once.
+   *
+   * @tparam OutputType Type of the output container. The function supports
+   *                    the following types: arma::mat,
+   *                    std::vector<std::vector<>>.
+   * @tparam TokenizerType Type of the tokenizer.
+   * @tparam PolicyType The type of the encoding policy. It has to be
+   *                    equal to EncodingPolicyType.
+   *
+   * @param input Corpus of text to encode.
+   * @param output Output container to store the result.
+   * @param tokenizer The tokenizer object.
+   * @param policy The policy object.
+   */
+  template<typename OutputType, typename TokenizerType, typename PolicyType>
+  void EncodeHelper(const std::vector<std::string>& input,
+                    OutputType& output,
+                    const TokenizerType& tokenizer,
+                    PolicyType& policy,
+                    typename std::enable_if<StringEncodingPolicyTraits<
+                        PolicyType>::dictionaryFreeEncoding>::type* = 0);
+
+  /**
+   * A helper function to encode the given text into a sparse matrix for
+   * policies that encode each token without the dictionary (such as feature
+   * hashing). The strings are encoded in parallel, and the sparse matrix is
+   * assembled directly. The tokenizer must be safe to call from several
+   * threads at once.
+   *
+   * @tparam TokenizerType Type of the tokenizer.
+   * @tparam PolicyType The type of the encoding policy. It has to be
+   *                    equal to EncodingPolicyType.
+   * @tparam ElemType Type of the output values.
+   *
+   * @param input Corpus of text to encode.
+   * @param output Output sparse matrix to store the result.
+   * @param tokenizer The tokenizer object.
+   * @param policy The policy object.
+   */
+  template<typename TokenizerType, typename PolicyType, typename ElemType>
+  void EncodeHelper(const std::vector<std::string>& input,
+                    arma::SpMat<ElemType>& output,
+                    const TokenizerType& tokenizer,
+                    PolicyType& policy,
+                    typename std::enable_if<StringEncodingPolicyTraits<
+                        PolicyType>::dictionaryFreeEncoding>::type* = 0);
+
  private:
   //! The encoding policy object.
   EncodingPolicyType encodingPolicy;
@@ -17,6 +17,10 @@
 #include "string_encoding.hpp"
 #include <type_traits>
 
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace data {
 
@@ -103,7 +107,9 @@ void StringEncoding<EncodingPolicyType, DictionaryType>::
 EncodeHelper(const std::vector<std::string>& input,
              MatType& output,
              const TokenizerType& tokenizer,
-             PolicyType& policy)
+             PolicyType& policy,
+             typename std::enable_if<!StringEncodingPolicyTraits<
+                 PolicyType>::dictionaryFreeEncoding>::type*)
 {
   size_t numColumns = 0;
 
@@ -196,6 +202,321 @@ EncodeHelper(const std::vector<std::string>& input,
   }
 }
 
+template<typename EncodingPolicyType, typename DictionaryType>
+template<typename TokenizerType, typename PolicyType, typename ElemType>
+void StringEncoding<EncodingPolicyType, DictionaryType>::
+EncodeHelper(const std::vector<std::string>& input,
+             arma::SpMat<ElemType>& output,
+             const TokenizerType& tokenizer,
+             PolicyType& policy,
+             typename std::enable_if<StringEncodingPolicyTraits<
+                 PolicyType>::countBasedEncoding>::type*)
+{
+  using TokenType = typename DictionaryType::TokenType;
+
+  policy.Reset();
+
+  // Use a few shards per thread so that the work is balanced.
+  size_t numShards = 1;
+  #ifdef HAS_OPENMP
+    numShards = 4 * omp_get_max_threads();
+  #endif
+  numShards = std::max((size_t) 1, std::min(numShards, input.size()));
+
+  // For each shard, the tokens of its dictionary in the order they were
+  // labeled, and the label and count of each distinct token of each string.
+  // The entries of each string end at entriesEnd, relative to its shard.
+  std::vector<std::vector<TokenType>> shardTokens(numShards);
+  std::vector<std::vector<std::pair<size_t, size_t>>> shardEntries(numShards);
+  std::vector<size_t> entriesEnd(input.size());
+  std::vector<size_t> linesSizes(input.size());
+
+  // The first pass tokenizes each shard into its own dictionary.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t s = 0; s < (omp_size_t) numShards; ++s)
+  {
+    const size_t begin = s * input.size() / numShards;
+    const size_t end = (s + 1) * input.size() / numShards;
+
+    DictionaryType shardDictionary;
+    std::vector<std::pair<size_t, size_t>>& entries = shardEntries[s];
+    // The last string that each label occurred in, and its entry there.
+    std::vector<size_t> lastLine;
+    std::vector<size_t> lastEntry;
+
+    for (size_t i = begin; i < end; ++i)
+    {
+      boost::string_view strView(input[i]);
+      auto token = tokenizer(strView);
+
+      static_assert(
+          std::is_same<typename std::remove_reference<decltype(token)>::type,
+                       typename std::remove_reference<TokenType>::type>::value,
+          "The dictionary token type doesn't match the return value type "
+          "of the tokenizer.");
+
+      size_t numTokens = 0;
+
+      while (!tokenizer.IsTokenEmpty(token))
+      {
+        size_t label;
+        if (shardDictionary.HasToken(token))
+        {
+          label = shardDictionary.Value(token);
+        }
+        else
+        {
+          shardTokens[s].push_back(token);
+          label = shardDictionary.AddToken(std::move(token));
+          lastLine.push_back(end);
+          lastEntry.push_back(0);
+        }
+
+        if (lastLine[label - 1] != i)
+        {
+          lastLine[label - 1] = i;
+          lastEntry[label - 1] = entries.size();
+          entries.emplace_back(label, 0);
+        }
+        entries[lastEntry[label - 1]].second++;
+
+        token = tokenizer(strView);
+        numTokens++;
+      }
+
+      entriesEnd[i] = entries.size();
+      linesSizes[i] = numTokens;
+    }
+  }
+
+  // Merge the shard dictionaries in order, so that the labels are the same as
+  // if the strings had been encoded one by one.
+  std::vector<std::vector<size_t>> labels(numShards);
+  for (size_t s = 0; s < numShards; ++s)
+  {
+    labels[s].resize(shardTokens[s].size());
+    for (size_t j = 0; j < shardTokens[s].size(); ++j)
+    {
+      if (dictionary.HasToken(shardTokens[s][j]))
+        labels[s][j] = dictionary.Value(shardTokens[s][j]);
+      else
+        labels[s][j] = dictionary.AddToken(std::move(shardTokens[s][j]));
+    }
+
+    shardTokens[s].clear();
+  }
+
+  // Relabel the entries, sort the entries of each string by label, and count
+  // the strings that contain each token.
+  std::vector<std::vector<size_t>> shardNumContainingStrings(numShards);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t s = 0; s < (omp_size_t) numShards; ++s)
+  {
+    const size_t begin = s * input.size() / numShards;
+    const size_t end = (s + 1) * input.size() / numShards;
+    std::vector<std::pair<size_t, size_t>>& entries = shardEntries[s];
+
+    shardNumContainingStrings[s].resize(labels[s].size(), 0);
+    for (std::pair<size_t, size_t>& entry : entries)
+    {
+      shardNumContainingStrings[s][entry.first - 1]++;
+      entry.first = labels[s][entry.first - 1];
+    }
+
+    for (size_t i = begin; i < end; ++i)
+    {
+      std::sort(entries.begin() + ((i == begin) ? 0 : entriesEnd[i - 1]),
+          entries.begin() + entriesEnd[i]);
+    }
+  }
+
+  std::vector<size_t> numContainingStrings(dictionary.Size() + 1, 0);
+  std::vector<size_t> shardOffsets(numShards + 1, 0);
+  for (size_t s = 0; s < numShards; ++s)
+  {
+    for (size_t j = 0; j < labels[s].size(); ++j)
+      numContainingStrings[labels[s][j]] += shardNumContainingStrings[s][j];
+
+    shardOffsets[s + 1] = shardOffsets[s] + shardEntries[s].size();
+  }
+
+  // The second pass writes the encoded values straight into the compressed
+  // sparse column form of the output.
+  arma::uvec rowIndices(shardOffsets[numShards]);
+  arma::uvec colPtrs(input.size() + 1);
+  arma::Col<ElemType> values(shardOffsets[numShards]);
+  colPtrs[0] = 0;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t s = 0; s < (omp_size_t) numShards; ++s)
+  {
+    const size_t begin = s * input.size() / numShards;
+    const size_t end = (s + 1) * input.size() / numShards;
+    const std::vector<std::pair<size_t, size_t>>& entries = shardEntries[s];
+
+    size_t j = 0;
+    for (size_t i = begin; i < end; ++i)
+    {
+      for (; j < entriesEnd[i]; ++j)
+      {
+        // The labels are assigned sequentially starting from one.
+        rowIndices[shardOffsets[s] + j] = entries[j].first - 1;
+        values[shardOffsets[s] + j] = policy.template TokenValue<ElemType>(
+            entries[j].second, linesSizes[i], input.size(),
+            numContainingStrings[entries[j].first]);
+      }
+
+      colPtrs[i + 1] = shardOffsets[s] + entriesEnd[i];
+    }
+  }
+
+  output = arma::SpMat<ElemType>(rowIndices, colPtrs, values,
+      dictionary.Size(), input.size());
+}
+
+template<typename EncodingPolicyType, typename DictionaryType>
+template<typename OutputType, typename TokenizerType, typename PolicyType>
+void StringEncoding<EncodingPolicyType, DictionaryType>::
+EncodeHelper(const std::vector<std::string>& input,
+             OutputType& output,
+             const TokenizerType& tokenizer,
+             PolicyType& policy,
+             typename std::enable_if<StringEncodingPolicyTraits<
+                 PolicyType>::dictionaryFreeEncoding>::type*)
+{
+  policy.Reset();
+  policy.InitMatrix(output, input.size(), 0, 0);
+
+  // Each string is written to its own part of the output, so the strings can
+  // be encoded in parallel.
+  #pragma omp parallel for schedule(dynamic, 256)
+  for (omp_size_t i = 0; i < (omp_size_t) input.size(); ++i)
+  {
+    boost::string_view strView(input[i]);
+    auto token = tokenizer(strView);
+    size_t numTokens = 0;
+
+    while (!tokenizer.IsTokenEmpty(token))
+    {
+      policy.Encode(output, policy.Hash(token), i, numTokens);
+      token = tokenizer(strView);
+      numTokens++;
+    }
+  }
+}
+
+template<typename EncodingPolicyType, typename DictionaryType>
+template<typename TokenizerType, typename PolicyType, typename ElemType>
+void StringEncoding<EncodingPolicyType, DictionaryType>::
+EncodeHelper(const std::vector<std::string>& input,
+             arma::SpMat<ElemType>& output,
+             const TokenizerType& tokenizer,
+             PolicyType& policy,
+             typename std::enable_if<StringEncodingPolicyTraits<
+                 PolicyType>::dictionaryFreeEncoding>::type*)
+{
+  policy.Reset();
+
+  // Use a few shards per thread so that the work is balanced.
+  size_t numShards = 1;
+  #ifdef HAS_OPENMP
+    numShards = 4 * omp_get_max_threads();
+  #endif
+  numShards = std::max((size_t) 1, std::min(numShards, input.size()));
+
+  // For each shard, the dimension and value of the nonzero elements of each
+  // string, sorted by dimension.  The entries of each string end at
+  // entriesEnd, relative to its shard.
+  std::vector<std::vector<std::pair<arma::uword, ElemType>>> shardEntries(
+      numShards);
+  std::vector<size_t> entriesEnd(input.size());
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t s = 0; s < (omp_size_t) numShards; ++s)
+  {
+    const size_t begin = s * input.size() / numShards;
+    const size_t end = (s + 1) * input.size() / numShards;
+    std::vector<std::pair<arma::uword, ElemType>>& entries = shardEntries[s];
+
+    for (size_t i = begin; i < end; ++i)
+    {
+      const size_t lineBegin = entries.size();
+      boost::string_view strView(input[i]);
+      auto token = tokenizer(strView);
+
+      while (!tokenizer.IsTokenEmpty(token))
+      {
+        const uint64_t hash = policy.Hash(token);
+        entries.emplace_back(policy.Dimension(hash),
+            policy.template Sign<ElemType>(hash));
+        token = tokenizer(strView);
+      }
+
+      // Sum the values of tokens with the same dimension, and drop the sums
+      // that cancel out.
+      std::sort(entries.begin() + lineBegin, entries.end(),
+          [](const std::pair<arma::uword, ElemType>& a,
+             const std::pair<arma::uword, ElemType>& b)
+          {
+            return a.first < b.first;
+          });
+
+      size_t lineEnd = lineBegin;
+      for (size_t j = lineBegin; j < entries.size(); ++j)
+      {
+        if (lineEnd > lineBegin && entries[lineEnd - 1].first ==
+            entries[j].first)
+        {
+          entries[lineEnd - 1].second += entries[j].second;
+        }
+        else
+        {
+          if (lineEnd > lineBegin && entries[lineEnd - 1].second == 0)
+            --lineEnd;
+          entries[lineEnd++] = entries[j];
+        }
+      }
+      if (lineEnd > lineBegin && entries[lineEnd - 1].second == 0)
+        --lineEnd;
+
+      entries.resize(lineEnd);
+      entriesEnd[i] = lineEnd;
+    }
+  }
+
+  std::vector<size_t> shardOffsets(numShards + 1, 0);
+  for (size_t s = 0; s < numShards; ++s)
+    shardOffsets[s + 1] = shardOffsets[s] + shardEntries[s].size();
+
+  // Assemble the compressed sparse column form of the output.
+  arma::uvec rowIndices(shardOffsets[numShards]);
+  arma::uvec colPtrs(input.size() + 1);
+  arma::Col<ElemType> values(shardOffsets[numShards]);
+  colPtrs[0] = 0;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t s = 0; s < (omp_size_t) numShards; ++s)
+  {
+    const size_t begin = s * input.size() / numShards;
+    const size_t end = (s + 1) * input.size() / numShards;
+    const std::vector<std::pair<arma::uword, ElemType>>& entries =
+        shardEntries[s];
+
+    for (size_t j = 0; j < entries.size(); ++j)
+    {
+      rowIndices[shardOffsets[s] + j] = entries[j].first;
+      values[shardOffsets[s] + j] = entries[j].second;
+    }
+
+    for (size_t i = begin; i < end; ++i)
+      colPtrs[i + 1] = shardOffsets[s] + entriesEnd[i];
+  }
+
+  output = arma::SpMat<ElemType>(rowIndices, colPtrs, values,
+      policy.NumFeatures(), input.size());
+}
+
 template<typename EncodingPolicyType, typename DictionaryType>
 template<typename Archive>
 void StringEncoding<EncodingPolicyType, DictionaryType>::serialize(
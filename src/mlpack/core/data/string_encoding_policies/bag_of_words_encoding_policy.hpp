@@ -134,6 +134,29 @@ class BagOfWordsEncodingPolicy
     output[line][value - 1] += 1;
   }
 
+  /**
+   * Get the encoded value of a token in a string, which is the number of
+   * times the token occurs in the string.  This is used to encode into
+   * sparse matrices.
+   *
+   * @tparam ElemType Type of the output values.
+   *
+   * @param numOccurrences The number of times the token occurs in the string.
+   * @param * (numTokens) The number of tokens in the string (not used).
+   * @param * (numStrings) The number of strings in the input dataset (not
+   *     used).
+   * @param * (numContainingStrings) The number of strings that contain the
+   *     token (not used).
+   */
+  template<typename ElemType>
+  static ElemType TokenValue(const size_t numOccurrences,
+                             const size_t /* numTokens */,
+                             const size_t /* numStrings */,
+                             const size_t /* numContainingStrings */)
+  {
+    return numOccurrences;
+  }
+
   /**
    * The function is not used by the bag of words encoding policy.
    *
@@ -156,6 +179,33 @@ class BagOfWordsEncodingPolicy
   }
 };
 
+/**
+ * The specialization provides some information about the bag of words encoding
+ * policy.
+ */
+template<>
+struct StringEncodingPolicyTraits<BagOfWordsEncodingPolicy>
+{
+  /**
+   * Indicates if the policy is able to encode the token at once without
+   * any information about other tokens as well as the total tokens count.
+   */
+  static const bool onePassEncoding = false;
+
+  /**
+   * Indicates if the encoded value of a token in a string depends only on the
+   * number of times the token occurs in the string, the number of tokens in
+   * the string, and the number of strings that contain the token.
+   */
+  static const bool countBasedEncoding = true;
+
+  /**
+   * Indicates if the policy encodes each token straight from the token itself,
+   * without the dictionary.
+   */
+  static const bool dictionaryFreeEncoding = false;
+};
+
 /**
  * A convenient alias for the StringEncoding class with BagOfWordsEncodingPolicy
  * and the default dictionary for the given token type.
@@ -133,6 +133,19 @@ struct StringEncodingPolicyTraits<DictionaryEncodingPolicy>
    * any information about other tokens as well as the total tokens count.
    */
   static const bool onePassEncoding = true;
+
+  /**
+   * Indicates if the encoded value of a token in a string depends only on the
+   * number of times the token occurs in the string, the number of tokens in
+   * the string, and the number of strings that contain the token.
+   */
+  static const bool countBasedEncoding = false;
+
+  /**
+   * Indicates if the policy encodes each token straight from the token itself,
+   * without the dictionary.
+   */
+  static const bool dictionaryFreeEncoding = false;
 };
 
 /**
@@ -0,0 +1,297 @@
+/**
+ * @file core/data/string_encoding_policies/feature_hashing_encoding_policy.hpp
+ *
+ * Definition of the FeatureHashingEncodingPolicy class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_STR_ENCODING_POLICIES_FEATURE_HASHING_POLICY_HPP
+#define MLPACK_CORE_DATA_STR_ENCODING_POLICIES_FEATURE_HASHING_POLICY_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/boost_backport/boost_backport_string_view.hpp>
+#include <mlpack/core/data/string_encoding_policies/policy_traits.hpp>
+#include <mlpack/core/data/string_encoding.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Definition of the FeatureHashingEncodingPolicy class.
+ *
+ * FeatureHashingEncodingPolicy is used as a helper class for StringEncoding.
+ * It implements the hashing trick: instead of labeling the tokens with a
+ * dictionary, each token is hashed straight to one of a fixed number of
+ * output dimensions, and the i-th coordinate of the output vector of a dataset
+ * item is the number of its tokens that hash to i.  When alternateSign is
+ * true, another bit of the hash decides whether a token adds 1 or -1, so that
+ * collisions cancel out on average instead of piling up.
+ *
+ * The dictionary of the StringEncoding class is not used, so memory use does
+ * not depend on the number of unique tokens, every string can be encoded
+ * independently (and in parallel), and separately encoded batches of a
+ * stream of strings share the same dimensions.  The tokens are hashed with
+ * 64-bit FNV-1a followed by the MurmurHash3 finalizer; this is fast, and the
+ * hash of a token is the same on every platform.
+ */
+class FeatureHashingEncodingPolicy
+{
+ public:
+  /**
+   * Construct the policy with the given number of output dimensions.
+   *
+   * @param numFeatures Number of dimensions that the tokens are hashed to.
+   * @param alternateSign If true, the sign of each token is also taken from
+   *     its hash.
+   */
+  FeatureHashingEncodingPolicy(const size_t numFeatures = 1 << 20,
+                               const bool alternateSign = true) :
+      numFeatures(numFeatures),
+      alternateSign(alternateSign)
+  {
+    if (numFeatures == 0)
+    {
+      throw std::invalid_argument("FeatureHashingEncodingPolicy: the number "
+          "of features must be positive");
+    }
+  }
+
+  /**
+   * Clear the necessary internal variables.
+   */
+  static void Reset()
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * Hash the given token.
+   *
+   * @param token The token to hash.
+   */
+  static uint64_t Hash(const boost::string_view token)
+  {
+    return Hash(token.data(), token.size());
+  }
+
+  /**
+   * Hash the given token, which is a single character (as returned by
+   * CharExtract).
+   *
+   * @param token The token to hash.
+   */
+  static uint64_t Hash(const int token)
+  {
+    const char c = (char) token;
+    return Hash(&c, 1);
+  }
+
+  //! Get the output dimension of a token with the given hash.
+  size_t Dimension(const uint64_t hash) const
+  {
+    return (size_t) (hash % numFeatures);
+  }
+
+  //! Get the value that a token with the given hash adds to its dimension.
+  template<typename ElemType>
+  ElemType Sign(const uint64_t hash) const
+  {
+    // The low bits choose the dimension, so use the top bit for the sign.
+    return (alternateSign && (hash >> 63)) ? ElemType(-1) : ElemType(1);
+  }
+
+  /**
+   * The function initializes the output matrix. The encoder writes data
+   * in the column-major order.
+   *
+   * @tparam MatType The output matrix type.
+   *
+   * @param output Output matrix to store the encoded results (sp_mat or mat).
+   * @param datasetSize The number of strings in the input dataset.
+   * @param * (maxNumTokens) The maximum number of tokens in the strings of the
+   *                     input dataset (not used).
+   * @param * (dictionarySize) The size of the dictionary (not used).
+   */
+  template<typename MatType>
+  void InitMatrix(MatType& output,
+                  const size_t datasetSize,
+                  const size_t /* maxNumTokens */,
+                  const size_t /* dictionarySize */) const
+  {
+    output.zeros(numFeatures, datasetSize);
+  }
+
+  /**
+   * The function initializes the output matrix. The encoder writes data
+   * in the row-major order.
+   *
+   * Overloaded function to save the result in vector<vector<ElemType>>.
+   *
+   * @tparam ElemType Type of the output values.
+   *
+   * @param output Output matrix to store the encoded results.
+   * @param datasetSize The number of strings in the input dataset.
+   * @param * (maxNumTokens) The maximum number of tokens in the strings of the
+   *                     input dataset (not used).
+   * @param * (dictionarySize) The size of the dictionary (not used).
+   */
+  template<typename ElemType>
+  void InitMatrix(std::vector<std::vector<ElemType>>& output,
+                  const size_t datasetSize,
+                  const size_t /* maxNumTokens */,
+                  const size_t /* dictionarySize */) const
+  {
+    output.clear();
+    output.resize(datasetSize, std::vector<ElemType>(numFeatures));
+  }
+
+  /**
+   * The function performs the feature hashing encoding algorithm i.e. it adds
+   * the hashed token to the output. The encoder writes data in the
+   * column-major order.
+   *
+   * @tparam MatType The output matrix type.
+   *
+   * @param output Output matrix to store the encoded results.
+   * @param hash The hash of the token.
+   * @param line The line number at which the encoding is performed.
+   * @param * (index) The token index in the line.
+   */
+  template<typename MatType>
+  void Encode(MatType& output,
+              const uint64_t hash,
+              const size_t line,
+              const size_t /* index */) const
+  {
+    output(Dimension(hash), line) +=
+        Sign<typename MatType::elem_type>(hash);
+  }
+
+  /**
+   * The function performs the feature hashing encoding algorithm i.e. it adds
+   * the hashed token to the output. The encoder writes data in the
+   * row-major order.
+   *
+   * Overloaded function to accept vector<vector<ElemType>> as the output
+   * type.
+   *
+   * @tparam ElemType Type of the output values.
+   *
+   * @param output Output matrix to store the encoded results.
+   * @param hash The hash of the token.
+   * @param line The line number at which the encoding is performed.
+   * @param * (index) The token index in the line.
+   */
+  template<typename ElemType>
+  void Encode(std::vector<std::vector<ElemType>>& output,
+              const uint64_t hash,
+              const size_t line,
+              const size_t /* index */) const
+  {
+    output[line][Dimension(hash)] += Sign<ElemType>(hash);
+  }
+
+  /**
+   * The function is not used by the feature hashing encoding policy.
+   *
+   * @param * (line) The line number at which the encoding is performed.
+   * @param * (index) The token sequence number in the line.
+   * @param * (value) The encoded token.
+   */
+  static void PreprocessToken(const size_t /* line */,
+                              const size_t /* index */,
+                              const size_t /* value */)
+  { }
+
+  //! Get the number of output dimensions.
+  size_t NumFeatures() const { return numFeatures; }
+  //! Modify the number of output dimensions.
+  size_t& NumFeatures() { return numFeatures; }
+
+  //! Get whether the sign of each token is taken from its hash.
+  bool AlternateSign() const { return alternateSign; }
+  //! Modify whether the sign of each token is taken from its hash.
+  bool& AlternateSign() { return alternateSign; }
+
+  /**
+   * Serialize the class to the given archive.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */)
+  {
+    ar & BOOST_SERIALIZATION_NVP(numFeatures);
+    ar & BOOST_SERIALIZATION_NVP(alternateSign);
+  }
+
+ private:
+  //! Hash the given bytes with FNV-1a, and mix the bits of the result.
+  static uint64_t Hash(const char* data, const size_t length)
+  {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; ++i)
+    {
+      hash ^= (uint8_t) data[i];
+      hash *= 1099511628211ULL;
+    }
+
+    // FNV-1a mixes the last bytes poorly into the high bits, so apply the
+    // MurmurHash3 finalizer.
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+
+    return hash;
+  }
+
+  //! The number of output dimensions.
+  size_t numFeatures;
+  //! Whether the sign of each token is taken from its hash.
+  bool alternateSign;
+};
+
+/**
+ * The specialization provides some information about the feature hashing
+ * encoding policy.
+ */
+template<>
+struct StringEncodingPolicyTraits<FeatureHashingEncodingPolicy>
+{
+  /**
+   * Indicates if the policy is able to encode the token at once without
+   * any information about other tokens as well as the total tokens count.
+   */
+  static const bool onePassEncoding = false;
+
+  /**
+   * Indicates if the encoded value of a token in a string depends only on the
+   * number of times the token occurs in the string, the number of tokens in
+   * the string, and the number of strings that contain the token.
+   */
+  static const bool countBasedEncoding = false;
+
+  /**
+   * Indicates if the policy encodes each token straight from the token itself,
+   * without the dictionary.
+   */
+  static const bool dictionaryFreeEncoding = true;
+};
+
+/**
+ * A convenient alias for the StringEncoding class with
+ * FeatureHashingEncodingPolicy.  The dictionary is never filled.
+ *
+ * @tparam TokenType Type of the tokens.
+ */
+template<typename TokenType>
+using FeatureHashingEncoding = StringEncoding<FeatureHashingEncodingPolicy,
+    StringEncodingDictionary<TokenType>>;
+
+} // namespace data
+} // namespace mlpack
+
+#endif
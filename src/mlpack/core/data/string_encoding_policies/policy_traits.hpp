@@ -31,6 +31,22 @@ struct StringEncodingPolicyTraits
    * any information about other tokens as well as the total tokens count.
    */
   static const bool onePassEncoding = false;
+
+  /**
+   * Indicates if the encoded value of a token in a string depends only on the
+   * number of times the token occurs in the string, the number of tokens in
+   * the string, and the number of strings that contain the token.  Such
+   * policies provide a TokenValue() function and can be encoded straight into
+   * a sparse matrix in parallel.
+   */
+  static const bool countBasedEncoding = false;
+
+  /**
+   * Indicates if the policy encodes each token straight from the token itself,
+   * without the dictionary.  Such policies provide a Hash() function, and the
+   * strings are encoded in parallel.
+   */
+  static const bool dictionaryFreeEncoding = false;
 };
 
 } // namespace data
@@ -191,6 +191,27 @@ class TfIdfEncodingPolicy
     output[line][value - 1] =  tf * idf;
   }
 
+  /**
+   * Get the tf-idf value of a token in a string from the statistics of the
+   * token.  This is used to encode into sparse matrices.
+   *
+   * @tparam ElemType Type of the output values.
+   *
+   * @param numOccurrences The number of times the token occurs in the string.
+   * @param numTokens The number of tokens in the string.
+   * @param numStrings The number of strings in the input dataset.
+   * @param numContainingStrings The number of strings that contain the token.
+   */
+  template<typename ElemType>
+  ElemType TokenValue(const size_t numOccurrences,
+                      const size_t numTokens,
+                      const size_t numStrings,
+                      const size_t numContainingStrings) const
+  {
+    return TermFrequency<ElemType>(numOccurrences, numTokens) *
+        InverseDocumentFrequency<ElemType>(numStrings, numContainingStrings);
+  }
+
   /*
    * The function calculates the necessary statistics for the purpose
    * of the tf-idf algorithm during the first pass through the dataset.
@@ -275,7 +296,7 @@ class TfIdfEncodingPolicy
    */
   template<typename ValueType>
   ValueType TermFrequency(const size_t numOccurrences,
-                          const size_t numTokens)
+                          const size_t numTokens) const
   {
     switch (tfType)
     {
@@ -304,7 +325,7 @@ class TfIdfEncodingPolicy
    */
   template<typename ValueType>
   ValueType InverseDocumentFrequency(const size_t totalNumLines,
-                                     const size_t numOccurrences)
+                                     const size_t numOccurrences) const
   {
     if (smoothIdf)
     {
@@ -334,6 +355,33 @@ class TfIdfEncodingPolicy
   bool smoothIdf;
 };
 
+/**
+ * The specialization provides some information about the tf-idf encoding
+ * policy.
+ */
+template<>
+struct StringEncodingPolicyTraits<TfIdfEncodingPolicy>
+{
+  /**
+   * Indicates if the policy is able to encode the token at once without
+   * any information about other tokens as well as the total tokens count.
+   */
+  static const bool onePassEncoding = false;
+
+  /**
+   * Indicates if the encoded value of a token in a string depends only on the
+   * number of times the token occurs in the string, the number of tokens in
+   * the string, and the number of strings that contain the token.
+   */
+  static const bool countBasedEncoding = true;
+
+  /**
+   * Indicates if the policy encodes each token straight from the token itself,
+   * without the dictionary.
+   */
+  static const bool dictionaryFreeEncoding = false;
+};
+
 /**
  * A convenient alias for the StringEncoding class with TfIdfEncodingPolicy
  * and the default dictionary for the given token type.
@@ -73,6 +73,31 @@ class CVFunction
    */
   double Evaluate(const arma::mat& parameters);
 
+  /**
+   * Run cross-validation with the bound and passed parameters, and store the
+   * trained model in the given pointer.  The best model is not updated, so
+   * this may be called by several threads at once.
+   *
+   * @param parameters Arguments (rather than the bound arguments) that should
+   *     be passed into the Evaluate method of the CVType object.
+   * @param model Pointer to store the trained model in.
+   */
+  double Evaluate(const arma::mat& parameters,
+                  std::unique_ptr<MLAlgorithm>& model);
+
+  /**
+   * Run cross-validation with the bound and passed parameters, training on
+   * only the given fraction of the training data.  The best model is not
+   * updated, since the objectives for different fractions can not be
+   * compared.  If the CVType object does not provide an EvaluateSubsample
+   * method, all the training data is used.
+   *
+   * @param parameters Arguments (rather than the bound arguments) that should
+   *     be passed into the Evaluate method of the CVType object.
+   * @param fraction Fraction of the training data to train on, in (0, 1].
+   */
+  double EvaluateSubsample(const arma::mat& parameters, const double fraction);
+
   /**
    * Evaluate numerically the gradient of the CVFunction with the given
    * parameters.
@@ -133,7 +158,10 @@ class CVFunction
            typename... Args,
            typename = typename
                std::enable_if<(BoundArgIndex + ParamIndex < TotalArgs)>::type>
-  inline double Evaluate(const arma::mat& parameters, const Args&... args);
+  inline double Evaluate(const arma::mat& parameters,
+                         const double fraction,
+                         std::unique_ptr<MLAlgorithm>& model,
+                         const Args&... args);
 
   /**
    * Run cross-validation with the collected arguments.
@@ -144,7 +172,10 @@ class CVFunction
            typename = typename
                std::enable_if<BoundArgIndex + ParamIndex == TotalArgs>::type,
            typename = void>
-  inline double Evaluate(const arma::mat& parameters, const Args&... args);
+  inline double Evaluate(const arma::mat& parameters,
+                         const double fraction,
+                         std::unique_ptr<MLAlgorithm>& model,
+                         const Args&... args);
 
   /**
    * Put the bound argument (at the BoundArgIndex position) as the next one.
@@ -154,7 +185,10 @@ class CVFunction
            typename... Args,
            typename = typename std::enable_if<
                UseBoundArg<BoundArgIndex, ParamIndex>::value>::type>
-  inline double PutNextArg(const arma::mat& parameters, const Args&... args);
+  inline double PutNextArg(const arma::mat& parameters,
+                           const double fraction,
+                           std::unique_ptr<MLAlgorithm>& model,
+                           const Args&... args);
 
   /**
    * Put the element (at the ParamIndex position) of the parameters as the next
@@ -166,7 +200,55 @@ class CVFunction
            typename = typename std::enable_if<
                !UseBoundArg<BoundArgIndex, ParamIndex>::value>::type,
            typename = void>
-  inline double PutNextArg(const arma::mat& parameters, const Args&... args);
+  inline double PutNextArg(const arma::mat& parameters,
+                           const double fraction,
+                           std::unique_ptr<MLAlgorithm>& model,
+                           const Args&... args);
+
+  /**
+   * Run cross-validation with the EvaluateSubsample method of the CVType
+   * object, which trains on the given fraction of the training data and
+   * stores the trained model in the given pointer.
+   */
+  template<typename... Args>
+  inline auto RunCV(int /* preferred */,
+                    const double fraction,
+                    std::unique_ptr<MLAlgorithm>& model,
+                    const Args&... args)
+      -> decltype(std::declval<CVType&>().EvaluateSubsample(model, fraction,
+          args...));
+
+  /**
+   * Run cross-validation when the CVType object does not provide an
+   * EvaluateSubsample method.  The model is then trained on all the training
+   * data.
+   */
+  template<typename... Args>
+  inline double RunCV(long /* fallback */,
+                      const double fraction,
+                      std::unique_ptr<MLAlgorithm>& model,
+                      const Args&... args);
+
+  /**
+   * Run cross-validation on all the training data with the Evaluate method of
+   * the CVType object that stores the trained model in the given pointer.
+   */
+  template<typename... Args>
+  inline auto RunFullCV(int /* preferred */,
+                        std::unique_ptr<MLAlgorithm>& model,
+                        const Args&... args)
+      -> decltype(std::declval<CVType&>().Evaluate(model, args...));
+
+  /**
+   * Run cross-validation on all the training data when the CVType object does
+   * not provide an Evaluate method that takes the model pointer.  The model is
+   * then taken from the CVType object, so only one thread may run
+   * cross-validation at once.
+   */
+  template<typename... Args>
+  inline double RunFullCV(long /* fallback */,
+                          std::unique_ptr<MLAlgorithm>& model,
+                          const Args&... args);
 };
 
 
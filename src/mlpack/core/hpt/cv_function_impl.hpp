@@ -12,6 +12,8 @@
 #ifndef MLPACK_CORE_HPT_CV_FUNCTION_IMPL_HPP
 #define MLPACK_CORE_HPT_CV_FUNCTION_IMPL_HPP
 
+#include <exception>
+
 namespace mlpack {
 namespace hpt {
 
@@ -65,7 +67,41 @@ template<typename CVType,
 double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::Evaluate(
     const arma::mat& parameters)
 {
-  return Evaluate<0, 0>(parameters);
+  std::unique_ptr<MLAlgorithm> model;
+  const double objective = Evaluate(parameters, model);
+
+  // Change the best model if we have got a better score, or if we probably
+  // have not assigned any valid (trained) model yet.
+  if (bestObjective > objective ||
+      bestObjective == std::numeric_limits<double>::max())
+  {
+    bestObjective = objective;
+    bestModel = std::move(*model);
+  }
+
+  return objective;
+}
+
+template<typename CVType,
+         typename MLAlgorithm,
+         size_t TotalArgs,
+         typename... BoundArgs>
+double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::Evaluate(
+    const arma::mat& parameters,
+    std::unique_ptr<MLAlgorithm>& model)
+{
+  return Evaluate<0, 0>(parameters, 1.0, model);
+}
+
+template<typename CVType,
+         typename MLAlgorithm,
+         size_t TotalArgs,
+         typename... BoundArgs>
+double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::
+    EvaluateSubsample(const arma::mat& parameters, const double fraction)
+{
+  std::unique_ptr<MLAlgorithm> model;
+  return Evaluate<0, 0>(parameters, fraction, model);
 }
 
 template<typename CVType,
@@ -99,9 +135,12 @@ template<size_t BoundArgIndex,
          typename>
 double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::Evaluate(
     const arma::mat& parameters,
+    const double fraction,
+    std::unique_ptr<MLAlgorithm>& model,
     const Args&... args)
 {
-  return PutNextArg<BoundArgIndex, ParamIndex>(parameters, args...);
+  return PutNextArg<BoundArgIndex, ParamIndex>(parameters, fraction, model,
+      args...);
 }
 
 template<typename CVType,
@@ -115,19 +154,87 @@ template<size_t BoundArgIndex,
          typename>
 double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::Evaluate(
     const arma::mat& /* parameters */,
+    const double fraction,
+    std::unique_ptr<MLAlgorithm>& model,
     const Args&... args)
 {
-  double objective = cv.Evaluate(args...);
+  return RunCV(0, fraction, model, args...);
+}
 
-  // Change the best model if we have got a better score, or if we probably
-  // have not assigned any valid (trained) model yet.
-  if (bestObjective > objective ||
-      bestObjective == std::numeric_limits<double>::max())
+template<typename CVType,
+         typename MLAlgorithm,
+         size_t TotalArgs,
+         typename... BoundArgs>
+template<typename... Args>
+auto CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::RunCV(
+    int /* preferred */,
+    const double fraction,
+    std::unique_ptr<MLAlgorithm>& model,
+    const Args&... args)
+    -> decltype(std::declval<CVType&>().EvaluateSubsample(model, fraction,
+        args...))
+{
+  return cv.EvaluateSubsample(model, fraction, args...);
+}
+
+template<typename CVType,
+         typename MLAlgorithm,
+         size_t TotalArgs,
+         typename... BoundArgs>
+template<typename... Args>
+double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::RunCV(
+    long /* fallback */,
+    const double /* fraction */,
+    std::unique_ptr<MLAlgorithm>& model,
+    const Args&... args)
+{
+  return RunFullCV(0, model, args...);
+}
+
+template<typename CVType,
+         typename MLAlgorithm,
+         size_t TotalArgs,
+         typename... BoundArgs>
+template<typename... Args>
+auto CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::RunFullCV(
+    int /* preferred */,
+    std::unique_ptr<MLAlgorithm>& model,
+    const Args&... args)
+    -> decltype(std::declval<CVType&>().Evaluate(model, args...))
+{
+  return cv.Evaluate(model, args...);
+}
+
+template<typename CVType,
+         typename MLAlgorithm,
+         size_t TotalArgs,
+         typename... BoundArgs>
+template<typename... Args>
+double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::RunFullCV(
+    long /* fallback */,
+    std::unique_ptr<MLAlgorithm>& model,
+    const Args&... args)
+{
+  // Exceptions can't leave a critical section, so they are thrown again after
+  // it.
+  double objective = 0.0;
+  std::exception_ptr exception;
+  #pragma omp critical(CVFunctionRunCV)
   {
-    bestObjective = objective;
-    bestModel = std::move(cv.Model());
+    try
+    {
+      objective = cv.Evaluate(args...);
+      model.reset(new MLAlgorithm(std::move(cv.Model())));
+    }
+    catch (...)
+    {
+      exception = std::current_exception();
+    }
   }
 
+  if (exception)
+    std::rethrow_exception(exception);
+
   return objective;
 }
 
@@ -141,10 +248,13 @@ template<size_t BoundArgIndex,
          typename>
 double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::PutNextArg(
     const arma::mat& parameters,
+    const double fraction,
+    std::unique_ptr<MLAlgorithm>& model,
     const Args&... args)
 {
   return Evaluate<BoundArgIndex + 1, ParamIndex>(
-      parameters, args..., std::get<BoundArgIndex>(boundArgs).value);
+      parameters, fraction, model, args...,
+      std::get<BoundArgIndex>(boundArgs).value);
 }
 
 template<typename CVType,
@@ -158,17 +268,20 @@ template<size_t BoundArgIndex,
          typename>
 double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::PutNextArg(
     const arma::mat& parameters,
+    const double fraction,
+    std::unique_ptr<MLAlgorithm>& model,
     const Args&... args)
 {
   if (datasetInfo.Type(ParamIndex) == data::Datatype::categorical)
   {
-    return Evaluate<BoundArgIndex, ParamIndex + 1>(parameters, args...,
+    return Evaluate<BoundArgIndex, ParamIndex + 1>(parameters, fraction,
+        model, args...,
         datasetInfo.UnmapString(size_t(parameters(ParamIndex, 0)), ParamIndex));
   }
   else
   {
-    return Evaluate<BoundArgIndex, ParamIndex + 1>(parameters, args...,
-        parameters(ParamIndex, 0));
+    return Evaluate<BoundArgIndex, ParamIndex + 1>(parameters, fraction,
+        model, args..., parameters(ParamIndex, 0));
   }
 }
 
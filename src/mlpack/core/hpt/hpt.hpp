@@ -14,6 +14,7 @@
 
 #include <mlpack/core/cv/meta_info_extractor.hpp>
 #include <mlpack/core/hpt/deduce_hp_types.hpp>
+#include <mlpack/core/hpt/successive_halving.hpp>
 #include <ensmallen.hpp>
 
 namespace mlpack {
@@ -67,12 +68,17 @@ namespace hpt {
  *     Fixed(useCholesky), lambda1Set, lambda2Set);
  * @endcode
  *
+ * When GridSearch is used and OpenMP is enabled, the sets of hyper-parameters
+ * are assessed in parallel.  Each set assessed at once trains its own models,
+ * so the number of sets assessed at once can be limited with MaxThreads() to
+ * save memory.  The result is the same as with the serial search.
+ *
  * @tparam MLAlgorithm A machine learning algorithm.
  * @tparam Metric A metric to assess the quality of a trained model.
  * @tparam CV A cross-validation strategy used to assess a set of
  *     hyper-parameters.
- * @tparam OptimizerType An optimization strategy (GridSearch and
- *     GradientDescent are supported).
+ * @tparam OptimizerType An optimization strategy (GridSearch,
+ *     SuccessiveHalving and GradientDescent are supported).
  * @tparam MatType The type of data.
  * @tparam PredictionsType The type of predictions (should be passed when the
  *     predictions type is a template parameter in Train methods of the given
@@ -151,13 +157,30 @@ class HyperParameterTuner
    */
   double& MinDelta() { return minDelta; }
 
+  /**
+   * Get the maximum number of sets of hyper-parameters assessed at once by
+   * GridSearch.  0 means as many as there are OpenMP threads.
+   *
+   * The default value is 0.
+   */
+  size_t MaxThreads() const { return maxThreads; }
+
+  /**
+   * Modify the maximum number of sets of hyper-parameters assessed at once by
+   * GridSearch.  0 means as many as there are OpenMP threads.
+   *
+   * The default value is 0.
+   */
+  size_t& MaxThreads() { return maxThreads; }
+
   /**
    * Find the best hyper-parameters by using the given Optimizer. For each
    * hyper-parameter one of the following should be passed as an argument.
-   * 1. A set of values to choose from (when using GridSearch as an optimizer).
+   * 1. A set of values to choose from (when using GridSearch or
+   *   SuccessiveHalving as an optimizer).
    *   The set of values should be an STL-compatible container (it should
    *   provide begin() and end() methods returning iterators).
-   * 2. A starting value (when using any other optimizer than GridSearch).
+   * 2. A starting value (when using any other optimizer).
    * 3. A value fixed by using the function mlpack::hpt::Fixed. In this case the
    *   hyper-parameter will not be optimized.
    *
@@ -230,6 +253,9 @@ class HyperParameterTuner
    */
   double minDelta;
 
+  //! The maximum number of sets of hyper-parameters assessed at once.
+  size_t maxThreads;
+
   /**
    * A type function to check whether the element I of the tuple type is a
    * PreFixedArg.
@@ -324,6 +350,51 @@ class HyperParameterTuner
       data::DatasetMapper<data::IncrementPolicy, double>& datasetInfo,
       FixedArgs... fixedArgs);
 
+  /**
+   * Run the optimizer on the given CV function, and store the best model in
+   * bestModel.  This overload is used for every optimizer but GridSearch.
+   *
+   * @param cvFunction Function to optimize.
+   * @param bestParams Starting point; set to the best set of hyper-parameters.
+   * @param categoricalDimensions Whether each dimension is categorical.
+   * @param numCategories Number of values of each dimension.
+   * @return The objective of the best set of hyper-parameters.
+   */
+  template<typename CVFunctionType>
+  double RunOptimizer(CVFunctionType& cvFunction,
+                      arma::mat& bestParams,
+                      const std::vector<bool>& categoricalDimensions,
+                      const arma::Row<size_t>& numCategories,
+                      std::false_type /* isGridSearch */);
+
+  /**
+   * Run GridSearch on the given CV function by searching the grid in
+   * parallel with GridSearch(), and store the best model in bestModel.
+   */
+  template<typename CVFunctionType>
+  double RunOptimizer(CVFunctionType& cvFunction,
+                      arma::mat& bestParams,
+                      const std::vector<bool>& categoricalDimensions,
+                      const arma::Row<size_t>& numCategories,
+                      std::true_type /* isGridSearch */);
+
+  /**
+   * Assess every set of hyper-parameters on the grid given by numCategories
+   * in parallel, in the same way as ens::GridSearch, and store the best model
+   * in bestModel.  All the dimensions should be categorical.
+   *
+   * @param cvFunction Function to assess the sets of hyper-parameters with.
+   * @param bestParams Set to the best set of hyper-parameters.
+   * @param categoricalDimensions Whether each dimension is categorical.
+   * @param numCategories Number of values of each dimension.
+   * @return The objective of the best set of hyper-parameters.
+   */
+  template<typename CVFunctionType>
+  double GridSearch(CVFunctionType& cvFunction,
+                    arma::mat& bestParams,
+                    const std::vector<bool>& categoricalDimensions,
+                    const arma::Row<size_t>& numCategories);
+
   /**
    * Gather all elements of vector in an argument list and use them to create a
    * tuple.
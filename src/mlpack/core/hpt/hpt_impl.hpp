@@ -14,6 +14,12 @@
 
 #include <mlpack/core.hpp>
 
+#include <exception>
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace hpt {
 
@@ -32,7 +38,7 @@ HyperParameterTuner<MLAlgorithm,
                     MatType,
                     PredictionsType,
                     WeightsType>::HyperParameterTuner(const CVArgs&... args) :
-    cv(args...), relativeDelta(0.01), minDelta(1e-10) {}
+    cv(args...), relativeDelta(0.01), minDelta(1e-10), maxThreads(0) {}
 
 template<typename MLAlgorithm,
          typename Metric,
@@ -104,11 +110,154 @@ void HyperParameterTuner<MLAlgorithm,
 
   CVFunction<CVType, MLAlgorithm, totalArgs, FixedArgs...>
       cvFunction(cv, datasetInfo, relativeDelta, minDelta, fixedArgs...);
-  bestObjective = Metric::NeedsMinimization ? optimizer.Optimize(cvFunction,
-      bestParams, categoricalDimensions, numCategories) :
-      -optimizer.Optimize(cvFunction, bestParams, categoricalDimensions,
+
+  const double objective = RunOptimizer(cvFunction, bestParams,
+      categoricalDimensions, numCategories,
+      typename std::is_same<Optimizer, ens::GridSearch>::type());
+  bestObjective = Metric::NeedsMinimization ? objective : -objective;
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         template<typename, typename, typename, typename, typename> class CV,
+         typename Optimizer,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename CVFunctionType>
+double HyperParameterTuner<MLAlgorithm,
+                           Metric,
+                           CV,
+                           Optimizer,
+                           MatType,
+                           PredictionsType,
+                           WeightsType>::RunOptimizer(
+    CVFunctionType& cvFunction,
+    arma::mat& bestParams,
+    const std::vector<bool>& categoricalDimensions,
+    const arma::Row<size_t>& numCategories,
+    std::false_type /* isGridSearch */)
+{
+  const double objective = optimizer.Optimize(cvFunction, bestParams,
+      categoricalDimensions, numCategories);
+  bestModel = std::move(cvFunction.BestModel());
+  return objective;
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         template<typename, typename, typename, typename, typename> class CV,
+         typename Optimizer,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename CVFunctionType>
+double HyperParameterTuner<MLAlgorithm,
+                           Metric,
+                           CV,
+                           Optimizer,
+                           MatType,
+                           PredictionsType,
+                           WeightsType>::RunOptimizer(
+    CVFunctionType& cvFunction,
+    arma::mat& bestParams,
+    const std::vector<bool>& categoricalDimensions,
+    const arma::Row<size_t>& numCategories,
+    std::true_type /* isGridSearch */)
+{
+  // The grid can be searched in parallel, since the sets of hyper-parameters
+  // do not depend on each other.
+  return GridSearch(cvFunction, bestParams, categoricalDimensions,
       numCategories);
-      bestModel = std::move(cvFunction.BestModel());
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         template<typename, typename, typename, typename, typename> class CV,
+         typename Optimizer,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename CVFunctionType>
+double HyperParameterTuner<MLAlgorithm,
+                           Metric,
+                           CV,
+                           Optimizer,
+                           MatType,
+                           PredictionsType,
+                           WeightsType>::GridSearch(
+    CVFunctionType& cvFunction,
+    arma::mat& bestParams,
+    const std::vector<bool>& categoricalDimensions,
+    const arma::Row<size_t>& numCategories)
+{
+  size_t numPoints = 1;
+  for (size_t d = 0; d < categoricalDimensions.size(); ++d)
+  {
+    if (!categoricalDimensions[d])
+    {
+      std::ostringstream oss;
+      oss << "HyperParameterTuner::Optimize(): GridSearch can only be used "
+          << "with sets of values, but the hyper-parameter " << d + 1
+          << " is given a starting value" << std::endl;
+      throw std::invalid_argument(oss.str());
+    }
+    numPoints *= numCategories[d];
+  }
+
+  #ifdef HAS_OPENMP
+    const int numThreads = (maxThreads == 0) ? omp_get_max_threads() :
+        (int) std::min(maxThreads, (size_t) omp_get_max_threads());
+  #else
+    const int numThreads = 1;
+  #endif
+
+  // The best set is the one with the smallest objective and, among those, the
+  // first one on the grid, as with ens::GridSearch.
+  double gridObjective = std::numeric_limits<double>::max();
+  size_t bestIndex = numPoints;
+  std::exception_ptr exception;
+  #pragma omp parallel for schedule(dynamic) num_threads(numThreads)
+  for (omp_size_t i = 0; i < (omp_size_t) numPoints; ++i)
+  {
+    try
+    {
+      // The last dimension changes fastest, as in ens::GridSearch.
+      arma::mat parameters(numCategories.n_elem, 1);
+      size_t index = i;
+      for (size_t d = numCategories.n_elem; d > 0; --d)
+      {
+        parameters(d - 1) = index % numCategories[d - 1];
+        index /= numCategories[d - 1];
+      }
+
+      std::unique_ptr<MLAlgorithm> model;
+      const double objective = cvFunction.Evaluate(parameters, model);
+
+      #pragma omp critical(HyperParameterTunerBest)
+      {
+        if (objective < gridObjective ||
+            (objective == gridObjective && (size_t) i < bestIndex))
+        {
+          gridObjective = objective;
+          bestIndex = i;
+          bestParams = parameters;
+          bestModel = std::move(*model);
+        }
+      }
+    }
+    catch (...)
+    {
+      #pragma omp critical(HyperParameterTunerException)
+      if (!exception)
+        exception = std::current_exception();
+    }
+  }
+
+  if (exception)
+    std::rethrow_exception(exception);
+
+  return gridObjective;
 }
 
 template<typename MLAlgorithm,
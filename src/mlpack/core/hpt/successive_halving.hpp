@@ -0,0 +1,160 @@
+/**
+ * @file core/hpt/successive_halving.hpp
+ *
+ * Successive halving and Hyperband for hyper-parameter tuning.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_HPT_SUCCESSIVE_HALVING_HPP
+#define MLPACK_CORE_HPT_SUCCESSIVE_HALVING_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+namespace hpt {
+
+/**
+ * SuccessiveHalving is an optimizer for HyperParameterTuner that searches the
+ * same grid of hyper-parameters as GridSearch, but assesses most sets of
+ * hyper-parameters with models trained on small fractions of the training
+ * data:
+ *
+ * @code
+ * @inproceedings{jamieson2016non,
+ *   title={Non-stochastic best arm identification and hyperparameter
+ *       optimization},
+ *   author={Jamieson, K. and Talwalkar, A.},
+ *   booktitle={Proceedings of the 19th International Conference on Artificial
+ *       Intelligence and Statistics (AISTATS 2016)},
+ *   pages={240--248},
+ *   year={2016}
+ * }
+ * @endcode
+ *
+ * All the sets are first assessed with the smallest fraction of the training
+ * data.  Then only the best 1 / eta of them are assessed again with eta times
+ * as much data, and so on, until the remaining sets are assessed with all the
+ * training data.  The best of those is returned.
+ *
+ * If Hyperband is enabled, successive halving is run several times, from
+ * many sets of hyper-parameters sampled at random from the grid and the
+ * smallest fraction to a few sets and all the training data, so that the
+ * search does not depend as much on the choice of the smallest fraction:
+ *
+ * @code
+ * @article{li2017hyperband,
+ *   title={Hyperband: A novel bandit-based approach to hyperparameter
+ *       optimization},
+ *   author={Li, L. and Jamieson, K. and DeSalvo, G. and Rostamizadeh, A. and
+ *       Talwalkar, A.},
+ *   journal={Journal of Machine Learning Research},
+ *   volume={18},
+ *   number={1},
+ *   pages={6765--6816},
+ *   year={2017}
+ * }
+ * @endcode
+ *
+ * As with GridSearch, a set of values should be passed to
+ * HyperParameterTuner::Optimize() for each hyper-parameter that is not fixed.
+ * The objective function should provide the following methods (CVFunction
+ * does), where the objective is trained on the given fraction of the training
+ * data:
+ *
+ * @code
+ * double Evaluate(const arma::mat& parameters);
+ * double EvaluateSubsample(const arma::mat& parameters, const double fraction);
+ * @endcode
+ *
+ * SimpleCV and KFoldCV train on the first points of each training set, so the
+ * data should be shuffled if its order is not random.
+ */
+class SuccessiveHalving
+{
+ public:
+  /**
+   * Create the SuccessiveHalving object with the given parameters.
+   *
+   * @param eta Factor by which the number of sets of hyper-parameters is
+   *     divided, and the fraction of the training data multiplied, at each
+   *     round.
+   * @param minFraction Smallest fraction of the training data to train on.
+   * @param hyperband Whether to run Hyperband rather than a single run of
+   *     successive halving over the whole grid.
+   */
+  SuccessiveHalving(const double eta = 3.0,
+                    const double minFraction = 1.0 / 27.0,
+                    const bool hyperband = false) :
+      eta(eta),
+      minFraction(minFraction),
+      hyperband(hyperband)
+  { /* Nothing to do. */ }
+
+  /**
+   * Find the best set of hyper-parameters on the grid given by the number of
+   * values of each hyper-parameter, and return its objective.  Every
+   * dimension should be categorical.
+   *
+   * @param function Function to optimize.
+   * @param bestParameters Set to the best set of hyper-parameters.
+   * @param categoricalDimensions Whether each dimension is categorical.
+   * @param numCategories Number of values of each dimension.
+   */
+  template<typename FunctionType>
+  double Optimize(FunctionType& function,
+                  arma::mat& bestParameters,
+                  const std::vector<bool>& categoricalDimensions,
+                  const arma::Row<size_t>& numCategories);
+
+  //! Get the factor by which the number of sets is divided at each round.
+  double Eta() const { return eta; }
+  //! Modify the factor by which the number of sets is divided at each round.
+  double& Eta() { return eta; }
+
+  //! Get the smallest fraction of the training data to train on.
+  double MinFraction() const { return minFraction; }
+  //! Modify the smallest fraction of the training data to train on.
+  double& MinFraction() { return minFraction; }
+
+  //! Get whether Hyperband is run.
+  bool Hyperband() const { return hyperband; }
+  //! Modify whether Hyperband is run.
+  bool& Hyperband() { return hyperband; }
+
+ private:
+  /**
+   * Run successive halving on the given points of the grid, starting with
+   * eta^-rounds of the training data, and update the best objective and
+   * parameters if the best of the points is better.
+   */
+  template<typename FunctionType>
+  void Halve(FunctionType& function,
+             std::vector<size_t> points,
+             const size_t rounds,
+             const arma::Row<size_t>& numCategories,
+             double& bestObjective,
+             arma::mat& bestParameters);
+
+  //! Get the parameters of the given point of the grid.
+  static arma::mat Point(size_t index, const arma::Row<size_t>& numCategories);
+
+  //! Factor by which the number of sets is divided at each round.
+  double eta;
+
+  //! Smallest fraction of the training data to train on.
+  double minFraction;
+
+  //! Whether to run Hyperband.
+  bool hyperband;
+};
+
+} // namespace hpt
+} // namespace mlpack
+
+// Include implementation.
+#include "successive_halving_impl.hpp"
+
+#endif
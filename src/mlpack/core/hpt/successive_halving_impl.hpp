@@ -0,0 +1,167 @@
+/**
+ * @file core/hpt/successive_halving_impl.hpp
+ *
+ * Implementation of successive halving and Hyperband.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_HPT_SUCCESSIVE_HALVING_IMPL_HPP
+#define MLPACK_CORE_HPT_SUCCESSIVE_HALVING_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "successive_halving.hpp"
+
+namespace mlpack {
+namespace hpt {
+
+template<typename FunctionType>
+double SuccessiveHalving::Optimize(
+    FunctionType& function,
+    arma::mat& bestParameters,
+    const std::vector<bool>& categoricalDimensions,
+    const arma::Row<size_t>& numCategories)
+{
+  if (eta <= 1.0)
+  {
+    throw std::invalid_argument("SuccessiveHalving::Optimize(): eta should be "
+        "greater than 1");
+  }
+
+  if (minFraction <= 0.0 || minFraction > 1.0)
+  {
+    throw std::invalid_argument("SuccessiveHalving::Optimize(): minFraction "
+        "should be in (0, 1]");
+  }
+
+  size_t numPoints = 1;
+  for (size_t d = 0; d < categoricalDimensions.size(); ++d)
+  {
+    if (!categoricalDimensions[d])
+    {
+      std::ostringstream oss;
+      oss << "SuccessiveHalving::Optimize(): only sets of values are "
+          << "supported, but the hyper-parameter " << d + 1 << " is given a "
+          << "starting value" << std::endl;
+      throw std::invalid_argument(oss.str());
+    }
+    numPoints *= numCategories[d];
+  }
+
+  // The number of rounds before the sets are trained on all the data.  The
+  // small constant guards against rounding errors when minFraction is a power
+  // of 1 / eta.
+  const size_t rounds = (size_t) std::floor(std::log(1.0 / minFraction) /
+      std::log(eta) + 1e-10);
+
+  double bestObjective = std::numeric_limits<double>::max();
+  if (!hyperband)
+  {
+    std::vector<size_t> points(numPoints);
+    for (size_t i = 0; i < numPoints; ++i)
+      points[i] = i;
+
+    Halve(function, std::move(points), rounds, numCategories, bestObjective,
+        bestParameters);
+    return bestObjective;
+  }
+
+  // Each bracket of Hyperband starts from eta^-s of the data, with about as
+  // many sets as can be trained with the same total budget.
+  for (size_t s = rounds + 1; s-- > 0; )
+  {
+    const size_t numSampled = (size_t) std::ceil((rounds + 1) / double(s + 1) *
+        std::pow(eta, (double) s));
+
+    std::vector<size_t> points;
+    if (numSampled >= numPoints)
+    {
+      points.resize(numPoints);
+      for (size_t i = 0; i < numPoints; ++i)
+        points[i] = i;
+    }
+    else
+    {
+      const arma::uvec sample = arma::randperm(numPoints, numSampled);
+      points.assign(sample.begin(), sample.end());
+    }
+
+    Halve(function, std::move(points), s, numCategories, bestObjective,
+        bestParameters);
+  }
+
+  return bestObjective;
+}
+
+template<typename FunctionType>
+void SuccessiveHalving::Halve(FunctionType& function,
+                              std::vector<size_t> points,
+                              const size_t rounds,
+                              const arma::Row<size_t>& numCategories,
+                              double& bestObjective,
+                              arma::mat& bestParameters)
+{
+  for (size_t round = 0; round < rounds && points.size() > 1; ++round)
+  {
+    const double fraction = std::pow(eta, (double) round - (double) rounds);
+
+    // Sets with an invalid objective are never kept before valid ones.
+    std::vector<double> objectives(points.size());
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      objectives[i] = function.EvaluateSubsample(
+          Point(points[i], numCategories), fraction);
+      if (std::isnan(objectives[i]))
+        objectives[i] = std::numeric_limits<double>::infinity();
+    }
+
+    // Keep the best sets; sets with the same objective keep their order.
+    std::vector<size_t> order(points.size());
+    for (size_t i = 0; i < order.size(); ++i)
+      order[i] = i;
+    std::stable_sort(order.begin(), order.end(),
+        [&objectives](const size_t a, const size_t b)
+        { return objectives[a] < objectives[b]; });
+
+    const size_t numKept = std::max((size_t) (points.size() / eta),
+        (size_t) 1);
+    std::vector<size_t> keptPoints(numKept);
+    for (size_t i = 0; i < numKept; ++i)
+      keptPoints[i] = points[order[i]];
+    points.swap(keptPoints);
+  }
+
+  // The remaining sets are trained on all the data.
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    const arma::mat parameters = Point(points[i], numCategories);
+    const double objective = function.Evaluate(parameters);
+    if (objective < bestObjective)
+    {
+      bestObjective = objective;
+      bestParameters = parameters;
+    }
+  }
+}
+
+inline arma::mat SuccessiveHalving::Point(
+    size_t index,
+    const arma::Row<size_t>& numCategories)
+{
+  // The last dimension changes fastest, as in ens::GridSearch.
+  arma::mat parameters(numCategories.n_elem, 1);
+  for (size_t d = numCategories.n_elem; d > 0; --d)
+  {
+    parameters(d - 1) = index % numCategories[d - 1];
+    index /= numCategories[d - 1];
+  }
+
+  return parameters;
+}
+
+} // namespace hpt
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,162 @@
+/**
+ * @file core/math/quantile_sketch.hpp
+ *
+ * Definition of QuantileSketch, a mergeable sketch that estimates the
+ * quantiles of a stream of values in small memory.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_QUANTILE_SKETCH_HPP
+#define MLPACK_CORE_MATH_QUANTILE_SKETCH_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace math {
+
+/**
+ * QuantileSketch estimates the quantiles and ranks of a stream of values
+ * without storing the values, following the KLL sketch:
+ *
+ * @code
+ * @inproceedings{karnin2016optimal,
+ *   title={Optimal Quantile Approximation in Streams},
+ *   author={Karnin, Z. and Lang, K. and Liberty, E.},
+ *   booktitle={Proceedings of the 57th Annual IEEE Symposium on Foundations
+ *       of Computer Science (FOCS '16)},
+ *   pages={71--78},
+ *   year={2016}
+ * }
+ * @endcode
+ *
+ * The sketch is a stack of compactors; a value at level h stands for 2^h
+ * values of the stream.  When a level is full it is sorted, and every other
+ * value is promoted to the next level.  The capacities of the levels shrink
+ * geometrically from the top, so the sketch holds O(k log(n / k)) values, and
+ * the error of a rank is roughly n / k.  Until the first level is full (k
+ * values) the sketch is exact.
+ *
+ * Sketches can be merged, so a dataset can be sketched in parallel by giving
+ * each thread (or each chunk of a stream) its own sketch and merging them:
+ *
+ * @code
+ * std::vector<QuantileSketch<>> sketches(numThreads);
+ * // ... each thread calls sketches[t].Insert() on its values ...
+ * for (size_t t = 1; t < numThreads; ++t)
+ *   sketches[0].Merge(sketches[t]);
+ * const double median = sketches[0].Quantile(0.5);
+ * @endcode
+ *
+ * Which value of a pair is promoted alternates deterministically, so a sketch
+ * does not touch the random number generator and can be used from any thread.
+ *
+ * @tparam eT Type of the values.
+ */
+template<typename eT = double>
+class QuantileSketch
+{
+ public:
+  /**
+   * Create an empty sketch.
+   *
+   * @param k Size of the sketch; the larger k, the more accurate the sketch.
+   */
+  QuantileSketch(const size_t k = 200);
+
+  /**
+   * Add a value to the sketch.
+   *
+   * @param value Value to add.
+   */
+  void Insert(const eT value);
+
+  /**
+   * Merge another sketch into this one.  The result is a sketch of the values
+   * of both sketches.
+   *
+   * @param other Sketch to merge into this one.
+   */
+  void Merge(const QuantileSketch& other);
+
+  /**
+   * Estimate the number of values less than or equal to the given value.
+   *
+   * @param value Value to find the rank of.
+   */
+  double Rank(const eT value) const;
+
+  /**
+   * Estimate the q-quantile of the values: the smallest value whose rank is
+   * at least q times the number of values.  The 0-quantile and 1-quantile are
+   * the exact minimum and maximum.  An exception is thrown if the sketch is
+   * empty.
+   *
+   * @param q Quantile to estimate, between 0 and 1.
+   */
+  eT Quantile(const double q) const;
+
+  /**
+   * Estimate several quantiles at once; this is faster than calling
+   * Quantile() for each of them.
+   *
+   * @param q Quantiles to estimate, between 0 and 1.
+   * @param quantiles Vector to store the estimated quantiles in.
+   */
+  void Quantiles(const arma::vec& q, arma::Col<eT>& quantiles) const;
+
+  //! Get the number of values added to the sketch.
+  size_t Count() const { return count; }
+  //! Get the smallest value added to the sketch.
+  eT Min() const { return min; }
+  //! Get the largest value added to the sketch.
+  eT Max() const { return max; }
+  //! Get the size of the sketch.
+  size_t K() const { return k; }
+  //! Get the number of values held by the sketch.
+  size_t Size() const { return size; }
+
+  //! Serialize the sketch.
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */);
+
+ private:
+  //! Return the capacity of the given level.
+  size_t Capacity(const size_t level) const;
+
+  //! Compact full levels until the sketch is below its maximum size.
+  void Compress();
+
+  //! Recompute the maximum size after the number of levels changes.
+  void UpdateMaxSize();
+
+  //! Collect the values and their weights, sorted by value.
+  void SortedValues(std::vector<std::pair<eT, size_t>>& values) const;
+
+  //! The size of the sketch.
+  size_t k;
+  //! The number of values added.
+  size_t count;
+  //! The smallest value added.
+  eT min;
+  //! The largest value added.
+  eT max;
+  //! The values of each level.
+  std::vector<std::vector<eT>> compactors;
+  //! The number of values held in all levels.
+  size_t size;
+  //! The number of values the levels can hold before compaction.
+  size_t maxSize;
+  //! Whether the next compaction promotes the second value of each pair.
+  bool promoteSecond;
+};
+
+} // namespace math
+} // namespace mlpack
+
+// Include implementation.
+#include "quantile_sketch_impl.hpp"
+
+#endif
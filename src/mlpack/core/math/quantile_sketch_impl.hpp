@@ -0,0 +1,242 @@
+/**
+ * @file core/math/quantile_sketch_impl.hpp
+ *
+ * Implementation of QuantileSketch.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_QUANTILE_SKETCH_IMPL_HPP
+#define MLPACK_CORE_MATH_QUANTILE_SKETCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "quantile_sketch.hpp"
+
+namespace mlpack {
+namespace math {
+
+template<typename eT>
+QuantileSketch<eT>::QuantileSketch(const size_t k) :
+    k(std::max(k, (size_t) 2)),
+    count(0),
+    min(eT()),
+    max(eT()),
+    compactors(1),
+    size(0),
+    maxSize(0),
+    promoteSecond(false)
+{
+  UpdateMaxSize();
+}
+
+template<typename eT>
+void QuantileSketch<eT>::Insert(const eT value)
+{
+  if (count == 0 || value < min)
+    min = value;
+  if (count == 0 || value > max)
+    max = value;
+
+  compactors[0].push_back(value);
+  ++size;
+  ++count;
+
+  if (size >= maxSize)
+    Compress();
+}
+
+template<typename eT>
+void QuantileSketch<eT>::Merge(const QuantileSketch& other)
+{
+  if (other.count == 0)
+    return;
+
+  if (count == 0 || other.min < min)
+    min = other.min;
+  if (count == 0 || other.max > max)
+    max = other.max;
+
+  if (other.compactors.size() > compactors.size())
+    compactors.resize(other.compactors.size());
+  for (size_t h = 0; h < other.compactors.size(); ++h)
+  {
+    compactors[h].insert(compactors[h].end(), other.compactors[h].begin(),
+        other.compactors[h].end());
+  }
+
+  size += other.size;
+  count += other.count;
+  UpdateMaxSize();
+
+  if (size >= maxSize)
+    Compress();
+}
+
+template<typename eT>
+double QuantileSketch<eT>::Rank(const eT value) const
+{
+  double rank = 0.0;
+  for (size_t h = 0; h < compactors.size(); ++h)
+  {
+    const double weight = (double) ((size_t) 1 << h);
+    for (size_t i = 0; i < compactors[h].size(); ++i)
+    {
+      if (compactors[h][i] <= value)
+        rank += weight;
+    }
+  }
+
+  return rank;
+}
+
+template<typename eT>
+eT QuantileSketch<eT>::Quantile(const double q) const
+{
+  arma::Col<eT> quantiles;
+  Quantiles(arma::vec(1).fill(q), quantiles);
+  return quantiles[0];
+}
+
+template<typename eT>
+void QuantileSketch<eT>::Quantiles(const arma::vec& q,
+                                   arma::Col<eT>& quantiles) const
+{
+  if (count == 0)
+  {
+    throw std::invalid_argument("QuantileSketch::Quantiles(): the sketch is "
+        "empty!");
+  }
+
+  std::vector<std::pair<eT, size_t>> values;
+  SortedValues(values);
+
+  // The weights of the values add up to the number of values added.
+  std::vector<size_t> cumulative(values.size());
+  size_t total = 0;
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    total += values[i].second;
+    cumulative[i] = total;
+  }
+
+  quantiles.set_size(q.n_elem);
+  for (size_t j = 0; j < q.n_elem; ++j)
+  {
+    if (q[j] <= 0.0)
+    {
+      quantiles[j] = min;
+    }
+    else if (q[j] >= 1.0)
+    {
+      quantiles[j] = max;
+    }
+    else
+    {
+      const double target = q[j] * total;
+      const size_t index = std::lower_bound(cumulative.begin(),
+          cumulative.end(), target, [](const size_t c, const double t)
+          { return (double) c < t; }) - cumulative.begin();
+      quantiles[j] = values[std::min(index, values.size() - 1)].first;
+    }
+  }
+}
+
+template<typename eT>
+template<typename Archive>
+void QuantileSketch<eT>::serialize(Archive& ar,
+                                   const unsigned int /* version */)
+{
+  ar & BOOST_SERIALIZATION_NVP(k);
+  ar & BOOST_SERIALIZATION_NVP(count);
+  ar & BOOST_SERIALIZATION_NVP(min);
+  ar & BOOST_SERIALIZATION_NVP(max);
+  ar & BOOST_SERIALIZATION_NVP(compactors);
+  ar & BOOST_SERIALIZATION_NVP(promoteSecond);
+
+  if (Archive::is_loading::value)
+  {
+    size = 0;
+    for (size_t h = 0; h < compactors.size(); ++h)
+      size += compactors[h].size();
+    UpdateMaxSize();
+  }
+}
+
+template<typename eT>
+size_t QuantileSketch<eT>::Capacity(const size_t level) const
+{
+  // The top level has capacity k, and each level below has 2/3 of the
+  // capacity of the level above.
+  const size_t depth = compactors.size() - level - 1;
+  const double capacity = std::ceil(k * std::pow(2.0 / 3.0, (double) depth));
+  return std::max((size_t) 2, (size_t) capacity);
+}
+
+template<typename eT>
+void QuantileSketch<eT>::Compress()
+{
+  // Adding a level lowers the capacities of the levels below it, so a pass
+  // may leave a level over its capacity; there is always a full level while
+  // the sketch is over its maximum size.
+  while (size >= maxSize)
+  {
+    for (size_t h = 0; h < compactors.size() && size >= maxSize; ++h)
+    {
+      if (compactors[h].size() < Capacity(h))
+        continue;
+
+      if (h + 1 == compactors.size())
+      {
+        compactors.emplace_back();
+        UpdateMaxSize();
+      }
+
+      std::vector<eT>& level = compactors[h];
+      std::vector<eT>& next = compactors[h + 1];
+      std::sort(level.begin(), level.end());
+
+      // If the level holds an odd number of values, the smallest stays
+      // behind.
+      const size_t first = level.size() % 2;
+      const size_t offset = promoteSecond ? 1 : 0;
+      promoteSecond = !promoteSecond;
+      for (size_t i = first; i + 1 < level.size(); i += 2)
+        next.push_back(level[i + offset]);
+
+      size -= (level.size() - first) / 2;
+      level.resize(first);
+    }
+  }
+}
+
+template<typename eT>
+void QuantileSketch<eT>::UpdateMaxSize()
+{
+  maxSize = 0;
+  for (size_t h = 0; h < compactors.size(); ++h)
+    maxSize += Capacity(h);
+}
+
+template<typename eT>
+void QuantileSketch<eT>::SortedValues(
+    std::vector<std::pair<eT, size_t>>& values) const
+{
+  values.clear();
+  values.reserve(size);
+  for (size_t h = 0; h < compactors.size(); ++h)
+  {
+    for (size_t i = 0; i < compactors[h].size(); ++i)
+      values.emplace_back(compactors[h][i], (size_t) 1 << h);
+  }
+
+  std::sort(values.begin(), values.end(),
+      [](const std::pair<eT, size_t>& a, const std::pair<eT, size_t>& b)
+      { return a.first < b.first; });
+}
+
+} // namespace math
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,62 @@
+/**
+ * @file core/tree/subtree_frontier.hpp
+ *
+ * A function that splits a tree into subtrees, so that the subtrees can be
+ * handed to different threads.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_SUBTREE_FRONTIER_HPP
+#define MLPACK_CORE_TREE_SUBTREE_FRONTIER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * Split the given tree into at least the given number of subtrees that
+ * together hold all the descendants of the tree, if the tree has enough
+ * nodes.  The subtree with the most descendants is replaced by its
+ * children until there are enough subtrees, so the subtrees are of similar
+ * sizes.  This is useful to run one traversal per subtree on each thread; a
+ * few subtrees per thread keep the threads busy even if the work per subtree
+ * is uneven.
+ *
+ * @param root Root of the tree to split.
+ * @param numSubtrees Number of subtrees to split the tree into.
+ * @return The subtrees.
+ */
+template<typename TreeType>
+std::vector<TreeType*> SubtreeFrontier(TreeType& root,
+                                       const size_t numSubtrees)
+{
+  std::vector<TreeType*> subtrees(1, &root);
+  while (subtrees.size() < numSubtrees)
+  {
+    size_t largest = 0;
+    for (size_t i = 1; i < subtrees.size(); ++i)
+    {
+      if (subtrees[i]->NumDescendants() > subtrees[largest]->NumDescendants())
+        largest = i;
+    }
+
+    TreeType* node = subtrees[largest];
+    if (node->NumChildren() == 0)
+      break;
+
+    subtrees[largest] = &node->Child(0);
+    for (size_t i = 1; i < node->NumChildren(); ++i)
+      subtrees.push_back(&node->Child(i));
+  }
+
+  return subtrees;
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -25,6 +25,7 @@
 #include <mlpack/methods/amf/update_rules/svd_batch_learning.hpp>
 #include <mlpack/methods/amf/update_rules/svd_incomplete_incremental_learning.hpp>
 #include <mlpack/methods/amf/update_rules/svd_complete_incremental_learning.hpp>
+#include <mlpack/methods/amf/update_rules/sparse_als.hpp>
 
 #include <mlpack/methods/amf/init_rules/random_init.hpp>
 #include <mlpack/methods/amf/init_rules/random_acol_init.hpp>
@@ -183,6 +184,19 @@ using SVDCompleteIncrementalFactorizer = amf::AMF<
     amf::SimpleResidueTermination,
     amf::RandomAcolInitialization<>,
     amf::SVDCompleteIncrementalLearning<MatType>>;
+
+/**
+ * SparseALSFactorizer factorizes given matrix V into two matrices W and H by
+ * alternating least squares over the observed (nonzero) entries of V, with
+ * weighted-lambda regularization.  The rows of W and columns of H are solved
+ * in parallel.
+ *
+ * @see SparseALSUpdate
+ */
+typedef amf::AMF<amf::SimpleResidueTermination,
+                 amf::RandomAcolInitialization<>,
+                 amf::SparseALSUpdate> SparseALSFactorizer;
+
 } // namespace amf
 } // namespace mlpack
 
@@ -0,0 +1,218 @@
+/**
+ * @file methods/amf/update_rules/sparse_als.hpp
+ *
+ * Alternating least squares update rules that only consider the observed
+ * (nonzero) entries of the input matrix, as is typical for collaborative
+ * filtering.  Each row of W and each column of H is an independent regularized
+ * least squares problem, so the updates are solved in parallel with OpenMP.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_AMF_UPDATE_RULES_SPARSE_ALS_HPP
+#define MLPACK_METHODS_AMF_UPDATE_RULES_SPARSE_ALS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace amf {
+
+/**
+ * This class implements alternating least squares with weighted-lambda
+ * regularization (ALS-WR), as described in the following paper:
+ *
+ * @code
+ * @inproceedings{zhou2008large,
+ *   title={Large-scale parallel collaborative filtering for the Netflix
+ *       prize},
+ *   author={Zhou, Y. and Wilkinson, D. and Schreiber, R. and Pan, R.},
+ *   booktitle={International Conference on Algorithmic Applications in
+ *       Management},
+ *   pages={337--348},
+ *   year={2008}
+ * }
+ * @endcode
+ *
+ * Unlike NMFALSUpdate, which treats every entry of V as known, only the
+ * nonzero entries of V are treated as observations.  With V of size n x m, W
+ * of size n x r and H of size r x m, each column j of H is the solution of
+ *
+ * \f[
+ * (\sum_{i \in \Omega_j} w_i w_i^T + \lambda |\Omega_j| I) h_j =
+ *     \sum_{i \in \Omega_j} V_{ij} w_i
+ * \f]
+ *
+ * where \f$ \Omega_j \f$ is the set of observed rows in column j, and each row
+ * of W is found symmetrically.  These r x r systems are independent of each
+ * other, so they are solved in parallel when OpenMP is available.  The cost of
+ * an update is linear in the number of nonzero entries of V.
+ *
+ * A transposed copy of V is held internally so that the rows of V can be
+ * traversed efficiently during the W update.
+ */
+class SparseALSUpdate
+{
+ public:
+  /**
+   * Create the update rule with the given regularization parameter.
+   *
+   * @param lambda Regularization parameter; it is scaled by the number of
+   *     observations of each user and item.  With a lambda of 0, users and
+   *     items with fewer observations than the rank get the minimum-norm
+   *     solution.
+   */
+  SparseALSUpdate(const double lambda = 0.05) : lambda(lambda) { }
+
+  /**
+   * Initialize the update rule before a new factorization.  This stores the
+   * transpose of the dataset in sparse form.
+   *
+   * @param dataset Input matrix to be factorized.
+   * @param * (rank) Rank of the factorization.
+   */
+  template<typename MatType>
+  void Initialize(const MatType& dataset, const size_t /* rank */)
+  {
+    vt = arma::sp_mat(dataset.t());
+  }
+
+  /**
+   * The update rule for the basis matrix W.  Each row of W is solved
+   * independently using the observed entries of the corresponding row of V.
+   *
+   * @param * (V) Input matrix to be factorized (the transpose stored by
+   *     Initialize() is used instead).
+   * @param W Basis matrix to be updated.
+   * @param H Encoding matrix.
+   */
+  template<typename MatType>
+  inline void WUpdate(const MatType& /* V */,
+                      arma::mat& W,
+                      const arma::mat& H)
+  {
+    // The rows of V are the columns of V^T, so solving for W^T is the same
+    // problem as solving for H.
+    arma::mat wt(W.n_cols, W.n_rows);
+    SolveColumns(vt, H, wt);
+    W = wt.t();
+  }
+
+  /**
+   * The update rule for the encoding matrix H.  Each column of H is solved
+   * independently using the observed entries of the corresponding column of V.
+   *
+   * @param V Input matrix to be factorized.
+   * @param W Basis matrix.
+   * @param H Encoding matrix to be updated.
+   */
+  template<typename MatType>
+  inline void HUpdate(const MatType& V,
+                      const arma::mat& W,
+                      arma::mat& H)
+  {
+    // Only the nonzero entries of V are observations.
+    const arma::mat wt = W.t();
+    SolveColumns(AsSparse(V), wt, H);
+  }
+
+  //! Get the regularization parameter.
+  double Lambda() const { return lambda; }
+  //! Modify the regularization parameter.
+  double& Lambda() { return lambda; }
+
+  //! Serialize the object.
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */)
+  {
+    ar & BOOST_SERIALIZATION_NVP(lambda);
+  }
+
+ private:
+  //! Sparse data can be used directly.
+  static const arma::sp_mat& AsSparse(const arma::sp_mat& V) { return V; }
+
+  //! Dense data is converted; zero entries are treated as unobserved.
+  template<typename MatType>
+  static arma::sp_mat AsSparse(const MatType& V) { return arma::sp_mat(V); }
+
+  /**
+   * Solve the regularized least squares problem for every column of the
+   * output.  For column j, the columns of factors that correspond to the
+   * nonzero rows of data.col(j) are used as the design matrix.
+   *
+   * @param data Sparse observations; one column per output column.
+   * @param factors Fixed factor matrix, with one column per row of data.
+   * @param output Matrix to store the solutions in; it must already have the
+   *     right size.
+   */
+  void SolveColumns(const arma::sp_mat& data,
+                    const arma::mat& factors,
+                    arma::mat& output) const
+  {
+    const size_t rank = factors.n_rows;
+
+    // Exceptions can't leave the parallel region, so failures are only
+    // recorded inside it.
+    bool failed = false;
+
+    #pragma omp parallel for schedule(dynamic, 64) reduction(||:failed)
+    for (omp_size_t j = 0; j < (omp_size_t) data.n_cols; ++j)
+    {
+      arma::mat gram(rank, rank, arma::fill::zeros);
+      arma::vec rhs(rank, arma::fill::zeros);
+      size_t observations = 0;
+
+      arma::sp_mat::const_iterator it = data.begin_col(j);
+      for (; it != data.end_col(j); ++it)
+      {
+        const arma::vec f(const_cast<double*>(factors.colptr(it.row())), rank,
+            false, true);
+        gram += f * f.t();
+        rhs += (*it) * f;
+        ++observations;
+      }
+
+      if (observations == 0)
+      {
+        // Nothing is known about this column.
+        output.col(j).zeros();
+        continue;
+      }
+
+      gram.diag() += lambda * observations;
+
+      // With lambda = 0, the system is singular when there are fewer
+      // observations than the rank; then the minimum-norm solution is taken.
+      arma::vec solution;
+      if (!arma::solve(solution, gram, rhs, arma::solve_opts::no_approx))
+      {
+        arma::mat gramInv;
+        if (!arma::pinv(gramInv, gram))
+        {
+          failed = true;
+          continue;
+        }
+        solution = gramInv * rhs;
+      }
+      output.col(j) = solution;
+    }
+
+    if (failed)
+    {
+      throw std::runtime_error("SparseALSUpdate: could not solve the least "
+          "squares problem for some rows or columns; try a larger lambda");
+    }
+  }
+
+  //! Regularization parameter.
+  double lambda;
+  //! Transpose of the matrix being factorized.
+  arma::sp_mat vt;
+}; // class SparseALSUpdate
+
+} // namespace amf
+} // namespace mlpack
+
+#endif
@@ -192,32 +192,52 @@ class SVDBatchLearning
   arma::mat mH;
 }; // class SVDBatchLearning
 
-//! TODO : Merge this template specialized function for sparse matrix using
-//!        common row_col_iterator
+/**
+ * Compute the residual V - W * H at the nonzero entries of the sparse matrix
+ * V.  The result has the same sparsity pattern as V, and the columns are
+ * processed in parallel.
+ */
+inline arma::sp_mat SparseResidual(const arma::sp_mat& V,
+                                   const arma::mat& W,
+                                   const arma::mat& H)
+{
+  // Make sure the CSC arrays are up to date before reading them directly.
+  V.sync();
+
+  // Dot products are taken between columns of W^T, which are contiguous.
+  const arma::mat wt = W.t();
+  arma::vec values(V.n_nonzero);
+
+  #pragma omp parallel for schedule(dynamic, 256)
+  for (omp_size_t j = 0; j < (omp_size_t) V.n_cols; ++j)
+  {
+    for (size_t k = V.col_ptrs[j]; k < V.col_ptrs[j + 1]; ++k)
+    {
+      values[k] = V.values[k] - arma::dot(wt.col(V.row_indices[k]),
+          H.col(j));
+    }
+  }
+
+  const arma::uvec rowIndices(const_cast<arma::uword*>(V.row_indices),
+      V.n_nonzero, false, true);
+  const arma::uvec colPtrs(const_cast<arma::uword*>(V.col_ptrs),
+      V.n_cols + 1, false, true);
+  return arma::sp_mat(rowIndices, colPtrs, values, V.n_rows, V.n_cols);
+}
 
 /**
- * WUpdate function specialization for sparse matrix
+ * WUpdate function specialization for sparse matrix.  The step is
+ * R * H^T, where R is the residual at the observed entries, so it is computed
+ * as a single sparse-dense product instead of one rank-one update per entry.
  */
 template<>
 inline void SVDBatchLearning::WUpdate<arma::sp_mat>(const arma::sp_mat& V,
                                                     arma::mat& W,
                                                     const arma::mat& H)
 {
-  const size_t n = V.n_rows;
-  const size_t r = W.n_cols;
-
   mW = momentum * mW;
 
-  arma::mat deltaW;
-  deltaW.zeros(n, r);
-
-  for (arma::sp_mat::const_iterator it = V.begin(); it != V.end(); ++it)
-  {
-    const size_t row = it.row();
-    const size_t col = it.col();
-    deltaW.row(it.row()) += (*it - arma::dot(W.row(row), H.col(col))) *
-                                             arma::trans(H.col(col));
-  }
+  arma::mat deltaW = SparseResidual(V, W, H) * H.t();
 
   if (kw != 0)
     deltaW -= kw * W;
@@ -226,26 +246,18 @@ inline void SVDBatchLearning::WUpdate<arma::sp_mat>(const arma::sp_mat& V,
   W += mW;
 }
 
+/**
+ * HUpdate function specialization for sparse matrix.  The step is W^T * R,
+ * where R is the residual at the observed entries.
+ */
 template<>
 inline void SVDBatchLearning::HUpdate<arma::sp_mat>(const arma::sp_mat& V,
                                                     const arma::mat& W,
                                                     arma::mat& H)
 {
-  const size_t m = V.n_cols;
-  const size_t r = W.n_cols;
-
   mH = momentum * mH;
 
-  arma::mat deltaH;
-  deltaH.zeros(r, m);
-
-  for (arma::sp_mat::const_iterator it = V.begin(); it != V.end(); ++it)
-  {
-    const size_t row = it.row();
-    const size_t col = it.col();
-    deltaH.col(col) += (*it - arma::dot(W.row(row), H.col(col))) *
-        W.row(row).t();
-  }
+  arma::mat deltaH = W.t() * SparseResidual(V, W, H);
 
   if (kh != 0)
     deltaH -= kh * H;
@@ -179,19 +179,36 @@ void DrusillaSelect<MatType>::Search(const MatType& querySet,
     throw std::invalid_argument("DrusillaSelect::Search(): requested k is "
         "greater than number of points in candidate set!  Increase l or m.");
 
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
   // We'll use the NeighborSearchRules class to perform our brute-force search.
-  // Note that we aren't using trees for our search, so we can use 'int' as a
-  // TreeType.
-  metric::EuclideanDistance metric;
-  NeighborSearchRules<FurthestNeighborSort, metric::EuclideanDistance,
-      tree::KDTree<metric::EuclideanDistance, tree::EmptyStatistic, MatType>>
-      rules(candidateSet, querySet, k, metric, 0, false);
-
-  for (size_t q = 0; q < querySet.n_cols; ++q)
-    for (size_t r = 0; r < candidateSet.n_cols; ++r)
-      rules.BaseCase(q, r);
-
-  rules.GetResults(neighbors, distances);
+  // The rules hold the results of their query points, so blocks of query
+  // points are searched in parallel, each with its own rules.
+  const size_t blockSize = 256;
+  const size_t numBlocks = (querySet.n_cols + blockSize - 1) / blockSize;
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+  {
+    const size_t begin = b * blockSize;
+    const size_t end = std::min(begin + blockSize, (size_t) querySet.n_cols);
+    const MatType queryBlock = querySet.cols(begin, end - 1);
+
+    metric::EuclideanDistance metric;
+    NeighborSearchRules<FurthestNeighborSort, metric::EuclideanDistance,
+        tree::KDTree<metric::EuclideanDistance, tree::EmptyStatistic, MatType>>
+        rules(candidateSet, queryBlock, k, metric, 0, false);
+
+    for (size_t q = 0; q < queryBlock.n_cols; ++q)
+      for (size_t r = 0; r < candidateSet.n_cols; ++r)
+        rules.BaseCase(q, r);
+
+    arma::Mat<size_t> blockNeighbors;
+    arma::mat blockDistances;
+    rules.GetResults(blockNeighbors, blockDistances);
+    neighbors.cols(begin, end - 1) = blockNeighbors;
+    distances.cols(begin, end - 1) = blockDistances;
+  }
 
   // Map the neighbors back to their original indices in the reference set.
   for (size_t i = 0; i < neighbors.n_elem; ++i)
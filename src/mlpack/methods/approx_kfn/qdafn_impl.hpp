@@ -70,11 +70,13 @@ void QDAFN<MatType>::Train(const MatType& referenceSet,
   // top m elements.
   projections = referenceSet.t() * lines;
 
-  // Loop over each projection and find the top m elements.
+  // Loop over each projection and find the top m elements.  The projections
+  // are independent, so they are handled in parallel.
   sIndices.set_size(m, l);
   sValues.set_size(m, l);
   candidateSet.resize(l);
-  for (size_t i = 0; i < l; ++i)
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) l; ++i)
   {
     candidateSet[i].set_size(referenceSet.n_rows, m);
     arma::uvec sortedIndices = arma::sort_index(projections.col(i), "descend");
@@ -104,8 +106,12 @@ void QDAFN<MatType>::Search(const MatType& querySet,
   neighbors.fill(size_t() - 1);
   distances.zeros(k, querySet.n_cols);
 
+  // Project all the query points onto all the lines at once.
+  const arma::mat queryProjections = lines.t() * querySet;
+
   // Search for each point.
-  for (size_t q = 0; q < querySet.n_cols; ++q)
+  #pragma omp parallel for schedule(dynamic, 64)
+  for (omp_size_t q = 0; q < (omp_size_t) querySet.n_cols; ++q)
   {
     // Initialize a priority queue.
     // The size_t represents the index of the table, and the double represents
@@ -113,8 +119,7 @@ void QDAFN<MatType>::Search(const MatType& querySet,
     std::priority_queue<std::pair<double, size_t>> queue;
     for (size_t i = 0; i < l; ++i)
     {
-      const double val = sValues(0, i) - arma::dot(querySet.col(q),
-          lines.col(i));
+      const double val = sValues(0, i) - queryProjections(i, q);
       queue.push(std::make_pair(val, i));
     }
 
@@ -129,7 +134,7 @@ void QDAFN<MatType>::Search(const MatType& querySet,
         resultsQueue(std::less<std::pair<double, size_t>>(), std::move(v));
     for (size_t i = 0; i < m; ++i)
     {
-      std::pair<size_t, double> p = queue.top();
+      std::pair<double, size_t> p = queue.top();
       queue.pop();
 
       // Get index of reference point to look at.
@@ -171,8 +176,8 @@ void QDAFN<MatType>::Search(const MatType& querySet,
       // Avoid inserting any duplicates.
       if (neighbors(extracted - 1, q) != result.second)
       {
-        neighbors(extracted, q) = resultsQueue.top().second;
-        distances(extracted, q) = resultsQueue.top().first;
+        neighbors(extracted, q) = result.second;
+        distances(extracted, q) = result.first;
         ++extracted;
       }
     }
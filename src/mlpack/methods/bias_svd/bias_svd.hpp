@@ -17,6 +17,7 @@
 #include <mlpack/prereqs.hpp>
 #include <ensmallen.hpp>
 #include <mlpack/methods/cf/cf.hpp>
+#include <mlpack/methods/cf/svd_optimizer.hpp>
 
 #include "bias_svd_function.hpp"
 
@@ -52,6 +53,11 @@ namespace svd {
  * rSVD.Apply(data, rank, u, v, p, q);
  * @endcode
  *
+ * OptimizerType may also be ens::ParallelSGD<ens::ExponentialBackoff>, to
+ * train with several OpenMP threads; see SVDOptimizer.  The threads update the
+ * shared factors without locking, which is a data race (undefined behavior in
+ * C++), and the result is not reproducible.
+ *
  */
 template<typename OptimizerType = ens::StandardSGD>
 class BiasSVD
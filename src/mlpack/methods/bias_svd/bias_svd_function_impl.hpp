@@ -271,7 +271,7 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
   arma::Col<size_t> visitationOrder = arma::linspace<arma::Col<size_t>>(0,
       (function.NumFunctions() - 1), function.NumFunctions());
 
-  const arma::mat data = function.Dataset();
+  const arma::mat& data = function.Dataset();
   const size_t numUsers = function.NumUsers();
   const double lambda = function.Lambda();
 
@@ -336,38 +336,30 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
         const size_t user = data(0, visitationOrder[j]);
         const size_t item = data(1, visitationOrder[j]) + numUsers;
 
+        double* userVec = iterate.colptr(user);
+        double* itemVec = iterate.colptr(item);
+
         // Prediction error for the example.
         const double rating = data(2, visitationOrder[j]);
-        const double userBias = iterate(rank, user);
-        const double itemBias = iterate(rank, item);
-        double ratingError = rating - userBias - itemBias -
-            arma::dot(iterate.col(user).subvec(0, rank - 1),
-                      iterate.col(item).subvec(0, rank - 1));
-
-        arma::mat userVecUpdate = stepSize * 2 * (
-            lambda * iterate.col(user).subvec(0, rank - 1) -
-            ratingError * iterate.col(item).subvec(0, rank - 1));
-        arma::mat itemVecUpdate = stepSize * 2 * (
-            lambda * iterate.col(item).subvec(0, rank - 1) -
-            ratingError * iterate.col(user).subvec(0, rank - 1));
-        double userBiasUpdate = stepSize * 2 * (
-            lambda * iterate(rank, user) - ratingError);
-        double itemBiasUpdate = stepSize * 2 * (
-            lambda * iterate(rank, item) - ratingError);
+        const double userBias = userVec[rank];
+        const double itemBias = itemVec[rank];
+        double ratingError = rating - userBias - itemBias;
+        for (size_t k = 0; k < rank; ++k)
+          ratingError -= userVec[k] * itemVec[k];
 
         // Gradient is non-zero only for the parameter columns corresponding to
-        // the example.
-        for (size_t i = 0; i < rank; ++i)
+        // the example.  They are updated in place without locking; see
+        // SVDOptimizer.
+        for (size_t k = 0; k < rank; ++k)
         {
-          #pragma omp atomic
-          iterate(i, user) -= userVecUpdate(i);
-          #pragma omp atomic
-          iterate(i, item) -= itemVecUpdate(i);
+          const double userValue = userVec[k];
+          userVec[k] -= stepSize * 2 * (lambda * userValue -
+              ratingError * itemVec[k]);
+          itemVec[k] -= stepSize * 2 * (lambda * itemVec[k] -
+              ratingError * userValue);
         }
-        #pragma omp atomic
-        iterate(rank, user) -= userBiasUpdate;
-        #pragma omp atomic
-        iterate(rank, item) -= itemBiasUpdate;
+        userVec[rank] -= stepSize * 2 * (lambda * userBias - ratingError);
+        itemVec[rank] -= stepSize * 2 * (lambda * itemBias - ratingError);
       }
     }
   }
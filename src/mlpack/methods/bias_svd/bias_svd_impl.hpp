@@ -44,12 +44,11 @@ void BiasSVD<OptimizerType>::Apply(const arma::mat& data,
 
   // Make the optimizer object using a BiasSVDFunction object.
   BiasSVDFunction<arma::mat> biasSVDFunc(data, rank, lambda);
-  ens::StandardSGD optimizer(alpha, batchSize,
-      iterations * data.n_cols);
 
   // Get optimized parameters.
   arma::mat parameters = biasSVDFunc.GetInitialPoint();
-  optimizer.Optimize(biasSVDFunc, parameters);
+  SVDOptimizer<OptimizerType>::Optimize(biasSVDFunc, parameters, alpha,
+      batchSize, iterations);
 
   // Constants for extracting user and item matrices.
   const size_t numUsers = max(data.row(0)) + 1;
@@ -200,6 +200,11 @@ class CFType
 
   /**
    * Generates the given number of recommendations for the specified users.
+   * The query users are processed in blocks, in parallel if OpenMP is
+   * available.  The ratings of the neighbors of each block are computed with
+   * one matrix product, the best items of each user are found by partial
+   * selection, and items the user has already rated are skipped using the
+   * sparse rating matrix.
    *
    * @tparam NeighborSearchPolicy The policy used to search neighbors of
    *     query set in referece set.
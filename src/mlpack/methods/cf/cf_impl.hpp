@@ -198,75 +198,114 @@ GetRecommendations(const size_t numRecs,
   decomposition.template GetNeighborhood<NeighborSearchPolicy>(
       users, numUsersForSimilarity, neighborhood, similarities);
 
-  // Generate recommendations for each query user by finding the maximum numRecs
-  // elements in the ratings vector.
-  recommendations.set_size(numRecs, users.n_elem);
-  arma::mat values(numRecs, users.n_elem);
-  recommendations.fill(SIZE_MAX);
-  values.fill(DBL_MAX);
-
   // Initialization of an InterpolationPolicy object should be put ahead of the
   // following loop, because the initialization may takes a relatively long
   // time and we don't want to repeat the initialization process in each loop.
+  // Some interpolation policies cache intermediate results, so the weights for
+  // every query user are computed before the parallel section below.
   InterpolationPolicy interpolation(cleanedData);
-
+  arma::mat weights(neighborhood.n_rows, users.n_elem);
   for (size_t i = 0; i < users.n_elem; ++i)
   {
-    // First, calculate the weighted sum of neighborhood values.
-    arma::vec ratings;
-    ratings.zeros(cleanedData.n_rows);
-
-    // Calculate interpolation weights.
-    arma::vec weights(numUsersForSimilarity);
-    interpolation.GetWeights(weights, decomposition, users(i),
+    interpolation.GetWeights(weights.col(i), decomposition, users(i),
         neighborhood.col(i), similarities.col(i), cleanedData);
+  }
 
-    for (size_t j = 0; j < neighborhood.n_rows; ++j)
-    {
-      arma::vec neighborRatings;
-      decomposition.GetRatingOfUser(neighborhood(j, i), neighborRatings);
-      ratings += weights(j) * neighborRatings;
-    }
+  // Generate recommendations for each query user by finding the maximum numRecs
+  // elements in the ratings vector.  The query users are split into blocks
+  // that are handled in parallel.  The ratings of all the neighbors of a block
+  // are computed with one matrix product, and each thread reuses its own
+  // buffers.  Blocks are kept small enough that the neighbor ratings of a
+  // block take at most about 2^22 elements.
+  recommendations.set_size(numRecs, users.n_elem);
+  recommendations.fill(SIZE_MAX);
+
+  const size_t numNeighbors = neighborhood.n_rows;
+  const size_t blockSize = std::max((size_t) 1, std::min((size_t) 64,
+      ((size_t) 1 << 22) / std::max((size_t) 1, cleanedData.n_rows *
+      numNeighbors)));
+  const size_t numBlocks = (users.n_elem + blockSize - 1) / blockSize;
+  std::vector<char> incomplete(users.n_elem, 0);
 
-    // Let's build the list of candidate recomendations for the given user.
-    // Default candidate: the smallest possible value and invalid item number.
-    const Candidate def = std::make_pair(-DBL_MAX, cleanedData.n_rows);
-    std::vector<Candidate> vect(numRecs, def);
-    typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
-        CandidateList;
-    CandidateList pqueue(CandidateCmp(), std::move(vect));
+  // Make sure the sparse matrix is in a consistent state before it is read
+  // concurrently.
+  cleanedData.sync();
 
-    // Look through the ratings column corresponding to the current user.
-    for (size_t j = 0; j < ratings.n_rows; ++j)
+  #pragma omp parallel
+  {
+    arma::mat neighborRatings;
+    arma::vec ratings;
+    std::vector<char> rated(cleanedData.n_rows, 0);
+    std::vector<Candidate> candidates;
+    candidates.reserve(cleanedData.n_rows);
+
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
     {
-      // Ensure that the user hasn't already rated the item.
-      // The algorithm omits rating of zero. Thus, when normalizing original
-      // ratings in Normalize(), if normalized rating equals zero, it is set
-      // to the smallest positive double value.
-      if (cleanedData(j, users(i)) != 0.0)
-        continue; // The user already rated the item.
-
-      // Is the estimated value better than the worst candidate?
-      // Denormalize rating before comparison.
-      double realRating = normalization.Denormalize(users(i), j, ratings[j]);
-      if (realRating > pqueue.top().first)
+      const size_t begin = b * blockSize;
+      const size_t end = std::min((size_t) (b + 1) * blockSize, users.n_elem);
+
+      // Get the ratings of every neighbor of every user in the block at once;
+      // the neighbors of user i are columns (i - begin) * numNeighbors onwards.
+      const arma::Col<size_t> neighbors = arma::vectorise(
+          neighborhood.cols(begin, end - 1));
+      decomposition.GetRatingOfUsers(neighbors, neighborRatings);
+
+      for (size_t i = begin; i < end; ++i)
       {
-        Candidate c = std::make_pair(realRating, j);
-        pqueue.pop();
-        pqueue.push(c);
+        // First, calculate the weighted sum of neighborhood values.
+        const size_t first = (i - begin) * numNeighbors;
+        ratings = neighborRatings.cols(first, first + numNeighbors - 1) *
+            weights.col(i);
+
+        // Mark the items that the user already rated by walking the user's
+        // column of the sparse rating matrix once.  The algorithm omits rating
+        // of zero. Thus, when normalizing original ratings in Normalize(), if
+        // normalized rating equals zero, it is set to the smallest positive
+        // double value.
+        arma::sp_mat::const_iterator it = cleanedData.begin_col(users(i));
+        arma::sp_mat::const_iterator itEnd = cleanedData.end_col(users(i));
+        for (; it != itEnd; ++it)
+          rated[it.row()] = 1;
+
+        // Collect the denormalized ratings of the items the user hasn't rated.
+        candidates.clear();
+        for (size_t j = 0; j < ratings.n_elem; ++j)
+        {
+          if (!rated[j])
+          {
+            candidates.push_back(std::make_pair(normalization.Denormalize(
+                users(i), j, ratings[j]), j));
+          }
+        }
+
+        // Select the best numRecs candidates, and sort only those.
+        const size_t found = std::min(numRecs, candidates.size());
+        std::nth_element(candidates.begin(), candidates.begin() + found,
+            candidates.end(), CandidateCmp());
+        std::sort(candidates.begin(), candidates.begin() + found,
+            CandidateCmp());
+
+        for (size_t p = 0; p < found; ++p)
+          recommendations(p, i) = candidates[p].second;
+        for (size_t p = found; p < numRecs; ++p)
+          recommendations(p, i) = cleanedData.n_rows;
+
+        if (found < numRecs)
+          incomplete[i] = 1;
+
+        // Reset the marks for the next user.
+        for (it = cleanedData.begin_col(users(i)); it != itEnd; ++it)
+          rated[it.row()] = 0;
       }
     }
+  }
 
-    for (size_t p = 1; p <= numRecs; p++)
-    {
-      recommendations(numRecs - p, i) = pqueue.top().second;
-      values(numRecs - p, i) = pqueue.top().first;
-      pqueue.pop();
-    }
-
-    // If we were not able to come up with enough recommendations, issue a
-    // warning.
-    if (recommendations(numRecs - 1, i) == def.second)
+  // If we were not able to come up with enough recommendations, issue a
+  // warning.
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    if (incomplete[i])
       Log::Warn << "Could not provide " << numRecs << " recommendations "
           << "for user " << users(i) << " (not enough un-rated items)!"
           << std::endl;
@@ -17,6 +17,7 @@
 #include "cf.hpp"
 #include "cf_model.hpp"
 
+#include <mlpack/methods/cf/decomposition_policies/als_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/batch_svd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/randomized_svd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/regularized_svd_method.hpp>
@@ -86,6 +87,8 @@ PROGRAM_INFO("Collaborative Filtering",
     " - 'SVDCompleteIncremental' -- SVD complete incremental learning\n"
     " - 'BiasSVD' -- Bias SVD using a SGD optimizer\n"
     " - 'SVDPP' -- SVD++ using a SGD optimizer\n"
+    " - 'ALS' -- Alternating least squares on the observed ratings, with "
+    "user and item factors solved in parallel\n"
     "\n\n"
     "The following neighbor search algorithms can be specified via" +
     " the " + PRINT_PARAM_STRING("neighbor_search") + " parameter:"
@@ -456,6 +459,10 @@ void AssembleFactorizerType(const std::string& algorithm,
         "when max_iterations is reached");
     PerformAction<SVDPlusPlusPolicy>(dataset, rank, maxIterations, minResidue);
   }
+  else if (algorithm == "ALS")
+  {
+    PerformAction<ALSPolicy>(dataset, rank, maxIterations, minResidue);
+  }
 }
 
 static void mlpackMain()
@@ -479,7 +486,7 @@ static void mlpackMain()
 
   RequireParamInSet<string>("algorithm", { "NMF", "BatchSVD",
       "SVDIncompleteIncremental", "SVDCompleteIncremental", "RegSVD",
-      "RandSVD", "BiasSVD", "SVDPP" }, true, "unknown algorithm");
+      "RandSVD", "BiasSVD", "SVDPP", "ALS" }, true, "unknown algorithm");
 
   ReportIgnoredParam({{ "iteration_only_termination", true }}, "min_residue");
 
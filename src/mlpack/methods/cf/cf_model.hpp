@@ -17,6 +17,7 @@
 #include <boost/variant.hpp>
 #include "cf.hpp"
 
+#include <mlpack/methods/cf/decomposition_policies/als_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/batch_svd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/randomized_svd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/regularized_svd_method.hpp>
@@ -170,7 +171,13 @@ class CFModel
                  CFType<SVDCompletePolicy, ZScoreNormalization>*,
                  CFType<SVDIncompletePolicy, ZScoreNormalization>*,
                  CFType<BiasSVDPolicy, ZScoreNormalization>*,
-                 CFType<SVDPlusPlusPolicy, ZScoreNormalization>*> cf;
+                 CFType<SVDPlusPlusPolicy, ZScoreNormalization>*,
+
+                 CFType<ALSPolicy, NoNormalization>*,
+                 CFType<ALSPolicy, ItemMeanNormalization>*,
+                 CFType<ALSPolicy, UserMeanNormalization>*,
+                 CFType<ALSPolicy, OverallMeanNormalization>*,
+                 CFType<ALSPolicy, ZScoreNormalization>*> cf;
 
  public:
   //! Create an empty CF model.
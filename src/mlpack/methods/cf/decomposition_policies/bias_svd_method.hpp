@@ -106,6 +106,22 @@ class BiasSVDPolicy
     rating = w * h.col(user) + p + q(user);
   }
 
+  /**
+   * Get predicted ratings for a set of users with one matrix product.  Column
+   * i of the result holds the ratings of users[i].
+   *
+   * @param users User IDs.
+   * @param ratings Resulting rating matrix.
+   */
+  void GetRatingOfUsers(const arma::Col<size_t>& users,
+                        arma::mat& ratings) const
+  {
+    const arma::uvec indices = arma::conv_to<arma::uvec>::from(users);
+    ratings = w * h.cols(indices);
+    ratings.each_col() += p;
+    ratings.each_row() += q.elem(indices).t();
+  }
+
   /**
    * Get the neighborhood and corresponding similarities for a set of users.
    *
@@ -100,6 +100,19 @@ class RegSVDPolicy
     rating = w * h.col(user);
   }
 
+  /**
+   * Get predicted ratings for a set of users with one matrix product.  Column
+   * i of the result holds the ratings of users[i].
+   *
+   * @param users User IDs.
+   * @param ratings Resulting rating matrix.
+   */
+  void GetRatingOfUsers(const arma::Col<size_t>& users,
+                        arma::mat& ratings) const
+  {
+    ratings = w * h.cols(arma::conv_to<arma::uvec>::from(users));
+  }
+
   /**
    * Get the neighborhood and corresponding similarities for a set of users.
    *
@@ -141,6 +141,39 @@ class SVDPlusPlusPolicy
     rating = w * userVec + p + q(user);
   }
 
+  /**
+   * Get predicted ratings for a set of users with one matrix product.  Column
+   * i of the result holds the ratings of users[i].
+   *
+   * @param users User IDs.
+   * @param ratings Resulting rating matrix.
+   */
+  void GetRatingOfUsers(const arma::Col<size_t>& users,
+                        arma::mat& ratings) const
+  {
+    // Build the user vector of every user, as in GetRatingOfUser().
+    arma::mat userVecs(h.n_rows, users.n_elem, arma::fill::zeros);
+    for (size_t i = 0; i < users.n_elem; ++i)
+    {
+      arma::sp_mat::const_iterator it = implicitData.begin_col(users[i]);
+      arma::sp_mat::const_iterator it_end = implicitData.end_col(users[i]);
+      size_t implicitCount = 0;
+      for (; it != it_end; ++it)
+      {
+        userVecs.col(i) += y.col(it.row());
+        implicitCount += 1;
+      }
+      if (implicitCount != 0)
+        userVecs.col(i) /= std::sqrt(implicitCount);
+      userVecs.col(i) += h.col(users[i]);
+    }
+
+    const arma::uvec indices = arma::conv_to<arma::uvec>::from(users);
+    ratings = w * userVecs;
+    ratings.each_col() += p;
+    ratings.each_row() += q.elem(indices).t();
+  }
+
   /**
    * Get the neighborhood and corresponding similarities for a set of users.
    *
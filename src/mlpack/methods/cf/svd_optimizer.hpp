@@ -0,0 +1,105 @@
+/**
+ * @file methods/cf/svd_optimizer.hpp
+ *
+ * Run the optimizer requested by RegularizedSVD, BiasSVD or SVDPlusPlus on
+ * the objective of the factorization.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_CF_SVD_OPTIMIZER_HPP
+#define MLPACK_METHODS_CF_SVD_OPTIMIZER_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <ensmallen.hpp>
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+namespace svd {
+
+/**
+ * Optimize the objective of a factorization of ratings, which has one separable
+ * function per rating, with the given optimizer type.  By default,
+ * ens::StandardSGD is used with the given step size and batch size.
+ *
+ * @tparam OptimizerType Optimizer requested by the factorization.
+ */
+template<typename OptimizerType>
+class SVDOptimizer
+{
+ public:
+  /**
+   * Optimize the given objective, starting from the given parameters.
+   *
+   * @param function Objective of the factorization.
+   * @param parameters Starting point; it is overwritten with the result.
+   * @param alpha Learning rate.
+   * @param batchSize Number of ratings in each batch.
+   * @param iterations Number of passes over the ratings.
+   */
+  template<typename FunctionType>
+  static void Optimize(FunctionType& function,
+                       arma::mat& parameters,
+                       const double alpha,
+                       const size_t batchSize,
+                       const size_t iterations)
+  {
+    ens::StandardSGD optimizer(alpha, batchSize,
+        iterations * function.NumFunctions());
+    optimizer.Optimize(function, parameters);
+  }
+};
+
+/**
+ * With ens::ParallelSGD<ens::ExponentialBackoff>, the ratings are shuffled and
+ * split evenly between the OpenMP threads in every pass, and each thread
+ * updates the parameters without any locking (HOGWILD!).  A rating only
+ * changes the few parameter columns of its user and item, so conflicting
+ * writes between threads are rare and in practice do not prevent convergence.
+ *
+ * Note that these unsynchronized writes are still a data race, which is
+ * undefined behavior in C++; the result is not deterministic even with a fixed
+ * random seed, and tools like ThreadSanitizer will report the race.  Use
+ * ens::StandardSGD when reproducible or strictly conforming training is
+ * needed.  The
+ * ParallelSGD::Optimize() specializations for RegularizedSVDFunction,
+ * BiasSVDFunction and SVDPlusPlusFunction implement these updates.
+ *
+ * The step size is kept constant, as with ens::StandardSGD, and the batch size
+ * is not used.
+ */
+template<>
+class SVDOptimizer<ens::ParallelSGD<ens::ExponentialBackoff>>
+{
+ public:
+  template<typename FunctionType>
+  static void Optimize(FunctionType& function,
+                       arma::mat& parameters,
+                       const double alpha,
+                       const size_t /* batchSize */,
+                       const size_t iterations)
+  {
+    #ifdef HAS_OPENMP
+      const size_t numThreads = omp_get_max_threads();
+    #else
+      const size_t numThreads = 1;
+    #endif
+
+    // ParallelSGD runs maxIterations - 1 passes.
+    ens::ExponentialBackoff decayPolicy(iterations + 1, alpha, 1.0);
+    ens::ParallelSGD<ens::ExponentialBackoff> optimizer(iterations + 1,
+        std::ceil((double) function.NumFunctions() / numThreads), 0.0, true,
+        decayPolicy);
+    optimizer.Optimize(function, parameters);
+  }
+};
+
+} // namespace svd
+} // namespace mlpack
+
+#endif
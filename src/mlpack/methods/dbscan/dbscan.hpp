@@ -14,8 +14,11 @@
 #define MLPACK_METHODS_DBSCAN_DBSCAN_HPP
 
 #include <mlpack/core.hpp>
+#include <mlpack/core/tree/subtree_frontier.hpp>
 #include <mlpack/methods/range_search/range_search.hpp>
 #include <mlpack/methods/emst/union_find.hpp>
+#include <mlpack/methods/emst/concurrent_union_find.hpp>
+#include "dbscan_rules.hpp"
 #include "random_point_selection.hpp"
 #include "ordered_point_selection.hpp"
 #include <boost/dynamic_bitset.hpp>
@@ -54,11 +57,12 @@ class DBSCAN
 {
  public:
   /**
-   * Construct the DBSCAN object with the given parameters.  The batchMode
-   * parameter should be set to false in the case where RAM issues will be
-   * encountered (i.e. if the dataset is very large or if epsilon is large).
-   * When batchMode is false, each point will be searched iteratively, which
-   * could be slower but will use less memory.
+   * Construct the DBSCAN object with the given parameters.  In either mode,
+   * neighboring points are united as soon as the range search finds them, so
+   * the neighborhoods are never stored.  When batchMode is true, the points
+   * are searched in batch with dual-tree traversals, in parallel if OpenMP is
+   * enabled.  When batchMode is false, each point will be searched
+   * iteratively on one thread, which could be slower.
    *
    * @param epsilon Size of range query.
    * @param minPoints Minimum number of points for each cluster.
@@ -144,17 +148,18 @@ class DBSCAN
                         emst::UnionFind& uf);
 
   /**
-   * Performs DBSCAN clustering on the data, returning number of clusters
-   * and also the list of cluster assignments.  This can perform search in batch,
-   * so it is well suited for dual-tree or naive search.
+   * Performs DBSCAN clustering on the data, setting the assignment of each
+   * point to the index of its component.  This performs the search in batch:
+   * subtrees of the reference tree are searched in parallel with dual-tree
+   * traversals that unite neighbors in a concurrent union-find structure, and
+   * nodes whose points are all neighbors of each other are united in bulk.
    *
    * @param data Dataset to cluster.
    * @param assignments Assignments for each point.
-   * @param uf UnionFind structure that will be modified.
    */
   template<typename MatType>
   void BatchCluster(const MatType& data,
-                    emst::UnionFind& uf);
+                    arma::Row<size_t>& assignments);
 };
 
 } // namespace dbscan
@@ -14,6 +14,10 @@
 
 #include "dbscan.hpp"
 
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace dbscan {
 
@@ -100,19 +104,22 @@ size_t DBSCAN<RangeSearchType, PointSelectionPolicy>::Cluster(
     const MatType& data,
     arma::Row<size_t>& assignments)
 {
-  // Initialize the UnionFind object.
-  emst::UnionFind uf(data.n_cols);
   rangeSearch.Train(data);
 
+  // Set each assignment to the index of the component of the point.
+  assignments.set_size(data.n_cols);
   if (batchMode)
-    BatchCluster(data, uf);
+  {
+    BatchCluster(data, assignments);
+  }
   else
+  {
+    emst::UnionFind uf(data.n_cols);
     PointwiseCluster(data, uf);
 
-  // Now set assignments.
-  assignments.set_size(data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
-    assignments[i] = uf.Find(i);
+    for (size_t i = 0; i < data.n_cols; ++i)
+      assignments[i] = uf.Find(i);
+  }
 
   // Get a count of all clusters.
   const size_t numClusters = arma::max(assignments) + 1;
@@ -152,50 +159,92 @@ void DBSCAN<RangeSearchType, PointSelectionPolicy>::PointwiseCluster(
     const MatType& data,
     emst::UnionFind& uf)
 {
-  std::vector<std::vector<size_t>> neighbors;
-  std::vector<std::vector<double>> distances;
-
   for (size_t i = 0; i < data.n_cols; ++i)
   {
     if (i % 10000 == 0 && i > 0)
       Log::Info << "DBSCAN clustering on point " << i << "..." << std::endl;
 
-    // Do the range search for only this point.
-    rangeSearch.Search(data.col(i), math::Range(0.0, epsilon), neighbors,
-        distances);
-
-    // Union to all neighbors.
-    for (size_t j = 0; j < neighbors[0].size(); ++j)
-      uf.Union(i, neighbors[0][j]);
+    // Do the range search for only this point, and union to all neighbors as
+    // they are found.
+    auto unionNeighbor = [&uf, i](const size_t /* queryIndex */,
+                                  const size_t referenceIndex,
+                                  const double /* distance */)
+    {
+      uf.Union(i, referenceIndex);
+    };
+    rangeSearch.Search(data.col(i), math::Range(0.0, epsilon), unionNeighbor);
   }
 }
 
 /**
- * Performs DBSCAN clustering on the data, returning number of clusters
- * and also the list of cluster assignments.  This can perform search in batch,
- * naive search).
+ * Performs DBSCAN clustering on the data, setting the assignment of each point
+ * to the index of its component.  The reference tree is split into subtrees,
+ * and each subtree is searched against the whole tree by a dual-tree
+ * traversal on its own thread, uniting neighbors in a concurrent union-find
+ * structure as they are found.
  */
 template<typename RangeSearchType, typename PointSelectionPolicy>
 template<typename MatType>
 void DBSCAN<RangeSearchType, PointSelectionPolicy>::BatchCluster(
     const MatType& data,
-    emst::UnionFind& uf)
+    arma::Row<size_t>& assignments)
 {
-  // For each point, find the points in epsilon-nighborhood and their distances.
-  std::vector<std::vector<size_t>> neighbors;
-  std::vector<std::vector<double>> distances;
+  typedef typename RangeSearchType::Tree Tree;
+
+  // The reference set was already set by Cluster().
+  emst::ConcurrentUnionFind uf(data.n_cols);
+  Tree* referenceTree = rangeSearch.ReferenceTree();
   Log::Info << "Performing range search." << std::endl;
-  rangeSearch.Train(data);
-  rangeSearch.Search(data, math::Range(0.0, epsilon), neighbors, distances);
+  if (referenceTree == NULL)
+  {
+    // Naive search has no tree to split, so just union each pair of
+    // neighbors as it is found.
+    auto unionNeighbor = [&uf](const size_t queryIndex,
+                               const size_t referenceIndex,
+                               const double /* distance */)
+    {
+      uf.Union(queryIndex, referenceIndex);
+    };
+    rangeSearch.Search(data, math::Range(0.0, epsilon), unionNeighbor);
+    Log::Info << "Range search complete." << std::endl;
+
+    for (size_t i = 0; i < data.n_cols; ++i)
+      assignments[i] = uf.Find(i);
+    return;
+  }
+
+  typedef typename std::decay<decltype(referenceTree->Metric())>::type
+      MetricType;
+  typedef DBSCANRules<MetricType, Tree> RuleType;
+
+  // Split the tree into a few subtrees per thread, so that the threads stay
+  // busy even if the subtrees are uneven.
+  size_t numTasks = 1;
+  #ifdef HAS_OPENMP
+    numTasks = 4 * omp_get_max_threads();
+  #endif
+  std::vector<Tree*> queryNodes = tree::SubtreeFrontier(*referenceTree,
+      numTasks);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) queryNodes.size(); ++i)
+  {
+    MetricType metric = referenceTree->Metric();
+    RuleType rules(referenceTree->Dataset(), epsilon, uf, metric);
+    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+    traverser.Traverse(*queryNodes[i], *referenceTree);
+  }
   Log::Info << "Range search complete." << std::endl;
 
-  // Now loop over all points.
+  // The tree may have rearranged the points, so map them back.
+  const std::vector<size_t>& oldFromNew = rangeSearch.OldFromNewReferences();
   for (size_t i = 0; i < data.n_cols; ++i)
   {
-    // Get the next index.
-    const size_t index = pointSelector.Select(i, data);
-    for (size_t j = 0; j < neighbors[index].size(); ++j)
-      uf.Union(index, neighbors[index][j]);
+    const size_t component = uf.Find(i);
+    if (oldFromNew.empty())
+      assignments[i] = component;
+    else
+      assignments[oldFromNew[i]] = component;
   }
 }
 
@@ -0,0 +1,144 @@
+/**
+ * @file methods/dbscan/dbscan_rules.hpp
+ *
+ * Tree traversal rules for DBSCAN, which unite the points within epsilon of
+ * each other as the traversal finds them.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DBSCAN_DBSCAN_RULES_HPP
+#define MLPACK_METHODS_DBSCAN_DBSCAN_RULES_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/methods/emst/concurrent_union_find.hpp>
+
+namespace mlpack {
+namespace dbscan {
+
+/**
+ * The DBSCANRules class is a set of rules for a monochromatic range search
+ * that unites each pair of points within epsilon of each other in a
+ * ConcurrentUnionFind, instead of returning the pairs.  Whenever every point
+ * of a node is within epsilon of every point of another node (or of itself,
+ * when its diameter is at most epsilon), the points of both nodes are united
+ * in bulk and the pair of nodes is not descended into, so dense regions cost
+ * time linear in their number of points instead of quadratic.
+ *
+ * Since the union-find structure is concurrent, several traversals with their
+ * own DBSCANRules objects may run at once on different threads.
+ *
+ * @tparam MetricType The metric to use for computation.
+ * @tparam TreeType The tree type to use; must adhere to the TreeType API.
+ */
+template<typename MetricType, typename TreeType>
+class DBSCANRules
+{
+ public:
+  /**
+   * Construct the DBSCANRules object.
+   *
+   * @param dataset Dataset the tree is built on.
+   * @param epsilon Maximum distance between two neighbors.
+   * @param uf Union-find structure to unite neighbors in.
+   * @param metric Instantiated metric.
+   */
+  DBSCANRules(const arma::mat& dataset,
+              const double epsilon,
+              emst::ConcurrentUnionFind& uf,
+              MetricType& metric);
+
+  /**
+   * Compute the base case between the given query point and reference point,
+   * and unite them if they are neighbors.
+   *
+   * @param queryIndex Index of query point.
+   * @param referenceIndex Index of reference point.
+   */
+  double BaseCase(const size_t queryIndex, const size_t referenceIndex);
+
+  /**
+   * Get the score for recursion order.  If the reference node is too far
+   * away, or if all of its points are neighbors of the query point (they are
+   * then united with it), DBL_MAX is returned to prune the node.
+   *
+   * @param queryIndex Index of query point.
+   * @param referenceNode Candidate node to be recursed into.
+   */
+  double Score(const size_t queryIndex, TreeType& referenceNode);
+
+  /**
+   * Re-evaluate the score for recursion order.  Nothing can change between
+   * Score() and Rescore(), so this returns the old score.
+   *
+   * @param queryIndex Index of query point.
+   * @param referenceNode Candidate node to be recursed into.
+   * @param oldScore Old score produced by Score() (or Rescore()).
+   */
+  double Rescore(const size_t /* queryIndex */,
+                 TreeType& /* referenceNode */,
+                 const double oldScore) const { return oldScore; }
+
+  /**
+   * Get the score for recursion order.  If the nodes are too far apart, or if
+   * all of their points are neighbors of each other (they are then united),
+   * DBL_MAX is returned to prune the combination.
+   *
+   * @param queryNode Candidate query node to recurse into.
+   * @param referenceNode Candidate reference node to recurse into.
+   */
+  double Score(TreeType& queryNode, TreeType& referenceNode);
+
+  /**
+   * Re-evaluate the score for recursion order.  Nothing can change between
+   * Score() and Rescore(), so this returns the old score.
+   *
+   * @param queryNode Candidate query node to recurse into.
+   * @param referenceNode Candidate reference node to recurse into.
+   * @param oldScore Old score produced by Score() (or Rescore()).
+   */
+  double Rescore(TreeType& /* queryNode */,
+                 TreeType& /* referenceNode */,
+                 const double oldScore) const { return oldScore; }
+
+  typedef typename tree::TraversalInfo<TreeType> TraversalInfoType;
+
+  const TraversalInfoType& TraversalInfo() const { return traversalInfo; }
+  TraversalInfoType& TraversalInfo() { return traversalInfo; }
+
+  //! Get the number of base cases.
+  size_t BaseCases() const { return baseCases; }
+  //! Get the number of scores.
+  size_t Scores() const { return scores; }
+
+ private:
+  //! Unite all the points in the given node with the given point.
+  void UnionAll(TreeType& node, const size_t point);
+
+  //! The dataset.
+  const arma::mat& dataset;
+  //! The maximum distance between two neighbors.
+  double epsilon;
+  //! The union-find structure.
+  emst::ConcurrentUnionFind& uf;
+  //! The instantiated metric.
+  MetricType& metric;
+
+  TraversalInfoType traversalInfo;
+
+  //! The number of base cases.
+  size_t baseCases;
+  //! The number of scores.
+  size_t scores;
+};
+
+} // namespace dbscan
+} // namespace mlpack
+
+// Include implementation.
+#include "dbscan_rules_impl.hpp"
+
+#endif
@@ -0,0 +1,113 @@
+/**
+ * @file methods/dbscan/dbscan_rules_impl.hpp
+ *
+ * Implementation of the tree traversal rules for DBSCAN.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DBSCAN_DBSCAN_RULES_IMPL_HPP
+#define MLPACK_METHODS_DBSCAN_DBSCAN_RULES_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "dbscan_rules.hpp"
+
+namespace mlpack {
+namespace dbscan {
+
+template<typename MetricType, typename TreeType>
+DBSCANRules<MetricType, TreeType>::DBSCANRules(
+    const arma::mat& dataset,
+    const double epsilon,
+    emst::ConcurrentUnionFind& uf,
+    MetricType& metric) :
+    dataset(dataset),
+    epsilon(epsilon),
+    uf(uf),
+    metric(metric),
+    baseCases(0),
+    scores(0)
+{
+  // Nothing to do.
+}
+
+template<typename MetricType, typename TreeType>
+inline force_inline
+double DBSCANRules<MetricType, TreeType>::BaseCase(
+    const size_t queryIndex,
+    const size_t referenceIndex)
+{
+  if (queryIndex == referenceIndex)
+    return 0.0;
+
+  const double distance = metric.Evaluate(dataset.unsafe_col(queryIndex),
+      dataset.unsafe_col(referenceIndex));
+  ++baseCases;
+
+  if (distance <= epsilon)
+    uf.Union(queryIndex, referenceIndex);
+
+  return distance;
+}
+
+template<typename MetricType, typename TreeType>
+double DBSCANRules<MetricType, TreeType>::Score(const size_t queryIndex,
+                                                TreeType& referenceNode)
+{
+  const math::Range distances =
+      referenceNode.RangeDistance(dataset.unsafe_col(queryIndex));
+  ++scores;
+
+  if (distances.Lo() > epsilon)
+    return DBL_MAX;
+
+  // If every point of the node is a neighbor, unite them all with the query
+  // point at once.
+  if (distances.Hi() <= epsilon)
+  {
+    UnionAll(referenceNode, queryIndex);
+    return DBL_MAX;
+  }
+
+  return distances.Lo();
+}
+
+template<typename MetricType, typename TreeType>
+double DBSCANRules<MetricType, TreeType>::Score(TreeType& queryNode,
+                                                TreeType& referenceNode)
+{
+  const math::Range distances = referenceNode.RangeDistance(queryNode);
+  ++scores;
+
+  if (distances.Lo() > epsilon)
+    return DBL_MAX;
+
+  // If every point of one node is a neighbor of every point of the other, all
+  // of them are in the same cluster.  This is also the case of a node with a
+  // diameter of at most epsilon, paired with itself.
+  if (distances.Hi() <= epsilon)
+  {
+    const size_t point = queryNode.Descendant(0);
+    UnionAll(queryNode, point);
+    if (&referenceNode != &queryNode)
+      UnionAll(referenceNode, point);
+    return DBL_MAX;
+  }
+
+  return distances.Lo();
+}
+
+template<typename MetricType, typename TreeType>
+void DBSCANRules<MetricType, TreeType>::UnionAll(TreeType& node,
+                                                 const size_t point)
+{
+  for (size_t i = 0; i < node.NumDescendants(); ++i)
+    uf.Union(point, node.Descendant(i));
+}
+
+} // namespace dbscan
+} // namespace mlpack
+
+#endif
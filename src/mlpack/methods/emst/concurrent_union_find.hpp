@@ -0,0 +1,112 @@
+/**
+ * @file methods/emst/concurrent_union_find.hpp
+ *
+ * A union-find data structure that many threads can use at once, without
+ * locks.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_EMST_CONCURRENT_UNION_FIND_HPP
+#define MLPACK_METHODS_EMST_CONCURRENT_UNION_FIND_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <atomic>
+
+namespace mlpack {
+namespace emst {
+
+/**
+ * A union-find data structure that can be used by many threads at once:
+ * Union() and Find() may be called concurrently, with no locks.  It has the
+ * same interface as UnionFind.
+ *
+ * Each parent pointer is an atomic.  Find() shortens the paths it follows by
+ * path halving, and Union() links the root with the larger index below the
+ * root with the smaller index with a compare-and-swap, starting over if
+ * another thread changed that root in the meantime.  So the result does not
+ * depend on the order of the unions: the index of the component containing a
+ * point is always the smallest index in the component.
+ */
+class ConcurrentUnionFind
+{
+ public:
+  //! Construct the object with the given size.
+  ConcurrentUnionFind(const size_t size) : parent(size)
+  {
+    for (size_t i = 0; i < size; ++i)
+      parent[i].store(i, std::memory_order_relaxed);
+  }
+
+  /**
+   * Returns the component containing an element.  This may be called while
+   * other threads call Union(); the result is the component at some point
+   * during the call.
+   *
+   * @param x the component to be found
+   * @return The index of the component containing x
+   */
+  size_t Find(size_t x)
+  {
+    while (true)
+    {
+      size_t p = parent[x].load(std::memory_order_acquire);
+      if (p == x)
+        return x;
+
+      // Point x to its grandparent, so that later calls follow shorter paths.
+      // If another thread changed the parent of x first, that is fine too.
+      const size_t grandparent = parent[p].load(std::memory_order_acquire);
+      if (grandparent != p)
+      {
+        parent[x].compare_exchange_weak(p, grandparent,
+            std::memory_order_acq_rel, std::memory_order_relaxed);
+      }
+
+      x = grandparent;
+    }
+  }
+
+  /**
+   * Union the components containing x and y.  If several threads try to union
+   * the same components at once, only one of them succeeds.
+   *
+   * @param x one component
+   * @param y the other component
+   * @return Whether the components were merged by this call; false if x and y
+   *     were already in the same component.
+   */
+  bool Union(size_t x, size_t y)
+  {
+    while (true)
+    {
+      x = Find(x);
+      y = Find(y);
+      if (x == y)
+        return false;
+
+      // Link the larger root below the smaller one.  This only succeeds if it
+      // is still a root; otherwise, find the roots again.
+      if (x < y)
+        std::swap(x, y);
+      size_t expected = x;
+      if (parent[x].compare_exchange_strong(expected, y,
+          std::memory_order_acq_rel, std::memory_order_relaxed))
+        return true;
+    }
+  }
+
+  //! Get the number of elements.
+  size_t Size() const { return parent.size(); }
+
+ private:
+  //! The parent of each element; roots are their own parents.
+  std::vector<std::atomic<size_t>> parent;
+}; // class ConcurrentUnionFind
+
+} // namespace emst
+} // namespace mlpack
+
+#endif // MLPACK_METHODS_EMST_CONCURRENT_UNION_FIND_HPP
@@ -27,6 +27,7 @@
 
 #include "dtb_stat.hpp"
 #include "edge_pair.hpp"
+#include "concurrent_union_find.hpp"
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/metrics/lmetric.hpp>
@@ -68,6 +69,13 @@ namespace emst /** Euclidean Minimum Spanning Trees. */ {
  * More advanced usage of the class can use different types of trees, pass in an
  * already-built tree, or compute the MST using the O(n^2) naive algorithm.
  *
+ * If OpenMP is enabled, each Boruvka iteration runs on several threads: the
+ * tree is split into subtrees, and the nearest neighbors of the points of each
+ * subtree are found by a dual-tree traversal against the whole tree.  Each
+ * thread keeps its own candidate edge for each component; the candidates are
+ * then reduced per component, and the components are merged in parallel with
+ * a concurrent union-find structure.
+ *
  * @tparam MetricType The metric to use.
  * @tparam MatType The type of data matrix to use.
  * @tparam TreeType Type of tree to use.  This should follow the TreeType policy
@@ -103,14 +111,14 @@ class DualTreeBoruvka
   std::vector<EdgePair> edges; // We must use vector with non-numerical types.
 
   //! Connections.
-  UnionFind connections;
+  ConcurrentUnionFind connections;
 
-  //! List of edge nodes.
-  arma::Col<size_t> neighborsInComponent;
-  //! List of edge nodes.
-  arma::Col<size_t> neighborsOutComponent;
-  //! List of edge distances.
-  arma::vec neighborsDistances;
+  //! List of edge nodes, for each thread.
+  std::vector<arma::Col<size_t>> neighborsInComponent;
+  //! List of edge nodes, for each thread.
+  std::vector<arma::Col<size_t>> neighborsOutComponent;
+  //! List of edge distances, for each thread.
+  std::vector<arma::vec> neighborsDistances;
 
   //! Total distance of the tree.
   double totalDist;
@@ -182,7 +190,9 @@ class DualTreeBoruvka
   void AddEdge(const size_t e1, const size_t e2, const double distance);
 
   /**
-   * Adds all the edges found in one iteration to the list of neighbors.
+   * Reduces the candidate edges of all threads for each component, merges the
+   * components, and adds all the edges found in one iteration to the list of
+   * neighbors.
    */
   void AddAllEdges();
 
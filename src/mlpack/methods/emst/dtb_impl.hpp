@@ -14,6 +14,12 @@
 
 #include "dtb_rules.hpp"
 
+#include <mlpack/core/tree/subtree_frontier.hpp>
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace emst {
 
@@ -62,11 +68,6 @@ DualTreeBoruvka<MetricType, MatType, TreeType>::DualTreeBoruvka(
     metric(metric)
 {
   edges.reserve(data.n_cols - 1); // Set size.
-
-  neighborsInComponent.set_size(data.n_cols);
-  neighborsOutComponent.set_size(data.n_cols);
-  neighborsDistances.set_size(data.n_cols);
-  neighborsDistances.fill(DBL_MAX);
 }
 
 template<
@@ -87,11 +88,6 @@ DualTreeBoruvka<MetricType, MatType, TreeType>::DualTreeBoruvka(
     metric(metric)
 {
   edges.reserve(data.n_cols - 1); // Fill with EdgePairs.
-
-  neighborsInComponent.set_size(data.n_cols);
-  neighborsOutComponent.set_size(data.n_cols);
-  neighborsDistances.set_size(data.n_cols);
-  neighborsDistances.fill(DBL_MAX);
 }
 
 template<
@@ -123,22 +119,69 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::ComputeMST(
 
   totalDist = 0; // Reset distance.
 
+  // Each thread keeps its own candidate edge for each component.
+  size_t numThreads = 1;
+  #ifdef HAS_OPENMP
+    numThreads = omp_get_max_threads();
+  #endif
+  neighborsInComponent.assign(numThreads, arma::Col<size_t>(data.n_cols));
+  neighborsOutComponent.assign(numThreads, arma::Col<size_t>(data.n_cols));
+  neighborsDistances.assign(numThreads, arma::vec(data.n_cols));
+  for (size_t t = 0; t < numThreads; ++t)
+    neighborsDistances[t].fill(DBL_MAX);
+
+  // Split the tree into a few subtrees per thread, so that the threads stay
+  // busy even if the subtrees are uneven.  The subtrees don't change, so this
+  // is only done once.
+  std::vector<Tree*> queryNodes;
+  if (!naive)
+    queryNodes = tree::SubtreeFrontier(*tree, 4 * numThreads);
+
   typedef DTBRules<MetricType, Tree> RuleType;
-  RuleType rules(data, connections, neighborsDistances, neighborsInComponent,
-                 neighborsOutComponent, metric);
+  size_t baseCases = 0;
+  size_t scores = 0;
   while (edges.size() < (data.n_cols - 1))
   {
     if (naive)
     {
       // Full O(N^2) traversal.
-      for (size_t i = 0; i < data.n_cols; ++i)
+      #pragma omp parallel for schedule(dynamic)
+      for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+      {
+        size_t thread = 0;
+        #ifdef HAS_OPENMP
+          thread = omp_get_thread_num();
+        #endif
+        MetricType threadMetric(metric);
+        RuleType rules(data, connections, neighborsDistances[thread],
+            neighborsInComponent[thread], neighborsOutComponent[thread],
+            threadMetric);
         for (size_t j = 0; j < data.n_cols; ++j)
           rules.BaseCase(i, j);
+      }
     }
     else
     {
-      typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
-      traverser.Traverse(*tree, *tree);
+      // Search for the neighbors of the points of each subtree against the
+      // whole tree.  The statistics of the query nodes are only modified by
+      // the traversal of their own subtree.
+      #pragma omp parallel for schedule(dynamic) reduction(+:baseCases, scores)
+      for (omp_size_t i = 0; i < (omp_size_t) queryNodes.size(); ++i)
+      {
+        size_t thread = 0;
+        #ifdef HAS_OPENMP
+          thread = omp_get_thread_num();
+        #endif
+        MetricType threadMetric(metric);
+        RuleType rules(data, connections, neighborsDistances[thread],
+            neighborsInComponent[thread], neighborsOutComponent[thread],
+            threadMetric);
+        typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+        traverser.Traverse(*queryNodes[i], *tree);
+
+        baseCases += rules.BaseCases();
+        scores += rules.Scores();
+      }
     }
 
     AddAllEdges();
@@ -148,8 +191,8 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::ComputeMST(
     Log::Info << edges.size() << " edges found so far." << std::endl;
     if (!naive)
     {
-      Log::Info << rules.BaseCases() << " cumulative base cases." << std::endl;
-      Log::Info << rules.Scores() << " cumulative node combinations scored."
+      Log::Info << baseCases << " cumulative base cases." << std::endl;
+      Log::Info << scores << " cumulative node combinations scored."
           << std::endl;
     }
   }
@@ -195,18 +238,45 @@ template<
              typename TreeMatType> class TreeType>
 void DualTreeBoruvka<MetricType, MatType, TreeType>::AddAllEdges()
 {
+  // Only the components at the start of the iteration have candidate edges.
+  // Take the best candidate over all threads for each of them and merge the
+  // components in parallel.  An edge is kept only if it merged two components,
+  // so no cycle is created.  The kept edges are stored in the candidates of
+  // the first thread, and a distance of DBL_MAX marks the others.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+  {
+    size_t best = 0;
+    for (size_t t = 1; t < neighborsDistances.size(); ++t)
+      if (neighborsDistances[t][i] < neighborsDistances[best][i])
+        best = t;
+
+    if (neighborsDistances[best][i] == DBL_MAX)
+      continue;
+
+    const size_t inEdge = neighborsInComponent[best][i];
+    const size_t outEdge = neighborsOutComponent[best][i];
+    if (connections.Union(inEdge, outEdge))
+    {
+      neighborsDistances[0][i] = neighborsDistances[best][i];
+      neighborsInComponent[0][i] = inEdge;
+      neighborsOutComponent[0][i] = outEdge;
+    }
+    else
+    {
+      neighborsDistances[0][i] = DBL_MAX;
+    }
+  }
+
   for (size_t i = 0; i < data.n_cols; ++i)
   {
-    size_t component = connections.Find(i);
-    size_t inEdge = neighborsInComponent[component];
-    size_t outEdge = neighborsOutComponent[component];
-    if (connections.Find(inEdge) != connections.Find(outEdge))
+    if (neighborsDistances[0][i] != DBL_MAX)
     {
       // totalDist = totalDist + dist;
       // changed to make this agree with the cover tree code
-      totalDist += neighborsDistances[component];
-      AddEdge(inEdge, outEdge, neighborsDistances[component]);
-      connections.Union(inEdge, outEdge);
+      totalDist += neighborsDistances[0][i];
+      AddEdge(neighborsInComponent[0][i], neighborsOutComponent[0][i],
+          neighborsDistances[0][i]);
     }
   }
 }
@@ -318,8 +388,8 @@ template<
              typename TreeMatType> class TreeType>
 void DualTreeBoruvka<MetricType, MatType, TreeType>::Cleanup()
 {
-  for (size_t i = 0; i < data.n_cols; ++i)
-    neighborsDistances[i] = DBL_MAX;
+  for (size_t t = 0; t < neighborsDistances.size(); ++t)
+    neighborsDistances[t].fill(DBL_MAX);
 
   if (!naive)
     CleanupHelper(tree);
@@ -15,6 +15,7 @@
 #include <mlpack/prereqs.hpp>
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include "concurrent_union_find.hpp"
 
 namespace mlpack {
 namespace emst {
@@ -24,7 +25,7 @@ class DTBRules
 {
  public:
   DTBRules(const arma::mat& dataSet,
-           UnionFind& connections,
+           ConcurrentUnionFind& connections,
            arma::vec& neighborsDistances,
            arma::Col<size_t>& neighborsInComponent,
            arma::Col<size_t>& neighborsOutComponent,
@@ -102,7 +103,7 @@ class DTBRules
   const arma::mat& dataSet;
 
   //! Stores the tree structure so far
-  UnionFind& connections;
+  ConcurrentUnionFind& connections;
 
   //! The distance to the candidate nearest neighbor for each component.
   arma::vec& neighborsDistances;
@@ -164,6 +164,12 @@ class HoeffdingTree
    * Train on a set of points, either in streaming mode or in batch mode, with
    * the given labels.
    *
+   * In streaming mode the points are treated as one micro-batch: each point is
+   * routed to the leaf it currently falls into, and then the leaves are
+   * trained on their points in parallel.  Because leaves do not share any
+   * statistics, the resulting tree is the same as if Train() had been called
+   * on each point in order.
+   *
    * @param data Data points to train on.
    * @param labels Labels of data points.
    * @param batchTraining If true, perform training in batch.
@@ -314,6 +320,21 @@ class HoeffdingTree
   void serialize(Archive& ar, const unsigned int /* version */);
 
  private:
+  /**
+   * Train this node (and the subtree beneath it) on the given points, in
+   * order, in streaming mode.  This is equivalent to calling Train() on each
+   * point, but the split statistics are updated one dimension at a time for
+   * all the points that arrive between two split checks.
+   *
+   * @param data Dataset the points belong to.
+   * @param labels Labels of the dataset.
+   * @param points Indices of the points to train on, in order.
+   */
+  template<typename MatType>
+  void TrainOnPoints(const MatType& data,
+                     const arma::Row<size_t>& labels,
+                     const std::vector<size_t>& points);
+
   // We need to keep some information for before we have split.
 
   //! Information for splitting of numeric features (used before split).
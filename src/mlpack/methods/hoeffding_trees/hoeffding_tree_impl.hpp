@@ -258,8 +258,10 @@ void HoeffdingTree<
     // Don't split if there are fewer than five points.
     size_t oldMaxSamples = maxSamples;
     maxSamples = std::max(size_t(data.n_cols - 1), size_t(5));
+    std::vector<size_t> points(data.n_cols);
     for (size_t i = 0; i < data.n_cols; ++i)
-      Train(data.col(i), labels[i]);
+      points[i] = i;
+    TrainOnPoints(data, labels, points);
     maxSamples = oldMaxSamples;
 
     // Now, if we did split, find out which points go to which child, and
@@ -310,9 +312,41 @@ void HoeffdingTree<
   }
   else
   {
-    // We aren't training in batch mode; loop through the points.
+    // We aren't training in batch mode.  Find the leaf that each point falls
+    // into right now.
+    std::vector<const HoeffdingTree*> pointLeaves(data.n_cols);
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+    {
+      const HoeffdingTree* node = this;
+      while (node->children.size() > 0)
+        node = node->children[node->CalculateDirection(data.col(i))];
+      pointLeaves[i] = node;
+    }
+
+    // Group the points by leaf, keeping them in order.
+    std::unordered_map<const HoeffdingTree*, size_t> leafIndices;
+    std::vector<HoeffdingTree*> leaves;
+    std::vector<std::vector<size_t>> leafPoints;
     for (size_t i = 0; i < data.n_cols; ++i)
-      Train(data.col(i), labels[i]);
+    {
+      auto it = leafIndices.find(pointLeaves[i]);
+      if (it == leafIndices.end())
+      {
+        it = leafIndices.insert(std::make_pair(pointLeaves[i],
+            leaves.size())).first;
+        leaves.push_back(const_cast<HoeffdingTree*>(pointLeaves[i]));
+        leafPoints.push_back(std::vector<size_t>());
+      }
+
+      leafPoints[it->second].push_back(i);
+    }
+
+    // Each leaf only ever modifies itself and the children it creates, so the
+    // leaves can be trained in parallel.
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) leaves.size(); ++i)
+      leaves[i]->TrainOnPoints(data, labels, leafPoints[i]);
   }
 }
 
@@ -429,6 +463,85 @@ void HoeffdingTree<
   }
 }
 
+//! Train on a sequence of points in streaming mode.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename MatType>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::TrainOnPoints(const MatType& data,
+                 const arma::Row<size_t>& labels,
+                 const std::vector<size_t>& points)
+{
+  size_t start = 0;
+  while (start < points.size() && splitDimension == size_t(-1))
+  {
+    // Take all of the points up to the next split check.
+    const size_t end = std::min(points.size(),
+        start + (checkInterval - numSamples % checkInterval));
+
+    size_t numericIndex = 0;
+    size_t categoricalIndex = 0;
+    for (size_t i = 0; i < data.n_rows; ++i)
+    {
+      if (datasetInfo->Type(i) == data::Datatype::categorical)
+      {
+        CategoricalSplitType<FitnessFunction>& split =
+            categoricalSplits[categoricalIndex++];
+        for (size_t j = start; j < end; ++j)
+          split.Train(data(i, points[j]), labels[points[j]]);
+      }
+      else if (datasetInfo->Type(i) == data::Datatype::numeric)
+      {
+        NumericSplitType<FitnessFunction>& split =
+            numericSplits[numericIndex++];
+        for (size_t j = start; j < end; ++j)
+          split.Train(data(i, points[j]), labels[points[j]]);
+      }
+    }
+    numSamples += (end - start);
+    start = end;
+
+    // Grab majority class from splits.
+    if (categoricalSplits.size() > 0)
+    {
+      majorityClass = categoricalSplits[0].MajorityClass();
+      majorityProbability = categoricalSplits[0].MajorityProbability();
+    }
+    else
+    {
+      majorityClass = numericSplits[0].MajorityClass();
+      majorityProbability = numericSplits[0].MajorityProbability();
+    }
+
+    // Check for a split, if we should.
+    if (numSamples % checkInterval == 0)
+    {
+      const size_t numChildren = SplitCheck();
+      if (numChildren > 0)
+      {
+        children.clear();
+        CreateChildren();
+      }
+    }
+  }
+
+  if (start == points.size())
+    return;
+
+  // We have split, so pass the rest of the points to the relevant children.
+  std::vector<std::vector<size_t>> childPoints(children.size());
+  for (size_t j = start; j < points.size(); ++j)
+    childPoints[CalculateDirection(data.col(points[j]))].push_back(points[j]);
+
+  for (size_t i = 0; i < children.size(); ++i)
+    if (childPoints[i].size() > 0)
+      children[i]->TrainOnPoints(data, labels, childPoints[i]);
+}
+
 template<typename FitnessFunction,
          template<typename> class NumericSplitType,
          template<typename> class CategoricalSplitType>
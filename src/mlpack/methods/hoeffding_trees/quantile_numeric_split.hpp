@@ -0,0 +1,152 @@
+/**
+ * @file methods/hoeffding_trees/quantile_numeric_split.hpp
+ *
+ * A numeric feature split for Hoeffding trees that bins the feature at its
+ * quantiles, estimated with quantile sketches.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HOEFFDING_TREES_QUANTILE_NUMERIC_SPLIT_HPP
+#define MLPACK_METHODS_HOEFFDING_TREES_QUANTILE_NUMERIC_SPLIT_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/quantile_sketch.hpp>
+#include "numeric_split_info.hpp"
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The QuantileNumericSplit class is a histogram split for numeric features:
+ * like HoeffdingNumericSplit, it discretizes the feature into a fixed number
+ * of bins and makes a split with one child per bin.  But instead of splitting
+ * the range of the first points equally, the bin boundaries are the quantiles
+ * of all the points seen so far, so that each bin holds about the same number
+ * of points even when the feature is skewed, and the boundaries keep adapting
+ * as more points are seen.
+ *
+ * The values of each class are summarized by a math::QuantileSketch, so the
+ * memory used does not grow with the number of points.  The boundaries are
+ * the quantiles of the merged sketches, and the number of points of each
+ * class in each bin is estimated from the ranks of the boundaries in the
+ * sketch of that class.
+ *
+ * @tparam FitnessFunction Fitness function to use for calculating gain.
+ * @tparam ObservationType Type of observations in this dimension.
+ */
+template<typename FitnessFunction,
+         typename ObservationType = double>
+class QuantileNumericSplit
+{
+ public:
+  //! The splitting information type required by the QuantileNumericSplit.
+  typedef NumericSplitInfo<ObservationType> SplitInfo;
+
+  /**
+   * Create the QuantileNumericSplit class, and specify some basic parameters
+   * about how the binning should take place.
+   *
+   * @param numClasses Number of classes.
+   * @param bins Number of bins.
+   * @param observationsBeforeBinning Number of points to see before the
+   *      fitness function is evaluated.
+   * @param sketchSize Size of the quantile sketch of each class.
+   */
+  QuantileNumericSplit(const size_t numClasses = 0,
+                       const size_t bins = 10,
+                       const size_t observationsBeforeBinning = 100,
+                       const size_t sketchSize = 200);
+
+  /**
+   * Create the QuantileNumericSplit class, using the parameters from the given
+   * other split object.
+   */
+  QuantileNumericSplit(const size_t numClasses,
+                       const QuantileNumericSplit& other);
+
+  /**
+   * Train the QuantileNumericSplit on the given observed value (remember that
+   * this object only cares about the information for a single feature, not an
+   * entire point).
+   *
+   * @param value Value in the dimension that this QuantileNumericSplit refers
+   *      to.
+   * @param label Label of the given point.
+   */
+  void Train(ObservationType value, const size_t label);
+
+  /**
+   * Evaluate the fitness function given what has been calculated so far.  If
+   * fewer than observationsBeforeBinning points have been seen, 0 will be
+   * returned (i.e., no gain).  Because this split can only split one possible
+   * way, secondBestFitness will be set to 0.
+   *
+   * @param bestFitness Value of the fitness function for the best possible
+   *      split.
+   * @param secondBestFitness Value of the fitness function for the second best
+   *      possible split (always 0 for this split).
+   */
+  void EvaluateFitnessFunction(double& bestFitness, double& secondBestFitness)
+      const;
+
+  //! Return the number of children if this node splits on this feature.
+  size_t NumChildren() const { return bins; }
+
+  /**
+   * Return the majority class of each child to be created, if a split on this
+   * dimension was performed.  Also create the split object.
+   */
+  void Split(arma::Col<size_t>& childMajorities, SplitInfo& splitInfo) const;
+
+  //! Return the majority class.
+  size_t MajorityClass() const;
+  //! Return the probability of the majority class.
+  double MajorityProbability() const;
+
+  //! Return the number of bins.
+  size_t Bins() const { return bins; }
+
+  //! Serialize the object.
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */);
+
+ private:
+  /**
+   * Compute the bin boundaries (the quantiles of all the points seen so far)
+   * and the estimated number of points of each class in each bin.
+   *
+   * @param splitPoints Vector to store the bin boundaries in.
+   * @param counts Matrix to store the counts in (classes by bins).
+   */
+  void BinCounts(arma::Col<ObservationType>& splitPoints,
+                 arma::Mat<size_t>& counts) const;
+
+  //! The quantile sketch of the values of each class.
+  std::vector<math::QuantileSketch<ObservationType>> sketches;
+  //! The number of points of each class.
+  arma::Col<size_t> classCounts;
+  //! The number of bins.
+  size_t bins;
+  //! The number of observations we must see before binning.
+  size_t observationsBeforeBinning;
+  //! The size of the quantile sketch of each class.
+  size_t sketchSize;
+  //! The number of samples we have seen so far.
+  size_t samplesSeen;
+};
+
+//! Convenience typedef.
+template<typename FitnessFunction>
+using QuantileDoubleNumericSplit = QuantileNumericSplit<FitnessFunction,
+    double>;
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "quantile_numeric_split_impl.hpp"
+
+#endif
@@ -0,0 +1,177 @@
+/**
+ * @file methods/hoeffding_trees/quantile_numeric_split_impl.hpp
+ *
+ * Implementation of the QuantileNumericSplit class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HOEFFDING_TREES_QUANTILE_NUMERIC_SPLIT_IMPL_HPP
+#define MLPACK_METHODS_HOEFFDING_TREES_QUANTILE_NUMERIC_SPLIT_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "quantile_numeric_split.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename FitnessFunction, typename ObservationType>
+QuantileNumericSplit<FitnessFunction, ObservationType>::QuantileNumericSplit(
+    const size_t numClasses,
+    const size_t bins,
+    const size_t observationsBeforeBinning,
+    const size_t sketchSize) :
+    sketches(numClasses, math::QuantileSketch<ObservationType>(sketchSize)),
+    classCounts(arma::zeros<arma::Col<size_t>>(numClasses)),
+    bins(bins),
+    observationsBeforeBinning(observationsBeforeBinning),
+    sketchSize(sketchSize),
+    samplesSeen(0)
+{
+  // Nothing to do.
+}
+
+template<typename FitnessFunction, typename ObservationType>
+QuantileNumericSplit<FitnessFunction, ObservationType>::QuantileNumericSplit(
+    const size_t numClasses,
+    const QuantileNumericSplit& other) :
+    sketches(numClasses,
+        math::QuantileSketch<ObservationType>(other.sketchSize)),
+    classCounts(arma::zeros<arma::Col<size_t>>(numClasses)),
+    bins(other.bins),
+    observationsBeforeBinning(other.observationsBeforeBinning),
+    sketchSize(other.sketchSize),
+    samplesSeen(0)
+{
+  // Nothing to do.
+}
+
+template<typename FitnessFunction, typename ObservationType>
+void QuantileNumericSplit<FitnessFunction, ObservationType>::Train(
+    ObservationType value,
+    const size_t label)
+{
+  sketches[label].Insert(value);
+  classCounts[label]++;
+  ++samplesSeen;
+}
+
+template<typename FitnessFunction, typename ObservationType>
+void QuantileNumericSplit<FitnessFunction, ObservationType>::
+    EvaluateFitnessFunction(double& bestFitness,
+                            double& secondBestFitness) const
+{
+  secondBestFitness = 0.0; // We can only split one way.
+  if (samplesSeen < observationsBeforeBinning)
+  {
+    bestFitness = 0.0;
+    return;
+  }
+
+  arma::Col<ObservationType> splitPoints;
+  arma::Mat<size_t> counts;
+  BinCounts(splitPoints, counts);
+  bestFitness = FitnessFunction::Evaluate(counts);
+}
+
+template<typename FitnessFunction, typename ObservationType>
+void QuantileNumericSplit<FitnessFunction, ObservationType>::Split(
+    arma::Col<size_t>& childMajorities,
+    SplitInfo& splitInfo) const
+{
+  arma::Col<ObservationType> splitPoints;
+  arma::Mat<size_t> counts;
+  BinCounts(splitPoints, counts);
+
+  childMajorities.set_size(counts.n_cols);
+  for (size_t i = 0; i < counts.n_cols; ++i)
+  {
+    arma::uword maxIndex = 0;
+    counts.unsafe_col(i).max(maxIndex);
+    childMajorities[i] = size_t(maxIndex);
+  }
+
+  // Create the SplitInfo object.
+  splitInfo = SplitInfo(splitPoints);
+}
+
+template<typename FitnessFunction, typename ObservationType>
+size_t QuantileNumericSplit<FitnessFunction, ObservationType>::
+    MajorityClass() const
+{
+  arma::uword majorityClass = 0;
+  classCounts.max(majorityClass);
+  return size_t(majorityClass);
+}
+
+template<typename FitnessFunction, typename ObservationType>
+double QuantileNumericSplit<FitnessFunction, ObservationType>::
+    MajorityProbability() const
+{
+  return double(classCounts.max()) / double(arma::accu(classCounts));
+}
+
+template<typename FitnessFunction, typename ObservationType>
+template<typename Archive>
+void QuantileNumericSplit<FitnessFunction, ObservationType>::serialize(
+    Archive& ar,
+    const unsigned int /* version */)
+{
+  ar & BOOST_SERIALIZATION_NVP(sketches);
+  ar & BOOST_SERIALIZATION_NVP(classCounts);
+  ar & BOOST_SERIALIZATION_NVP(bins);
+  ar & BOOST_SERIALIZATION_NVP(observationsBeforeBinning);
+  ar & BOOST_SERIALIZATION_NVP(sketchSize);
+  ar & BOOST_SERIALIZATION_NVP(samplesSeen);
+}
+
+template<typename FitnessFunction, typename ObservationType>
+void QuantileNumericSplit<FitnessFunction, ObservationType>::BinCounts(
+    arma::Col<ObservationType>& splitPoints,
+    arma::Mat<size_t>& counts) const
+{
+  counts.zeros(classCounts.n_elem, bins);
+  splitPoints.reset();
+  if (samplesSeen == 0 || bins < 2)
+  {
+    if (bins > 0)
+      counts.col(0) = classCounts;
+    return;
+  }
+
+  // The bin boundaries are the quantiles of the values of all classes.  The
+  // merged sketch is large enough to hold every value of the class sketches,
+  // so merging them loses nothing; the class sketches are already bounded.
+  math::QuantileSketch<ObservationType> all(std::max(sketchSize,
+      samplesSeen + 1));
+  for (size_t c = 0; c < sketches.size(); ++c)
+    all.Merge(sketches[c]);
+
+  arma::vec q(bins - 1);
+  for (size_t i = 0; i < bins - 1; ++i)
+    q[i] = double(i + 1) / double(bins);
+  all.Quantiles(q, splitPoints);
+
+  // Bin i holds the values in (splitPoints[i - 1], splitPoints[i]], as in
+  // NumericSplitInfo::CalculateDirection(), so its count is a difference of
+  // ranks.
+  for (size_t c = 0; c < sketches.size(); ++c)
+  {
+    size_t lastRank = 0;
+    for (size_t i = 0; i < bins - 1; ++i)
+    {
+      const size_t rank = std::min(classCounts[c], std::max(lastRank,
+          (size_t) std::round(sketches[c].Rank(splitPoints[i]))));
+      counts(c, i) = rank - lastRank;
+      lastRank = rank;
+    }
+    counts(c, bins - 1) = classCounts[c] - lastRank;
+  }
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
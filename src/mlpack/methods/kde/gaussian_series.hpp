@@ -0,0 +1,182 @@
+/**
+ * @file methods/kde/gaussian_series.hpp
+ *
+ * Taylor series expansions of the Gaussian kernel around the center of a tree
+ * node, used to approximate the contribution of a whole reference node to the
+ * density of a query point.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KDE_GAUSSIAN_SERIES_HPP
+#define MLPACK_METHODS_KDE_GAUSSIAN_SERIES_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/range.hpp>
+#include <mlpack/core/kernels/gaussian_kernel.hpp>
+
+#include "kde_stat.hpp"
+
+namespace mlpack {
+namespace kde {
+
+/**
+ * The GaussianSeries class approximates sums of Gaussian kernels with
+ * truncated Taylor series, as in the improved fast Gauss transform:
+ *
+ * @code
+ * @inproceedings{yang2003improved,
+ *   title={Improved fast gauss transform and efficient kernel density
+ *       estimation},
+ *   author={Yang, C. and Duraiswami, R. and Gumerov, N.A. and Davis, L.},
+ *   booktitle={Proceedings of the Ninth IEEE International Conference on
+ *       Computer Vision (ICCV 2003)},
+ *   pages={664--671},
+ *   year={2003}
+ * }
+ * @endcode
+ *
+ * With the scale \f$ \delta = \sqrt{2} h \f$, where \f$ h \f$ is the bandwidth,
+ * \f$ u = (y - c) / \delta \f$ for a query point \f$ y \f$ and
+ * \f$ v_j = (x_j - c) / \delta \f$ for the reference points \f$ x_j \f$ of a
+ * node with center \f$ c \f$, the sum of the kernel values is
+ *
+ * \f[
+ * \sum_j e^{-\|u - v_j\|^2} \approx e^{-\|u\|^2} \sum_{|\alpha| < p}
+ *     C_\alpha u^\alpha, \qquad
+ * C_\alpha = \frac{2^{|\alpha|}}{\alpha!} \sum_j e^{-\|v_j\|^2} v_j^\alpha.
+ * \f]
+ *
+ * The coefficients \f$ C_\alpha \f$ only depend on the reference node, so they
+ * are computed once and stored in its KDEStat.  The error of each term of the
+ * sum is at most \f$ (2ab)^p / p! \, e^{-(a - b)^2} \f$, where
+ * \f$ a = \|u\| \f$ and \f$ b = \|v_j\| \f$, so the order \f$ p \f$ can be
+ * chosen to meet the error tolerance of KDE.
+ *
+ * This only holds for the Gaussian kernel with the Euclidean distance.
+ */
+class GaussianSeries
+{
+ public:
+  /**
+   * Create the object for series up to the given order.  An order of 0
+   * disables the expansions.
+   *
+   * @param dimensionality Dimensionality of the points.
+   * @param maxOrder Maximum order of the expansions.
+   * @param scale Scale of the expansions: sqrt(2) times the bandwidth.
+   */
+  GaussianSeries(const size_t dimensionality,
+                 const size_t maxOrder,
+                 const double scale);
+
+  /**
+   * Get the scale of the expansions of the given kernel.  Only the Gaussian
+   * kernel has expansions, so this is 0 for every other kernel.
+   */
+  template<typename KernelType>
+  static double Scale(const KernelType& /* kernel */) { return 0.0; }
+
+  //! Get the scale of the expansions of the Gaussian kernel.
+  static double Scale(const kernel::GaussianKernel& kernel)
+  {
+    return std::sqrt(2.0) * kernel.Bandwidth();
+  }
+
+  /**
+   * Compute the expansions of the nodes of the given tree that are small
+   * enough and have enough descendants for the expansions to be useful, if
+   * they do not have an expansion for this series already.  The nodes are
+   * expanded in parallel if OpenMP is enabled.
+   *
+   * @param root Root of the tree.
+   */
+  template<typename TreeType>
+  void ComputeExpansions(TreeType& root) const;
+
+  //! Return whether the given statistic has an expansion for this series.
+  bool HasExpansion(const KDEStat& stat) const
+  {
+    return maxOrder > 0 && stat.SeriesScale() == scale &&
+        stat.SeriesCoefficients().n_elem == NumTerms(maxOrder);
+  }
+
+  /**
+   * Get the lowest order for which the error of each term of the sum is at
+   * most the given error, for query points at a distance in the given range
+   * from the center of the expansion.  If no order up to the maximum order
+   * meets the error, or if the expansion would need at least as many terms as
+   * the given number of points, 0 is returned.
+   *
+   * @param distances Range of distances of the query points to the center.
+   * @param radius Largest distance of a reference point to the center.
+   * @param maxError Largest allowed error of each term.
+   * @param numPoints Number of reference points.
+   * @param error Set to the error bound of each term at the returned order.
+   */
+  size_t Order(const math::Range& distances,
+               const double radius,
+               const double maxError,
+               const size_t numPoints,
+               double& error) const;
+
+  /**
+   * Evaluate the expansion stored in the given statistic at the given point,
+   * up to the given order.
+   *
+   * @param stat Statistic holding the expansion.
+   * @param point Query point.
+   * @param order Order of the series; at most the maximum order.
+   */
+  template<typename VecType>
+  double Evaluate(const KDEStat& stat,
+                  const VecType& point,
+                  const size_t order) const;
+
+  //! Get the number of terms of a series of the given order.
+  size_t NumTerms(const size_t order) const { return numTerms[order]; }
+
+  //! Get the maximum order of the expansions.
+  size_t MaxOrder() const { return maxOrder; }
+
+  //! Get the scale of the expansions.
+  double Scale() const { return scale; }
+
+ private:
+  //! Compute the expansion of the given node and store it in its statistic.
+  template<typename TreeType>
+  void ComputeExpansion(TreeType& node) const;
+
+  //! Compute the monomials u^alpha of the given order of the given vector.
+  void Monomials(const arma::vec& u,
+                 const size_t order,
+                 arma::vec& monomials) const;
+
+  //! Maximum order of the expansions.
+  size_t maxOrder;
+
+  //! Scale of the expansions.
+  double scale;
+
+  //! Number of terms of the series of each order.
+  std::vector<size_t> numTerms;
+
+  //! The monomial each term is computed from; sorted by degree.
+  std::vector<size_t> sources;
+
+  //! The dimension each term multiplies its source monomial by.
+  std::vector<size_t> dimensions;
+
+  //! The constant 2^|alpha| / alpha! of each term.
+  arma::vec constants;
+};
+
+} // namespace kde
+} // namespace mlpack
+
+// Include implementation.
+#include "gaussian_series_impl.hpp"
+
+#endif
@@ -0,0 +1,177 @@
+/**
+ * @file methods/kde/gaussian_series_impl.hpp
+ *
+ * Implementation of the Taylor series expansions of the Gaussian kernel.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KDE_GAUSSIAN_SERIES_IMPL_HPP
+#define MLPACK_METHODS_KDE_GAUSSIAN_SERIES_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "gaussian_series.hpp"
+
+#include <stack>
+
+namespace mlpack {
+namespace kde {
+
+inline GaussianSeries::GaussianSeries(const size_t dimensionality,
+                                      const size_t maxOrder,
+                                      const double scale) :
+    maxOrder(maxOrder),
+    scale(scale),
+    numTerms(maxOrder + 1, 0)
+{
+  if (maxOrder == 0)
+    return;
+
+  // The terms of each degree are the terms of the previous degree whose
+  // dimensions are all at least d, multiplied by dimension d, so each
+  // monomial is computed once and the terms are sorted by degree.  heads[d] is
+  // the first term of the previous degree that can be multiplied by d.
+  std::vector<size_t> heads(dimensionality, 0);
+  std::vector<size_t> powers(1, 0);
+  sources.push_back(0);
+  dimensions.push_back(0);
+  numTerms[1] = 1;
+  for (size_t order = 2; order <= maxOrder; ++order)
+  {
+    const size_t tail = sources.size();
+    for (size_t d = 0; d < dimensionality; ++d)
+    {
+      const size_t head = heads[d];
+      heads[d] = sources.size();
+      for (size_t j = head; j < tail; ++j)
+      {
+        // The smallest dimension of term j is the last one it was multiplied
+        // by, so this gives the power of d in the new term.
+        const size_t power = (j > 0 && dimensions[j] == d) ? powers[j] + 1 : 1;
+        sources.push_back(j);
+        dimensions.push_back(d);
+        powers.push_back(power);
+      }
+    }
+    numTerms[order] = sources.size();
+  }
+
+  // Compute 2^|alpha| / alpha! incrementally, in the same way.
+  constants.set_size(sources.size());
+  constants[0] = 1.0;
+  for (size_t t = 1; t < sources.size(); ++t)
+    constants[t] = constants[sources[t]] * 2.0 / powers[t];
+}
+
+template<typename TreeType>
+void GaussianSeries::ComputeExpansions(TreeType& root) const
+{
+  if (maxOrder == 0)
+    return;
+
+  // Find the nodes to expand first, so that they can be expanded in parallel.
+  // Nodes with no more descendants than terms are cheaper to compute exactly,
+  // and the expansions of nodes wider than the scale converge too slowly to
+  // be useful.
+  std::vector<TreeType*> nodes;
+  std::stack<TreeType*> stack;
+  stack.push(&root);
+  while (!stack.empty())
+  {
+    TreeType* node = stack.top();
+    stack.pop();
+    if (node->NumDescendants() <= numTerms[maxOrder])
+      continue;
+
+    if (node->FurthestDescendantDistance() <= scale &&
+        !HasExpansion(node->Stat()))
+      nodes.push_back(node);
+
+    for (size_t i = 0; i < node->NumChildren(); ++i)
+      stack.push(&node->Child(i));
+  }
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) nodes.size(); ++i)
+    ComputeExpansion(*nodes[i]);
+}
+
+inline size_t GaussianSeries::Order(const math::Range& distances,
+                                    const double radius,
+                                    const double maxError,
+                                    const size_t numPoints,
+                                    double& error) const
+{
+  // The error of each term is at most (2ab)^p / p! e^{-(a - b)^2}, with a and
+  // b the scaled distances of the query and reference points to the center.
+  const double a = distances.Hi() / scale;
+  const double b = radius / scale;
+  const double gap = std::max(distances.Lo() / scale - b, 0.0);
+  double bound = std::exp(-gap * gap);
+  for (size_t p = 1; p <= maxOrder && numTerms[p] < numPoints; ++p)
+  {
+    bound *= 2 * a * b / p;
+    if (bound <= maxError)
+    {
+      error = bound;
+      return p;
+    }
+  }
+
+  return 0;
+}
+
+template<typename VecType>
+double GaussianSeries::Evaluate(const KDEStat& stat,
+                                const VecType& point,
+                                const size_t order) const
+{
+  const arma::vec u = (point - stat.SeriesCenter()) / scale;
+  arma::vec monomials;
+  Monomials(u, order, monomials);
+
+  return std::exp(-arma::dot(u, u)) * arma::dot(monomials,
+      stat.SeriesCoefficients().head(numTerms[order]));
+}
+
+template<typename TreeType>
+void GaussianSeries::ComputeExpansion(TreeType& node) const
+{
+  arma::vec center;
+  node.Center(center);
+
+  arma::vec coefficients(numTerms[maxOrder], arma::fill::zeros);
+  arma::vec monomials;
+  double radius = 0.0;
+  for (size_t i = 0; i < node.NumDescendants(); ++i)
+  {
+    const arma::vec v =
+        (node.Dataset().col(node.Descendant(i)) - center) / scale;
+    Monomials(v, maxOrder, monomials);
+    coefficients += std::exp(-arma::dot(v, v)) * monomials;
+    radius = std::max(radius, arma::norm(v));
+  }
+
+  KDEStat& stat = node.Stat();
+  stat.SeriesCenter() = std::move(center);
+  stat.SeriesCoefficients() = coefficients % constants;
+  stat.SeriesRadius() = radius * scale;
+  stat.SeriesScale() = scale;
+}
+
+inline void GaussianSeries::Monomials(const arma::vec& u,
+                                      const size_t order,
+                                      arma::vec& monomials) const
+{
+  monomials.set_size(numTerms[order]);
+  monomials[0] = 1.0;
+  for (size_t t = 1; t < monomials.n_elem; ++t)
+    monomials[t] = u[dimensions[t]] * monomials[sources[t]];
+}
+
+} // namespace kde
+} // namespace mlpack
+
+#endif
@@ -17,6 +17,7 @@
 #include <mlpack/core/tree/binary_space_tree.hpp>
 
 #include "kde_stat.hpp"
+#include "gaussian_series.hpp"
 
 namespace mlpack {
 namespace kde /** Kernel Density Estimation. */ {
@@ -55,6 +56,12 @@ struct KDEDefaultParams
 
   //! Monte Carlo break coefficient.
   static constexpr double mcBreakCoef = 0.4;
+
+  //! Whether to use series expansions of the Gaussian kernel when possible.
+  static constexpr bool seriesExpansion = false;
+
+  //! Maximum order of the series expansions.
+  static constexpr size_t seriesOrder = 8;
 };
 
 /**
@@ -64,6 +71,21 @@ struct KDEDefaultParams
  * This implementation performs this estimation using a tree-independent
  * dual-tree algorithm. Details about this algorithm are available in KDERules.
  *
+ * If OpenMP is enabled, evaluations run on several threads: in dual-tree mode
+ * the query tree is split into subtrees that are traversed in parallel, and in
+ * single-tree mode the query points are traversed in parallel.  Each thread
+ * keeps its own error tolerance accumulators.  Monte Carlo estimations use the
+ * shared random number generator, so they still run on one thread.
+ *
+ * Reference points can be added to a trained model with AddReferences(),
+ * without building the whole reference tree again.
+ *
+ * With the Gaussian kernel and the Euclidean distance, reference nodes that
+ * are too close to be pruned can be estimated with Taylor series expansions of
+ * the kernel around their centers (see GaussianSeries), whose order is chosen
+ * to meet the same error tolerances.  This helps most with large bandwidths
+ * and low-dimensional data.
+ *
  * @tparam KernelType Kernel function to use for KDE calculations.
  * @tparam MetricType Metric to use for KDE calculations.
  * @tparam MatType Type of data to use.
@@ -110,6 +132,9 @@ class KDE
    * @param mcBreakCoef Coefficient to control what fraction of the node's
    *                    descendants evaluated is the limit before Monte Carlo
    *                    estimation recurses.
+   * @param seriesExpansion Whether to use series expansions of the Gaussian
+   *                        kernel when possible.
+   * @param seriesOrder Maximum order of the series expansions.
    */
   KDE(const double relError = KDEDefaultParams::relError,
       const double absError = KDEDefaultParams::absError,
@@ -120,7 +145,9 @@ class KDE
       const double mcProb = KDEDefaultParams::mcProb,
       const size_t initialSampleSize = KDEDefaultParams::initialSampleSize,
       const double mcEntryCoef = KDEDefaultParams::mcEntryCoef,
-      const double mcBreakCoef = KDEDefaultParams::mcBreakCoef);
+      const double mcBreakCoef = KDEDefaultParams::mcBreakCoef,
+      const bool seriesExpansion = KDEDefaultParams::seriesExpansion,
+      const size_t seriesOrder = KDEDefaultParams::seriesOrder);
 
   /**
    * Construct KDE object as a copy of the given model. This may be
@@ -173,6 +200,25 @@ class KDE
    */
   void Train(Tree* referenceTree, std::vector<size_t>* oldFromNewReferences);
 
+  /**
+   * Add points to the reference set of a trained model.  The reference tree is
+   * not built again: the added points are kept in a second tree, which is
+   * built again with each call and is only as large as the points added so
+   * far.  Once more points have been added than a quarter of the size of the
+   * reference tree, all points are merged into a new reference tree, so each
+   * point takes part in O(log n) builds of the reference tree, amortized.
+   *
+   * Evaluations use both trees, and monochromatic evaluations return the
+   * estimations of the added points after the ones of the original reference
+   * points, in the order they were added.
+   *
+   * - Use std::move if the new reference points are no longer needed.
+   *
+   * @pre The model has to be previously trained.
+   * @param newReferences Reference points to add.
+   */
+  void AddReferences(MatType newReferences);
+
   /**
    * Estimate density of each point in the query set given the data of the
    * reference set. The result is stored in an estimations vector.
@@ -235,6 +281,13 @@ class KDE
   //! Get the reference tree.
   Tree* ReferenceTree() { return referenceTree; }
 
+  //! Get the tree of the reference points added since the reference tree was
+  //! built, or nullptr if there are none.
+  Tree* AddedReferenceTree() { return addedReferenceTree; }
+
+  //! Get the number of reference points, including the added ones.
+  size_t NumReferences() const;
+
   //! Get relative error tolerance.
   double RelativeError() const { return relError; }
 
@@ -290,6 +343,18 @@ class KDE
   //! Modify Monte Carlo break coefficient. (0 < newCoef <= 1).
   void MCBreakCoef(const double newCoef);
 
+  //! Get whether series expansions are being used or not.
+  bool SeriesExpansion() const { return seriesExpansion; }
+
+  //! Modify whether series expansions are being used or not.
+  bool& SeriesExpansion() { return seriesExpansion; }
+
+  //! Get the maximum order of the series expansions.
+  size_t SeriesOrder() const { return seriesOrder; }
+
+  //! Modify the maximum order of the series expansions. (newOrder > 0).
+  void SeriesOrder(const size_t newOrder);
+
   //! Serialize the model.
   template<typename Archive>
   void serialize(Archive& ar, const unsigned int version);
@@ -307,6 +372,13 @@ class KDE
   //! Permutations of reference points.
   std::vector<size_t>* oldFromNewReferences;
 
+  //! Tree of the reference points added since the reference tree was built.
+  //! It is always owned by the KDE object.
+  Tree* addedReferenceTree;
+
+  //! Permutations of the added reference points.
+  std::vector<size_t>* oldFromNewAddedReferences;
+
   //! Relative error tolerance.
   double relError;
 
@@ -341,12 +413,63 @@ class KDE
   //! is the limit before Monte Carlo estimation recurses.
   double mcBreakCoef;
 
+  //! If true, series expansions of the Gaussian kernel will be used when
+  //! possible.
+  bool seriesExpansion;
+
+  //! Maximum order of the series expansions.
+  size_t seriesOrder;
+
   //! Check whether absolute and relative error values are compatible.
   static void CheckErrorValues(const double relError, const double absError);
 
   //! Rearrange estimations vector if required.
   static void RearrangeEstimations(const std::vector<size_t>& oldFromNew,
                                    arma::vec& estimations);
+
+  //! Get the dataset of a tree in its original order.
+  static MatType OriginalDataset(const Tree& tree,
+                                 const std::vector<size_t>* oldFromNew);
+
+  //! Delete the tree of added reference points, if there is one.
+  void DeleteAddedReferences();
+
+  /**
+   * Add the unnormalized estimations of the points of the query tree given the
+   * points of the reference tree to the given vector (in the order of the
+   * query tree dataset), using the current mode.
+   */
+  void EvaluateTrees(Tree* queryTree,
+                     Tree* referenceTree,
+                     const bool sameSet,
+                     arma::vec& estimations);
+
+  /**
+   * Add the unnormalized estimations of the points of the query tree given the
+   * points of the reference tree to the given vector, with dual-tree
+   * traversals of subtrees of the query tree in parallel.
+   */
+  void EvaluateDualTree(Tree* queryTree,
+                        Tree* referenceTree,
+                        const bool sameSet,
+                        arma::vec& estimations);
+
+  /**
+   * Add the unnormalized estimations of the query points given the points of
+   * the reference tree to the given vector, with single-tree traversals of the
+   * query points in parallel.
+   */
+  void EvaluateSingleTree(const MatType& querySet,
+                          Tree* referenceTree,
+                          const bool sameSet,
+                          arma::vec& estimations);
+
+  /**
+   * Get the series expansions to use with the given reference tree, and
+   * compute the expansions of its nodes if needed.  The returned object has a
+   * maximum order of 0 if series expansions are not used.
+   */
+  GaussianSeries PrepareSeries(Tree* referenceTree) const;
 };
 
 } // namespace kde
@@ -377,7 +500,7 @@ struct version<mlpack::kde::KDE<KernelType,
                                 DualTreeTraversalType,
                                 SingleTreeTraversalType>>
 {
-  typedef mpl::int_<1> type;
+  typedef mpl::int_<3> type;
   typedef mpl::integral_c_tag tag;
   BOOST_STATIC_CONSTANT(int, value = version::type::value);
   BOOST_MPL_ASSERT((boost::mpl::less<boost::mpl::int_<1>,
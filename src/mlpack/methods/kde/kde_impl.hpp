@@ -13,6 +13,12 @@
 #include "kde.hpp"
 #include "kde_rules.hpp"
 
+#include <mlpack/core/tree/subtree_frontier.hpp>
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace kde {
 
@@ -61,23 +67,29 @@ KDE(const double relError,
     const double mcProb,
     const size_t initialSampleSize,
     const double mcEntryCoef,
-    const double mcBreakCoef) :
+    const double mcBreakCoef,
+    const bool seriesExpansion,
+    const size_t seriesOrder) :
     kernel(kernel),
     metric(metric),
     referenceTree(nullptr),
     oldFromNewReferences(nullptr),
+    addedReferenceTree(nullptr),
+    oldFromNewAddedReferences(nullptr),
     relError(relError),
     absError(absError),
     ownsReferenceTree(false),
     trained(false),
     mode(mode),
     monteCarlo(monteCarlo),
-    initialSampleSize(initialSampleSize)
+    initialSampleSize(initialSampleSize),
+    seriesExpansion(seriesExpansion)
 {
   CheckErrorValues(relError, absError);
   MCProb(mcProb);
   MCEntryCoef(mcEntryCoef);
   MCBreakCoef(mcBreakCoef);
+  SeriesOrder(seriesOrder);
 }
 
 template<typename KernelType,
@@ -97,6 +109,8 @@ KDE<KernelType,
 KDE(const KDE& other) :
     kernel(KernelType(other.kernel)),
     metric(MetricType(other.metric)),
+    addedReferenceTree(nullptr),
+    oldFromNewAddedReferences(nullptr),
     relError(other.relError),
     absError(other.absError),
     ownsReferenceTree(other.ownsReferenceTree),
@@ -106,7 +120,9 @@ KDE(const KDE& other) :
     mcProb(other.mcProb),
     initialSampleSize(other.initialSampleSize),
     mcEntryCoef(other.mcEntryCoef),
-    mcBreakCoef(other.mcBreakCoef)
+    mcBreakCoef(other.mcBreakCoef),
+    seriesExpansion(other.seriesExpansion),
+    seriesOrder(other.seriesOrder)
 {
   if (trained)
   {
@@ -121,6 +137,14 @@ KDE(const KDE& other) :
       oldFromNewReferences = other.oldFromNewReferences;
       referenceTree = other.referenceTree;
     }
+
+    // The tree of added points is always owned.
+    if (other.addedReferenceTree)
+    {
+      oldFromNewAddedReferences =
+          new std::vector<size_t>(*other.oldFromNewAddedReferences);
+      addedReferenceTree = new Tree(*other.addedReferenceTree);
+    }
   }
 }
 
@@ -143,6 +167,8 @@ KDE(KDE&& other) :
     metric(std::move(other.metric)),
     referenceTree(other.referenceTree),
     oldFromNewReferences(other.oldFromNewReferences),
+    addedReferenceTree(other.addedReferenceTree),
+    oldFromNewAddedReferences(other.oldFromNewAddedReferences),
     relError(other.relError),
     absError(other.absError),
     ownsReferenceTree(other.ownsReferenceTree),
@@ -152,12 +178,16 @@ KDE(KDE&& other) :
     mcProb(other.mcProb),
     initialSampleSize(other.initialSampleSize),
     mcEntryCoef(other.mcEntryCoef),
-    mcBreakCoef(other.mcBreakCoef)
+    mcBreakCoef(other.mcBreakCoef),
+    seriesExpansion(other.seriesExpansion),
+    seriesOrder(other.seriesOrder)
 {
   other.kernel = std::move(KernelType());
   other.metric = std::move(MetricType());
   other.referenceTree = nullptr;
   other.oldFromNewReferences = nullptr;
+  other.addedReferenceTree = nullptr;
+  other.oldFromNewAddedReferences = nullptr;
   other.relError = KDEDefaultParams::relError;
   other.absError = KDEDefaultParams::absError;
   other.ownsReferenceTree = false;
@@ -168,6 +198,8 @@ KDE(KDE&& other) :
   other.initialSampleSize = KDEDefaultParams::initialSampleSize;
   other.mcEntryCoef = KDEDefaultParams::mcEntryCoef;
   other.mcBreakCoef = KDEDefaultParams::mcBreakCoef;
+  other.seriesExpansion = KDEDefaultParams::seriesExpansion;
+  other.seriesOrder = KDEDefaultParams::seriesOrder;
 }
 
 template<typename KernelType,
@@ -198,12 +230,17 @@ operator=(KDE other)
     delete referenceTree;
     delete oldFromNewReferences;
   }
+  DeleteAddedReferences();
 
   // Move the other object.
   this->kernel = std::move(other.kernel);
   this->metric = std::move(other.metric);
   this->referenceTree = std::move(other.referenceTree);
   this->oldFromNewReferences = std::move(other.oldFromNewReferences);
+  this->addedReferenceTree = other.addedReferenceTree;
+  this->oldFromNewAddedReferences = other.oldFromNewAddedReferences;
+  other.addedReferenceTree = nullptr;
+  other.oldFromNewAddedReferences = nullptr;
   this->relError = other.relError;
   this->absError = other.absError;
   this->ownsReferenceTree = other.ownsReferenceTree;
@@ -214,6 +251,8 @@ operator=(KDE other)
   this->initialSampleSize = other.initialSampleSize;
   this->mcEntryCoef = other.mcEntryCoef;
   this->mcBreakCoef = other.mcBreakCoef;
+  this->seriesExpansion = other.seriesExpansion;
+  this->seriesOrder = other.seriesOrder;
 
   return *this;
 }
@@ -239,6 +278,7 @@ KDE<KernelType,
     delete referenceTree;
     delete oldFromNewReferences;
   }
+  DeleteAddedReferences();
 }
 
 template<typename KernelType,
@@ -269,6 +309,7 @@ Train(MatType referenceSet)
     delete referenceTree;
     delete oldFromNewReferences;
   }
+  DeleteAddedReferences();
 
   this->ownsReferenceTree = true;
   Timer::Start("building_reference_tree");
@@ -307,6 +348,7 @@ Train(Tree* referenceTree, std::vector<size_t>* oldFromNewReferences)
     delete this->referenceTree;
     delete this->oldFromNewReferences;
   }
+  DeleteAddedReferences();
 
   this->ownsReferenceTree = false;
   this->referenceTree = referenceTree;
@@ -380,35 +422,12 @@ Evaluate(MatType querySet, arma::vec& estimations)
     Timer::Start("computing_kde");
 
     // Evaluate.
-    typedef KDERules<MetricType, KernelType, Tree> RuleType;
-    RuleType rules = RuleType(referenceTree->Dataset(),
-                              querySet,
-                              estimations,
-                              relError,
-                              absError,
-                              mcProb,
-                              initialSampleSize,
-                              mcEntryCoef,
-                              mcBreakCoef,
-                              metric,
-                              kernel,
-                              monteCarlo,
-                              false);
-
-    // Create traverser.
-    SingleTreeTraversalType<RuleType> traverser(rules);
+    EvaluateSingleTree(querySet, referenceTree, false, estimations);
+    if (addedReferenceTree)
+      EvaluateSingleTree(querySet, addedReferenceTree, false, estimations);
 
-    // Traverse for each point.
-    for (size_t i = 0; i < querySet.n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
-
-    estimations /= referenceTree->Dataset().n_cols;
+    estimations /= NumReferences();
     Timer::Stop("computing_kde");
-
-    Log::Info << rules.Scores() << " node combinations were scored."
-              << std::endl;
-    Log::Info << rules.BaseCases() << " base cases were calculated."
-              << std::endl;
   }
 }
 
@@ -478,32 +497,15 @@ Evaluate(Tree* queryTree,
   Timer::Start("computing_kde");
 
   // Evaluate.
-  typedef KDERules<MetricType, KernelType, Tree> RuleType;
-  RuleType rules = RuleType(referenceTree->Dataset(),
-                            queryTree->Dataset(),
-                            estimations,
-                            relError,
-                            absError,
-                            mcProb,
-                            initialSampleSize,
-                            mcEntryCoef,
-                            mcBreakCoef,
-                            metric,
-                            kernel,
-                            monteCarlo,
-                            false);
-
-  // Create traverser.
-  DualTreeTraversalType<RuleType> traverser(rules);
-  traverser.Traverse(*queryTree, *referenceTree);
-  estimations /= referenceTree->Dataset().n_cols;
+  EvaluateDualTree(queryTree, referenceTree, false, estimations);
+  if (addedReferenceTree)
+    EvaluateDualTree(queryTree, addedReferenceTree, false, estimations);
+
+  estimations /= NumReferences();
   Timer::Stop("computing_kde");
 
   // Rearrange if necessary.
   RearrangeEstimations(oldFromNewQueries, estimations);
-
-  Log::Info << rules.Scores() << " node combinations were scored." << std::endl;
-  Log::Info << rules.BaseCases() << " base cases were calculated." << std::endl;
 }
 
 template<typename KernelType,
@@ -541,47 +543,139 @@ Evaluate(arma::vec& estimations)
     KDECleanRules<Tree> cleanRules;
     SingleTreeTraversalType<KDECleanRules<Tree>> cleanTraverser(cleanRules);
     cleanTraverser.Traverse(0, *referenceTree);
+    if (addedReferenceTree)
+      cleanTraverser.Traverse(0, *addedReferenceTree);
     Timer::Stop("cleaning_query_tree");
   }
 
   Timer::Start("computing_kde");
 
   // Evaluate.
-  typedef KDERules<MetricType, KernelType, Tree> RuleType;
-  RuleType rules = RuleType(referenceTree->Dataset(),
-                            referenceTree->Dataset(),
-                            estimations,
-                            relError,
-                            absError,
-                            mcProb,
-                            initialSampleSize,
-                            mcEntryCoef,
-                            mcBreakCoef,
-                            metric,
-                            kernel,
-                            monteCarlo,
-                            true);
-
-  if (mode == DUAL_TREE_MODE)
+  EvaluateTrees(referenceTree, referenceTree, true, estimations);
+  if (addedReferenceTree)
   {
-    // Create traverser.
-    DualTreeTraversalType<RuleType> traverser(rules);
-    traverser.Traverse(*referenceTree, *referenceTree);
+    // The added points are query points too.
+    arma::vec addedEstimations(addedReferenceTree->Dataset().n_cols,
+        arma::fill::zeros);
+    EvaluateTrees(referenceTree, addedReferenceTree, false, estimations);
+    EvaluateTrees(addedReferenceTree, referenceTree, false, addedEstimations);
+    EvaluateTrees(addedReferenceTree, addedReferenceTree, true,
+        addedEstimations);
+
+    // Rearrange if necessary, and put the added points last.
+    RearrangeEstimations(*oldFromNewReferences, estimations);
+    RearrangeEstimations(*oldFromNewAddedReferences, addedEstimations);
+    estimations = arma::join_cols(estimations, addedEstimations);
   }
-  else if (mode == SINGLE_TREE_MODE)
+  else
   {
-    SingleTreeTraversalType<RuleType> traverser(rules);
-    for (size_t i = 0; i < referenceTree->Dataset().n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
+    // Rearrange if necessary.
+    RearrangeEstimations(*oldFromNewReferences, estimations);
   }
 
-  estimations /= referenceTree->Dataset().n_cols;
-  // Rearrange if necessary.
-  RearrangeEstimations(*oldFromNewReferences, estimations);
+  estimations /= NumReferences();
   Timer::Stop("computing_kde");
+}
+
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+AddReferences(MatType newReferences)
+{
+  // Check whether has already been trained.
+  if (!trained)
+  {
+    throw std::runtime_error("cannot add reference points to KDE model: "
+                             "model needs to be trained first");
+  }
+
+  if (newReferences.n_cols == 0)
+    return;
+
+  // Check whether dimensions match.
+  if (newReferences.n_rows != referenceTree->Dataset().n_rows)
+  {
+    throw std::invalid_argument("cannot add reference points to KDE model: "
+                                "new points and referenceSet dimensions don't "
+                                "match");
+  }
+
+  // Gather all the added points, in the order they were added.
+  MatType addedReferences;
+  if (addedReferenceTree)
+  {
+    addedReferences = arma::join_rows(OriginalDataset(*addedReferenceTree,
+        oldFromNewAddedReferences), newReferences);
+    DeleteAddedReferences();
+  }
+  else
+  {
+    addedReferences = std::move(newReferences);
+  }
+
+  Timer::Start("building_reference_tree");
+  if (4 * addedReferences.n_cols > referenceTree->Dataset().n_cols)
+  {
+    // There are enough added points to build the reference tree again with
+    // all the points.
+    MatType referenceSet = arma::join_rows(OriginalDataset(*referenceTree,
+        oldFromNewReferences), addedReferences);
+
+    if (ownsReferenceTree)
+    {
+      delete referenceTree;
+      delete oldFromNewReferences;
+    }
+
+    ownsReferenceTree = true;
+    oldFromNewReferences = new std::vector<size_t>;
+    referenceTree = BuildTree<Tree>(std::move(referenceSet),
+                                    *oldFromNewReferences);
+  }
+  else
+  {
+    oldFromNewAddedReferences = new std::vector<size_t>;
+    addedReferenceTree = BuildTree<Tree>(std::move(addedReferences),
+                                         *oldFromNewAddedReferences);
+  }
+  Timer::Stop("building_reference_tree");
+}
+
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+size_t KDE<KernelType,
+           MetricType,
+           MatType,
+           TreeType,
+           DualTreeTraversalType,
+           SingleTreeTraversalType>::
+NumReferences() const
+{
+  if (!trained)
+    return 0;
 
-  Log::Info << rules.Scores() << " node combinations were scored." << std::endl;
-  Log::Info << rules.BaseCases() << " base cases were calculated." << std::endl;
+  size_t numReferences = referenceTree->Dataset().n_cols;
+  if (addedReferenceTree)
+    numReferences += addedReferenceTree->Dataset().n_cols;
+
+  return numReferences;
 }
 
 template<typename KernelType,
@@ -697,6 +791,30 @@ MCBreakCoef(const double newCoef)
   mcBreakCoef = newCoef;
 }
 
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+SeriesOrder(const size_t newOrder)
+{
+  if (newOrder == 0)
+  {
+    throw std::invalid_argument("Series expansion order must be greater than "
+                                "0");
+  }
+  seriesOrder = newOrder;
+}
+
 template<typename KernelType,
          typename MetricType,
          typename MatType,
@@ -747,6 +865,7 @@ serialize(Archive& ar, const unsigned int version)
       delete referenceTree;
       delete oldFromNewReferences;
     }
+    DeleteAddedReferences();
     // After loading tree, we own it.
     ownsReferenceTree = true;
   }
@@ -756,6 +875,32 @@ serialize(Archive& ar, const unsigned int version)
   ar & BOOST_SERIALIZATION_NVP(metric);
   ar & BOOST_SERIALIZATION_NVP(referenceTree);
   ar & BOOST_SERIALIZATION_NVP(oldFromNewReferences);
+
+  // Backward compatibility: Old versions of KDE did not have added reference
+  // points.
+  if (version > 1)
+  {
+    bool hasAddedReferences = (addedReferenceTree != nullptr);
+    ar & BOOST_SERIALIZATION_NVP(hasAddedReferences);
+    if (hasAddedReferences)
+    {
+      ar & BOOST_SERIALIZATION_NVP(addedReferenceTree);
+      ar & BOOST_SERIALIZATION_NVP(oldFromNewAddedReferences);
+    }
+  }
+
+  // Backward compatibility: Old versions of KDE did not have series
+  // expansions.
+  if (version > 2)
+  {
+    ar & BOOST_SERIALIZATION_NVP(seriesExpansion);
+    ar & BOOST_SERIALIZATION_NVP(seriesOrder);
+  }
+  else if (Archive::is_loading::value)
+  {
+    seriesExpansion = KDEDefaultParams::seriesExpansion;
+    seriesOrder = KDEDefaultParams::seriesOrder;
+  }
 }
 
 template<typename KernelType,
@@ -816,5 +961,261 @@ RearrangeEstimations(const std::vector<size_t>& oldFromNew,
   }
 }
 
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+MatType KDE<KernelType,
+            MetricType,
+            MatType,
+            TreeType,
+            DualTreeTraversalType,
+            SingleTreeTraversalType>::
+OriginalDataset(const Tree& sourceTree, const std::vector<size_t>* oldFromNew)
+{
+  if (!tree::TreeTraits<Tree>::RearrangesDataset || !oldFromNew)
+    return sourceTree.Dataset();
+
+  MatType dataset(sourceTree.Dataset().n_rows, sourceTree.Dataset().n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    dataset.col((*oldFromNew)[i]) = sourceTree.Dataset().col(i);
+
+  return dataset;
+}
+
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+DeleteAddedReferences()
+{
+  delete addedReferenceTree;
+  delete oldFromNewAddedReferences;
+  addedReferenceTree = nullptr;
+  oldFromNewAddedReferences = nullptr;
+}
+
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+EvaluateTrees(Tree* queryTree,
+              Tree* referenceTree,
+              const bool sameSet,
+              arma::vec& estimations)
+{
+  if (mode == DUAL_TREE_MODE)
+  {
+    EvaluateDualTree(queryTree, referenceTree, sameSet, estimations);
+  }
+  else if (mode == SINGLE_TREE_MODE)
+  {
+    EvaluateSingleTree(queryTree->Dataset(), referenceTree, sameSet,
+        estimations);
+  }
+}
+
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+EvaluateDualTree(Tree* queryTree,
+                 Tree* referenceTree,
+                 const bool sameSet,
+                 arma::vec& estimations)
+{
+  typedef KDERules<MetricType, KernelType, Tree> RuleType;
+
+  // Monte Carlo estimations draw from the shared random number generator, so
+  // they are done on one thread.  Otherwise, the query tree is split into a
+  // few subtrees per thread, which are traversed in parallel.  The statistics
+  // of each query node are only modified by the traversal of its subtree.
+  const bool useMonteCarlo = monteCarlo &&
+      std::is_same<KernelType, kernel::GaussianKernel>::value;
+  size_t numTasks = 1;
+  #ifdef HAS_OPENMP
+    if (!useMonteCarlo)
+      numTasks = 4 * omp_get_max_threads();
+  #endif
+  std::vector<Tree*> queryNodes = tree::SubtreeFrontier(*queryTree, numTasks);
+
+  // Each reference tree gets its share of the absolute error tolerance.
+  const double treeAbsError = absError * referenceTree->Dataset().n_cols /
+      NumReferences();
+
+  const GaussianSeries series = PrepareSeries(referenceTree);
+
+  size_t scores = 0;
+  size_t baseCases = 0;
+  #pragma omp parallel if (!useMonteCarlo) reduction(+:scores, baseCases)
+  {
+    // The rules hold the accumulated error tolerances, so each thread has its
+    // own.
+    MetricType threadMetric(metric);
+    KernelType threadKernel(kernel);
+    RuleType rules(referenceTree->Dataset(),
+                   queryTree->Dataset(),
+                   estimations,
+                   relError,
+                   treeAbsError,
+                   mcProb,
+                   initialSampleSize,
+                   mcEntryCoef,
+                   mcBreakCoef,
+                   threadMetric,
+                   threadKernel,
+                   monteCarlo,
+                   sameSet,
+                   series.MaxOrder() > 0 ? &series : nullptr);
+
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) queryNodes.size(); ++i)
+    {
+      rules.TraversalInfo() = typename RuleType::TraversalInfoType();
+      DualTreeTraversalType<RuleType> traverser(rules);
+      traverser.Traverse(*queryNodes[i], *referenceTree);
+    }
+
+    scores += rules.Scores();
+    baseCases += rules.BaseCases();
+  }
+
+  Log::Info << scores << " node combinations were scored." << std::endl;
+  Log::Info << baseCases << " base cases were calculated." << std::endl;
+}
+
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+EvaluateSingleTree(const MatType& querySet,
+                   Tree* referenceTree,
+                   const bool sameSet,
+                   arma::vec& estimations)
+{
+  typedef KDERules<MetricType, KernelType, Tree> RuleType;
+
+  // Monte Carlo estimations draw from the shared random number generator, so
+  // they are done on one thread.
+  const bool useMonteCarlo = monteCarlo &&
+      std::is_same<KernelType, kernel::GaussianKernel>::value;
+
+  // Each reference tree gets its share of the absolute error tolerance.
+  const double treeAbsError = absError * referenceTree->Dataset().n_cols /
+      NumReferences();
+
+  const GaussianSeries series = PrepareSeries(referenceTree);
+
+  size_t scores = 0;
+  size_t baseCases = 0;
+  #pragma omp parallel if (!useMonteCarlo) reduction(+:scores, baseCases)
+  {
+    // The rules hold the accumulated error tolerances, so each thread has its
+    // own.
+    MetricType threadMetric(metric);
+    KernelType threadKernel(kernel);
+    RuleType rules(referenceTree->Dataset(),
+                   querySet,
+                   estimations,
+                   relError,
+                   treeAbsError,
+                   mcProb,
+                   initialSampleSize,
+                   mcEntryCoef,
+                   mcBreakCoef,
+                   threadMetric,
+                   threadKernel,
+                   monteCarlo,
+                   sameSet,
+                   series.MaxOrder() > 0 ? &series : nullptr);
+
+    // Create traverser.
+    SingleTreeTraversalType<RuleType> traverser(rules);
+
+    // Traverse for each point.
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+      traverser.Traverse(i, *referenceTree);
+
+    scores += rules.Scores();
+    baseCases += rules.BaseCases();
+  }
+
+  Log::Info << scores << " node combinations were scored." << std::endl;
+  Log::Info << baseCases << " base cases were calculated." << std::endl;
+}
+
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+GaussianSeries KDE<KernelType,
+                   MetricType,
+                   MatType,
+                   TreeType,
+                   DualTreeTraversalType,
+                   SingleTreeTraversalType>::
+PrepareSeries(Tree* referenceTree) const
+{
+  // The expansions only hold for the Gaussian kernel with the Euclidean
+  // distance; otherwise, an object with no expansions is returned.
+  const bool useSeries = seriesExpansion &&
+      std::is_same<KernelType, kernel::GaussianKernel>::value &&
+      std::is_same<MetricType, metric::EuclideanDistance>::value;
+
+  GaussianSeries series(referenceTree->Dataset().n_rows,
+      useSeries ? seriesOrder : 0, GaussianSeries::Scale(kernel));
+  series.ComputeExpansions(*referenceTree);
+  return series;
+}
+
 } // namespace kde
 } // namespace mlpack
@@ -171,6 +171,27 @@ class TrainVisitor : public boost::static_visitor<void>
   TrainVisitor(arma::mat&& referenceSet);
 };
 
+/**
+ * AddReferencesVisitor adds reference points to a trained KDEType.
+ */
+class AddReferencesVisitor : public boost::static_visitor<void>
+{
+ private:
+  //! The reference points to add.
+  arma::mat&& newReferences;
+
+ public:
+  //! Default AddReferencesVisitor on some KDEType.
+  template<typename KernelType,
+           template<typename TreeMetricType,
+                    typename TreeStatType,
+                    typename TreeMatType> class TreeType>
+  void operator()(KDEType<KernelType, TreeType>* kde) const;
+
+  //! AddReferencesVisitor constructor. Takes ownership of the given points.
+  AddReferencesVisitor(arma::mat&& newReferences);
+};
+
 /**
  * BandwidthVisitor modifies the bandwidth of a KDEType kernel.
  */
@@ -576,6 +597,17 @@ class KDEModel
    */
   void BuildModel(arma::mat&& referenceSet);
 
+  /**
+   * Add points to the reference set of the model, without building the whole
+   * reference tree again.  See KDE::AddReferences() for details.
+   * Takes possession of the new points to avoid a copy, so they will not be
+   * usable after this.
+   *
+   * @pre The model has to be previously created with BuildModel.
+   * @param newReferences Set of reference points to add.
+   */
+  void AddReferences(arma::mat&& newReferences);
+
   /**
    * Perform kernel density estimation on the given query set.
    * Takes possession of the query set to avoid a copy, so the query set
@@ -269,6 +269,13 @@ inline void KDEModel::BuildModel(arma::mat&& referenceSet)
   boost::apply_visitor(train, kdeModel);
 }
 
+// Add reference points.
+inline void KDEModel::AddReferences(arma::mat&& newReferences)
+{
+  AddReferencesVisitor addReferences(std::move(newReferences));
+  boost::apply_visitor(addReferences, kdeModel);
+}
+
 // Perform bichromatic evaluation.
 inline void KDEModel::Evaluate(arma::mat&& querySet, arma::vec& estimations)
 {
@@ -363,6 +370,25 @@ void TrainVisitor::operator()(KDEType<KernelType, TreeType>* kde) const
     throw std::runtime_error("no KDE model initialized");
 }
 
+// Parameters for AddReferences.
+AddReferencesVisitor::AddReferencesVisitor(arma::mat&& newReferences) :
+    newReferences(std::move(newReferences))
+{}
+
+// Default AddReferences.
+template<typename KernelType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void AddReferencesVisitor::operator()(KDEType<KernelType, TreeType>* kde) const
+{
+  Log::Info << "Adding reference points to KDE model..." << std::endl;
+  if (kde)
+    kde->AddReferences(std::move(newReferences));
+  else
+    throw std::runtime_error("no KDE model initialized");
+}
+
 // Modify kernel bandwidth.
 BandwidthVisitor::BandwidthVisitor(const double bandwidth) :
     bandwidth(bandwidth)
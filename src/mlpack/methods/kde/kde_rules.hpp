@@ -15,12 +15,19 @@
 
 #include <mlpack/core/tree/traversal_info.hpp>
 
+#include "gaussian_series.hpp"
+
 namespace mlpack {
 namespace kde {
 
 /**
  * A dual-tree traversal Rules class for kernel density estimation.  This
  * contains the Score() and BaseCase() implementations.
+ *
+ * If a GaussianSeries is given, reference nodes that cannot be pruned but have
+ * a series expansion (see GaussianSeries::ComputeExpansions()) are estimated
+ * with the lowest order of their expansion that meets the error tolerance,
+ * before Monte Carlo estimations are tried.
  */
 template<typename MetricType, typename KernelType, typename TreeType>
 class KDERules
@@ -45,6 +52,8 @@ class KDERules
    *                   possible.
    * @param sameSet True if query and reference sets are the same
    *                (monochromatic evaluation).
+   * @param series Series expansions of the Gaussian kernel to use, or nullptr
+   *               to use none.  The metric must be the Euclidean distance.
    */
   KDERules(const arma::mat& referenceSet,
            const arma::mat& querySet,
@@ -58,7 +67,8 @@ class KDERules
            MetricType& metric,
            KernelType& kernel,
            const bool monteCarlo,
-           const bool sameSet);
+           const bool sameSet,
+           const GaussianSeries* series = nullptr);
 
   //! Base Case.
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
@@ -105,6 +115,11 @@ class KDERules
   //! Calculate depth alpha for some node.
   double CalculateAlpha(TreeType* node);
 
+  //! Check whether the series expansion of the reference node can be used,
+  //! given the minimum distance of the query points to the node.
+  bool CanUseSeries(const TreeType& referenceNode,
+                    const double minDistance) const;
+
   //! The reference set.
   const arma::mat& referenceSet;
 
@@ -154,6 +169,9 @@ class KDERules
   //! Whether reference and query sets are the same.
   const bool sameSet;
 
+  //! Series expansions of the Gaussian kernel, or nullptr if none are used.
+  const GaussianSeries* series;
+
   //! Whether the kernel used for the rule is the Gaussian Kernel.
   constexpr static bool kernelIsGaussian =
       std::is_same<KernelType, kernel::GaussianKernel>::value;
@@ -36,7 +36,8 @@ KDERules<MetricType, KernelType, TreeType>::KDERules(
     MetricType& metric,
     KernelType& kernel,
     const bool monteCarlo,
-    const bool sameSet) :
+    const bool sameSet,
+    const GaussianSeries* series) :
     referenceSet(referenceSet),
     querySet(querySet),
     densities(densities),
@@ -50,6 +51,7 @@ KDERules<MetricType, KernelType, TreeType>::KDERules(
     kernel(kernel),
     monteCarlo(monteCarlo),
     sameSet(sameSet),
+    series(series),
     absErrorTol(absError / referenceSet.n_cols),
     lastQueryIndex(querySet.n_cols),
     lastReferenceIndex(referenceSet.n_cols),
@@ -154,13 +156,28 @@ Score(const size_t queryIndex, TreeType& referenceNode)
   // We relax the bound for pruning by accumError(queryIndex), so that if there
   // is any leftover error tolerance from the rest of the traversal, we can use
   // it here to prune more.
-  double pointAccumErrorTol;
-  if (alreadyDidRefPoint0)
-    pointAccumErrorTol = accumError(queryIndex) / (refNumDesc - 1);
-  else
-    pointAccumErrorTol = accumError(queryIndex) / refNumDesc;
+  const size_t numEstimated = alreadyDidRefPoint0 ? refNumDesc - 1 :
+      refNumDesc;
+  const double pointAccumErrorTol = accumError(queryIndex) / numEstimated;
+  const bool canPrune = (bound <= 2 * errorTolerance + pointAccumErrorTol);
+
+  // Otherwise, check whether the series expansion of the node is accurate
+  // enough.  It approximates all the descendants of the node, so each of them
+  // may use at most its share of the error tolerance of the estimated points.
+  size_t seriesOrder = 0;
+  double seriesError = 0.0;
+  if (!canPrune && CanUseSeries(referenceNode, minDistance))
+  {
+    const KDEStat& referenceStat = referenceNode.Stat();
+    const double centerDistance =
+        metric.Evaluate(queryPoint, referenceStat.SeriesCenter());
+    const double maxError = (numEstimated * errorTolerance +
+        accumError(queryIndex) / 2) / refNumDesc;
+    seriesOrder = series->Order(math::Range(centerDistance, centerDistance),
+        referenceStat.SeriesRadius(), maxError, refNumDesc, seriesError);
+  }
 
-  if (bound <= 2 * errorTolerance + pointAccumErrorTol)
+  if (canPrune)
   {
     // Estimate kernel value.
     const double kernelValue = (maxKernel + minKernel) / 2.0;
@@ -184,6 +201,26 @@ Score(const size_t queryIndex, TreeType& referenceNode)
     if (kernelIsGaussian && monteCarlo)
       accumMCAlpha(queryIndex) += depthAlpha;
   }
+  else if (seriesOrder > 0)
+  {
+    // Estimate the sum of the kernel values with the series expansion.
+    double estimation = series->Evaluate(referenceNode.Stat(), queryPoint,
+        seriesOrder);
+    if (alreadyDidRefPoint0)
+      estimation -= EvaluateKernel(queryIndex, referenceNode.Point(0));
+    densities(queryIndex) += estimation;
+
+    // Don't explore this tree branch.
+    score = DBL_MAX;
+
+    // Subtract used error tolerance or add extra available tolerance.
+    accumError(queryIndex) -= 2 * (refNumDesc * seriesError -
+        numEstimated * errorTolerance);
+
+    // Store not used alpha for Monte Carlo.
+    if (kernelIsGaussian && monteCarlo)
+      accumMCAlpha(queryIndex) += depthAlpha;
+  }
   else if (monteCarlo &&
            refNumDesc >= mcAccessCoef * initialSampleSize &&
            kernelIsGaussian)
@@ -366,9 +403,23 @@ Score(TreeType& queryNode, TreeType& referenceNode)
   // is any leftover error tolerance from the rest of the traversal, we can use
   // it here to prune more.
   const double pointAccumErrorTol = queryStat.AccumError() / refNumDesc;
+  const bool canPrune = (bound <= 2 * errorTolerance + pointAccumErrorTol);
+
+  // Otherwise, check whether the series expansion of the reference node is
+  // accurate enough for every query point of the query node.
+  size_t seriesOrder = 0;
+  double seriesError = 0.0;
+  if (!canPrune && CanUseSeries(referenceNode, minDistance))
+  {
+    const KDEStat& referenceStat = referenceNode.Stat();
+    const math::Range centerDistances =
+        queryNode.RangeDistance(referenceStat.SeriesCenter());
+    seriesOrder = series->Order(centerDistances, referenceStat.SeriesRadius(),
+        errorTolerance + pointAccumErrorTol / 2, refNumDesc, seriesError);
+  }
 
   // If possible, avoid some calculations because of the error tolerance.
-  if (bound <= 2 * errorTolerance + pointAccumErrorTol)
+  if (canPrune)
   {
     // Estimate kernel value.
     const double kernelValue = (maxKernel + minKernel) / 2.0;
@@ -393,6 +444,30 @@ Score(TreeType& queryNode, TreeType& referenceNode)
     if (kernelIsGaussian && monteCarlo)
       queryStat.AccumAlpha() += depthAlpha;
   }
+  else if (seriesOrder > 0)
+  {
+    // Estimate the sum of the kernel values for each query point with the
+    // series expansion.
+    for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
+    {
+      const size_t queryIndex = queryNode.Descendant(i);
+      double estimation = series->Evaluate(referenceNode.Stat(),
+          querySet.unsafe_col(queryIndex), seriesOrder);
+      if (alreadyDidRefPoint0 && i == 0)
+        estimation -= EvaluateKernel(queryIndex, referenceNode.Point(0));
+      densities(queryIndex) += estimation;
+    }
+
+    // Prune.
+    score = DBL_MAX;
+
+    // Subtract used error tolerance or add extra available tolerance.
+    queryStat.AccumError() -= 2 * refNumDesc * (seriesError - errorTolerance);
+
+    // Store not used alpha for Monte Carlo.
+    if (kernelIsGaussian && monteCarlo)
+      queryStat.AccumAlpha() += depthAlpha;
+  }
   else if (monteCarlo &&
            refNumDesc >= mcAccessCoef * initialSampleSize &&
            kernelIsGaussian)
@@ -573,6 +648,16 @@ CalculateAlpha(TreeType* node)
   return stat.MCAlpha();
 }
 
+template<typename MetricType, typename KernelType, typename TreeType>
+inline force_inline bool KDERules<MetricType, KernelType, TreeType>::
+CanUseSeries(const TreeType& referenceNode, const double minDistance) const
+{
+  // In monochromatic evaluations, the expansion would include the kernel
+  // value of a query point with itself if it is in the reference node.
+  return series != nullptr && !(sameSet && minDistance == 0.0) &&
+      series->HasExpansion(referenceNode.Stat());
+}
+
 //! Clean rules base case.
 template<typename TreeType>
 inline force_inline
@@ -29,7 +29,9 @@ class KDEStat
       mcBeta(0),
       mcAlpha(0),
       accumAlpha(0),
-      accumError(0)
+      accumError(0),
+      seriesRadius(0),
+      seriesScale(0)
   { /* Nothing to do.*/ }
 
   //! Initialization for a fully initialized node.
@@ -38,7 +40,9 @@ class KDEStat
       mcBeta(0),
       mcAlpha(0),
       accumAlpha(0),
-      accumError(0)
+      accumError(0),
+      seriesRadius(0),
+      seriesScale(0)
   { /* Nothing to do. */ }
 
   //! Get accumulated Monte Carlo alpha of the node.
@@ -65,6 +69,33 @@ class KDEStat
   //! Modify Monte Carlo alpha of the node.
   inline double& MCAlpha() { return mcAlpha; }
 
+  //! Get the center of the series expansion of the node.
+  inline const arma::vec& SeriesCenter() const { return seriesCenter; }
+
+  //! Modify the center of the series expansion of the node.
+  inline arma::vec& SeriesCenter() { return seriesCenter; }
+
+  //! Get the coefficients of the series expansion of the node.
+  inline const arma::vec& SeriesCoefficients() const
+  { return seriesCoefficients; }
+
+  //! Modify the coefficients of the series expansion of the node.
+  inline arma::vec& SeriesCoefficients() { return seriesCoefficients; }
+
+  //! Get the largest distance of a descendant to the center of the series
+  //! expansion of the node.
+  inline double SeriesRadius() const { return seriesRadius; }
+
+  //! Modify the largest distance of a descendant to the center of the series
+  //! expansion of the node.
+  inline double& SeriesRadius() { return seriesRadius; }
+
+  //! Get the scale of the series expansion of the node (0 if there is none).
+  inline double SeriesScale() const { return seriesScale; }
+
+  //! Modify the scale of the series expansion of the node.
+  inline double& SeriesScale() { return seriesScale; }
+
   //! Serialize the statistic to/from an archive.
   template<typename Archive>
   void serialize(Archive& ar, const unsigned int version)
@@ -97,6 +128,16 @@ class KDEStat
       accumAlpha = -1;
       accumError = -1;
     }
+
+    // Series expansions are not serialized; they are computed again when
+    // needed.
+    if (Archive::is_loading::value)
+    {
+      seriesCenter.clear();
+      seriesCoefficients.clear();
+      seriesRadius = 0;
+      seriesScale = 0;
+    }
   }
 
  private:
@@ -111,6 +152,18 @@ class KDEStat
 
   //! Accumulated not used error tolerance in the current node.
   double accumError;
+
+  //! Center of the series expansion of the Gaussian kernel in the node.
+  arma::vec seriesCenter;
+
+  //! Coefficients of the series expansion of the Gaussian kernel in the node.
+  arma::vec seriesCoefficients;
+
+  //! Largest distance of a descendant to the center of the series expansion.
+  double seriesRadius;
+
+  //! Scale of the series expansion, or 0 if the node has no expansion.
+  double seriesScale;
 };
 
 } // namespace kde
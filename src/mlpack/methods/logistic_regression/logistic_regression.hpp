@@ -17,6 +17,8 @@
 #include <mlpack/prereqs.hpp>
 #include <ensmallen.hpp>
 
+#include <mlpack/core/data/minibatch_function.hpp>
+
 #include "logistic_regression_function.hpp"
 
 namespace mlpack {
@@ -162,6 +164,32 @@ class LogisticRegression
                OptimizerType& optimizer,
                CallbackTypes&&... callbacks);
 
+  /**
+   * Train the LogisticRegression model on the batches of the given minibatch
+   * source (see data::MatrixSource, data::CSVSource and data::PrefetchSource),
+   * with the given instantiated optimizer.  The predictors do not need to be
+   * held in memory: the optimizer sees a data::MinibatchFunction, which only
+   * loads the batches that are used, and shuffling only shuffles the order of
+   * the source.  The model is initialized to zeros before training, and the
+   * objective is the same as when training on the whole matrix.
+   *
+   * @tparam SourceType Type of the minibatch source.
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param source Source of the predictors and responses.
+   * @param optimizer Instantiated optimizer.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The final objective of the trained model (NaN or Inf on error)
+   */
+  template<typename SourceType, typename OptimizerType,
+           typename... CallbackTypes>
+  typename std::enable_if<data::IsMinibatchSource<SourceType>::value,
+      double>::type
+  Train(SourceType& source,
+        OptimizerType& optimizer,
+        CallbackTypes&&... callbacks);
+
   //! Return the parameters (the b vector).
   const arma::rowvec& Parameters() const { return parameters; }
   //! Modify the parameters (the b vector).
@@ -101,6 +101,42 @@ double LogisticRegression<MatType>::Train(
   return out;
 }
 
+template<typename MatType>
+template<typename SourceType, typename OptimizerType,
+         typename... CallbackTypes>
+typename std::enable_if<data::IsMinibatchSource<SourceType>::value,
+    double>::type
+LogisticRegression<MatType>::Train(
+    SourceType& source,
+    OptimizerType& optimizer,
+    CallbackTypes&&... callbacks)
+{
+  // Each batch of b points gets b / n of the regularization, as in
+  // LogisticRegressionFunction::Evaluate() for a batch.
+  const double lambda = this->lambda;
+  data::MinibatchFunction<SourceType, LogisticRegressionFunction<MatType>>
+      errorFunction(source, [lambda](const MatType& predictors,
+                                     const arma::Row<size_t>& responses,
+                                     const size_t numPoints)
+      {
+        return LogisticRegressionFunction<MatType>(predictors, responses,
+            lambda * predictors.n_cols / numPoints);
+      });
+
+  // Set size of parameters vector according to the input data received.
+  parameters = arma::rowvec(source.Dimensionality() + 1, arma::fill::zeros);
+
+  Timer::Start("logistic_regression_optimization");
+  const double out = optimizer.Optimize(errorFunction, parameters,
+      callbacks...);
+  Timer::Stop("logistic_regression_optimization");
+
+  Log::Info << "LogisticRegression::LogisticRegression(): final objective of "
+      << "trained model is " << out << "." << std::endl;
+
+  return out;
+}
+
 template<typename MatType>
 template<typename VecType>
 size_t LogisticRegression<MatType>::Classify(const VecType& point,
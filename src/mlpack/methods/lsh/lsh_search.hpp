@@ -294,6 +294,16 @@ class LSHSearch
   const std::vector<arma::Col<size_t>>& SecondHashTable() const
       { return secondHashTable; }
 
+  /**
+   * Get the offsets of each row of the second hash table into
+   * BucketContents(), the compact layout used during search.  Row i holds the elements BucketOffsets()[i] through
+   * BucketOffsets()[i + 1] - 1, so there are (number of rows + 1) offsets.
+   */
+  const arma::Col<size_t>& BucketOffsets() const { return bucketOffsets; }
+
+  //! Get the packed point indices of every row of the second hash table.
+  const arma::Col<arma::u32>& BucketContents() const { return bucketContents; }
+
   //! Get the projection tables.
   const arma::cube& Projections() { return projections; }
 
@@ -306,6 +316,9 @@ class LSHSearch
   }
 
  private:
+  //! Fill secondHashTable from bucketOffsets and bucketContents.
+  void UnpackSecondHashTable();
+
   /**
    * This function takes a query and hashes it into each of the hash tables to
    * get keys for the query and then the key is hashed to a bucket of the second
@@ -316,6 +329,9 @@ class LSHSearch
    * @param referenceIndices The list of neighbor candidates obtained from
    *    hashing the query into all the hash tables and eventually into
    *    multiple buckets of the second hash table.
+   * @param candidateMarkers Scratch bitset of length referenceSet.n_cols used
+   *    to discard duplicate candidates.  It must be all false on entry, and is
+   *    all false again on return, so that each thread can reuse one.
    * @param numTablesToSearch The number of tables to perform the search in. If
    *    0, all tables are searched.
    * @param T The number of additional probing bins for multiprobe LSH. If 0,
@@ -323,7 +339,8 @@ class LSHSearch
    */
   template<typename VecType>
   void ReturnIndicesFromTable(const VecType& queryPoint,
-                              arma::uvec& referenceIndices,
+                              std::vector<size_t>& referenceIndices,
+                              std::vector<bool>& candidateMarkers,
                               size_t numTablesToSearch,
                               const size_t T) const;
 
@@ -341,7 +358,7 @@ class LSHSearch
    * @param distances Matrix holding output distances.
    */
   void BaseCase(const size_t queryIndex,
-                const arma::uvec& referenceIndices,
+                const std::vector<size_t>& referenceIndices,
                 const size_t k,
                 arma::Mat<size_t>& neighbors,
                 arma::mat& distances) const;
@@ -361,7 +378,7 @@ class LSHSearch
    * @param distances Matrix holding output distances.
    */
   void BaseCase(const size_t queryIndex,
-                const arma::uvec& referenceIndices,
+                const std::vector<size_t>& referenceIndices,
                 const size_t k,
                 const MatType& querySet,
                 arma::Mat<size_t>& neighbors,
@@ -450,15 +467,21 @@ class LSHSearch
   //! The bucket size of the second hash.
   size_t bucketSize;
 
-  //! The final hash table; should be (< secondHashSize) vectors each with
-  //! (<= bucketSize) elements.
-  std::vector<arma::Col<size_t>> secondHashTable;
+  //! The final hash table is stored in compressed sparse row form: row i (one
+  //! of < secondHashSize rows, each with <= bucketSize elements) occupies
+  //! bucketContents[bucketOffsets[i]] through
+  //! bucketContents[bucketOffsets[i + 1] - 1].
+  arma::Col<size_t> bucketOffsets;
 
-  //! The number of elements present in each hash bucket; should be
-  //! secondHashSize.
-  arma::Col<size_t> bucketContentSize;
+  //! The point indices held in each row of the final hash table, packed
+  //! contiguously.
+  arma::Col<arma::u32> bucketContents;
+
+  //! The final hash table with one vector per row; it holds the same points as
+  //! bucketContents, and is kept for SecondHashTable().
+  std::vector<arma::Col<size_t>> secondHashTable;
 
-  //! For a particular hash value, points to the row in secondHashTable
+  //! For a particular hash value, points to the row in the final hash table
   //! corresponding to this value. Length secondHashSize.
   arma::Col<size_t> bucketRowInHashTable;
 
@@ -486,7 +509,7 @@ class LSHSearch
 
 //! Set the serialization version of the LSHSearch class.
 BOOST_TEMPLATE_CLASS_VERSION(template<typename SortPolicy>,
-    mlpack::neighbor::LSHSearch<SortPolicy>, 1);
+    mlpack::neighbor::LSHSearch<SortPolicy>, 2);
 
 // Include implementation.
 #include "lsh_search_impl.hpp"
@@ -83,8 +83,9 @@ LSHSearch<SortPolicy, MatType>::LSHSearch(const LSHSearch& other) :
     secondHashSize(other.secondHashSize),
     secondHashWeights(other.secondHashWeights),
     bucketSize(other.bucketSize),
+    bucketOffsets(other.bucketOffsets),
+    bucketContents(other.bucketContents),
     secondHashTable(other.secondHashTable),
-    bucketContentSize(other.bucketContentSize),
     bucketRowInHashTable(other.bucketRowInHashTable),
     distanceEvaluations(other.distanceEvaluations)
 {
@@ -103,8 +104,9 @@ LSHSearch<SortPolicy, MatType>::LSHSearch(LSHSearch&& other) :
     secondHashSize(other.secondHashSize),
     secondHashWeights(std::move(other.secondHashWeights)),
     bucketSize(other.bucketSize),
+    bucketOffsets(std::move(other.bucketOffsets)),
+    bucketContents(std::move(other.bucketContents)),
     secondHashTable(std::move(other.secondHashTable)),
-    bucketContentSize(std::move(other.bucketContentSize)),
     bucketRowInHashTable(std::move(other.bucketRowInHashTable)),
     distanceEvaluations(other.distanceEvaluations)
 {
@@ -131,8 +133,9 @@ LSHSearch<SortPolicy, MatType>& LSHSearch<SortPolicy, MatType>::operator=(
   secondHashSize = other.secondHashSize;
   secondHashWeights = other.secondHashWeights;
   bucketSize = other.bucketSize;
+  bucketOffsets = other.bucketOffsets;
+  bucketContents = other.bucketContents;
   secondHashTable = other.secondHashTable;
-  bucketContentSize = other.bucketContentSize;
   bucketRowInHashTable = other.bucketRowInHashTable;
   distanceEvaluations = other.distanceEvaluations;
 
@@ -153,8 +156,9 @@ LSHSearch<SortPolicy, MatType>& LSHSearch<SortPolicy, MatType>::operator=(
   secondHashSize = other.secondHashSize;
   secondHashWeights = std::move(other.secondHashWeights);
   bucketSize = other.bucketSize;
+  bucketOffsets = std::move(other.bucketOffsets);
+  bucketContents = std::move(other.bucketContents);
   secondHashTable = std::move(other.secondHashTable);
-  bucketContentSize = std::move(other.bucketContentSize);
   bucketRowInHashTable = std::move(other.bucketRowInHashTable);
   distanceEvaluations = other.distanceEvaluations;
 
@@ -219,10 +223,9 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
   secondHashWeights = arma::floor(arma::randu(numProj) *
                                   (double) secondHashSize);
 
-  // Instead of putting the points in the row corresponding to the bucket, we
-  // chose the next empty row and keep track of the row in which the bucket
-  // lies. This allows us to stack together and slice out the empty buckets at
-  // the end of the hashing.
+  // Instead of putting the points in the row corresponding to the bucket, only
+  // nonempty buckets are given a row, and we keep track of the row in which the
+  // bucket lies.  This allows us to slice out the empty buckets.
   bucketRowInHashTable.set_size(secondHashSize);
   bucketRowInHashTable.fill(secondHashSize);
 
@@ -253,95 +256,149 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
         "tables provided must be equal to numProj");
   }
 
-  // We will store the second hash vectors in this matrix; the second hash
-  // vector for table i will be held in row i.  We have to use int and not
-  // size_t, otherwise negative numbers are cast to 0.
-  arma::Mat<size_t> secondHashVectors(numTables, this->referenceSet.n_cols);
+  // Point indices are packed as 32-bit integers in the final hash table.
+  const size_t numPoints = this->referenceSet.n_cols;
+  if (numPoints > (size_t) std::numeric_limits<arma::u32>::max())
+  {
+    throw std::invalid_argument("LSHSearch::Train(): reference set has too "
+        "many points; at most 2^32 - 1 points are supported");
+  }
 
-  for (size_t i = 0; i < numTables; ++i)
+  // We will store the second hash vectors in this matrix; the second hash
+  // vector for table i will be held in column i.  Stored this way, the
+  // elements of the matrix are in the order in which points are inserted into
+  // the second hash table.
+  arma::Mat<size_t> secondHashVectors(numPoints, numTables);
+
+  // Each table is hashed in blocks of points, so that the (table, block) pairs
+  // can be processed in parallel without holding the full
+  // 'numProj' x 'referenceSet.n_cols' key matrix for any table.
+  const size_t blockSize = 4096;
+  const size_t numBlocks = (numPoints + blockSize - 1) / blockSize;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t task = 0; task < (omp_size_t) (numTables * numBlocks);
+      ++task)
   {
+    const size_t i = task / numBlocks;
+    const size_t begin = (task % numBlocks) * blockSize;
+    const size_t end = std::min(begin + blockSize, numPoints) - 1;
+
     // Step IV: create the 'numProj'-dimensional key for each point in each
     // table.
 
     // The following code performs the task of hashing each point to a
     // 'numProj'-dimensional integer key.  Hence you get a ('numProj' x
-    // 'referenceSet.n_cols') key matrix.
+    // 'blockSize') key matrix.
     //
     // For a single table, let the 'numProj' projections be denoted by 'proj_i'
     // and the corresponding offset be 'offset_i'.  Then the key of a single
     // point is obtained as:
     // key = { floor((<proj_i, point> + offset_i) / 'hashWidth') forall i }
-    arma::mat offsetMat = arma::repmat(offsets.unsafe_col(i), 1,
-                                       this->referenceSet.n_cols);
-    arma::mat hashMat = projections.slice(i).t() * (this->referenceSet);
-    hashMat += offsetMat;
+    arma::mat hashMat = projections.slice(i).t() *
+        this->referenceSet.cols(begin, end);
+    hashMat.each_col() += offsets.col(i);
     hashMat /= hashWidth;
 
     // Step V: Putting the points in the 'secondHashTable' by hashing the key.
     // Now we hash every key, point ID to its corresponding bucket.  We must
     // also normalize the hashes to the range [0, secondHashSize).
-    arma::rowvec unmodVector = secondHashWeights.t() * arma::floor(hashMat);
+    const arma::rowvec unmodVector = secondHashWeights.t() *
+        arma::floor(hashMat);
     for (size_t j = 0; j < unmodVector.n_elem; ++j)
     {
       double shs = (double) secondHashSize; // Convenience cast.
       if (unmodVector[j] >= 0.0)
       {
         const size_t key = size_t(fmod(unmodVector[j], shs));
-        secondHashVectors(i, j) = key;
+        secondHashVectors(begin + j, i) = key;
       }
       else
       {
         const double mod = fmod(-unmodVector[j], shs);
         const size_t key = (mod < 1.0) ? 0 : secondHashSize - size_t(mod);
-        secondHashVectors(i, j) = key;
+        secondHashVectors(begin + j, i) = key;
       }
     }
   }
 
-  // Now, using the hash vectors for each table, count the number of rows we
-  // have in the second hash table.
-  arma::Row<size_t> secondHashBinCounts(secondHashSize, arma::fill::zeros);
-  for (size_t i = 0; i < secondHashVectors.n_elem; ++i)
-    secondHashBinCounts[secondHashVectors[i]]++;
+  // Step VI: fill the second hash table with a counting sort.  The sequence of
+  // keys is split into one contiguous chunk per thread; each chunk is counted
+  // separately, so that every chunk knows where its points go in each bucket
+  // and the buckets keep the same (table, point) order as a serial insertion.
+  size_t numChunks = 1;
+  #ifdef HAS_OPENMP
+    numChunks = omp_get_max_threads();
+  #endif
+  const size_t numKeys = secondHashVectors.n_elem;
+  numChunks = std::max((size_t) 1, std::min(numChunks, numKeys));
+
+  arma::Mat<size_t> chunkPositions(secondHashSize, numChunks,
+      arma::fill::zeros);
+  #pragma omp parallel for
+  for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+  {
+    const size_t chunkBegin = c * numKeys / numChunks;
+    const size_t chunkEnd = (c + 1) * numKeys / numChunks;
+    for (size_t k = chunkBegin; k < chunkEnd; ++k)
+      chunkPositions(secondHashVectors[k], c)++;
+  }
 
-  // Enforce the maximum bucket size.
+  // Turn the counts into the position of each chunk's first point in each
+  // bucket, and enforce the maximum bucket size.
   const size_t effectiveBucketSize = (bucketSize == 0) ? SIZE_MAX : bucketSize;
-  secondHashBinCounts.transform([effectiveBucketSize](size_t val)
-      { return std::min(val, effectiveBucketSize); });
+  arma::Col<size_t> secondHashBinCounts(secondHashSize);
+  #pragma omp parallel for
+  for (omp_size_t b = 0; b < (omp_size_t) secondHashSize; ++b)
+  {
+    size_t total = 0;
+    for (size_t c = 0; c < numChunks; ++c)
+    {
+      const size_t count = chunkPositions(b, c);
+      chunkPositions(b, c) = total;
+      total += count;
+    }
+    secondHashBinCounts[b] = std::min(total, effectiveBucketSize);
+  }
 
+  // Only nonempty buckets get a row in the table.
   const size_t numRowsInTable = arma::accu(secondHashBinCounts > 0);
-  bucketContentSize.zeros(numRowsInTable);
-  secondHashTable.resize(numRowsInTable);
-
-  // Next we must assign each point in each table to the right second hash
-  // table.
+  bucketOffsets.set_size(numRowsInTable + 1);
+  bucketOffsets[0] = 0;
   size_t currentRow = 0;
-  for (size_t i = 0; i < numTables; ++i)
+  for (size_t b = 0; b < secondHashSize; ++b)
+  {
+    if (secondHashBinCounts[b] > 0)
+    {
+      bucketRowInHashTable[b] = currentRow;
+      bucketOffsets[currentRow + 1] = bucketOffsets[currentRow] +
+          secondHashBinCounts[b];
+      ++currentRow;
+    }
+  }
+
+  // Now each chunk can place its points independently.  Points beyond the
+  // maximum bucket size are dropped.
+  bucketContents.set_size(bucketOffsets[numRowsInTable]);
+  #pragma omp parallel for
+  for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
   {
-    // Insert the point in the corresponding row to its bucket in the
-    // 'secondHashTable'.
-    for (size_t j = 0; j < secondHashVectors.n_cols; ++j)
+    const size_t chunkBegin = c * numKeys / numChunks;
+    const size_t chunkEnd = (c + 1) * numKeys / numChunks;
+    for (size_t k = chunkBegin; k < chunkEnd; ++k)
     {
-      // This is the bucket number.
-      size_t hashInd = (size_t) secondHashVectors(i, j);
-      // The point ID is 'j'.
-
-      // If this is currently an empty bucket, start a new row keep track of
-      // which row corresponds to the bucket.
-      const size_t maxSize = secondHashBinCounts[hashInd];
-      if (bucketRowInHashTable[hashInd] == secondHashSize)
+      const size_t hashInd = secondHashVectors[k];
+      const size_t position = chunkPositions(hashInd, c)++;
+      if (position < secondHashBinCounts[hashInd])
       {
-        bucketRowInHashTable[hashInd] = currentRow;
-        secondHashTable[currentRow].set_size(maxSize);
-        currentRow++;
+        // The point ID is the row of the key in secondHashVectors.
+        bucketContents[bucketOffsets[bucketRowInHashTable[hashInd]] +
+            position] = (arma::u32) (k % numPoints);
       }
+    }
+  }
 
-      // If this vector in the hash table is not full, add the point.
-      const size_t index = bucketRowInHashTable[hashInd];
-      if (bucketContentSize[index] < maxSize)
-        secondHashTable[index](bucketContentSize[index]++) = j;
-    } // Loop over all points in the reference set.
-  } // Loop over tables.
+  UnpackSecondHashTable();
 
   Log::Info << "Final hash table size: " << numRowsInTable << " rows, with a "
             << "maximum length of " << arma::max(secondHashBinCounts) << ", "
@@ -355,7 +412,7 @@ template<typename SortPolicy, typename MatType>
 inline force_inline
 void LSHSearch<SortPolicy, MatType>::BaseCase(
     const size_t queryIndex,
-    const arma::uvec& referenceIndices,
+    const std::vector<size_t>& referenceIndices,
     const size_t k,
     arma::Mat<size_t>& neighbors,
     arma::mat& distances) const
@@ -368,7 +425,7 @@ void LSHSearch<SortPolicy, MatType>::BaseCase(
   std::vector<Candidate> vect(k, def);
   CandidateList pqueue(CandidateCmp(), std::move(vect));
 
-  for (size_t j = 0; j < referenceIndices.n_elem; ++j)
+  for (size_t j = 0; j < referenceIndices.size(); ++j)
   {
     const size_t referenceIndex = referenceIndices[j];
     // If the points are the same, skip this point.
@@ -401,7 +458,7 @@ template<typename SortPolicy, typename MatType>
 inline force_inline
 void LSHSearch<SortPolicy, MatType>::BaseCase(
     const size_t queryIndex,
-    const arma::uvec& referenceIndices,
+    const std::vector<size_t>& referenceIndices,
     const size_t k,
     const MatType& querySet,
     arma::Mat<size_t>& neighbors,
@@ -415,7 +472,7 @@ void LSHSearch<SortPolicy, MatType>::BaseCase(
   std::vector<Candidate> vect(k, def);
   CandidateList pqueue(CandidateCmp(), std::move(vect));
 
-  for (size_t j = 0; j < referenceIndices.n_elem; ++j)
+  for (size_t j = 0; j < referenceIndices.size(); ++j)
   {
     const size_t referenceIndex = referenceIndices[j];
     const double distance = metric::EuclideanDistance::Evaluate(
@@ -706,7 +763,8 @@ template<typename SortPolicy, typename MatType>
 template<typename VecType>
 void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
     const VecType& queryPoint,
-    arma::uvec& referenceIndices,
+    std::vector<size_t>& referenceIndices,
+    std::vector<bool>& candidateMarkers,
     size_t numTablesToSearch,
     const size_t T) const
 {
@@ -768,89 +826,59 @@ void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
     }
   }
 
-  // Count number of points hashed in the same bucket as the query.
-  size_t maxNumPoints = 0;
-  for (size_t i = 0; i < numTablesToSearch; ++i)
+  // Collect the points hashed in the same buckets as the query.  A point is
+  // only added the first time it is seen; candidateMarkers remembers which
+  // points have been added already.
+  referenceIndices.clear();
+  for (size_t i = 0; i < numTablesToSearch; ++i) // For all tables.
   {
-    for (size_t p = 0; p < T + 1; ++p)
+    for (size_t p = 0; p < T + 1; ++p) // For entire probing sequence.
     {
-      const size_t hashInd = hashMat(p, i); // find query's bucket
+      const size_t hashInd = hashMat(p, i); // Find the query's bucket.
       const size_t tableRow = bucketRowInHashTable[hashInd];
+
       if (tableRow < secondHashSize)
-        maxNumPoints += bucketContentSize[tableRow]; // count bucket contents
+      {
+        const size_t rowBegin = bucketOffsets[tableRow];
+        const size_t rowEnd = bucketOffsets[tableRow + 1];
+        for (size_t j = rowBegin; j < rowEnd; ++j)
+        {
+          const size_t index = bucketContents[j];
+          if (!candidateMarkers[index])
+          {
+            candidateMarkers[index] = true;
+            referenceIndices.push_back(index);
+          }
+        }
+      }
     }
   }
 
-  // There are two ways to proceed here:
-  // Either allocate a maxNumPoints-size vector, place all candidates, and run
-  // unique on the vector to discard duplicates.
-  // Or allocate a referenceSet.n_cols size vector (i.e. number of reference
-  // points) of zeros, and mark found indices as 1.
-  // Option 1 runs faster for small maxNumPoints but worse for larger values, so
-  // we choose based on a heuristic.
+  // Return the candidates in increasing order, and reset the markers.  There
+  // are two ways to do this: sort the candidates, or scan all of the markers.
+  // Sorting is faster when there are few candidates but worse for larger
+  // numbers, so we choose based on a heuristic.
   const float cutoff = 0.1;
-  const float selectivity = static_cast<float>(maxNumPoints) /
+  const float selectivity = static_cast<float>(referenceIndices.size()) /
       static_cast<float>(referenceSet.n_cols);
 
   if (selectivity > cutoff)
   {
-    // Heuristic: larger maxNumPoints means we should use find() because it
-    // should be faster.
-    // Reference points hashed in the same bucket as the query are set to >0.
-    arma::Col<size_t> refPointsConsidered;
-    refPointsConsidered.zeros(referenceSet.n_cols);
-
-    for (size_t i = 0; i < numTablesToSearch; ++i) // for all tables
+    size_t numFound = 0;
+    for (size_t j = 0; j < referenceSet.n_cols; ++j)
     {
-      for (size_t p = 0; p < T + 1; ++p) // For entire probing sequence.
+      if (candidateMarkers[j])
       {
-        // get the sequence code
-        size_t hashInd = hashMat(p, i);
-        size_t tableRow = bucketRowInHashTable[hashInd];
-
-        if (tableRow < secondHashSize && bucketContentSize[tableRow] > 0)
-        {
-          // Pick the indices in the bucket corresponding to hashInd.
-          for (size_t j = 0; j < bucketContentSize[tableRow]; ++j)
-            refPointsConsidered[ secondHashTable[tableRow](j) ]++;
-        }
+        referenceIndices[numFound++] = j;
+        candidateMarkers[j] = false;
       }
     }
-
-    // Only keep reference points found in at least one bucket.
-    referenceIndices = arma::find(refPointsConsidered > 0);
-    return;
   }
   else
   {
-    // Heuristic: smaller maxNumPoints means we should use unique() because it
-    // should be faster.
-    // Allocate space for the query's potential neighbors.
-    arma::uvec refPointsConsideredSmall;
-    refPointsConsideredSmall.zeros(maxNumPoints);
-
-    // Retrieve candidates.
-    size_t start = 0;
-
-    for (size_t i = 0; i < numTablesToSearch; ++i) // For all tables
-    {
-      for (size_t p = 0; p < T + 1; ++p)
-      {
-        const size_t hashInd =  hashMat(p, i); // Find the query's bucket.
-        const size_t tableRow = bucketRowInHashTable[hashInd];
-
-        if (tableRow < secondHashSize)
-        {
-          // Store all secondHashTable points in the candidates set.
-          for (size_t j = 0; j < bucketContentSize[tableRow]; ++j)
-            refPointsConsideredSmall(start++) = secondHashTable[tableRow](j);
-       }
-      }
-    }
-
-    // Keep only one copy of each candidate.
-    referenceIndices = arma::unique(refPointsConsideredSmall);
-    return;
+    std::sort(referenceIndices.begin(), referenceIndices.end());
+    for (size_t j = 0; j < referenceIndices.size(); ++j)
+      candidateMarkers[referenceIndices[j]] = false;
   }
 }
 
@@ -911,29 +939,32 @@ void LSHSearch<SortPolicy, MatType>::Search(
 
   Timer::Start("computing_neighbors");
 
-  // Parallelization to process more than one query at a time.
-  #pragma omp parallel for \
+  // Parallelization to process more than one query at a time.  Each thread
+  // keeps its own candidate buffers, which are reused for all of its queries.
+  #pragma omp parallel \
       shared(resultingNeighbors, distances) \
-      schedule(dynamic)\
       reduction(+:avgIndicesReturned)
-  for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
   {
-    // Go through every query point.
-    // Hash every query into every hash table and eventually into the
-    // 'secondHashTable' to obtain the neighbor candidates.
-    arma::uvec refIndices;
-    ReturnIndicesFromTable(querySet.col(i), refIndices, numTablesToSearch,
-        Teffective);
-
-    // An informative book-keeping for the number of neighbor candidates
-    // returned on average.
-    // Make atomic to avoid race conditions when multiple threads are running
-    // #pragma omp atomic
-    avgIndicesReturned = avgIndicesReturned + refIndices.n_elem;
-
-    // Sequentially go through all the candidates and save the best 'k'
-    // candidates.
-    BaseCase(i, refIndices, k, querySet, resultingNeighbors, distances);
+    std::vector<size_t> refIndices;
+    std::vector<bool> candidateMarkers(referenceSet.n_cols, false);
+
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+    {
+      // Go through every query point.
+      // Hash every query into every hash table and eventually into the
+      // 'secondHashTable' to obtain the neighbor candidates.
+      ReturnIndicesFromTable(querySet.col(i), refIndices, candidateMarkers,
+          numTablesToSearch, Teffective);
+
+      // An informative book-keeping for the number of neighbor candidates
+      // returned on average.
+      avgIndicesReturned += refIndices.size();
+
+      // Sequentially go through all the candidates and save the best 'k'
+      // candidates.
+      BaseCase(i, refIndices, k, querySet, resultingNeighbors, distances);
+    }
   }
 
   Timer::Stop("computing_neighbors");
@@ -977,29 +1008,32 @@ Search(const size_t k,
 
   Timer::Start("computing_neighbors");
 
-  // Parallelization to process more than one query at a time.
-  #pragma omp parallel for \
+  // Parallelization to process more than one query at a time.  Each thread
+  // keeps its own candidate buffers, which are reused for all of its queries.
+  #pragma omp parallel \
       shared(resultingNeighbors, distances) \
-      schedule(dynamic)\
       reduction(+:avgIndicesReturned)
-  for (omp_size_t i = 0; i < (omp_size_t) referenceSet.n_cols; ++i)
   {
-    // Go through every query point.
-    // Hash every query into every hash table and eventually into the
-    // 'secondHashTable' to obtain the neighbor candidates.
-    arma::uvec refIndices;
-    ReturnIndicesFromTable(referenceSet.col(i), refIndices, numTablesToSearch,
-        Teffective);
-
-    // An informative book-keeping for the number of neighbor candidates
-    // returned on average.
-    // Make atomic to avoid race conditions when multiple threads are running.
-    // #pragma omp atomic
-    avgIndicesReturned += refIndices.n_elem;
-
-    // Sequentially go through all the candidates and save the best 'k'
-    // candidates.
-    BaseCase(i, refIndices, k, resultingNeighbors, distances);
+    std::vector<size_t> refIndices;
+    std::vector<bool> candidateMarkers(referenceSet.n_cols, false);
+
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) referenceSet.n_cols; ++i)
+    {
+      // Go through every query point.
+      // Hash every query into every hash table and eventually into the
+      // 'secondHashTable' to obtain the neighbor candidates.
+      ReturnIndicesFromTable(referenceSet.col(i), refIndices, candidateMarkers,
+          numTablesToSearch, Teffective);
+
+      // An informative book-keeping for the number of neighbor candidates
+      // returned on average.
+      avgIndicesReturned += refIndices.size();
+
+      // Sequentially go through all the candidates and save the best 'k'
+      // candidates.
+      BaseCase(i, refIndices, k, resultingNeighbors, distances);
+    }
   }
 
   Timer::Stop("computing_neighbors");
@@ -1037,6 +1071,25 @@ double LSHSearch<SortPolicy, MatType>::ComputeRecall(
   return ((double) found) / realNeighbors.n_elem;
 }
 
+template<typename SortPolicy, typename MatType>
+void LSHSearch<SortPolicy, MatType>::UnpackSecondHashTable()
+{
+  // An untrained model has no offsets at all.
+  const size_t numRows = (bucketOffsets.n_elem == 0) ? 0 :
+      bucketOffsets.n_elem - 1;
+
+  secondHashTable.clear();
+  secondHashTable.resize(numRows);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) numRows; ++i)
+  {
+    secondHashTable[i].set_size(bucketOffsets[i + 1] - bucketOffsets[i]);
+    for (size_t j = 0; j < secondHashTable[i].n_elem; ++j)
+      secondHashTable[i][j] = bucketContents[bucketOffsets[i] + j];
+  }
+}
+
 template<typename SortPolicy, typename MatType>
 template<typename Archive>
 void LSHSearch<SortPolicy, MatType>::serialize(Archive& ar,
@@ -1071,77 +1124,88 @@ void LSHSearch<SortPolicy, MatType>::serialize(Archive& ar,
   ar & BOOST_SERIALIZATION_NVP(secondHashSize);
   ar & BOOST_SERIALIZATION_NVP(secondHashWeights);
   ar & BOOST_SERIALIZATION_NVP(bucketSize);
-  // needs specific handling for new version
 
-  // Backward compatibility: in older versions of LSHSearch, the secondHashTable
-  // was stored as an arma::Mat<size_t>.  So we need to properly load that, then
-  // prune it down to size.
-  if (version == 0)
+  if (version >= 2)
   {
-    arma::Mat<size_t> tmpSecondHashTable;
-    ar & BOOST_SERIALIZATION_NVP(tmpSecondHashTable);
-
-    // The old secondHashTable was stored in row-major format, so we transpose
-    // it.
-    tmpSecondHashTable = tmpSecondHashTable.t();
-
-    secondHashTable.resize(tmpSecondHashTable.n_cols);
-    for (size_t i = 0; i < tmpSecondHashTable.n_cols; ++i)
-    {
-      // Find length of each column.  We know we are at the end of the list when
-      // the value referenceSet.n_cols is seen.
-
-      size_t len = 0;
-      for (; len < tmpSecondHashTable.n_rows; ++len)
-        if (tmpSecondHashTable(len, i) == referenceSet.n_cols)
-          break;
-
-      // Set the size of the new column correctly.
-      secondHashTable[i].set_size(len);
-      for (size_t j = 0; j < len; ++j)
-        secondHashTable[i](j) = tmpSecondHashTable(j, i);
-    }
+    ar & BOOST_SERIALIZATION_NVP(bucketOffsets);
+    ar & BOOST_SERIALIZATION_NVP(bucketContents);
+    ar & BOOST_SERIALIZATION_NVP(bucketRowInHashTable);
   }
   else
   {
-    size_t tables;
-    if (Archive::is_saving::value)
-      tables = secondHashTable.size();
-    ar & BOOST_SERIALIZATION_NVP(tables);
+    // Backward compatibility: versions of LSHSearch before 2 held the second
+    // hash table as one vector per row, so we load that and then pack it.
+    arma::Col<size_t> bucketContentSize;
+
+    // In the oldest versions of LSHSearch, the secondHashTable was stored as an
+    // arma::Mat<size_t>.  So we need to properly load that, then prune it down
+    // to size.
+    if (version == 0)
+    {
+      arma::Mat<size_t> tmpSecondHashTable;
+      ar & BOOST_SERIALIZATION_NVP(tmpSecondHashTable);
+
+      // The old secondHashTable was stored in row-major format, so we
+      // transpose it.
+      tmpSecondHashTable = tmpSecondHashTable.t();
+
+      secondHashTable.resize(tmpSecondHashTable.n_cols);
+      for (size_t i = 0; i < tmpSecondHashTable.n_cols; ++i)
+      {
+        // Find length of each column.  We know we are at the end of the list
+        // when the value referenceSet.n_cols is seen.
+
+        size_t len = 0;
+        for (; len < tmpSecondHashTable.n_rows; ++len)
+          if (tmpSecondHashTable(len, i) == referenceSet.n_cols)
+            break;
+
+        // Set the size of the new column correctly.
+        secondHashTable[i].set_size(len);
+        for (size_t j = 0; j < len; ++j)
+          secondHashTable[i](j) = tmpSecondHashTable(j, i);
+      }
 
-    // Set size of second hash table if needed.
-    if (Archive::is_loading::value)
+      // The bucketContentSize vector was stored in the old uncompressed form
+      // (of size secondHashSize).  So we need to shrink it.  But we can't do
+      // that until we have bucketRowInHashTable, so we also have to load that.
+      arma::Col<size_t> tmpBucketContentSize;
+      ar & BOOST_SERIALIZATION_NVP(tmpBucketContentSize);
+      ar & BOOST_SERIALIZATION_NVP(bucketRowInHashTable);
+
+      // Compress into a smaller vector by just dropping all of the zeros.
+      bucketContentSize.zeros(secondHashTable.size());
+      for (size_t i = 0; i < tmpBucketContentSize.n_elem; ++i)
+        if (tmpBucketContentSize[i] > 0)
+          bucketContentSize[bucketRowInHashTable[i]] = tmpBucketContentSize[i];
+    }
+    else
     {
-      secondHashTable.clear();
+      size_t tables = 0;
+      ar & BOOST_SERIALIZATION_NVP(tables);
       secondHashTable.resize(tables);
+
+      ar & BOOST_SERIALIZATION_NVP(secondHashTable);
+      ar & BOOST_SERIALIZATION_NVP(bucketContentSize);
+      ar & BOOST_SERIALIZATION_NVP(bucketRowInHashTable);
     }
 
-    ar & BOOST_SERIALIZATION_NVP(secondHashTable);
+    // Now pack the rows contiguously.
+    bucketOffsets.set_size(secondHashTable.size() + 1);
+    bucketOffsets[0] = 0;
+    for (size_t i = 0; i < secondHashTable.size(); ++i)
+      bucketOffsets[i + 1] = bucketOffsets[i] + bucketContentSize[i];
+
+    bucketContents.set_size(bucketOffsets[secondHashTable.size()]);
+    for (size_t i = 0; i < secondHashTable.size(); ++i)
+      for (size_t j = 0; j < bucketContentSize[i]; ++j)
+        bucketContents[bucketOffsets[i] + j] =
+            (arma::u32) secondHashTable[i][j];
   }
 
-  // Backward compatibility: old versions of LSHSearch held bucketContentSize
-  // for all possible buckets (of size secondHashSize), but now we hold a
-  // compressed representation.
-  if (version == 0)
-  {
-    // The vector was stored in the old uncompressed form.  So we need to shrink
-    // it.  But we can't do that until we have bucketRowInHashTable, so we also
-    // have to load that.
-    arma::Col<size_t> tmpBucketContentSize;
-    ar & BOOST_SERIALIZATION_NVP(tmpBucketContentSize);
-    ar & BOOST_SERIALIZATION_NVP(bucketRowInHashTable);
-
-    // Compress into a smaller vector by just dropping all of the zeros.
-    bucketContentSize.set_size(secondHashTable.size());
-    for (size_t i = 0; i < tmpBucketContentSize.n_elem; ++i)
-      if (tmpBucketContentSize[i] > 0)
-        bucketContentSize[bucketRowInHashTable[i]] = tmpBucketContentSize[i];
-  }
-  else
-  {
-    ar & BOOST_SERIALIZATION_NVP(bucketContentSize);
-    ar & BOOST_SERIALIZATION_NVP(bucketRowInHashTable);
-  }
+  // Only the compact layout is stored, so the rows are rebuilt from it.
+  if (Archive::is_loading::value)
+    UnpackSecondHashTable();
 
   ar & BOOST_SERIALIZATION_NVP(distanceEvaluations);
 }
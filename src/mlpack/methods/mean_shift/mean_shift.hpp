@@ -17,6 +17,7 @@
 #include <mlpack/core/kernels/gaussian_kernel.hpp>
 #include <mlpack/core/kernels/kernel_traits.hpp>
 #include <mlpack/core/metrics/lmetric.hpp>
+#include <mlpack/methods/range_search/range_search.hpp>
 #include <boost/utility.hpp>
 
 namespace mlpack {
@@ -27,6 +28,13 @@ namespace meanshift /** Mean shift clustering. */ {
  * apply mean shift algorithm until maximum iterations or convergence.  Then
  * remove duplicate centroids.
  *
+ * All the seeds that have not converged are moved at each iteration.  They
+ * are split into chunks that are processed in parallel (if OpenMP is
+ * enabled), and each chunk is moved with a dual-tree range search against a
+ * tree built on the dataset once, which accumulates the new centroids
+ * directly without storing the neighbors.  Duplicate centroids are found with
+ * a grid of cells whose side is the radius.
+ *
  * A simple example of how to run mean shift clustering is shown below.
  *
  * @code
@@ -126,35 +134,44 @@ class MeanShift
                 const int minFreq,
                 MatType& seeds);
 
+  //! The tree used to search the dataset.
+  typedef range::RangeSearch<>::Tree Tree;
+
   /**
-   * Use kernel to calculate new centroid given dataset and valid neighbors.
+   * Move each of the given centroids to the (weighted) mean of the points of
+   * the dataset within the radius of it.  If there are no such points, or if
+   * their weights sum to zero, the centroid is not moved.
    *
-   * @param data The whole dataset
-   * @param neighbors Valid neighbors
-   * @param distances Distances to neighbors
-   # @param centroid Store calculated centroid
+   * @param referenceTree Tree built on the dataset.
+   * @param centroids All the centroids.
+   * @param active Indices of the centroids to move.
+   * @param newCentroids Matrix to store the moved centroids in (one column for
+   *      each element of active).
+   * @param counts Vector to store the number of points within the radius of
+   *      each centroid in.
    */
-  template<bool ApplyKernel = UseKernel>
-  typename std::enable_if<ApplyKernel, bool>::type
-  CalculateCentroid(const MatType& data,
-                    const std::vector<size_t>& neighbors,
-                    const std::vector<double>& distances,
-                    arma::colvec& centroid);
+  void ShiftCentroids(Tree& referenceTree,
+                      const arma::mat& centroids,
+                      const std::vector<size_t>& active,
+                      arma::mat& newCentroids,
+                      arma::Col<size_t>& counts);
 
   /**
-   * Use mean to calculate new centroid given dataset and valid neighbors.
+   * Get the weight of a point at the given distance from the centroid, using
+   * the kernel.  Points at distance zero have no weight.
    *
-   * @param data The whole dataset
-   * @param neighbors Valid neighbors
-   * @param distances Distances to neighbors
-   # @param centroid Store calculated centroid
+   * @param distance Distance between the point and the centroid.
+   */
+  template<bool ApplyKernel = UseKernel>
+  typename std::enable_if<ApplyKernel, double>::type
+  Weight(const double distance);
+
+  /**
+   * Get the weight of a point when the mean is used; this is always 1.
    */
   template<bool ApplyKernel = UseKernel>
-  typename std::enable_if<!ApplyKernel, bool>::type
-  CalculateCentroid(const MatType& data,
-                    const std::vector<size_t>& neighbors,
-                    const std::vector<double>&, /*unused*/
-                    arma::colvec& centroid);
+  typename std::enable_if<!ApplyKernel, double>::type
+  Weight(const double /* distance */);
 
   /**
    * If distance of two centroids is less than radius, one will be removed.
@@ -20,6 +20,10 @@
 
 #include "map"
 
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 // In case it hasn't been included yet.
 #include "mean_shift.hpp"
 
@@ -129,51 +133,95 @@ void MeanShift<UseKernel, KernelType, MatType>::GenSeeds(
   seeds *= binSize;
 }
 
-// Calculate new centroid with given kernel.
+// Get the weight of a point with the given kernel.
 template<bool UseKernel, typename KernelType, typename MatType>
 template<bool ApplyKernel>
-typename std::enable_if<ApplyKernel, bool>::type
-MeanShift<UseKernel, KernelType, MatType>::
-CalculateCentroid(const MatType& data,
-                  const std::vector<size_t>& neighbors,
-                  const std::vector<double>& distances,
-                  arma::colvec& centroid)
+typename std::enable_if<ApplyKernel, double>::type
+MeanShift<UseKernel, KernelType, MatType>::Weight(const double distance)
 {
-  double sumWeight = 0;
-  for (size_t i = 0; i < neighbors.size(); ++i)
-  {
-    if (distances[i] > 0)
-    {
-      double dist = distances[i] / radius;
-      double weight = kernel.Gradient(dist) / dist;
-      sumWeight += weight;
-      centroid += weight * data.unsafe_col(neighbors[i]);
-    }
-  }
+  if (distance <= 0)
+    return 0.0;
 
-  if (sumWeight != 0)
-  {
-    centroid /= sumWeight;
-    return true;
-  }
-  return false;
+  const double dist = distance / radius;
+  return kernel.Gradient(dist) / dist;
 }
 
-// Calculate new centroid by mean.
+// Get the weight of a point for the mean.
 template<bool UseKernel, typename KernelType, typename MatType>
 template<bool ApplyKernel>
-typename std::enable_if<!ApplyKernel, bool>::type
-MeanShift<UseKernel, KernelType, MatType>::
-CalculateCentroid(const MatType& data,
-                  const std::vector<size_t>& neighbors,
-                  const std::vector<double>&, /*unused*/
-                  arma::colvec& centroid)
+typename std::enable_if<!ApplyKernel, double>::type
+MeanShift<UseKernel, KernelType, MatType>::Weight(
+    const double /* distance */)
+{
+  return 1.0;
+}
+
+// Move the given centroids to the weighted mean of the points around them.
+template<bool UseKernel, typename KernelType, typename MatType>
+void MeanShift<UseKernel, KernelType, MatType>::ShiftCentroids(
+    Tree& referenceTree,
+    const arma::mat& centroids,
+    const std::vector<size_t>& active,
+    arma::mat& newCentroids,
+    arma::Col<size_t>& counts)
 {
-  for (size_t i = 0; i < neighbors.size(); ++i)
-    centroid += data.unsafe_col(neighbors[i]);
+  newCentroids.zeros(centroids.n_rows, active.size());
+  counts.zeros(active.size());
+  arma::vec sumWeights(active.size(), arma::fill::zeros);
+  const arma::mat& referenceSet = referenceTree.Dataset();
+  const math::Range validRadius(0, radius);
+
+  // Each chunk of centroids is moved by its own dual-tree traversal.  A few
+  // chunks per thread keep the threads busy when some chunks are slower.
+  size_t numChunks = 1;
+  #ifdef HAS_OPENMP
+    numChunks = 4 * omp_get_max_threads();
+  #endif
+  numChunks = std::max((size_t) 1, std::min(numChunks, active.size()));
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t s = 0; s < (omp_size_t) numChunks; ++s)
+  {
+    const size_t begin = s * active.size() / numChunks;
+    const size_t end = (s + 1) * active.size() / numChunks;
+
+    arma::mat queries(centroids.n_rows, end - begin);
+    for (size_t j = begin; j < end; ++j)
+      queries.col(j - begin) = centroids.col(active[j]);
+
+    std::vector<size_t> oldFromNew;
+    Tree queryTree(std::move(queries), oldFromNew);
 
-  centroid /= neighbors.size();
-  return true;
+    // Accumulate the weighted sum of the points around each centroid as the
+    // points are found.  Each chunk writes to its own columns.
+    auto accumulate = [&](const size_t queryIndex,
+                          const size_t referenceIndex,
+                          const double distance)
+    {
+      const size_t j = begin + queryIndex;
+      const double weight = Weight(distance);
+      ++counts[j];
+      sumWeights[j] += weight;
+      newCentroids.col(j) += weight * referenceSet.unsafe_col(referenceIndex);
+    };
+
+    typedef range::MappedRangeCallback<decltype(accumulate)> CallbackType;
+    typedef range::RangeSearchRules<metric::EuclideanDistance, Tree,
+        CallbackType> RuleType;
+    metric::EuclideanDistance metric;
+    RuleType rules(referenceSet, queryTree.Dataset(), validRadius,
+        CallbackType(accumulate, &oldFromNew, NULL), metric);
+    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+    traverser.Traverse(queryTree, referenceTree);
+  }
+
+  for (size_t j = 0; j < active.size(); ++j)
+  {
+    if (sumWeights[j] != 0)
+      newCentroids.col(j) /= sumWeights[j];
+    else
+      newCentroids.col(j) = centroids.col(active[j]);
+  }
 }
 
 /**
@@ -202,64 +250,110 @@ inline void MeanShift<UseKernel, KernelType, MatType>::Cluster(
     pSeeds = &seeds;
   }
 
-  // Holds all centroids before removing duplicate ones.
-  arma::mat allCentroids(pSeeds->n_rows, pSeeds->n_cols);
+  // Holds all centroids before removing duplicate ones.  Initially each
+  // centroid is its seed.
+  arma::mat allCentroids(*pSeeds);
+  const size_t numSeeds = allCentroids.n_cols;
 
   assignments.set_size(data.n_cols);
 
-  range::RangeSearch<> rangeSearcher(data);
-  math::Range validRadius(0, radius);
-  std::vector<std::vector<size_t> > neighbors;
-  std::vector<std::vector<double> > distances;
-
-  // For each seed, perform mean shift algorithm.
-  for (size_t i = 0; i < pSeeds->n_cols; ++i)
+  // Move all the centroids that have not converged yet at each iteration.  A
+  // centroid stops if there are no points around it, or when the mean shift
+  // vector is small enough, in which case it has converged.
+  Tree referenceTree(data);
+  std::vector<size_t> active(numSeeds);
+  for (size_t i = 0; i < numSeeds; ++i)
+    active[i] = i;
+  std::vector<bool> converged(numSeeds, false);
+  arma::mat newCentroids;
+  arma::Col<size_t> counts;
+  for (size_t completedIterations = 0; !active.empty() &&
+      (completedIterations < maxIterations || forceConvergence);
+      completedIterations++)
   {
-    // Initial centroid is the seed itself.
-    allCentroids.col(i) = pSeeds->unsafe_col(i);
-    for (size_t completedIterations = 0; completedIterations < maxIterations
-        || forceConvergence; completedIterations++)
+    ShiftCentroids(referenceTree, allCentroids, active, newCentroids, counts);
+
+    size_t numActive = 0;
+    for (size_t j = 0; j < active.size(); ++j)
     {
-      // Store new centroid in this.
-      arma::colvec newCentroid = arma::zeros<arma::colvec>(pSeeds->n_rows);
+      const size_t i = active[j];
+      if (counts[j] == 0) // There are no points in the cluster.
+        continue;
 
-      rangeSearcher.Search(allCentroids.unsafe_col(i), validRadius,
-          neighbors, distances);
-      if (neighbors[0].size() == 0) // There are no points in the cluster.
-        break;
+      if (metric::EuclideanDistance::Evaluate(newCentroids.col(j),
+          allCentroids.col(i)) < 1e-3 * radius)
+      {
+        converged[i] = true;
+        continue;
+      }
+
+      // Update the centroid.
+      allCentroids.col(i) = newCentroids.col(j);
+      active[numActive++] = i;
+    }
+    active.resize(numActive);
+  }
 
-      // Calculate new centroid.
-      if (!CalculateCentroid(data, neighbors[0], distances[0], newCentroid))
-        newCentroid = allCentroids.unsafe_col(i);
+  // Keep the converged centroids in the order of the seeds, unless they are
+  // within the radius of a centroid that was already kept.  The kept
+  // centroids are binned into cells whose side is the radius, so only the 3^d
+  // cells around a centroid need to be checked (or all the kept centroids, if
+  // there are fewer of them).
+  typedef arma::Col<arma::sword> CellType;
+  std::map<CellType, std::vector<size_t>, less<CellType> > grid;
+  std::vector<size_t> kept;
+  const double numNeighborCells = std::pow(3.0, (double) data.n_rows);
+  for (size_t i = 0; i < numSeeds; ++i)
+  {
+    if (!converged[i])
+      continue;
 
-      // If the mean shift vector is small enough, it has converged.
-      if (metric::EuclideanDistance::Evaluate(newCentroid,
-          allCentroids.unsafe_col(i)) < 1e-3 * radius)
+    const CellType cell = arma::conv_to<CellType>::from(
+        arma::floor(allCentroids.col(i) / radius));
+    bool isDuplicated = false;
+    if (numNeighborCells > (double) kept.size())
+    {
+      for (size_t k = 0; k < kept.size() && !isDuplicated; ++k)
       {
-        // Determine if the new centroid is duplicate with old ones.
-        bool isDuplicated = false;
-        for (size_t k = 0; k < centroids.n_cols; ++k)
+        isDuplicated = (metric::EuclideanDistance::Evaluate(
+            allCentroids.col(i), allCentroids.col(kept[k])) < radius);
+      }
+    }
+    else
+    {
+      // Visit each cell whose coordinates differ by at most one.
+      CellType offset(cell.n_elem);
+      offset.fill(-1);
+      while (!isDuplicated)
+      {
+        typename std::map<CellType, std::vector<size_t>, less<CellType> >::
+            const_iterator it = grid.find(CellType(cell + offset));
+        if (it != grid.end())
         {
-          const double distance = metric::EuclideanDistance::Evaluate(
-              allCentroids.unsafe_col(i), centroids.unsafe_col(k));
-          if (distance < radius)
+          for (size_t k = 0; k < it->second.size() && !isDuplicated; ++k)
           {
-            isDuplicated = true;
-            break;
+            isDuplicated = (metric::EuclideanDistance::Evaluate(
+                allCentroids.col(i), allCentroids.col(it->second[k])) <
+                radius);
           }
         }
 
-        if (!isDuplicated)
-          centroids.insert_cols(centroids.n_cols, allCentroids.unsafe_col(i));
-
-        // Get out of the loop.
-        break;
+        size_t d = 0;
+        while (d < offset.n_elem && offset[d] == 1)
+          offset[d++] = -1;
+        if (d == offset.n_elem)
+          break;
+        ++offset[d];
       }
+    }
 
-      // Update the centroid.
-      allCentroids.col(i) = newCentroid;
+    if (!isDuplicated)
+    {
+      grid[cell].push_back(i);
+      kept.push_back(i);
     }
   }
+  centroids = allCentroids.cols(arma::conv_to<arma::uvec>::from(kept));
 
   // If no centroid has converged due to too little iterations and without
   // forcing convergence, take 1 random centroid calculated.
@@ -12,6 +12,7 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/util/io.hpp>
 #include <mlpack/core/util/mlpack_main.hpp>
+#include <mlpack/core/math/quantile_sketch.hpp>
 
 #include <boost/format.hpp>
 #include <boost/lexical_cast.hpp>
@@ -40,7 +41,10 @@ PROGRAM_INFO("Descriptive Statistics",
     "specific dimension to analyze if there are too many dimensions. The " +
     PRINT_PARAM_STRING("population") + " parameter can be specified when the "
     "dataset should be considered as a population.  Otherwise, the dataset "
-    "will be considered as a sample."
+    "will be considered as a sample.  If the " +
+    PRINT_PARAM_STRING("approximate_median") + " parameter is specified, the "
+    "median is estimated with a quantile sketch instead of being computed "
+    "exactly, which is faster on large datasets."
     "\n\n"
     "So, a simple example where we want to print out statistical facts about "
     "the dataset " + PRINT_DATASET("X") + " using the default settings, we "
@@ -69,6 +73,8 @@ PARAM_FLAG("population", "If specified, the program will calculate statistics "
 PARAM_FLAG("row_major", "If specified, the program will calculate statistics "
     "across rows, not across columns.  (Remember that in mlpack, a column "
     "represents a point, so this option is generally not necessary.)", "r");
+PARAM_FLAG("approximate_median", "If specified, the median of each dimension "
+    "is estimated with a quantile sketch.", "a");
 
 /**
  * Calculates the sum of deviations to the Nth Power.
@@ -168,6 +174,7 @@ static void mlpackMain()
   const size_t width = static_cast<size_t>(IO::GetParam<int>("width"));
   const bool population = IO::HasParam("population");
   const bool rowMajor = IO::HasParam("row_major");
+  const bool approximateMedian = IO::HasParam("approximate_median");
 
   // Load the data.
   arma::mat& data = IO::GetParam<arma::mat>("input");
@@ -207,13 +214,26 @@ static void mlpackMain()
     const double fMean = arma::mean(feature);
     const double fStd = arma::stddev(feature, population);
 
+    double fMedian;
+    if (approximateMedian)
+    {
+      math::QuantileSketch<double> sketch;
+      for (size_t i = 0; i < feature.n_elem; ++i)
+        sketch.Insert(feature[i]);
+      fMedian = sketch.Quantile(0.5);
+    }
+    else
+    {
+      fMedian = arma::median(feature);
+    }
+
     // Print statistics of the given dimension.
     Log::Info << boost::format(numberFormat)
         % dim
         % arma::var(feature, population)
         % fMean
         % fStd
-        % arma::median(feature)
+        % fMedian
         % fMin
         % fMax
         % (fMax - fMin) // range
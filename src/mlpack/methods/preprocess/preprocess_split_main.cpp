@@ -81,6 +81,9 @@ PARAM_DOUBLE_IN("test_ratio", "Ratio of test set; if not set,"
 
 PARAM_INT_IN("seed", "Random seed (0 for std::time(NULL)).", "s", 0);
 PARAM_FLAG("no_shuffle", "Avoid shuffling and splitting the data.", "S");
+PARAM_FLAG("stratify_data", "Stratify the split by label, so that the "
+    "training and test sets have the same class proportions as the dataset.  "
+    "Only used if labels are given.", "z");
 
 using namespace mlpack;
 using namespace mlpack::data;
@@ -93,6 +96,7 @@ static void mlpackMain()
   // Parse command line options.
   const double testRatio = IO::GetParam<double>("test_ratio");
   const bool shuffleData = IO::GetParam<bool>("no_shuffle");
+  const bool stratifyData = IO::GetParam<bool>("stratify_data");
 
   if (IO::GetParam<int>("seed") == 0)
     mlpack::math::RandomSeed(std::time(NULL));
@@ -116,6 +120,7 @@ static void mlpackMain()
   {
     ReportIgnoredParam({{ "input_labels", true }}, "training_labels");
     ReportIgnoredParam({{ "input_labels", true }}, "test_labels");
+    ReportIgnoredParam({{ "input_labels", false }}, "stratify_data");
   }
 
   // Check test_ratio.
@@ -132,41 +137,48 @@ static void mlpackMain()
   // Load the data.
   arma::mat& data = IO::GetParam<arma::mat>("input");
 
+  // Only the indices of the two sets are computed, so that each output is
+  // copied straight from the dataset.
+  arma::uvec trainIndices, testIndices;
+  if (IO::HasParam("input_labels") && stratifyData)
+  {
+    arma::Mat<size_t>& labels =
+        IO::GetParam<arma::Mat<size_t>>("input_labels");
+    const arma::Row<size_t> labelsRow = labels.row(0);
+    data::StratifiedSplitIndices(labelsRow, trainIndices, testIndices,
+        testRatio, !shuffleData);
+  }
+  else
+  {
+    data::SplitIndices(data.n_cols, trainIndices, testIndices, testRatio,
+        !shuffleData);
+  }
+
+  Log::Info << "Training data contains " << trainIndices.n_elem << " points."
+      << endl;
+  Log::Info << "Test data contains " << testIndices.n_elem << " points."
+      << endl;
+
+  if (IO::HasParam("training"))
+    IO::GetParam<arma::mat>("training") = data.cols(trainIndices);
+  if (IO::HasParam("test"))
+    IO::GetParam<arma::mat>("test") = data.cols(testIndices);
+
   // If parameters for labels exist, we must split the labels too.
   if (IO::HasParam("input_labels"))
   {
     arma::Mat<size_t>& labels =
         IO::GetParam<arma::Mat<size_t>>("input_labels");
-    arma::Row<size_t> labelsRow = labels.row(0);
-
-    const auto value = data::Split(data, labelsRow, testRatio, !shuffleData);
-    Log::Info << "Training data contains " << get<0>(value).n_cols << " points."
-        << endl;
-    Log::Info << "Test data contains " << get<1>(value).n_cols << " points."
-        << endl;
-
-    if (IO::HasParam("training"))
-      IO::GetParam<arma::mat>("training") = std::move(get<0>(value));
-    if (IO::HasParam("test"))
-      IO::GetParam<arma::mat>("test") = std::move(get<1>(value));
+
     if (IO::HasParam("training_labels"))
+    {
       IO::GetParam<arma::Mat<size_t>>("training_labels") =
-          std::move(get<2>(value));
+          labels.cols(trainIndices);
+    }
     if (IO::HasParam("test_labels"))
+    {
       IO::GetParam<arma::Mat<size_t>>("test_labels") =
-          std::move(get<3>(value));
-  }
-  else // We have no labels, so just split the dataset.
-  {
-    const auto value = data::Split(data, testRatio, !shuffleData);
-    Log::Info << "Training data contains " << get<0>(value).n_cols << " points."
-        << endl;
-    Log::Info << "Test data contains " << get<1>(value).n_cols << " points."
-        << endl;
-
-    if (IO::HasParam("training"))
-      IO::GetParam<arma::mat>("training") = std::move(get<0>(value));
-    if (IO::HasParam("test"))
-      IO::GetParam<arma::mat>("test") = std::move(get<1>(value));
+          labels.cols(testIndices);
+    }
   }
 }
@@ -3,7 +3,8 @@
  * @author Ryan Curtin
  *
  * Implementation of the Bootstrap() function, which creates a bootstrapped
- * dataset from the given input dataset.
+ * dataset from the given input dataset, and of the DefaultBootstrap and
+ * WeightedBootstrap policies used by RandomForest.
  *
  * mlpack is free software; you may redistribute it and/or modify it under the
  * terms of the 3-clause BSD license.  You should have received a copy of the
@@ -47,6 +48,104 @@ void Bootstrap(const MatType& dataset,
   }
 }
 
+/**
+ * The DefaultBootstrap policy creates each bootstrap sample with Bootstrap(),
+ * so that a point drawn several times appears several times in the sample.
+ */
+class DefaultBootstrap
+{
+ public:
+  //! The trees only need to be trained with weights if the user gave weights.
+  static const bool ProducesWeights = false;
+
+  /**
+   * Create a bootstrap sample of the given dataset.
+   *
+   * @param dataset Dataset to sample from.
+   * @param labels Labels of the dataset.
+   * @param weights Weights of the dataset (ignored if UseWeights is false).
+   * @param bootstrapDataset Matrix to store the sampled points in.
+   * @param bootstrapLabels Vector to store the sampled labels in.
+   * @param bootstrapWeights Vector to store the sampled weights in (not set if
+   *     UseWeights is false).
+   */
+  template<bool UseWeights,
+           typename MatType,
+           typename LabelsType,
+           typename WeightsType>
+  static void Sample(const MatType& dataset,
+                     const LabelsType& labels,
+                     const WeightsType& weights,
+                     MatType& bootstrapDataset,
+                     LabelsType& bootstrapLabels,
+                     WeightsType& bootstrapWeights)
+  {
+    Bootstrap<UseWeights>(dataset, labels, weights, bootstrapDataset,
+        bootstrapLabels, bootstrapWeights);
+  }
+};
+
+/**
+ * The WeightedBootstrap policy represents a bootstrap sample as a vector of
+ * integer weights: every point that is drawn at least once is kept once, and
+ * its weight is the number of times it was drawn (multiplied by its original
+ * weight, if weights are used).  On average only 63% of the points are drawn,
+ * so each tree copies and sorts less data than with DefaultBootstrap.
+ *
+ * The gain of every split is the same as for the equivalent DefaultBootstrap
+ * sample, but the minimum leaf size of each tree counts distinct points.  So
+ * the trees are only identical to DefaultBootstrap trees if the minimum leaf
+ * size is 1.
+ */
+class WeightedBootstrap
+{
+ public:
+  //! The trees must always be trained with the sampled weights.
+  static const bool ProducesWeights = true;
+
+  /**
+   * Create a bootstrap sample of the given dataset.
+   *
+   * @param dataset Dataset to sample from.
+   * @param labels Labels of the dataset.
+   * @param weights Weights of the dataset (ignored if UseWeights is false).
+   * @param bootstrapDataset Matrix to store the distinct sampled points in.
+   * @param bootstrapLabels Vector to store the sampled labels in.
+   * @param bootstrapWeights Vector to store the weight of each sampled point
+   *     in.
+   */
+  template<bool UseWeights,
+           typename MatType,
+           typename LabelsType,
+           typename WeightsType>
+  static void Sample(const MatType& dataset,
+                     const LabelsType& labels,
+                     const WeightsType& weights,
+                     MatType& bootstrapDataset,
+                     LabelsType& bootstrapLabels,
+                     WeightsType& bootstrapWeights)
+  {
+    // Random sampling with replacement; count how often each point is drawn.
+    arma::uvec indices = arma::randi<arma::uvec>(dataset.n_cols,
+        arma::distr_param(0, dataset.n_cols - 1));
+    arma::Col<size_t> counts(dataset.n_cols, arma::fill::zeros);
+    for (size_t i = 0; i < indices.n_elem; ++i)
+      ++counts[indices[i]];
+
+    const arma::uvec drawn = arma::find(counts);
+    bootstrapDataset.set_size(dataset.n_rows, drawn.n_elem);
+    bootstrapLabels.set_size(drawn.n_elem);
+    bootstrapWeights.set_size(drawn.n_elem);
+    for (size_t i = 0; i < drawn.n_elem; ++i)
+    {
+      bootstrapDataset.col(i) = dataset.col(drawn[i]);
+      bootstrapLabels[i] = labels[drawn[i]];
+      bootstrapWeights[i] = UseWeights ? counts[drawn[i]] * weights[drawn[i]] :
+          counts[drawn[i]];
+    }
+  }
+};
+
 } // namespace tree
 } // namespace mlpack
 
@@ -19,11 +19,32 @@
 namespace mlpack {
 namespace tree {
 
+/**
+ * The RandomForest class trains an ensemble of decision trees, each on its own
+ * bootstrap sample of the data, and predicts by averaging the class
+ * probabilities of the trees.  The trees are trained in parallel when OpenMP
+ * is available.
+ *
+ * @tparam FitnessFunction Fitness function to use for each decision tree.
+ * @tparam DimensionSelectionType Strategy used to choose the dimensions that
+ *     are considered for each split.
+ * @tparam NumericSplitType Split type for numeric dimensions.
+ * @tparam CategoricalSplitType Split type for categorical dimensions.
+ * @tparam ElemType Type of the elements of the data.
+ * @tparam BootstrapType Policy used to create the bootstrap sample of each
+ *     tree.  DefaultBootstrap copies each drawn point once per draw;
+ *     WeightedBootstrap keeps each drawn point once and trains the tree with
+ *     the number of draws as its weight, which lowers the memory used by each
+ *     tree.  With WeightedBootstrap, the minimumLeafSize given to Train()
+ *     counts the distinct points of a tree's sample, not the draws, so a leaf
+ *     may hold fewer draws than with DefaultBootstrap.
+ */
 template<typename FitnessFunction = GiniGain,
          typename DimensionSelectionType = MultipleRandomDimensionSelect,
          template<typename> class NumericSplitType = BestBinaryNumericSplit,
          template<typename> class CategoricalSplitType = AllCategoricalSplit,
-         typename ElemType = double>
+         typename ElemType = double,
+         typename BootstrapType = DefaultBootstrap>
 class RandomForest
 {
  public:
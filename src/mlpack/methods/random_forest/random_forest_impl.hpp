@@ -23,7 +23,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    typename ElemType
+    typename ElemType,
+    typename BootstrapType
 >
 template<typename MatType>
 RandomForest<
@@ -31,7 +32,8 @@ RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    ElemType
+    ElemType,
+    BootstrapType
 >::RandomForest(const MatType& dataset,
                 const arma::Row<size_t>& labels,
                 const size_t numClasses,
@@ -53,7 +55,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    typename ElemType
+    typename ElemType,
+    typename BootstrapType
 >
 template<typename MatType>
 RandomForest<
@@ -61,7 +64,8 @@ RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    ElemType
+    ElemType,
+    BootstrapType
 >::RandomForest(const MatType& dataset,
                 const data::DatasetInfo& datasetInfo,
                 const arma::Row<size_t>& labels,
@@ -84,7 +88,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    typename ElemType
+    typename ElemType,
+    typename BootstrapType
 >
 template<typename MatType>
 RandomForest<
@@ -92,7 +97,8 @@ RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    ElemType
+    ElemType,
+    BootstrapType
 >::RandomForest(const MatType& dataset,
                 const arma::Row<size_t>& labels,
                 const size_t numClasses,
@@ -114,7 +120,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    typename ElemType
+    typename ElemType,
+    typename BootstrapType
 >
 template<typename MatType>
 RandomForest<
@@ -122,7 +129,8 @@ RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    ElemType
+    ElemType,
+    BootstrapType
 >::RandomForest(const MatType& dataset,
                 const data::DatasetInfo& datasetInfo,
                 const arma::Row<size_t>& labels,
@@ -144,7 +152,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    typename ElemType
+    typename ElemType,
+    typename BootstrapType
 >
 template<typename MatType>
 double RandomForest<
@@ -152,7 +161,8 @@ double RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    ElemType
+    ElemType,
+    BootstrapType
 >::Train(const MatType& dataset,
          const arma::Row<size_t>& labels,
          const size_t numClasses,
@@ -175,7 +185,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    typename ElemType
+    typename ElemType,
+    typename BootstrapType
 >
 template<typename MatType>
 double RandomForest<
@@ -183,7 +194,8 @@ double RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    ElemType
+    ElemType,
+    BootstrapType
 >::Train(const MatType& dataset,
          const data::DatasetInfo& datasetInfo,
          const arma::Row<size_t>& labels,
@@ -206,7 +218,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    typename ElemType
+    typename ElemType,
+    typename BootstrapType
 >
 template<typename MatType>
 double RandomForest<
@@ -214,7 +227,8 @@ double RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    ElemType
+    ElemType,
+    BootstrapType
 >::Train(const MatType& dataset,
          const arma::Row<size_t>& labels,
          const size_t numClasses,
@@ -237,7 +251,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    typename ElemType
+    typename ElemType,
+    typename BootstrapType
 >
 template<typename MatType>
 double RandomForest<
@@ -245,7 +260,8 @@ double RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    ElemType
+    ElemType,
+    BootstrapType
 >::Train(const MatType& dataset,
          const data::DatasetInfo& datasetInfo,
          const arma::Row<size_t>& labels,
@@ -268,7 +284,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    typename ElemType
+    typename ElemType,
+    typename BootstrapType
 >
 template<typename VecType>
 size_t RandomForest<
@@ -276,7 +293,8 @@ size_t RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    ElemType
+    ElemType,
+    BootstrapType
 >::Classify(const VecType& point) const
 {
   // Pass off to another Classify() overload.
@@ -292,7 +310,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    typename ElemType
+    typename ElemType,
+    typename BootstrapType
 >
 template<typename VecType>
 void RandomForest<
@@ -300,7 +319,8 @@ void RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    ElemType
+    ElemType,
+    BootstrapType
 >::Classify(const VecType& point,
             size_t& prediction,
             arma::vec& probabilities) const
@@ -339,7 +359,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    typename ElemType
+    typename ElemType,
+    typename BootstrapType
 >
 template<typename MatType>
 void RandomForest<
@@ -347,7 +368,8 @@ void RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    ElemType
+    ElemType,
+    BootstrapType
 >::Classify(const MatType& data,
             arma::Row<size_t>& predictions) const
 {
@@ -374,7 +396,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    typename ElemType
+    typename ElemType,
+    typename BootstrapType
 >
 template<typename MatType>
 void RandomForest<
@@ -382,7 +405,8 @@ void RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    ElemType
+    ElemType,
+    BootstrapType
 >::Classify(const MatType& data,
             arma::Row<size_t>& predictions,
             arma::mat& probabilities) const
@@ -412,7 +436,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    typename ElemType
+    typename ElemType,
+    typename BootstrapType
 >
 template<typename Archive>
 void RandomForest<
@@ -420,7 +445,8 @@ void RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    ElemType
+    ElemType,
+    BootstrapType
 >::serialize(Archive& ar, const unsigned int /* version */)
 {
   size_t numTrees;
@@ -443,7 +469,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    typename ElemType
+    typename ElemType,
+    typename BootstrapType
 >
 template<bool UseWeights, bool UseDatasetInfo, typename MatType>
 double RandomForest<
@@ -451,7 +478,8 @@ double RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    ElemType
+    ElemType,
+    BootstrapType
 >::Train(const MatType& dataset,
          const data::DatasetInfo& datasetInfo,
          const arma::Row<size_t>& labels,
@@ -474,13 +502,13 @@ double RandomForest<
     MatType bootstrapDataset;
     arma::Row<size_t> bootstrapLabels;
     arma::rowvec bootstrapWeights;
-    Bootstrap<UseWeights>(dataset, labels, weights, bootstrapDataset,
-        bootstrapLabels, bootstrapWeights);
+    BootstrapType::template Sample<UseWeights>(dataset, labels, weights,
+        bootstrapDataset, bootstrapLabels, bootstrapWeights);
     Timer::Stop("bootstrap");
 
     // Now build the decision tree.
     Timer::Start("train_tree");
-    if (UseWeights)
+    if (UseWeights || BootstrapType::ProducesWeights)
     {
       if (UseDatasetInfo)
       {
@@ -259,6 +259,80 @@ class RangeSearch
               std::vector<std::vector<size_t>>& neighbors,
               std::vector<std::vector<double>>& distances);
 
+  /**
+   * Search for all reference points in the given range for each point in the
+   * query set, passing each result to the given callback instead of storing
+   * it.  The callback is called as
+   *
+   * @code
+   * callback(queryIndex, referenceIndex, distance);
+   * @endcode
+   *
+   * for each query point and each reference point within the given range of
+   * it, with the indices of the points in the query set and in the reference
+   * set, as soon as the result is found.  No results are stored, so this can
+   * be used when the results do not fit in memory, or when they are consumed
+   * immediately.  The results are not passed in any particular order.
+   *
+   * @param querySet Set of query points to search with.
+   * @param range Range of distances in which to search.
+   * @param callback Callback to pass each result to.
+   */
+  template<typename CallbackType>
+  void Search(const MatType& querySet,
+              const math::Range& range,
+              CallbackType& callback);
+
+  /**
+   * Search for all points in the given range for each point in the reference
+   * set, passing each result to the given callback instead of storing it (see
+   * the overload above).  The query set and the reference set are the same,
+   * and a point is not passed as its own neighbor.
+   *
+   * @param range Range of distances in which to search.
+   * @param callback Callback to pass each result to.
+   */
+  template<typename CallbackType>
+  void Search(const math::Range& range, CallbackType& callback);
+
+  /**
+   * Search for all reference points in the given range for each point in the
+   * query set, returning the results in compressed sparse row format: the
+   * neighbors of query point i and their distances are
+   * neighbors[offsets[i]] to neighbors[offsets[i + 1] - 1] and
+   * distances[offsets[i]] to distances[offsets[i + 1] - 1].  This takes much
+   * less memory than a vector of vectors when there are many results.  The
+   * neighbors of each query point are not sorted in any particular order.
+   *
+   * @param querySet Set of query points to search with.
+   * @param range Range of distances in which to search.
+   * @param offsets Vector to store the offset of the results of each query
+   *      point in (it will have one more element than there are query points).
+   * @param neighbors Vector to store the neighbors of all query points in.
+   * @param distances Vector to store the distances of all query points in.
+   */
+  void Search(const MatType& querySet,
+              const math::Range& range,
+              arma::Col<size_t>& offsets,
+              arma::Col<size_t>& neighbors,
+              arma::vec& distances);
+
+  /**
+   * Search for all points in the given range for each point in the reference
+   * set, returning the results in compressed sparse row format (see the
+   * overload above).  The query set and the reference set are the same, and a
+   * point is not returned as its own neighbor.
+   *
+   * @param range Range of distances in which to search.
+   * @param offsets Vector to store the offset of the results of each point in.
+   * @param neighbors Vector to store the neighbors of all points in.
+   * @param distances Vector to store the distances of all points in.
+   */
+  void Search(const math::Range& range,
+              arma::Col<size_t>& offsets,
+              arma::Col<size_t>& neighbors,
+              arma::vec& distances);
+
   //! Get whether single-tree search is being used.
   bool SingleMode() const { return singleMode; }
   //! Modify whether single-tree search is being used.
@@ -284,6 +358,12 @@ class RangeSearch
   //! Return the reference tree (or NULL if in naive mode).
   Tree* ReferenceTree() { return referenceTree; }
 
+  //! Return the mappings from the indices of the points in the reference tree
+  //! to their original indices (empty if this object did not build the tree,
+  //! or if the tree does not rearrange the dataset).
+  const std::vector<size_t>& OldFromNewReferences() const
+  { return oldFromNewReferences; }
+
  private:
   //! Mappings to old reference indices (used when this object builds trees).
   std::vector<size_t> oldFromNewReferences;
@@ -309,6 +389,19 @@ class RangeSearch
   //! The total number of scores during the last search.
   size_t scores;
 
+  /**
+   * Assemble the results of a search, given as a list of (query, reference,
+   * distance) triples, into compressed sparse row format.  The lists are
+   * emptied.
+   */
+  static void BuildCSR(const size_t numQueries,
+                       std::vector<size_t>& queryIndices,
+                       std::vector<size_t>& referenceIndices,
+                       std::vector<double>& resultDistances,
+                       arma::Col<size_t>& offsets,
+                       arma::Col<size_t>& neighbors,
+                       arma::vec& distances);
+
   //! For access to mappings when building models.
   friend class TrainVisitor;
 };
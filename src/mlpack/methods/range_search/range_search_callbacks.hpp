@@ -0,0 +1,116 @@
+/**
+ * @file methods/range_search/range_search_callbacks.hpp
+ *
+ * Callbacks that RangeSearchRules passes each result of a range search to:
+ * the default callback, which stores the results in vectors, and an adapter
+ * that maps the indices of rearranged trees back to the original indices.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANGE_SEARCH_RANGE_SEARCH_CALLBACKS_HPP
+#define MLPACK_METHODS_RANGE_SEARCH_RANGE_SEARCH_CALLBACKS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace range {
+
+/**
+ * The default callback of RangeSearchRules, which appends each result to the
+ * neighbors and distances of its query point.  A range search callback is
+ * called as
+ *
+ * @code
+ * callback(queryIndex, referenceIndex, distance);
+ * @endcode
+ *
+ * once for each pair of points whose distance is in the range.
+ */
+class VectorRangeCallback
+{
+ public:
+  /**
+   * Create the callback.  The vectors must already have one element for each
+   * query point.
+   *
+   * @param neighbors Vector to store the neighbors of each query point in.
+   * @param distances Vector to store the distances of each query point in.
+   */
+  VectorRangeCallback(std::vector<std::vector<size_t>>& neighbors,
+                      std::vector<std::vector<double>>& distances) :
+      neighbors(&neighbors),
+      distances(&distances)
+  { }
+
+  //! Store the given result.
+  void operator()(const size_t queryIndex,
+                  const size_t referenceIndex,
+                  const double distance)
+  {
+    (*neighbors)[queryIndex].push_back(referenceIndex);
+    (*distances)[queryIndex].push_back(distance);
+  }
+
+ private:
+  //! The neighbors of each query point.
+  std::vector<std::vector<size_t>>* neighbors;
+  //! The distances of each query point.
+  std::vector<std::vector<double>>* distances;
+};
+
+/**
+ * A callback that maps the query and reference indices of each result through
+ * the given mappings (as returned by trees that rearrange their dataset)
+ * before passing the result to another callback.  A NULL mapping leaves the
+ * indices unchanged.
+ *
+ * @tparam CallbackType Type of the callback to pass the results to.
+ */
+template<typename CallbackType>
+class MappedRangeCallback
+{
+ public:
+  /**
+   * Create the callback.  The callback and the mappings are not copied, so
+   * they must outlive this object.
+   *
+   * @param callback Callback to pass the mapped results to.
+   * @param oldFromNewQueries Mapping of the query indices, or NULL.
+   * @param oldFromNewReferences Mapping of the reference indices, or NULL.
+   */
+  MappedRangeCallback(CallbackType& callback,
+                      const std::vector<size_t>* oldFromNewQueries,
+                      const std::vector<size_t>* oldFromNewReferences) :
+      callback(&callback),
+      oldFromNewQueries(oldFromNewQueries),
+      oldFromNewReferences(oldFromNewReferences)
+  { }
+
+  //! Map the given result and pass it on.
+  void operator()(const size_t queryIndex,
+                  const size_t referenceIndex,
+                  const double distance)
+  {
+    (*callback)(
+        oldFromNewQueries ? (*oldFromNewQueries)[queryIndex] : queryIndex,
+        oldFromNewReferences ? (*oldFromNewReferences)[referenceIndex] :
+            referenceIndex,
+        distance);
+  }
+
+ private:
+  //! The callback to pass the results to.
+  CallbackType* callback;
+  //! The mapping of the query indices.
+  const std::vector<size_t>* oldFromNewQueries;
+  //! The mapping of the reference indices.
+  const std::vector<size_t>* oldFromNewReferences;
+};
+
+} // namespace range
+} // namespace mlpack
+
+#endif
@@ -618,6 +618,257 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
   }
 }
 
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename CallbackType>
+void RangeSearch<MetricType, MatType, TreeType>::Search(
+    const MatType& querySet,
+    const math::Range& range,
+    CallbackType& callback)
+{
+  if (querySet.n_rows != referenceSet->n_rows)
+  {
+    std::ostringstream oss;
+    oss << "RangeSearch::Search(): dimensionalities of query set ("
+        << querySet.n_rows << ") and reference set (" << referenceSet->n_rows
+        << ") do not match!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // If there are no points, there is no search to be done.
+  if (referenceSet->n_cols == 0)
+    return;
+
+  Timer::Start("range_search/computing_neighbors");
+
+  // The results are passed to the callback as soon as they are found, so the
+  // indices of the trees we built ourselves are mapped on the fly.
+  const std::vector<size_t>* referenceMapping =
+      (tree::TreeTraits<Tree>::RearrangesDataset && treeOwner) ?
+      &oldFromNewReferences : NULL;
+
+  typedef MappedRangeCallback<CallbackType> MappedCallbackType;
+  typedef RangeSearchRules<MetricType, Tree, MappedCallbackType> RuleType;
+
+  // Reset counts.
+  baseCases = 0;
+  scores = 0;
+
+  if (naive)
+  {
+    RuleType rules(*referenceSet, querySet, range,
+        MappedCallbackType(callback, NULL, NULL), metric);
+
+    // The naive brute-force solution.
+    for (size_t i = 0; i < querySet.n_cols; ++i)
+      for (size_t j = 0; j < referenceSet->n_cols; ++j)
+        rules.BaseCase(i, j);
+
+    baseCases += (querySet.n_cols * referenceSet->n_cols);
+  }
+  else if (singleMode)
+  {
+    // Create the traverser.
+    RuleType rules(*referenceSet, querySet, range,
+        MappedCallbackType(callback, NULL, referenceMapping), metric);
+    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+
+    // Now have it traverse for each point.
+    for (size_t i = 0; i < querySet.n_cols; ++i)
+      traverser.Traverse(i, *referenceTree);
+
+    baseCases += rules.BaseCases();
+    scores += rules.Scores();
+  }
+  else // Dual-tree recursion.
+  {
+    // Build the query tree.
+    std::vector<size_t> oldFromNewQueries;
+    Timer::Stop("range_search/computing_neighbors");
+    Timer::Start("range_search/tree_building");
+    Tree* queryTree = BuildTree<Tree>(querySet, oldFromNewQueries);
+    Timer::Stop("range_search/tree_building");
+    Timer::Start("range_search/computing_neighbors");
+
+    // Create the traverser.
+    const std::vector<size_t>* queryMapping =
+        tree::TreeTraits<Tree>::RearrangesDataset ? &oldFromNewQueries : NULL;
+    RuleType rules(*referenceSet, queryTree->Dataset(), range,
+        MappedCallbackType(callback, queryMapping, referenceMapping), metric);
+    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+
+    traverser.Traverse(*queryTree, *referenceTree);
+
+    baseCases += rules.BaseCases();
+    scores += rules.Scores();
+
+    // Clean up tree memory.
+    delete queryTree;
+  }
+
+  Timer::Stop("range_search/computing_neighbors");
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename CallbackType>
+void RangeSearch<MetricType, MatType, TreeType>::Search(
+    const math::Range& range,
+    CallbackType& callback)
+{
+  // If there are no points, there is no search to be done.
+  if (referenceSet->n_cols == 0)
+    return;
+
+  Timer::Start("range_search/computing_neighbors");
+
+  // Here the query set is the reference set, so both indices of each result
+  // are mapped if we built the tree ourselves.
+  const std::vector<size_t>* mapping =
+      (tree::TreeTraits<Tree>::RearrangesDataset && treeOwner) ?
+      &oldFromNewReferences : NULL;
+
+  typedef MappedRangeCallback<CallbackType> MappedCallbackType;
+  typedef RangeSearchRules<MetricType, Tree, MappedCallbackType> RuleType;
+  RuleType rules(*referenceSet, *referenceSet, range,
+      MappedCallbackType(callback, mapping, mapping), metric,
+      true /* don't return the query in the results */);
+
+  if (naive)
+  {
+    // The naive brute-force solution.
+    for (size_t i = 0; i < referenceSet->n_cols; ++i)
+      for (size_t j = 0; j < referenceSet->n_cols; ++j)
+        rules.BaseCase(i, j);
+
+    baseCases = (referenceSet->n_cols * referenceSet->n_cols);
+    scores = 0;
+  }
+  else if (singleMode)
+  {
+    // Create the traverser.
+    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+
+    // Now have it traverse for each point.
+    for (size_t i = 0; i < referenceSet->n_cols; ++i)
+      traverser.Traverse(i, *referenceTree);
+
+    baseCases = rules.BaseCases();
+    scores = rules.Scores();
+  }
+  else // Dual-tree recursion.
+  {
+    // Create the traverser.
+    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+
+    traverser.Traverse(*referenceTree, *referenceTree);
+
+    baseCases = rules.BaseCases();
+    scores = rules.Scores();
+  }
+
+  Timer::Stop("range_search/computing_neighbors");
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<MetricType, MatType, TreeType>::Search(
+    const MatType& querySet,
+    const math::Range& range,
+    arma::Col<size_t>& offsets,
+    arma::Col<size_t>& neighbors,
+    arma::vec& distances)
+{
+  std::vector<size_t> queryIndices, referenceIndices;
+  std::vector<double> resultDistances;
+  auto callback = [&](const size_t queryIndex,
+                      const size_t referenceIndex,
+                      const double distance)
+  {
+    queryIndices.push_back(queryIndex);
+    referenceIndices.push_back(referenceIndex);
+    resultDistances.push_back(distance);
+  };
+
+  Search(querySet, range, callback);
+  BuildCSR(querySet.n_cols, queryIndices, referenceIndices, resultDistances,
+      offsets, neighbors, distances);
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<MetricType, MatType, TreeType>::Search(
+    const math::Range& range,
+    arma::Col<size_t>& offsets,
+    arma::Col<size_t>& neighbors,
+    arma::vec& distances)
+{
+  std::vector<size_t> queryIndices, referenceIndices;
+  std::vector<double> resultDistances;
+  auto callback = [&](const size_t queryIndex,
+                      const size_t referenceIndex,
+                      const double distance)
+  {
+    queryIndices.push_back(queryIndex);
+    referenceIndices.push_back(referenceIndex);
+    resultDistances.push_back(distance);
+  };
+
+  Search(range, callback);
+  BuildCSR(referenceSet->n_cols, queryIndices, referenceIndices,
+      resultDistances, offsets, neighbors, distances);
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<MetricType, MatType, TreeType>::BuildCSR(
+    const size_t numQueries,
+    std::vector<size_t>& queryIndices,
+    std::vector<size_t>& referenceIndices,
+    std::vector<double>& resultDistances,
+    arma::Col<size_t>& offsets,
+    arma::Col<size_t>& neighbors,
+    arma::vec& distances)
+{
+  // Count the results of each query point, and turn the counts into offsets.
+  offsets.zeros(numQueries + 1);
+  for (size_t i = 0; i < queryIndices.size(); ++i)
+    ++offsets[queryIndices[i] + 1];
+  for (size_t i = 1; i < offsets.n_elem; ++i)
+    offsets[i] += offsets[i - 1];
+
+  // Now put each result in the next free slot of its query point.
+  std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+  neighbors.set_size(queryIndices.size());
+  distances.set_size(queryIndices.size());
+  for (size_t i = 0; i < queryIndices.size(); ++i)
+  {
+    const size_t position = next[queryIndices[i]]++;
+    neighbors[position] = referenceIndices[i];
+    distances[position] = resultDistances[i];
+  }
+
+  // Release the memory of the lists.
+  std::vector<size_t>().swap(queryIndices);
+  std::vector<size_t>().swap(referenceIndices);
+  std::vector<double>().swap(resultDistances);
+}
+
 template<typename MetricType,
          typename MatType,
          template<typename TreeMetricType,
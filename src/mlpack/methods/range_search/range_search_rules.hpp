@@ -13,18 +13,26 @@
 #define MLPACK_METHODS_RANGE_SEARCH_RANGE_SEARCH_RULES_HPP
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include "range_search_callbacks.hpp"
 
 namespace mlpack {
 namespace range {
 
 /**
  * The RangeSearchRules class is a template helper class used by RangeSearch
- * class when performing range searches.
+ * class when performing range searches.  Each result (a query point, a
+ * reference point, and the distance between them) is passed to a callback as
+ * soon as it is found; by default the results are stored in vectors (see
+ * VectorRangeCallback), but any other callback can process them without
+ * storing them.
  *
  * @tparam MetricType The metric to use for computation.
  * @tparam TreeType The tree type to use; must adhere to the TreeType API.
+ * @tparam CallbackType The callback to pass each result to.
  */
-template<typename MetricType, typename TreeType>
+template<typename MetricType,
+         typename TreeType,
+         typename CallbackType = VectorRangeCallback>
 class RangeSearchRules
 {
  public:
@@ -49,6 +57,27 @@ class RangeSearchRules
                    MetricType& metric,
                    const bool sameSet = false);
 
+  /**
+   * Construct the RangeSearchRules object with a callback that each result is
+   * passed to, as callback(queryIndex, referenceIndex, distance).  The
+   * callback is copied, so it should hold references to any state that it
+   * updates.
+   *
+   * @param referenceSet Set of reference data.
+   * @param querySet Set of query data.
+   * @param range Range to search for.
+   * @param callback Callback to pass each result to.
+   * @param metric Instantiated metric.
+   * @param sameSet If true, the query and reference set are taken to be the
+   *      same, and a query point will not return itself in the results.
+   */
+  RangeSearchRules(const arma::mat& referenceSet,
+                   const arma::mat& querySet,
+                   const math::Range& range,
+                   CallbackType callback,
+                   MetricType& metric,
+                   const bool sameSet = false);
+
   /**
    * Compute the base case between the given query point and reference point.
    *
@@ -117,6 +146,11 @@ class RangeSearchRules
   //! Get the number of scores (that is, calls to RangeDistance()).
   size_t Scores() const { return scores; }
 
+  //! Get the callback.
+  const CallbackType& Callback() const { return callback; }
+  //! Modify the callback.
+  CallbackType& Callback() { return callback; }
+
  private:
   //! The reference set.
   const arma::mat& referenceSet;
@@ -127,11 +161,8 @@ class RangeSearchRules
   //! The range of distances for which we are searching.
   const math::Range& range;
 
-  //! The vector the resultant neighbor indices should be stored in.
-  std::vector<std::vector<size_t> >& neighbors;
-
-  //! The vector the resultant neighbor distances should be stored in.
-  std::vector<std::vector<double> >& distances;
+  //! The callback that each result is passed to.
+  CallbackType callback;
 
   //! The instantiated metric.
   MetricType& metric;
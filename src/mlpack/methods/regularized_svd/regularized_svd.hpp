@@ -16,6 +16,7 @@
 #include <mlpack/prereqs.hpp>
 #include <ensmallen.hpp>
 #include <mlpack/methods/cf/cf.hpp>
+#include <mlpack/methods/cf/svd_optimizer.hpp>
 
 #include "regularized_svd_function.hpp"
 
@@ -53,6 +54,11 @@ namespace svd {
  * // Use the Apply() method to get a factorization.
  * rSVD.Apply(data, rank, u, v);
  * @endcode
+ *
+ * OptimizerType may also be ens::ParallelSGD<ens::ExponentialBackoff>, to
+ * train with several OpenMP threads; see SVDOptimizer.  The threads update the
+ * shared factors without locking, which is a data race (undefined behavior in
+ * C++), and the result is not reproducible.
  */
 template<typename OptimizerType = ens::StandardSGD>
 class RegularizedSVD
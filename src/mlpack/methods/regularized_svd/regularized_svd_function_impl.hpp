@@ -231,7 +231,9 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
   arma::Col<size_t> visitationOrder = arma::linspace<arma::Col<size_t>>(0,
       (function.NumFunctions() - 1), function.NumFunctions());
 
-  const arma::mat data = function.Dataset();
+  const arma::mat& data = function.Dataset();
+  const size_t numUsers = function.NumUsers();
+  const double lambda = function.Lambda();
 
   // Iterate till the objective is within tolerance or the maximum number of
   // allowed iterations is reached. If maxIterations is 0, this will iterate
@@ -287,32 +289,29 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
           j < (threadId + 1) * threadShareSize && j < visitationOrder.n_elem;
           ++j)
       {
-        const size_t numUsers = function.NumUsers();
-
         // Indices for accessing the the correct parameter columns.
         const size_t user = data(0, visitationOrder[j]);
         const size_t item = data(1, visitationOrder[j]) + numUsers;
 
+        double* userVec = iterate.colptr(user);
+        double* itemVec = iterate.colptr(item);
+
         // Prediction error for the example.
         const double rating = data(2, visitationOrder[j]);
-        double ratingError = rating - arma::dot(iterate.col(user),
-            iterate.col(item));
-
-        double lambda = function.Lambda();
-
-        arma::mat userUpdate = stepSize * (lambda * iterate.col(user) -
-            ratingError * iterate.col(item));
-        arma::mat itemUpdate = stepSize * (lambda * iterate.col(item) -
-            ratingError * iterate.col(user));
+        double ratingError = rating;
+        for (size_t k = 0; k < iterate.n_rows; ++k)
+          ratingError -= userVec[k] * itemVec[k];
 
         // Gradient is non-zero only for the parameter columns corresponding to
-        // the example.
-        for (size_t i = 0; i < iterate.n_rows; ++i)
+        // the example.  They are updated in place without locking; see
+        // SVDOptimizer.
+        for (size_t k = 0; k < iterate.n_rows; ++k)
         {
-          #pragma omp atomic
-          iterate(i, user) -= userUpdate(i);
-          #pragma omp atomic
-          iterate(i, item) -= itemUpdate(i);
+          const double userValue = userVec[k];
+          userVec[k] -= stepSize * (lambda * userValue -
+              ratingError * itemVec[k]);
+          itemVec[k] -= stepSize * (lambda * itemVec[k] -
+              ratingError * userValue);
         }
       }
     }
@@ -41,12 +41,11 @@ void RegularizedSVD<OptimizerType>::Apply(const arma::mat& data,
 
   // Make the optimizer object using a RegularizedSVDFunction object.
   RegularizedSVDFunction<arma::mat> rSVDFunc(data, rank, lambda);
-  ens::StandardSGD optimizer(alpha, batchSize,
-      iterations * data.n_cols);
 
   // Get optimized parameters.
   arma::mat parameters = rSVDFunc.GetInitialPoint();
-  optimizer.Optimize(rSVDFunc, parameters);
+  SVDOptimizer<OptimizerType>::Optimize(rSVDFunc, parameters, alpha, batchSize,
+      iterations);
 
   // Constants for extracting user and item matrices.
   const size_t numUsers = max(data.row(0)) + 1;
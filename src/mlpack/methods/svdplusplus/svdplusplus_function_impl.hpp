@@ -406,8 +406,8 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
   arma::Col<size_t> visitationOrder = arma::linspace<arma::Col<size_t>>(0,
       (function.NumFunctions() - 1), function.NumFunctions());
 
-  const arma::mat data = function.Dataset();
-  const arma::sp_mat implicitData = function.ImplicitDataset();
+  const arma::mat& data = function.Dataset();
+  const arma::sp_mat& implicitData = function.ImplicitDataset();
   const size_t numUsers = function.NumUsers();
   const size_t numItems = function.NumItems();
   const double lambda = function.Lambda();
@@ -465,6 +465,11 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
         threadId = omp_get_thread_num();
       #endif
 
+      // Buffers for the implicit user vector and the item vector, reused for
+      // every example handled by this thread.
+      arma::vec userVec(rank);
+      arma::vec itemVec(rank);
+
       for (size_t j = threadId * threadShareSize;
           j < (threadId + 1) * threadShareSize && j < visitationOrder.n_elem;
           ++j)
@@ -480,7 +485,7 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
         const double itemBias = iterate(rank, item);
         // Iterate through each item which the user interacted with to calculate
         // user vector.
-        arma::vec userVec(rank, arma::fill::zeros);
+        userVec.zeros();
         arma::sp_mat::const_iterator it = implicitData.begin_col(user);
         arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
         size_t implicitCount = 0;
@@ -493,56 +498,38 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
           userVec /= std::sqrt(implicitCount);
         userVec += iterate.col(user).subvec(0, rank - 1);
 
-        double ratingError = rating - userBias - itemBias -
-        arma::dot(userVec, iterate.col(item).subvec(0, rank - 1));
-
-        arma::mat userVecUpdate = stepSize * 2 * (
-            lambda * iterate.col(user).subvec(0, rank - 1) -
-            ratingError * iterate.col(item).subvec(0, rank - 1));
-        arma::mat itemVecUpdate = stepSize * 2 * (
-            lambda * iterate.col(item).subvec(0, rank - 1) -
-            ratingError * userVec);
-        double userBiasUpdate = stepSize * 2 * (
-            lambda * iterate(rank, user) - ratingError);
-        double itemBiasUpdate = stepSize * 2 * (
-            lambda * iterate(rank, item) - ratingError);
-
-        // Update of item implicit vectors.
-        arma::mat itemImplicitUpdate(rank, implicitCount);
-        arma::Col<size_t> implicitItems(implicitCount);
-        it = implicitData.begin_col(user);
-        it_end = implicitData.end_col(user);
-        size_t implicitIndex = 0;
-        for (; it != it_end; ++it, ++implicitIndex)
-        {
-          itemImplicitUpdate.col(implicitIndex) =
-              stepSize * 2.0 * (lambda / implicitCount *
-              iterate.col(implicitStart + it.row()).subvec(0, rank - 1) -
-              ratingError / std::sqrt(implicitCount) *
-              iterate.col(item).subvec(0, rank - 1));
-          implicitItems(implicitIndex) = it.row();
-        }
+        itemVec = iterate.col(item).subvec(0, rank - 1);
+        const double ratingError = rating - userBias - itemBias -
+            arma::dot(userVec, itemVec);
 
         // Gradient is non-zero only for the parameter columns corresponding to
-        // the example.
-        for (size_t i = 0; i < rank; ++i)
+        // the example.  They are updated in place without locking; see
+        // SVDOptimizer.
+        double* userCol = iterate.colptr(user);
+        double* itemCol = iterate.colptr(item);
+        for (size_t k = 0; k < rank; ++k)
         {
-          #pragma omp atomic
-          iterate(i, user) -= userVecUpdate(i);
-          #pragma omp atomic
-          iterate(i, item) -= itemVecUpdate(i);
+          userCol[k] -= stepSize * 2 * (lambda * userCol[k] -
+              ratingError * itemVec[k]);
+          itemCol[k] -= stepSize * 2 * (lambda * itemVec[k] -
+              ratingError * userVec[k]);
         }
-        #pragma omp atomic
-        iterate(rank, user) -= userBiasUpdate;
-        #pragma omp atomic
-        iterate(rank, item) -= itemBiasUpdate;
-        for (size_t k = 0; k < implicitCount; ++k)
+        userCol[rank] -= stepSize * 2 * (lambda * userBias - ratingError);
+        itemCol[rank] -= stepSize * 2 * (lambda * itemBias - ratingError);
+
+        // Update of item implicit vectors.
+        if (implicitCount != 0)
         {
-          for (size_t i = 0; i < rank; ++i)
+          const double sqrtCount = std::sqrt(implicitCount);
+          it = implicitData.begin_col(user);
+          for (; it != it_end; ++it)
           {
-            #pragma omp atomic
-            iterate(i, implicitStart + implicitItems(k)) -=
-                itemImplicitUpdate(i, k);
+            double* implicitCol = iterate.colptr(implicitStart + it.row());
+            for (size_t k = 0; k < rank; ++k)
+            {
+              implicitCol[k] -= stepSize * 2.0 * (lambda / implicitCount *
+                  implicitCol[k] - ratingError / sqrtCount * itemVec[k]);
+            }
           }
         }
       }
@@ -50,12 +50,11 @@ void SVDPlusPlus<OptimizerType>::Apply(const arma::mat& data,
 
   // Make the optimizer object using a SVDPlusPlusFunction object.
   SVDPlusPlusFunction<arma::mat> svdPPFunc(data, cleanedData, rank, lambda);
-  ens::StandardSGD optimizer(alpha, batchSize,
-      iterations * data.n_cols);
 
   // Get optimized parameters.
   arma::mat parameters = svdPPFunc.GetInitialPoint();
-  optimizer.Optimize(svdPPFunc, parameters);
+  SVDOptimizer<OptimizerType>::Optimize(svdPPFunc, parameters, alpha, batchSize,
+      iterations);
 
   // Constants for extracting user and item matrices.
   const size_t numUsers = max(data.row(0)) + 1;
@@ -377,6 +377,86 @@ BOOST_AUTO_TEST_CASE(BiasSVDFunctionParallelOptimize)
   BOOST_REQUIRE_SMALL(relativeError, 1e-2);
 }
 
+// Make a rating dataset from a random low-rank model with user and item
+// biases, and hold out a fifth of the ratings.
+static void LowRankRatings(arma::mat& train, arma::mat& test)
+{
+  const size_t numUsers = 60;
+  const size_t numItems = 40;
+  const size_t rank = 3;
+
+  const arma::mat userFactors = arma::randu(rank, numUsers);
+  const arma::mat itemFactors = arma::randu(rank, numItems);
+  const arma::rowvec userBias = 0.5 * arma::randu<arma::rowvec>(numUsers);
+  const arma::rowvec itemBias = 0.5 * arma::randu<arma::rowvec>(numItems);
+
+  // Every user rates half of the items.
+  arma::mat ratings(3, numUsers * numItems / 2);
+  size_t col = 0;
+  for (size_t user = 0; user < numUsers; ++user)
+  {
+    for (size_t item = user % 2; item < numItems; item += 2)
+    {
+      ratings(0, col) = user;
+      ratings(1, col) = item;
+      ratings(2, col) = 1.0 + userBias[user] + itemBias[item] +
+          arma::dot(userFactors.col(user), itemFactors.col(item));
+      ++col;
+    }
+  }
+
+  ratings = ratings.cols(arma::randperm(ratings.n_cols));
+
+  // Make sure the last user and item are in the training set, so that the
+  // model has the right size.
+  const arma::uvec last = arma::find(ratings.row(0) == numUsers - 1 &&
+      ratings.row(1) == numItems - 1, 1);
+  ratings.swap_cols(0, last[0]);
+
+  const size_t numTest = ratings.n_cols / 5;
+  train = ratings.head_cols(ratings.n_cols - numTest);
+  test = ratings.tail_cols(numTest);
+}
+
+// Make sure that the lock-free parallel SGD path of BiasSVD predicts held-out
+// ratings about as well as the serial SGD path.
+BOOST_AUTO_TEST_CASE(BiasSVDParallelSGDApplyTest)
+{
+  const size_t rank = 3;
+
+  arma::mat train, test;
+  LowRankRatings(train, test);
+
+  // Compute the RMSE on the held-out ratings.
+  auto rmse = [&test](const arma::mat& u, const arma::mat& v,
+                      const arma::vec& p, const arma::vec& q) -> double
+  {
+    double error = 0.0;
+    for (size_t i = 0; i < test.n_cols; ++i)
+    {
+      const size_t user = test(0, i);
+      const size_t item = test(1, i);
+      const double prediction = arma::dot(u.row(item), v.col(user)) +
+          p(item) + q(user);
+      error += std::pow(prediction - test(2, i), 2.0);
+    }
+    return std::sqrt(error / test.n_cols);
+  };
+
+  BiasSVD<> serialSVD(50);
+  arma::mat u, v;
+  arma::vec p, q;
+  serialSVD.Apply(train, rank, u, v, p, q);
+  const double serialRMSE = rmse(u, v, p, q);
+
+  BiasSVD<ens::ParallelSGD<ens::ExponentialBackoff>> parallelSVD(50);
+  parallelSVD.Apply(train, rank, u, v, p, q);
+  const double parallelRMSE = rmse(u, v, p, q);
+
+  BOOST_REQUIRE_LT(std::abs(parallelRMSE - serialRMSE),
+      0.2 * serialRMSE + 0.02);
+}
+
 #endif
 
 BOOST_AUTO_TEST_SUITE_END();
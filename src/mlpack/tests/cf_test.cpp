@@ -13,6 +13,7 @@
 
 #include <mlpack/core.hpp>
 #include <mlpack/methods/cf/cf.hpp>
+#include <mlpack/methods/cf/decomposition_policies/als_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/batch_svd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/bias_svd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/randomized_svd_method.hpp>
@@ -580,6 +581,15 @@ BOOST_AUTO_TEST_CASE(CFGetRecommendationsAllUsersSVDPPTest)
   GetRecommendationsAllUsers<SVDPlusPlusPolicy>();
 }
 
+/**
+ * Make sure that correct number of recommendations are generated when query
+ * set for ALS.
+ */
+BOOST_AUTO_TEST_CASE(CFGetRecommendationsAllUsersALSTest)
+{
+  GetRecommendationsAllUsers<ALSPolicy>();
+}
+
 /**
  * Make sure that the recommendations are generated for queried users only
  * for randomized SVD.
@@ -788,6 +798,12 @@ BOOST_AUTO_TEST_CASE(CFPredictSVDPPTest)
   CFPredict<SVDPlusPlusPolicy>();
 }
 
+// Make sure that Predict() is returning reasonable results for ALS.
+BOOST_AUTO_TEST_CASE(CFPredictALSTest)
+{
+  CFPredict<ALSPolicy>();
+}
+
 // Compare batch Predict() and individual Predict() for randomized SVD.
 BOOST_AUTO_TEST_CASE(CFBatchPredictRandSVDTest)
 {
@@ -840,6 +856,12 @@ BOOST_AUTO_TEST_CASE(CFBatchPredictSVDPPTest)
   BatchPredict<SVDPlusPlusPolicy>();
 }
 
+// Compare batch Predict() and individual Predict() for ALS.
+BOOST_AUTO_TEST_CASE(CFBatchPredictALSTest)
+{
+  BatchPredict<ALSPolicy>();
+}
+
 /**
  * Make sure we can train an already-trained model and it works okay for
  * randomized SVD.
@@ -920,6 +942,15 @@ BOOST_AUTO_TEST_CASE(TrainSVDPPTest)
   TrainWithCoordinateList(decomposition);
 }
 
+/**
+ * Make sure we can train an already-trained model and it works okay for ALS.
+ */
+BOOST_AUTO_TEST_CASE(TrainALSTest)
+{
+  ALSPolicy decomposition;
+  Train(decomposition);
+}
+
 /**
  * Make sure we can train a model after using the empty constructor when
  * using randomized SVD.
@@ -1014,6 +1045,14 @@ BOOST_AUTO_TEST_CASE(SerializationSVDIncompleteTest)
   Serialization<SVDIncompletePolicy>();
 }
 
+/**
+ * Ensure we can load and save the CF model using ALS.
+ */
+BOOST_AUTO_TEST_CASE(SerializationALSTest)
+{
+  Serialization<ALSPolicy>();
+}
+
 /**
  * Make sure that Predict() is returning reasonable results for NMF and
  * OverallMeanNormalization.
@@ -1228,4 +1267,140 @@ BOOST_AUTO_TEST_CASE(CFPredictRegressionInterpolation)
             RegressionInterpolation>(2.0);
 }
 
+/**
+ * Make sure that recommendations generated for a batch of users, which are
+ * handled in parallel, are the same as those generated for each user on its
+ * own.
+ */
+BOOST_AUTO_TEST_CASE(CFGetRecommendationsBatchTest)
+{
+  arma::mat dataset;
+  data::Load("GroupLensSmall.csv", dataset);
+
+  NMFPolicy decomposition;
+  CFType<NMFPolicy> c(dataset, decomposition, 5, 5, 30);
+
+  const size_t numRecs = 10;
+  arma::Col<size_t> users = arma::linspace<arma::Col<size_t>>(0, 49, 50);
+
+  arma::Mat<size_t> recommendations;
+  c.GetRecommendations(numRecs, recommendations, users);
+
+  BOOST_REQUIRE_EQUAL(recommendations.n_rows, numRecs);
+  BOOST_REQUIRE_EQUAL(recommendations.n_cols, users.n_elem);
+
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    arma::Col<size_t> user(1);
+    user(0) = users(i);
+    arma::Mat<size_t> userRecommendations;
+    c.GetRecommendations(numRecs, userRecommendations, user);
+
+    for (size_t j = 0; j < numRecs; ++j)
+      BOOST_REQUIRE_EQUAL(recommendations(j, i), userRecommendations(j, 0));
+  }
+}
+
+/**
+ * Make sure that users with fewer un-rated items than the number of
+ * recommendations get the un-rated items, followed by an invalid item, when
+ * they are part of a batch.
+ */
+BOOST_AUTO_TEST_CASE(CFGetRecommendationsIncompleteTest)
+{
+  // Each column is (user, item, rating).  User 0 has one un-rated item, and
+  // users 1 and 2 have two.
+  arma::mat dataset("0 0 0 1 1 2 2 3 3 4 4 4;"
+                    "0 1 2 0 3 1 3 2 3 0 1 3;"
+                    "5 4 3 2 4 5 1 3 2 4 5 3");
+
+  NMFPolicy decomposition;
+  CFType<NMFPolicy> c(dataset, decomposition, 3, 2, 100);
+
+  const size_t numItems = c.CleanedData().n_rows;
+  BOOST_REQUIRE_EQUAL(numItems, 4);
+
+  const size_t numRecs = 3;
+  arma::Col<size_t> users("0 1 2");
+  arma::Mat<size_t> recommendations;
+  c.GetRecommendations(numRecs, recommendations, users);
+
+  BOOST_REQUIRE_EQUAL(recommendations.n_rows, numRecs);
+  BOOST_REQUIRE_EQUAL(recommendations.n_cols, 3);
+
+  // User 0 only gets item 3.
+  BOOST_REQUIRE_EQUAL(recommendations(0, 0), 3);
+  BOOST_REQUIRE_EQUAL(recommendations(1, 0), numItems);
+  BOOST_REQUIRE_EQUAL(recommendations(2, 0), numItems);
+
+  // Users 1 and 2 get their two un-rated items in some order.
+  const arma::Col<size_t> unrated1("1 2");
+  const arma::Col<size_t> unrated2("0 2");
+  for (size_t j = 0; j < 2; ++j)
+  {
+    BOOST_REQUIRE(arma::any(unrated1 == recommendations(j, 1)));
+    BOOST_REQUIRE(arma::any(unrated2 == recommendations(j, 2)));
+  }
+  BOOST_REQUIRE_NE(recommendations(0, 1), recommendations(1, 1));
+  BOOST_REQUIRE_NE(recommendations(0, 2), recommendations(1, 2));
+  BOOST_REQUIRE_EQUAL(recommendations(2, 1), numItems);
+  BOOST_REQUIRE_EQUAL(recommendations(2, 2), numItems);
+
+  // The batch results match the results for each user on its own.
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    arma::Col<size_t> user(1);
+    user(0) = users(i);
+    arma::Mat<size_t> userRecommendations;
+    c.GetRecommendations(numRecs, userRecommendations, user);
+
+    for (size_t j = 0; j < numRecs; ++j)
+      BOOST_REQUIRE_EQUAL(recommendations(j, i), userRecommendations(j, 0));
+  }
+}
+
+/**
+ * Make sure that the ratings a decomposition policy computes for a set of users
+ * at once are the same as the ratings it computes for each user.
+ */
+template<typename DecompositionPolicy>
+void GetRatingOfUsers()
+{
+  arma::mat dataset;
+  data::Load("GroupLensSmall.csv", dataset);
+
+  DecompositionPolicy decomposition;
+  CFType<DecompositionPolicy> c(dataset, decomposition, 5, 5, 30);
+
+  arma::Col<size_t> users("0 3 3 17 42 199");
+  arma::mat ratings;
+  c.Decomposition().GetRatingOfUsers(users, ratings);
+
+  BOOST_REQUIRE_EQUAL(ratings.n_rows, c.CleanedData().n_rows);
+  BOOST_REQUIRE_EQUAL(ratings.n_cols, users.n_elem);
+
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    arma::vec userRatings;
+    c.Decomposition().GetRatingOfUser(users(i), userRatings);
+    for (size_t j = 0; j < userRatings.n_elem; ++j)
+      BOOST_REQUIRE_SMALL(ratings(j, i) - userRatings(j), 1e-8);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GetRatingOfUsersNMFTest)
+{
+  GetRatingOfUsers<NMFPolicy>();
+}
+
+BOOST_AUTO_TEST_CASE(GetRatingOfUsersBiasSVDTest)
+{
+  GetRatingOfUsers<BiasSVDPolicy>();
+}
+
+BOOST_AUTO_TEST_CASE(GetRatingOfUsersSVDPlusPlusTest)
+{
+  GetRatingOfUsers<SVDPlusPlusPolicy>();
+}
+
 BOOST_AUTO_TEST_SUITE_END();
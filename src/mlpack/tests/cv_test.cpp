@@ -38,6 +38,7 @@
 
 #include <boost/test/unit_test.hpp>
 #include "mock_categorical_data.hpp"
+#include "test_tools.hpp"
 
 using namespace mlpack;
 using namespace mlpack::ann;
@@ -735,4 +736,88 @@ BOOST_AUTO_TEST_CASE(SilhouetteScoreTest)
   BOOST_REQUIRE_CLOSE(silhouetteScore, 0.1121684822489150, 1e-5);
 }
 
+/**
+ * Test the silhouette scores computed in tiles match the ones computed from
+ * the pairwise distances, and the sampled overall score is close to the exact
+ * one.
+ */
+BOOST_AUTO_TEST_CASE(SilhouetteScoreBlockedTest)
+{
+  // More points than fit in one block, in three overlapping clusters.
+  const size_t n = 2 * SilhouetteScore::BlockSize + 100;
+  arma::mat X = arma::randn(2, n);
+  arma::Row<size_t> labels(n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    labels[i] = 2 * (i % 3);
+    X(0, i) += 3.0 * (i % 3);
+  }
+  // A cluster with a single point.
+  labels[0] = 7;
+
+  metric::EuclideanDistance metric;
+  arma::mat distances = PairwiseDistances(X, metric);
+  arma::rowvec expected = SilhouetteScore::SamplesScore(distances, labels);
+  arma::rowvec scores = SilhouetteScore::SamplesScore(X, labels, metric);
+  BOOST_REQUIRE_EQUAL(scores.n_elem, n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    if (std::abs(expected[i]) < 1e-10)
+      BOOST_REQUIRE_SMALL(scores[i], 1e-10);
+    else
+      BOOST_REQUIRE_CLOSE(scores[i], expected[i], 1e-5);
+  }
+  BOOST_REQUIRE_SMALL(scores[0], 1e-10);
+
+  const double overall = SilhouetteScore::Overall(X, labels, metric);
+  BOOST_REQUIRE_CLOSE(overall, arma::mean(expected), 1e-5);
+  BOOST_REQUIRE_CLOSE(SilhouetteScore::Overall(X, labels, metric, n), overall,
+      1e-5);
+
+  // The sampled score has a standard error of about 0.02 here.
+  BOOST_REQUIRE_SMALL(SilhouetteScore::Overall(X, labels, metric, n / 2) -
+      overall, 0.1);
+
+  // An empty dataset has no scores.
+  const arma::mat empty(2, 0);
+  const arma::Row<size_t> emptyLabels;
+  BOOST_REQUIRE_EQUAL(SilhouetteScore::SamplesScore(empty, emptyLabels,
+      metric).n_elem, 0);
+}
+
+/**
+ * Test SimpleCV and KFoldCV train on the first points of the training data
+ * when only a fraction of it is used.
+ */
+BOOST_AUTO_TEST_CASE(CVEvaluateSubsampleTest)
+{
+  arma::mat data = arma::randn(3, 100);
+  arma::rowvec responses = arma::randn(1, 3) * data +
+      0.1 * arma::randn(1, 100);
+
+  // 80 training points, so half of them is the first 40 points.
+  SimpleCV<LinearRegression, MSE> simpleCV(0.2, data, responses);
+  std::unique_ptr<LinearRegression> model;
+  const double objective = simpleCV.EvaluateSubsample(model, 0.5);
+
+  LinearRegression lr(data.cols(0, 39), responses.cols(0, 39));
+  CheckMatrices(model->Parameters(), lr.Parameters());
+  arma::mat validationData = data.cols(80, 99);
+  arma::rowvec validationResponses = responses.cols(80, 99);
+  BOOST_REQUIRE_CLOSE(objective, MSE::Evaluate(lr, validationData,
+      validationResponses), 1e-5);
+
+  // With all the training data, the result is the same as with Evaluate().
+  KFoldCV<LinearRegression, MSE> kFoldCV(4, data, responses, false);
+  kFoldCV.MaxThreads() = 1;
+  BOOST_REQUIRE_CLOSE(kFoldCV.EvaluateSubsample(model, 1.0),
+      kFoldCV.Evaluate(), 1e-5);
+  CheckMatrices(model->Parameters(), kFoldCV.Model().Parameters());
+
+  BOOST_REQUIRE_THROW(kFoldCV.EvaluateSubsample(model, 0.0),
+      std::invalid_argument);
+  BOOST_REQUIRE_THROW(simpleCV.EvaluateSubsample(model, 1.5),
+      std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
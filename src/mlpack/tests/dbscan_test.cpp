@@ -12,6 +12,7 @@
 #include <mlpack/core.hpp>
 #include <mlpack/methods/dbscan/dbscan.hpp>
 #include <mlpack/methods/dbscan/random_point_selection.hpp>
+#include <mlpack/core/tree/cover_tree.hpp>
 
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
@@ -309,4 +310,63 @@ BOOST_AUTO_TEST_CASE(RandomPointSelectionTest)
   BOOST_REQUIRE_EQUAL(assignments.n_elem, points.n_cols);
 }
 
+/**
+ * Make sure that the parallel batch search finds the same clusters as the
+ * pointwise search and as naive search, with a few different trees.
+ */
+BOOST_AUTO_TEST_CASE(BatchMatchesPointwiseTest)
+{
+  // Clusters of different densities, so that some nodes are united in bulk
+  // and some are not.
+  arma::mat points(2, 1500);
+  points.cols(0, 499) = 0.1 * arma::randn<arma::mat>(2, 500);
+  points.cols(500, 999) = arma::randn<arma::mat>(2, 500);
+  points.cols(500, 999).each_col() += arma::vec("8.0 0.0");
+  points.cols(1000, 1499) = 10.0 * arma::randu<arma::mat>(2, 500);
+
+  // Check that two assignments are the same up to the cluster indices.
+  auto checkSameClusters = [](const arma::Row<size_t>& a,
+                              const arma::Row<size_t>& b)
+  {
+    BOOST_REQUIRE_EQUAL(a.n_elem, b.n_elem);
+    std::map<size_t, size_t> aToB, bToA;
+    for (size_t i = 0; i < a.n_elem; ++i)
+    {
+      BOOST_REQUIRE_EQUAL(a[i] == SIZE_MAX, b[i] == SIZE_MAX);
+      if (a[i] == SIZE_MAX)
+        continue;
+
+      if (aToB.count(a[i]) == 0)
+        aToB[a[i]] = b[i];
+      if (bToA.count(b[i]) == 0)
+        bToA[b[i]] = a[i];
+      BOOST_REQUIRE_EQUAL(aToB[a[i]], b[i]);
+      BOOST_REQUIRE_EQUAL(bToA[b[i]], a[i]);
+    }
+  };
+
+  arma::Row<size_t> pointwiseAssignments;
+  DBSCAN<> pointwise(0.3, 5, false);
+  const size_t clusters = pointwise.Cluster(points, pointwiseAssignments);
+
+  arma::Row<size_t> assignments;
+  DBSCAN<> batch(0.3, 5);
+  BOOST_REQUIRE_EQUAL(batch.Cluster(points, assignments), clusters);
+  checkSameClusters(pointwiseAssignments, assignments);
+
+  DBSCAN<> naive(0.3, 5, true, RangeSearch<>(true));
+  BOOST_REQUIRE_EQUAL(naive.Cluster(points, assignments), clusters);
+  checkSameClusters(pointwiseAssignments, assignments);
+
+  DBSCAN<RangeSearch<metric::EuclideanDistance, arma::mat, tree::BallTree>>
+      ballTree(0.3, 5);
+  BOOST_REQUIRE_EQUAL(ballTree.Cluster(points, assignments), clusters);
+  checkSameClusters(pointwiseAssignments, assignments);
+
+  DBSCAN<RangeSearch<metric::EuclideanDistance, arma::mat,
+      tree::StandardCoverTree>> coverTree(0.3, 5);
+  BOOST_REQUIRE_EQUAL(coverTree.Cluster(points, assignments), clusters);
+  checkSameClusters(pointwiseAssignments, assignments);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
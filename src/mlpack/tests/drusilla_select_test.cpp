@@ -167,4 +167,42 @@ BOOST_AUTO_TEST_CASE(SparseTest)
   BOOST_REQUIRE_EQUAL(distances.n_rows, 3);
 }
 
+/**
+ * Make sure that the results for many query points, searched in blocks, are
+ * the furthest candidates of each query point.
+ */
+BOOST_AUTO_TEST_CASE(DrusillaSelectBatchTest)
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 1000);
+  arma::mat querySet = arma::randu<arma::mat>(5, 700);
+
+  DrusillaSelect<> ds(dataset, 5, 10);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  ds.Search(querySet, 3, neighbors, distances);
+
+  BOOST_REQUIRE_EQUAL(neighbors.n_rows, 3);
+  BOOST_REQUIRE_EQUAL(neighbors.n_cols, 700);
+
+  for (size_t q = 0; q < querySet.n_cols; ++q)
+  {
+    // Find the distances to all the candidates by brute force.
+    arma::vec candidateDistances(ds.CandidateSet().n_cols);
+    for (size_t c = 0; c < ds.CandidateSet().n_cols; ++c)
+    {
+      candidateDistances[c] = metric::EuclideanDistance::Evaluate(
+          querySet.col(q), ds.CandidateSet().col(c));
+    }
+    candidateDistances = arma::sort(candidateDistances, "descend");
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+      BOOST_REQUIRE_CLOSE(distances(i, q), candidateDistances[i], 1e-5);
+      BOOST_REQUIRE_CLOSE(distances(i, q), metric::EuclideanDistance::Evaluate(
+          querySet.col(q), dataset.col(neighbors(i, q))), 1e-5);
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -278,4 +278,47 @@ BOOST_AUTO_TEST_CASE(BallTreeTest)
   }
 }
 
+/**
+ * Make sure that the MST found on many threads is the same as the MST found on
+ * one thread, for each type of tree.
+ */
+template<template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void CheckParallelMST(const arma::mat& dataset)
+{
+  DualTreeBoruvka<EuclideanDistance, arma::mat, TreeType> parallel(dataset);
+  arma::mat parallelResults;
+  parallel.ComputeMST(parallelResults);
+
+  arma::mat serialResults;
+  #ifdef HAS_OPENMP
+    const size_t numThreads = omp_get_max_threads();
+    omp_set_num_threads(1);
+  #endif
+  DualTreeBoruvka<EuclideanDistance, arma::mat, TreeType> serial(dataset);
+  serial.ComputeMST(serialResults);
+  #ifdef HAS_OPENMP
+    omp_set_num_threads(numThreads);
+  #endif
+
+  BOOST_REQUIRE_EQUAL(parallelResults.n_cols, dataset.n_cols - 1);
+  BOOST_REQUIRE_EQUAL(serialResults.n_cols, dataset.n_cols - 1);
+  for (size_t i = 0; i < parallelResults.n_cols; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(parallelResults(0, i), serialResults(0, i));
+    BOOST_REQUIRE_EQUAL(parallelResults(1, i), serialResults(1, i));
+    BOOST_REQUIRE_CLOSE(parallelResults(2, i), serialResults(2, i), 1e-5);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ParallelSerialTest)
+{
+  arma::mat dataset(3, 3000, arma::fill::randu);
+
+  CheckParallelMST<KDTree>(dataset);
+  CheckParallelMST<BallTree>(dataset);
+  CheckParallelMST<StandardCoverTree>(dataset);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -15,6 +15,7 @@
 #include <mlpack/methods/hoeffding_trees/hoeffding_tree.hpp>
 #include <mlpack/methods/hoeffding_trees/hoeffding_categorical_split.hpp>
 #include <mlpack/methods/hoeffding_trees/binary_numeric_split.hpp>
+#include <mlpack/methods/hoeffding_trees/quantile_numeric_split.hpp>
 #include <mlpack/methods/hoeffding_trees/hoeffding_tree_model.hpp>
 
 #include <boost/test/unit_test.hpp>
@@ -932,6 +933,55 @@ BOOST_AUTO_TEST_CASE(BinaryNumericHoeffdingTreeTest)
   BOOST_REQUIRE_GT(batchCorrect, 8550);
 }
 
+/**
+ * Make sure that streaming training on micro-batches gives exactly the same
+ * tree as streaming training on one point at a time.
+ */
+BOOST_AUTO_TEST_CASE(MicroBatchStreamingTest)
+{
+  // Generate data with a categorical feature that is useful for splitting.
+  arma::mat dataset(3, 12000);
+  arma::Row<size_t> labels(12000);
+  data::DatasetInfo info(3); // The third feature is categorical.
+  info.MapString<size_t>("a", 2);
+  info.MapString<size_t>("b", 2);
+  info.MapString<size_t>("c", 2);
+  for (size_t i = 0; i < 12000; ++i)
+  {
+    const size_t category = mlpack::math::RandInt(3);
+    dataset(0, i) = mlpack::math::Random();
+    dataset(1, i) = mlpack::math::Random() + 0.3 * category;
+    dataset(2, i) = category;
+    labels[i] = (dataset(1, i) > 0.8) ? category : (category + 1) % 3;
+  }
+
+  HoeffdingTree<> pointTree(info, 3, 0.95, 5000, 100, 100);
+  for (size_t i = 0; i < 12000; ++i)
+    pointTree.Train(dataset.col(i), labels[i]);
+
+  HoeffdingTree<> batchTree(info, 3, 0.95, 5000, 100, 100);
+  for (size_t i = 0; i < 12000; i += 1500)
+  {
+    const arma::mat batch = dataset.cols(i, i + 1499);
+    const arma::Row<size_t> batchLabels = labels.cols(i, i + 1499);
+    batchTree.Train(batch, batchLabels, false);
+  }
+
+  BOOST_REQUIRE_GT(pointTree.NumChildren(), 0);
+  BOOST_REQUIRE_EQUAL(pointTree.NumDescendants(), batchTree.NumDescendants());
+  BOOST_REQUIRE_EQUAL(pointTree.SplitDimension(), batchTree.SplitDimension());
+
+  arma::Row<size_t> pointPredictions, batchPredictions;
+  arma::rowvec pointProbabilities, batchProbabilities;
+  pointTree.Classify(dataset, pointPredictions, pointProbabilities);
+  batchTree.Classify(dataset, batchPredictions, batchProbabilities);
+  for (size_t i = 0; i < 12000; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(pointPredictions[i], batchPredictions[i]);
+    BOOST_REQUIRE_CLOSE(pointProbabilities[i], batchProbabilities[i], 1e-5);
+  }
+}
+
 /**
  * Test majority probabilities.
  */
@@ -1462,4 +1512,75 @@ BOOST_AUTO_TEST_CASE(HoeffdingTreeModelSerializationTest)
   }
 }
 
+/**
+ * Use a numeric feature that is bimodal (with a margin), and make sure that the
+ * QuantileNumericSplit bins it at the median, so that each of the two bins
+ * holds one class.
+ */
+BOOST_AUTO_TEST_CASE(QuantileNumericSplitBimodalTest)
+{
+  // 2 classes, 2 bins, 200 samples before binning.
+  QuantileNumericSplit<GiniImpurity> split(2, 2, 200);
+
+  for (size_t i = 0; i < 100; ++i)
+  {
+    split.Train(mlpack::math::Random() + 0.3, 0);
+    split.Train(-mlpack::math::Random() - 0.3, 1);
+  }
+
+  // No binning has happened yet.
+  double bestGain, secondBestGain;
+  split.EvaluateFitnessFunction(bestGain, secondBestGain);
+  BOOST_REQUIRE_SMALL(bestGain, 1e-10);
+
+  // Push the majority class to 1.
+  split.Train(-mlpack::math::Random() - 0.3, 1);
+  BOOST_REQUIRE_EQUAL(split.MajorityClass(), 1);
+
+  // The impurity should be (0.5 * (1 - 0.5)) * 2 = 0.50 (it will be 0 in the
+  // two created children).
+  split.EvaluateFitnessFunction(bestGain, secondBestGain);
+  BOOST_REQUIRE_CLOSE(bestGain, 0.50, 0.03);
+  BOOST_REQUIRE_SMALL(secondBestGain, 1e-10);
+
+  NumericSplitInfo<> info;
+  arma::Col<size_t> childMajorities;
+  split.Split(childMajorities, info);
+  BOOST_REQUIRE_EQUAL(childMajorities.n_elem, 2);
+  BOOST_REQUIRE_EQUAL(childMajorities[0], 1);
+  BOOST_REQUIRE_EQUAL(childMajorities[1], 0);
+
+  for (size_t i = 0; i < 10; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(info.CalculateDirection(mlpack::math::Random() + 0.3),
+        1);
+    BOOST_REQUIRE_EQUAL(info.CalculateDirection(-mlpack::math::Random() - 0.3),
+        0);
+  }
+}
+
+/**
+ * Train a HoeffdingTree that uses the QuantileNumericSplit on a skewed numeric
+ * feature, and make sure it learns the threshold.
+ */
+BOOST_AUTO_TEST_CASE(QuantileNumericSplitTreeTest)
+{
+  // The feature is exponentially distributed, and the label is whether it is
+  // above 0.1; an equal-width split of the range would put most points in
+  // the first bin.
+  arma::mat dataset = -arma::log(arma::randu<arma::mat>(1, 20000));
+  arma::Row<size_t> labels(dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    labels[i] = (dataset(0, i) > 0.1) ? 1 : 0;
+
+  data::DatasetInfo info(1);
+  HoeffdingTree<GiniImpurity, QuantileDoubleNumericSplit> tree(dataset, info,
+      labels, 2, false /* streaming */);
+
+  arma::Row<size_t> predictions;
+  tree.Classify(dataset, predictions);
+  const size_t correct = arma::accu(predictions == labels);
+  BOOST_REQUIRE_GT(correct, 0.95 * dataset.n_cols);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
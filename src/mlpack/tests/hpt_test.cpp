@@ -12,15 +12,18 @@
 #include <mlpack/core/cv/metrics/mse.hpp>
 #include <mlpack/core/cv/metrics/accuracy.hpp>
 #include <mlpack/core/cv/simple_cv.hpp>
+#include <mlpack/core/cv/k_fold_cv.hpp>
 #include <mlpack/core/hpt/cv_function.hpp>
 #include <mlpack/core/hpt/fixed.hpp>
 #include <mlpack/core/hpt/hpt.hpp>
 #include <mlpack/methods/lars/lars.hpp>
+#include <mlpack/methods/linear_regression/linear_regression.hpp>
 #include <mlpack/methods/logistic_regression/logistic_regression.hpp>
 
 #include <ensmallen.hpp>
 
 #include <boost/test/unit_test.hpp>
+#include "test_tools.hpp"
 
 using namespace mlpack::cv;
 using namespace mlpack::data;
@@ -180,6 +183,61 @@ BOOST_AUTO_TEST_CASE(CVFunctionGradientTest)
 }
 
 
+/**
+ * A fake CV class like QuadraticFunction that stores the trained model in a
+ * given pointer, but can't train on a fraction of the training data.  It
+ * counts how it is called.
+ */
+template<typename MLAlgorithm>
+class ModelQuadraticFunction : public QuadraticFunction<MLAlgorithm>
+{
+ public:
+  using QuadraticFunction<MLAlgorithm>::QuadraticFunction;
+  using QuadraticFunction<MLAlgorithm>::Evaluate;
+
+  double Evaluate(std::unique_ptr<MLAlgorithm>& model,
+                  double x,
+                  double y,
+                  double z)
+  {
+    ++modelEvaluations;
+    model.reset(new MLAlgorithm());
+    return Evaluate(x, y, z);
+  }
+
+  MLAlgorithm Model()
+  {
+    ++modelCalls;
+    return MLAlgorithm();
+  }
+
+  size_t modelEvaluations = 0;
+  size_t modelCalls = 0;
+};
+
+/**
+ * Test that CVFunction uses the Evaluate method that takes the model pointer
+ * when the CV class has no EvaluateSubsample method, rather than taking the
+ * model from the CV class.
+ */
+BOOST_AUTO_TEST_CASE(CVFunctionModelPointerTest)
+{
+  ModelQuadraticFunction<LARS> lf(1.0, -1.5, 2.5, 3.0);
+
+  IncrementPolicy policy(true);
+  DatasetMapper<IncrementPolicy, double> datasetInfo(policy, 3);
+  CVFunction<decltype(lf), LARS, 3> cvFun(lf, datasetInfo, 0.01, 0.001);
+
+  const arma::mat parameters("0.0; -1.0; 2.0");
+  const double expected = lf.Evaluate(0.0, -1.0, 2.0);
+  BOOST_REQUIRE_CLOSE(cvFun.Evaluate(parameters), expected, 1e-5);
+  BOOST_REQUIRE_CLOSE(cvFun.EvaluateSubsample(parameters, 0.5), expected,
+      1e-5);
+
+  BOOST_REQUIRE_EQUAL(lf.modelEvaluations, 2);
+  BOOST_REQUIRE_EQUAL(lf.modelCalls, 0);
+}
+
 void InitProneToOverfittingData(arma::mat& xs,
                                 arma::rowvec& ys,
                                 double& validationSize)
@@ -402,4 +460,162 @@ BOOST_AUTO_TEST_CASE(HPTGradientDescentTest)
   BOOST_REQUIRE_CLOSE(zOptimized, zMin, 1e-4);
 }
 
+/**
+ * Test HyperParameterTuner gives the same result with GridSearch when the sets
+ * of hyper-parameters and the folds are assessed in parallel as when they are
+ * assessed one at a time.
+ */
+BOOST_AUTO_TEST_CASE(HPTParallelGridSearchTest)
+{
+  arma::mat xs;
+  arma::rowvec ys;
+  double validationSize;
+  InitProneToOverfittingData(xs, ys, validationSize);
+
+  bool transposeData = true;
+  bool useCholesky = false;
+  arma::vec lambda1Set("0 0.001 0.01 0.1 1.0 10.0 100.0");
+  arma::vec lambda2Set("0.0 0.05 0.5 5.0");
+
+  // The folds of KFoldCV are also trained in parallel, so the whole serial
+  // run is limited to one thread.
+  #ifdef HAS_OPENMP
+    const size_t numThreads = omp_get_max_threads();
+    omp_set_num_threads(1);
+  #endif
+  HyperParameterTuner<LARS, MSE, KFoldCV, GridSearch> serialHPT(3, xs, ys,
+      false);
+  serialHPT.MaxThreads() = 1;
+  double serialLambda1, serialLambda2;
+  std::tie(serialLambda1, serialLambda2) = serialHPT.Optimize(
+      Fixed(transposeData), Fixed(useCholesky), lambda1Set, lambda2Set);
+  #ifdef HAS_OPENMP
+    omp_set_num_threads(numThreads);
+  #endif
+
+  HyperParameterTuner<LARS, MSE, KFoldCV, GridSearch> parallelHPT(3, xs, ys,
+      false);
+  double parallelLambda1, parallelLambda2;
+  std::tie(parallelLambda1, parallelLambda2) = parallelHPT.Optimize(
+      Fixed(transposeData), Fixed(useCholesky), lambda1Set, lambda2Set);
+
+  BOOST_REQUIRE_EQUAL(serialLambda1, parallelLambda1);
+  BOOST_REQUIRE_EQUAL(serialLambda2, parallelLambda2);
+  BOOST_REQUIRE_CLOSE(serialHPT.BestObjective(), parallelHPT.BestObjective(),
+      1e-5);
+
+  // The objective should be the one of k-fold cross-validation with the best
+  // lambdas, and the best model should be the one of its last fold.
+  KFoldCV<LARS, MSE> cv(3, xs, ys, false);
+  cv.MaxThreads() = 1;
+  const double objective = cv.Evaluate(transposeData, useCholesky,
+      parallelLambda1, parallelLambda2);
+  BOOST_REQUIRE_CLOSE(parallelHPT.BestObjective(), objective, 1e-5);
+  CheckMatrices(parallelHPT.BestModel().Beta(), cv.Model().Beta());
+}
+
+/**
+ * A function of one hyper-parameter that counts how many times it is
+ * evaluated.  With fewer training points, the objective gets worse but keeps
+ * its minimum.
+ */
+class CountingFunction
+{
+ public:
+  CountingFunction(const double optimum) :
+      optimum(optimum), evaluations(0), subsampleEvaluations(0) {}
+
+  double Evaluate(const arma::mat& parameters)
+  {
+    ++evaluations;
+    return std::pow(parameters(0) - optimum, 2.0);
+  }
+
+  double EvaluateSubsample(const arma::mat& parameters, const double fraction)
+  {
+    ++subsampleEvaluations;
+    return std::pow(parameters(0) - optimum, 2.0) + (1.0 - fraction);
+  }
+
+  double optimum;
+  size_t evaluations;
+  size_t subsampleEvaluations;
+};
+
+/**
+ * Test SuccessiveHalving keeps the best third of the sets of hyper-parameters
+ * at each round, and finds the best one.
+ */
+BOOST_AUTO_TEST_CASE(SuccessiveHalvingTest)
+{
+  CountingFunction f(5.0);
+  SuccessiveHalving optimizer(3.0, 1.0 / 9.0);
+
+  arma::mat bestParameters(1, 1);
+  const double objective = optimizer.Optimize(f, bestParameters,
+      std::vector<bool>(1, true), arma::Row<size_t>("27"));
+
+  // 27 sets with 1 / 9 of the data, then 9 sets with 1 / 3 of the data, then
+  // 3 sets with all the data.
+  BOOST_REQUIRE_EQUAL(f.subsampleEvaluations, 36);
+  BOOST_REQUIRE_EQUAL(f.evaluations, 3);
+  BOOST_REQUIRE_EQUAL(bestParameters(0), 5.0);
+  BOOST_REQUIRE_SMALL(objective, 1e-10);
+
+  // Numeric hyper-parameters are not supported.
+  BOOST_REQUIRE_THROW(optimizer.Optimize(f, bestParameters,
+      std::vector<bool>(1, false), arma::Row<size_t>("0")),
+      std::invalid_argument);
+}
+
+/**
+ * Test the brackets of Hyperband.
+ */
+BOOST_AUTO_TEST_CASE(HyperbandTest)
+{
+  CountingFunction f(5.0);
+  SuccessiveHalving optimizer(3.0, 1.0 / 9.0, true);
+
+  arma::mat bestParameters(1, 1);
+  const double objective = optimizer.Optimize(f, bestParameters,
+      std::vector<bool>(1, true), arma::Row<size_t>("9"));
+
+  // The first bracket starts from all 9 sets with 1 / 9 of the data, the
+  // second one from 5 sampled sets with 1 / 3 of the data, and the last one
+  // trains 3 sampled sets with all the data.
+  BOOST_REQUIRE_EQUAL(f.subsampleEvaluations, 9 + 3 + 5);
+  BOOST_REQUIRE_EQUAL(f.evaluations, 1 + 1 + 3);
+  BOOST_REQUIRE_EQUAL(bestParameters(0), 5.0);
+  BOOST_REQUIRE_SMALL(objective, 1e-10);
+}
+
+/**
+ * Test HyperParameterTuner with SuccessiveHalving returns the objective and
+ * the model of the returned hyper-parameters trained on all the data.
+ */
+BOOST_AUTO_TEST_CASE(HPTSuccessiveHalvingTest)
+{
+  arma::mat xs = arma::randn(5, 300);
+  arma::rowvec ys = arma::randn(1, 5) * xs + 0.1 * arma::randn(1, 300);
+  const double validationSize = 0.2;
+
+  arma::vec lambdas("0 0.001 0.01 0.1 1.0 10.0 100.0 1000.0 10000.0");
+  HyperParameterTuner<LinearRegression, MSE, SimpleCV, SuccessiveHalving>
+      hpt(validationSize, xs, ys);
+  hpt.Optimizer().MinFraction() = 1.0 / 9.0;
+
+  bool intercept = true;
+  double bestLambda;
+  std::tie(bestLambda) = hpt.Optimize(lambdas, Fixed(intercept));
+  BOOST_REQUIRE(arma::any(lambdas == bestLambda));
+
+  // Heavy regularization should not win on this data.
+  BOOST_REQUIRE_LT(bestLambda, 1000.0);
+
+  SimpleCV<LinearRegression, MSE> cv(validationSize, xs, ys);
+  const double objective = cv.Evaluate(bestLambda, intercept);
+  BOOST_REQUIRE_CLOSE(hpt.BestObjective(), objective, 1e-5);
+  CheckMatrices(hpt.BestModel().Parameters(), cv.Model().Parameters());
+}
+
 BOOST_AUTO_TEST_SUITE_END();
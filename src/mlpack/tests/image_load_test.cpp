@@ -11,6 +11,7 @@
  */
 
 #include <mlpack/core.hpp>
+#include <mlpack/core/data/image_batch_loader.hpp>
 #include "serialization_catch.hpp"
 #include "catch.hpp"
 
@@ -132,6 +133,84 @@ TEST_CASE("SaveImageMatAPITest", "[ImageLoadTest]")
   remove("APITest.bmp");
 }
 
+/**
+ * Test that images of different sizes can only be loaded together when they
+ * are resized.
+ */
+TEST_CASE("LoadVectorImageResizeTest", "[ImageLoadTest]")
+{
+  data::ImageInfo smallInfo(5, 5, 3);
+  arma::Mat<unsigned char> small(5 * 5 * 3, 1);
+  small.fill(100);
+  REQUIRE(data::Save("ResizeTest.bmp", small, smallInfo, false) == true);
+
+  std::vector<std::string> files = {"test_image.png", "ResizeTest.bmp"};
+  arma::mat matrix;
+  data::ImageInfo info;
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(data::Load(files, matrix, info, true),
+      std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+
+  data::ImageInfo resizedInfo(20, 10, 3);
+  REQUIRE(data::Load(files, matrix, resizedInfo, false, true) == true);
+  REQUIRE(matrix.n_rows == 20 * 10 * 3);
+  REQUIRE(matrix.n_cols == 2);
+  REQUIRE(resizedInfo.Width() == 20);
+  REQUIRE(resizedInfo.Height() == 10);
+
+  // Resizing an image of one color keeps the color.
+  for (size_t i = 0; i < matrix.n_rows; ++i)
+    REQUIRE(matrix(i, 1) == 100.0);
+
+  remove("ResizeTest.bmp");
+}
+
+/**
+ * Test that ImageBatchLoader gives every image once per epoch, in batches
+ * that match the images loaded all at once.
+ */
+TEST_CASE("ImageBatchLoaderTest", "[ImageLoadTest]")
+{
+  std::vector<std::string> files(5, "test_image.png");
+  arma::mat images;
+  data::ImageInfo info;
+  REQUIRE(data::Load(files, images, info, false) == true);
+
+  for (size_t shuffle = 0; shuffle < 2; ++shuffle)
+  {
+    data::ImageBatchLoader<> loader(files, data::ImageInfo(), 2, shuffle);
+    REQUIRE(loader.Info().Width() == 50);
+    REQUIRE(loader.Info().Height() == 50);
+    REQUIRE(loader.NumBatches() == 3);
+
+    for (size_t epoch = 0; epoch < 2; ++epoch)
+    {
+      arma::mat batch;
+      arma::uvec seen(files.size(), arma::fill::zeros);
+      size_t batches = 0;
+      while (loader.Next(batch))
+      {
+        REQUIRE(batch.n_rows == images.n_rows);
+        REQUIRE(batch.n_cols == loader.BatchIndices().n_elem);
+        REQUIRE(batch.n_cols == ((batches < 2) ? 2 : 1));
+        for (size_t i = 0; i < batch.n_cols; ++i)
+        {
+          ++seen[loader.BatchIndices()[i]];
+          REQUIRE(arma::approx_equal(batch.col(i),
+              images.col(loader.BatchIndices()[i]), "absdiff", 1e-10));
+        }
+
+        ++batches;
+      }
+
+      REQUIRE(batches == 3);
+      REQUIRE(arma::all(seen == 1));
+      loader.Reset();
+    }
+  }
+}
+
 /**
  * Serialization test for the ImageInfo class.
  */
@@ -1301,4 +1301,189 @@ BOOST_AUTO_TEST_CASE(GaussianBreadthDualKDTreeMonteCarloKDE)
   BOOST_REQUIRE_GT(correctResults, 70);
 }
 
+/**
+ * Test that reference points added to a trained model give the same results
+ * as training the model with all the points, both while they are kept in a
+ * separate tree and once they are merged into the reference tree.
+ */
+BOOST_AUTO_TEST_CASE(AddReferencesTest)
+{
+  arma::mat reference = arma::randu(2, 470);
+  arma::mat query = arma::randu(2, 100);
+  const double kernelBandwidth = 0.2;
+  const double relError = 0.05;
+  GaussianKernel kernel(kernelBandwidth);
+
+  KDE<GaussianKernel, EuclideanDistance, arma::mat, KDTree>
+      dualKDE(relError, 0.0, kernel, KDEMode::DUAL_TREE_MODE);
+  KDE<GaussianKernel, EuclideanDistance, arma::mat, KDTree>
+      singleKDE(relError, 0.0, kernel, KDEMode::SINGLE_TREE_MODE);
+  dualKDE.Train(reference.cols(0, 299));
+  singleKDE.Train(reference.cols(0, 299));
+
+  // Points can't be added with the wrong dimensionality.
+  BOOST_REQUIRE_THROW(dualKDE.AddReferences(arma::randu(3, 10)),
+      std::invalid_argument);
+
+  // The first batches are kept in a separate tree; the last one is large
+  // enough to merge all points into the reference tree.
+  const size_t batchEnds[] = { 340, 370, 470 };
+  size_t begin = 300;
+  for (const size_t end : batchEnds)
+  {
+    dualKDE.AddReferences(reference.cols(begin, end - 1));
+    singleKDE.AddReferences(reference.cols(begin, end - 1));
+    begin = end;
+
+    BOOST_REQUIRE_EQUAL(dualKDE.NumReferences(), end);
+    BOOST_REQUIRE_EQUAL(singleKDE.NumReferences(), end);
+    if (end < 470)
+      BOOST_REQUIRE(dualKDE.AddedReferenceTree() != nullptr);
+    else
+      BOOST_REQUIRE(dualKDE.AddedReferenceTree() == nullptr);
+
+    const arma::mat currentReference = reference.cols(0, end - 1);
+
+    // Bichromatic evaluation.
+    arma::vec bfEstimations(query.n_cols, arma::fill::zeros);
+    BruteForceKDE<GaussianKernel>(currentReference, query, bfEstimations,
+        kernel);
+
+    arma::vec dualEstimations, singleEstimations;
+    dualKDE.Evaluate(query, dualEstimations);
+    singleKDE.Evaluate(query, singleEstimations);
+    for (size_t i = 0; i < query.n_cols; ++i)
+    {
+      BOOST_REQUIRE_CLOSE(bfEstimations[i], dualEstimations[i],
+          relError * 100);
+      BOOST_REQUIRE_CLOSE(bfEstimations[i], singleEstimations[i],
+          relError * 100);
+    }
+
+    // Monochromatic evaluation, which leaves out each point itself.
+    arma::vec bfMonoEstimations(end, arma::fill::zeros);
+    for (size_t i = 0; i < end; ++i)
+    {
+      for (size_t j = 0; j < end; ++j)
+      {
+        if (i != j)
+        {
+          bfMonoEstimations[i] += kernel.Evaluate(EuclideanDistance::Evaluate(
+              currentReference.col(i), currentReference.col(j)));
+        }
+      }
+    }
+    bfMonoEstimations /= end;
+
+    dualKDE.Evaluate(dualEstimations);
+    singleKDE.Evaluate(singleEstimations);
+    BOOST_REQUIRE_EQUAL(dualEstimations.n_elem, end);
+    BOOST_REQUIRE_EQUAL(singleEstimations.n_elem, end);
+    for (size_t i = 0; i < end; ++i)
+    {
+      BOOST_REQUIRE_CLOSE(bfMonoEstimations[i], dualEstimations[i],
+          relError * 100);
+      BOOST_REQUIRE_CLOSE(bfMonoEstimations[i], singleEstimations[i],
+          relError * 100);
+    }
+  }
+}
+
+/**
+ * Test that the series expansion of a node is within its error bound of the
+ * exact sum of the kernel values.
+ */
+BOOST_AUTO_TEST_CASE(GaussianSeriesTest)
+{
+  const double bandwidth = 1.0;
+  GaussianKernel kernel(bandwidth);
+  KDTree<EuclideanDistance, KDEStat, arma::mat> tree(
+      arma::mat(0.5 * arma::randu(3, 500)));
+
+  GaussianSeries series(3, 8, GaussianSeries::Scale(kernel));
+  series.ComputeExpansions(tree);
+  BOOST_REQUIRE(series.HasExpansion(tree.Stat()));
+  BOOST_REQUIRE_EQUAL(series.NumTerms(8), 120);
+
+  const arma::vec query("1.0 0.9 1.1");
+  double exact = 0.0;
+  for (size_t i = 0; i < tree.Dataset().n_cols; ++i)
+  {
+    exact += kernel.Evaluate(EuclideanDistance::Evaluate(query,
+        tree.Dataset().col(i)));
+  }
+
+  const double distance = EuclideanDistance::Evaluate(query,
+      tree.Stat().SeriesCenter());
+  double error = 0.0;
+  const size_t order = series.Order(math::Range(distance, distance),
+      tree.Stat().SeriesRadius(), 1e-6, tree.NumDescendants(), error);
+  BOOST_REQUIRE_GT(order, 0);
+  BOOST_REQUIRE_LE(error, 1e-6);
+
+  const double estimation = series.Evaluate(tree.Stat(), query, order);
+  BOOST_REQUIRE_SMALL(estimation - exact, tree.NumDescendants() * error);
+}
+
+/**
+ * Test that KDE with series expansions of the Gaussian kernel meets the
+ * relative error tolerance, with different trees and modes.
+ */
+BOOST_AUTO_TEST_CASE(GaussianSeriesExpansionKDE)
+{
+  arma::mat reference = arma::randu(3, 2000);
+  arma::mat query = arma::randu(3, 200);
+  const double relError = 0.01;
+  GaussianKernel kernel(1.0);
+
+  arma::vec bfEstimations(query.n_cols, arma::fill::zeros);
+  BruteForceKDE<GaussianKernel>(reference, query, bfEstimations, kernel);
+
+  KDE<GaussianKernel, EuclideanDistance, arma::mat, KDTree>
+      dualKDE(relError, 0.0, kernel, KDEMode::DUAL_TREE_MODE);
+  KDE<GaussianKernel, EuclideanDistance, arma::mat, KDTree>
+      singleKDE(relError, 0.0, kernel, KDEMode::SINGLE_TREE_MODE);
+  KDE<GaussianKernel, EuclideanDistance, arma::mat, StandardCoverTree>
+      coverKDE(relError, 0.0, kernel, KDEMode::DUAL_TREE_MODE);
+  dualKDE.SeriesExpansion() = true;
+  singleKDE.SeriesExpansion() = true;
+  coverKDE.SeriesExpansion() = true;
+  dualKDE.Train(reference);
+  singleKDE.Train(reference);
+  coverKDE.Train(reference);
+
+  arma::vec dualEstimations, singleEstimations, coverEstimations;
+  dualKDE.Evaluate(query, dualEstimations);
+  singleKDE.Evaluate(query, singleEstimations);
+  coverKDE.Evaluate(query, coverEstimations);
+
+  // The whole dataset fits in one expansion.
+  BOOST_REQUIRE_GT(dualKDE.ReferenceTree()->Stat().SeriesScale(), 0.0);
+
+  for (size_t i = 0; i < query.n_cols; ++i)
+  {
+    BOOST_REQUIRE_CLOSE(bfEstimations[i], dualEstimations[i], relError * 100);
+    BOOST_REQUIRE_CLOSE(bfEstimations[i], singleEstimations[i],
+        relError * 100);
+    BOOST_REQUIRE_CLOSE(bfEstimations[i], coverEstimations[i],
+        relError * 100);
+  }
+
+  // Monochromatic evaluation, which leaves out each point itself.
+  arma::vec bfMonoEstimations(reference.n_cols, arma::fill::zeros);
+  BruteForceKDE<GaussianKernel>(reference, reference, bfMonoEstimations,
+      kernel);
+  bfMonoEstimations -= 1.0 / reference.n_cols;
+
+  dualKDE.Evaluate(dualEstimations);
+  singleKDE.Evaluate(singleEstimations);
+  for (size_t i = 0; i < reference.n_cols; ++i)
+  {
+    BOOST_REQUIRE_CLOSE(bfMonoEstimations[i], dualEstimations[i],
+        relError * 100);
+    BOOST_REQUIRE_CLOSE(bfMonoEstimations[i], singleEstimations[i],
+        relError * 100);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -13,6 +13,7 @@
 
 #include <mlpack/core.hpp>
 #include <mlpack/core/data/load_arff.hpp>
+#include <mlpack/core/data/load_libsvm.hpp>
 #include <mlpack/core/data/map_policies/missing_policy.hpp>
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
@@ -2391,4 +2392,376 @@ BOOST_AUTO_TEST_CASE(DatasetMapperNonUniqueTest)
   BOOST_REQUIRE_EQUAL(dm.UnmapString(nan, 0, 2), "cheese");
 }
 
+/**
+ * Make sure that a CSV large enough to be split into several chunks gives the
+ * same matrix and mappings with the parallel parser (used for doubles) as with
+ * the serial parser (used for other element types).
+ */
+BOOST_AUTO_TEST_CASE(ParallelCSVMatchesSerialTest)
+{
+  const char* categories[] = { "coffee", "tea", "juice", "water", "milk" };
+
+  fstream f;
+  f.open("test.csv", fstream::out);
+  for (size_t i = 0; i < 30000; ++i)
+  {
+    // The last dimension holds numbers at first, but becomes categorical near
+    // the end of the file.
+    f << i << ", " << (i * 7) % 101 << ", " << categories[(i * i) % 5] << ", ";
+    if (i == 29000)
+      f << "\"quoted, value\"" << endl;
+    else
+      f << (i % 13) << endl;
+  }
+  f.close();
+
+  arma::mat dataset;
+  DatasetInfo info;
+  BOOST_REQUIRE(data::Load("test.csv", dataset, info, false));
+
+  arma::Mat<size_t> serialDataset;
+  DatasetInfo serialInfo;
+  BOOST_REQUIRE(data::Load("test.csv", serialDataset, serialInfo, false));
+
+  BOOST_REQUIRE_EQUAL(dataset.n_rows, 4);
+  BOOST_REQUIRE_EQUAL(dataset.n_cols, 30000);
+  CheckMatrices(dataset, arma::conv_to<arma::mat>::from(serialDataset));
+
+  BOOST_REQUIRE(info.Type(0) == Datatype::numeric);
+  BOOST_REQUIRE(info.Type(1) == Datatype::numeric);
+  BOOST_REQUIRE(info.Type(2) == Datatype::categorical);
+  BOOST_REQUIRE(info.Type(3) == Datatype::categorical);
+  for (size_t d = 2; d < 4; ++d)
+  {
+    BOOST_REQUIRE(serialInfo.Type(d) == Datatype::categorical);
+    BOOST_REQUIRE_EQUAL(info.NumMappings(d), serialInfo.NumMappings(d));
+    for (size_t i = 0; i < info.NumMappings(d); ++i)
+      BOOST_REQUIRE_EQUAL(info.UnmapString(i, d), serialInfo.UnmapString(i, d));
+  }
+
+  BOOST_REQUIRE_EQUAL(info.UnmapString(dataset(3, 29000), 3),
+      "\"quoted, value\"");
+
+  remove("test.csv");
+}
+
+/**
+ * Make sure a matrix and its DatasetInfo can be saved in the native format and
+ * loaded again, both into memory and in place from a memory-mapped file.
+ */
+BOOST_AUTO_TEST_CASE(NativeFormatTest)
+{
+  const char* categories[] = { "coffee", "tea", "juice" };
+
+  arma::mat dataset(5, 1000, arma::fill::randu);
+  DatasetInfo info(5);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    dataset(1, i) = info.MapString<double>(categories[(i * i) % 3], 1);
+
+  BOOST_REQUIRE(data::Save("test.mlc", dataset, info));
+
+  arma::mat loaded;
+  DatasetInfo loadedInfo;
+  BOOST_REQUIRE(data::Load("test.mlc", loaded, loadedInfo));
+  CheckMatrices(dataset, loaded);
+
+  // Loading without transposing gives one point per row.
+  arma::mat loadedTrans;
+  BOOST_REQUIRE(data::Load("test.mlc", loadedTrans, loadedInfo, false, false));
+  CheckMatrices(dataset.t(), loadedTrans);
+
+  BOOST_REQUIRE_EQUAL(loadedInfo.Dimensionality(), 5);
+  for (size_t d = 0; d < 5; ++d)
+    BOOST_REQUIRE(loadedInfo.Type(d) == info.Type(d));
+  BOOST_REQUIRE_EQUAL(loadedInfo.NumMappings(1), 3);
+  for (size_t i = 0; i < 3; ++i)
+    BOOST_REQUIRE_EQUAL(loadedInfo.UnmapString(i, 1), info.UnmapString(i, 1));
+
+  {
+    // With the same element type, the matrix uses the mapped file directly.
+    MemoryMappedFile file("test.mlc");
+    arma::mat mapped;
+    DatasetInfo mappedInfo;
+    BOOST_REQUIRE(data::Load(file, mapped, mappedInfo));
+    CheckMatrices(dataset, mapped);
+    BOOST_REQUIRE_EQUAL(mappedInfo.NumMappings(1), 3);
+
+    const char* memory = (const char*) mapped.memptr();
+    BOOST_REQUIRE(memory >= file.Data());
+    BOOST_REQUIRE(memory < file.Data() + file.Size());
+
+    // With a different element type, the data has to be converted.
+    arma::fmat converted;
+    BOOST_REQUIRE(data::Load(file, converted, mappedInfo));
+    BOOST_REQUIRE_EQUAL(converted.n_rows, dataset.n_rows);
+    BOOST_REQUIRE_EQUAL(converted.n_cols, dataset.n_cols);
+    for (size_t i = 0; i < dataset.n_elem; ++i)
+      BOOST_REQUIRE_EQUAL(converted[i], (float) dataset[i]);
+  }
+
+  // Only the native format can store a DatasetInfo.
+  BOOST_REQUIRE(!data::Save("test.csv", dataset, info));
+
+  remove("test.mlc");
+}
+
+/**
+ * Make sure a compressed native file with several chunks gives back exactly the
+ * original matrix, and is smaller than the uncompressed file.
+ */
+BOOST_AUTO_TEST_CASE(CompressedNativeFormatTest)
+{
+  arma::mat dataset(4, 70000);
+  dataset.row(0) = arma::randi<arma::rowvec>(70000, arma::distr_param(0, 200));
+  dataset.row(1) = arma::randi<arma::rowvec>(70000,
+      arma::distr_param(0, 60000));
+  dataset.row(2) = arma::conv_to<arma::rowvec>::from(
+      arma::fmat(arma::randn<arma::fmat>(1, 70000)));
+  dataset.row(3) = arma::randn<arma::rowvec>(70000);
+  // Make one chunk of the first dimension need a wider type.
+  dataset(0, 69000) = -1.0;
+
+  DatasetInfo info(4);
+  BOOST_REQUIRE(data::Save("test.mlc", dataset, info, false, true));
+  BOOST_REQUIRE(data::Save("test_uncompressed.mlc", dataset, info));
+
+  arma::mat loaded;
+  DatasetInfo loadedInfo;
+  BOOST_REQUIRE(data::Load("test.mlc", loaded, loadedInfo));
+  BOOST_REQUIRE_EQUAL(loaded.n_rows, 4);
+  BOOST_REQUIRE_EQUAL(loaded.n_cols, 70000);
+  for (size_t i = 0; i < dataset.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(loaded[i], dataset[i]);
+
+  {
+    MemoryMappedFile file("test.mlc");
+    MemoryMappedFile uncompressedFile("test_uncompressed.mlc");
+    BOOST_REQUIRE_LT(file.Size(), uncompressedFile.Size());
+
+    // A compressed file can't be used in place, so it is decompressed.
+    arma::mat mapped;
+    BOOST_REQUIRE(data::Load(file, mapped, loadedInfo));
+    for (size_t i = 0; i < dataset.n_elem; ++i)
+      BOOST_REQUIRE_EQUAL(mapped[i], dataset[i]);
+  }
+
+  remove("test.mlc");
+  remove("test_uncompressed.mlc");
+}
+
+/**
+ * Make sure dimensions with long runs of equal values are run-length encoded,
+ * and that the runs give back exactly the original values.
+ */
+BOOST_AUTO_TEST_CASE(RunLengthNativeFormatTest)
+{
+  arma::mat dataset(3, 70000);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    // A sorted categorical dimension, a dimension with runs of -0.0, 0.0 and
+    // NaN, and a dimension without runs.
+    dataset(0, i) = i / 1000;
+    dataset(1, i) = ((i / 100) % 3 == 0) ? -0.0 : ((i / 100) % 3 == 1) ?
+        0.0 : std::nan("");
+    dataset(2, i) = math::Random();
+  }
+
+  DatasetInfo info(3);
+  BOOST_REQUIRE(data::Save("test.mlc", dataset, info, false, true));
+
+  arma::mat loaded;
+  DatasetInfo loadedInfo;
+  BOOST_REQUIRE(data::Load("test.mlc", loaded, loadedInfo));
+  BOOST_REQUIRE_EQUAL(loaded.n_rows, 3);
+  BOOST_REQUIRE_EQUAL(loaded.n_cols, 70000);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(loaded(0, i), dataset(0, i));
+    if (std::isnan(dataset(1, i)))
+    {
+      BOOST_REQUIRE(std::isnan(loaded(1, i)));
+    }
+    else
+    {
+      BOOST_REQUIRE_EQUAL(loaded(1, i), dataset(1, i));
+      BOOST_REQUIRE_EQUAL(std::signbit(loaded(1, i)),
+          std::signbit(dataset(1, i)));
+    }
+    BOOST_REQUIRE_EQUAL(loaded(2, i), dataset(2, i));
+  }
+
+  {
+    // The first two dimensions take a few bytes per run, so the file is not
+    // much larger than the third dimension alone.
+    MemoryMappedFile file("test.mlc");
+    BOOST_REQUIRE_LT(file.Size(), 70000 * sizeof(double) + 40000);
+  }
+
+  remove("test.mlc");
+}
+
+/**
+ * Make sure a LibSVM file that is large enough to be parsed in several chunks
+ * loads into the right sparse matrix and labels.
+ */
+BOOST_AUTO_TEST_CASE(LibSVMLoadTest)
+{
+  fstream f;
+  f.open("test.svm", fstream::out);
+  f << "# a comment line" << endl;
+  for (size_t i = 0; i < 20000; ++i)
+  {
+    // Give the indices of odd points out of order, and skip dimension 3 of
+    // some points.
+    f << ((i % 2 == 0) ? "+1" : "-1") << " qid:" << (i % 7);
+    if (i % 2 == 0)
+      f << " 1:" << i << " 2:0.5";
+    else
+      f << " 2:0.5 1:" << i;
+    if (i % 3 != 0)
+      f << " 4:" << (i % 10) * 0.25;
+    f << " # point " << i << endl;
+    if (i == 10000)
+      f << endl;
+  }
+  f.close();
+
+  arma::sp_mat dataset;
+  arma::Row<int> labels;
+  BOOST_REQUIRE(data::Load("test.svm", dataset, labels));
+
+  BOOST_REQUIRE_EQUAL(dataset.n_rows, 4);
+  BOOST_REQUIRE_EQUAL(dataset.n_cols, 20000);
+  BOOST_REQUIRE_EQUAL(labels.n_elem, 20000);
+  for (size_t i = 0; i < 20000; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(labels[i], (i % 2 == 0) ? 1 : -1);
+    BOOST_REQUIRE_EQUAL((double) dataset(0, i), (double) i);
+    BOOST_REQUIRE_EQUAL((double) dataset(1, i), 0.5);
+    BOOST_REQUIRE_EQUAL((double) dataset(2, i), 0.0);
+    BOOST_REQUIRE_EQUAL((double) dataset(3, i),
+        (i % 3 != 0) ? (i % 10) * 0.25 : 0.0);
+  }
+
+  // A fixed dimensionality may be larger than the largest index, but not
+  // smaller.
+  LoadLibSVM("test.svm", dataset, labels, 10);
+  BOOST_REQUIRE_EQUAL(dataset.n_rows, 10);
+  BOOST_REQUIRE_THROW(LoadLibSVM("test.svm", dataset, labels, 3),
+      std::invalid_argument);
+
+  remove("test.svm");
+}
+
+/**
+ * Make sure invalid LibSVM files are rejected.
+ */
+BOOST_AUTO_TEST_CASE(BadLibSVMLoadTest)
+{
+  const char* lines[] = { "1 0:1.0", "1 2:1.0 2:3.0", "1 2=1.0", "one 1:1",
+      "1 1:x" };
+
+  arma::sp_mat dataset;
+  arma::rowvec labels;
+  for (size_t i = 0; i < 5; ++i)
+  {
+    fstream f;
+    f.open("test.svm", fstream::out);
+    f << "1 1:1.0" << endl << lines[i] << endl;
+    f.close();
+
+    BOOST_REQUIRE_THROW(LoadLibSVM("test.svm", dataset, labels),
+        std::runtime_error);
+    BOOST_REQUIRE(!data::Load("test.svm", dataset, labels));
+  }
+
+  remove("test.svm");
+}
+
+/**
+ * Make sure LibSVM labels out of the range of the label type are rejected, and
+ * that long numbers are parsed.
+ */
+BOOST_AUTO_TEST_CASE(LibSVMLabelRangeTest)
+{
+  fstream f;
+  f.open("test.svm", fstream::out);
+  f << "1 1:1.0" << endl;
+  f << "-1 1:0." << std::string(80, '0') << "5e1" << endl;
+  f.close();
+
+  arma::sp_mat dataset;
+  arma::Row<size_t> unsignedLabels;
+  BOOST_REQUIRE_THROW(LoadLibSVM("test.svm", dataset, unsignedLabels),
+      std::runtime_error);
+  BOOST_REQUIRE(!data::Load("test.svm", dataset, unsignedLabels));
+
+  arma::Row<int> labels;
+  BOOST_REQUIRE(data::Load("test.svm", dataset, labels));
+  BOOST_REQUIRE_EQUAL(labels.n_elem, 2);
+  BOOST_REQUIRE_EQUAL(labels[0], 1);
+  BOOST_REQUIRE_EQUAL(labels[1], -1);
+  BOOST_REQUIRE_CLOSE((double) dataset(0, 1), 5e-80, 1e-5);
+
+  remove("test.svm");
+}
+
+/**
+ * Make sure ARFF files with sparse data can be loaded into dense and sparse
+ * matrices.
+ */
+BOOST_AUTO_TEST_CASE(SparseARFFTest)
+{
+  fstream f;
+  f.open("test.arff", fstream::out);
+  f << "@relation test" << endl;
+  f << "@attribute one NUMERIC" << endl;
+  f << "@attribute two {a, b, c}" << endl;
+  f << "@attribute three NUMERIC" << endl;
+  f << "@attribute four NUMERIC" << endl;
+  f << "@data" << endl;
+  f << "{0 1.5, 3 -2}" << endl;
+  f << "{}" << endl;
+  f << "% a comment line" << endl;
+  f << endl;
+  f << "{3 4, 1 c}" << endl;
+  f << "0, b, 3, 0" << endl;
+  f.close();
+
+  arma::mat expected("1.5 0 0 0;"
+                     "0 0 2 1;"
+                     "0 0 0 3;"
+                     "-2 0 4 0");
+
+  arma::sp_mat sparse;
+  DatasetInfo info;
+  LoadARFF("test.arff", sparse, info);
+
+  BOOST_REQUIRE_EQUAL(info.Dimensionality(), 4);
+  BOOST_REQUIRE(info.Type(1) == Datatype::categorical);
+  BOOST_REQUIRE_EQUAL(info.NumMappings(1), 3);
+  BOOST_REQUIRE_EQUAL(sparse.n_nonzero, 6);
+  CheckMatrices(arma::mat(sparse), expected);
+
+  // The dense loader skips comments and empty lines in the same way.
+  arma::mat dense;
+  DatasetInfo denseInfo;
+  BOOST_REQUIRE(data::Load("test.arff", dense, denseInfo));
+  CheckMatrices(dense, expected);
+
+  // Indices must be in range and may not repeat.
+  f.open("test.arff", fstream::out);
+  f << "@relation test" << endl;
+  f << "@attribute one NUMERIC" << endl;
+  f << "@data" << endl;
+  f << "{0 1, 0 2}" << endl;
+  f.close();
+
+  DatasetInfo badInfo;
+  BOOST_REQUIRE_THROW(LoadARFF("test.arff", sparse, badInfo),
+      std::runtime_error);
+
+  remove("test.arff");
+}
+
 BOOST_AUTO_TEST_SUITE_END();
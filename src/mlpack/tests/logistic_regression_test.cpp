@@ -1023,4 +1023,72 @@ BOOST_AUTO_TEST_CASE(ConstructionThenTraining)
   BOOST_REQUIRE_NO_THROW(lr.Train(myMatrix, myTargets));
 }
 
+/**
+ * Test that training from minibatch sources gives the same model as training
+ * on the matrix when the batches are the same, and that training with
+ * shuffled batches works.
+ */
+BOOST_AUTO_TEST_CASE(LogisticRegressionMinibatchSourceTest)
+{
+  GaussianDistribution g1(arma::vec("1.0 1.0 1.0"), arma::eye<arma::mat>(3, 3));
+  GaussianDistribution g2(arma::vec("5.0 5.0 5.0"), arma::eye<arma::mat>(3, 3));
+
+  arma::mat dataset(3, 1000);
+  arma::Row<size_t> responses(1000);
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    dataset.col(i) = (i % 2 == 0) ? g1.Random() : g2.Random();
+    responses[i] = i % 2;
+  }
+
+  // The objective over all points is the same.
+  const arma::mat parameters("0.5 -0.2 0.1 0.3");
+  LogisticRegressionFunction<> lrf(dataset, responses, 0.5);
+  data::MatrixSource<> source(dataset, responses);
+  data::MinibatchFunction<data::MatrixSource<>, LogisticRegressionFunction<>>
+      mf(source, [](const arma::mat& predictors,
+                    const arma::Row<size_t>& labels,
+                    const size_t numPoints)
+      {
+        return LogisticRegressionFunction<>(predictors, labels,
+            0.5 * predictors.n_cols / numPoints);
+      }, 64);
+  BOOST_REQUIRE_CLOSE(mf.Evaluate(parameters), lrf.Evaluate(parameters),
+      1e-8);
+
+  // Without shuffling, SGD sees the same batches.
+  ens::StandardSGD sgd(0.01, 16, 3 * dataset.n_cols, 1e-10, false);
+  LogisticRegression<> lr(0, 0.5);
+  lr.Train(dataset, responses, sgd);
+
+  LogisticRegression<> sourceLr(0, 0.5);
+  sourceLr.Train(source, sgd);
+  CheckMatrices(lr.Parameters(), sourceLr.Parameters(), 1e-6);
+
+  // The same, through a CSV file and a background thread.  The file holds the
+  // values to fewer digits, so the model is not exactly the same.
+  data::Save("minibatch_source.csv", dataset);
+  {
+    data::CSVSource<> csvSource("minibatch_source.csv", responses);
+    BOOST_REQUIRE_EQUAL(csvSource.NumPoints(), dataset.n_cols);
+    BOOST_REQUIRE_EQUAL(csvSource.Dimensionality(), dataset.n_rows);
+
+    data::PrefetchSource<data::CSVSource<>> prefetchSource(csvSource);
+    LogisticRegression<> csvLr(0, 0.5);
+    csvLr.Train(prefetchSource, sgd);
+    CheckMatrices(lr.Parameters(), csvLr.Parameters(), 1e-2);
+  }
+  remove("minibatch_source.csv");
+
+  // With shuffling, the model still separates the classes.
+  ens::StandardSGD shuffledSgd(0.01, 16, 5 * dataset.n_cols, 1e-10, true);
+  data::PrefetchSource<data::MatrixSource<>> prefetchSource(source);
+  LogisticRegression<> shuffledLr(0, 0.5);
+  shuffledLr.Train(prefetchSource, shuffledSgd);
+
+  arma::Row<size_t> predictions;
+  shuffledLr.Classify(dataset, predictions);
+  BOOST_REQUIRE_GE((double) arma::accu(predictions == responses), 950.0);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
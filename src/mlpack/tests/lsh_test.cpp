@@ -844,8 +844,71 @@ BOOST_AUTO_TEST_CASE(ParallelMonochromatic)
       sequentialNeighbors, parallelNeighbors);
   BOOST_REQUIRE_EQUAL(recall, 1);
 }
+
+/**
+ * Test: building the hash tables with several threads must give exactly the
+ * same table as building them with one thread.
+ */
+BOOST_AUTO_TEST_CASE(ParallelTrain)
+{
+  arma::mat rdata = arma::randu<arma::mat>(5, 20000);
+  const arma::cube projections = arma::randn<arma::cube>(5, 4, 8);
+
+  // Use the same random seed for both models so the offsets and second hash
+  // weights are the same.
+  math::RandomSeed(42);
+  LSHSearch<> parallelLSH(rdata, projections, 0.5, 99901, 30);
+
+  size_t prevNumThreads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  math::RandomSeed(42);
+  LSHSearch<> sequentialLSH(rdata, projections, 0.5, 99901, 30);
+  omp_set_num_threads(prevNumThreads);
+
+  CheckMatrices(parallelLSH.BucketOffsets(), sequentialLSH.BucketOffsets());
+  CheckMatrices(
+      arma::conv_to<arma::Mat<size_t>>::from(parallelLSH.BucketContents()),
+      arma::conv_to<arma::Mat<size_t>>::from(sequentialLSH.BucketContents()));
+}
 #endif
 
+/**
+ * Make sure that the packed second hash table holds every point once per
+ * table when the bucket size is unlimited, and that SecondHashTable() holds
+ * the same rows.
+ */
+BOOST_AUTO_TEST_CASE(BucketLayoutTest)
+{
+  const size_t numTables = 6;
+  arma::mat rdata = arma::randu<arma::mat>(4, 1500);
+
+  LSHSearch<> lsh(rdata, 3, numTables, 0.0, 99901, 0);
+
+  const arma::Col<size_t>& offsets = lsh.BucketOffsets();
+  const arma::Col<arma::u32>& contents = lsh.BucketContents();
+  BOOST_REQUIRE_GT(offsets.n_elem, 1);
+  BOOST_REQUIRE_EQUAL(offsets[0], 0);
+  BOOST_REQUIRE_EQUAL(offsets[offsets.n_elem - 1], contents.n_elem);
+  BOOST_REQUIRE_EQUAL(contents.n_elem, numTables * rdata.n_cols);
+
+  // Every point must be found once in each table.
+  arma::Col<size_t> counts(rdata.n_cols, arma::fill::zeros);
+  for (size_t i = 0; i < contents.n_elem; ++i)
+    counts[contents[i]]++;
+  for (size_t i = 0; i < counts.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(counts[i], numTables);
+
+  const std::vector<arma::Col<size_t>>& table = lsh.SecondHashTable();
+  BOOST_REQUIRE_EQUAL(table.size(), offsets.n_elem - 1);
+  for (size_t i = 0; i < table.size(); ++i)
+  {
+    BOOST_REQUIRE_EQUAL(table[i].n_elem, offsets[i + 1] - offsets[i]);
+    BOOST_REQUIRE_GT(table[i].n_elem, 0);
+    for (size_t j = 0; j < table[i].n_elem; ++j)
+      BOOST_REQUIRE_EQUAL(table[i][j], contents[offsets[i] + j]);
+  }
+}
+
 // Test the copy constructor and the copy operator.
 BOOST_AUTO_TEST_CASE(CopyConstructorAndOperatorTest)
 {
@@ -230,4 +230,34 @@ BOOST_AUTO_TEST_CASE(PreprocessSplitLabelShuffleDataTest)
   CheckMatrices(inputData, concat);
 }
 
+/**
+ * Check that a stratified split keeps the class proportions of the dataset in
+ * both sets.
+ */
+BOOST_AUTO_TEST_CASE(PreprocessSplitStratifyDataTest)
+{
+  arma::mat inputData(3, 1000, arma::fill::randu);
+  arma::Mat<size_t> labels(1, 1000);
+  for (size_t i = 0; i < labels.n_cols; ++i)
+    labels[i] = (i % 10 == 0) ? 1 : 0;
+
+  SetInputParam("input", std::move(inputData));
+  SetInputParam("input_labels", std::move(labels));
+  SetInputParam("test_ratio", (double) 0.2);
+  SetInputParam("stratify_data", true);
+
+  mlpackMain();
+
+  const arma::Mat<size_t>& trainLabels =
+      IO::GetParam<arma::Mat<size_t>>("training_labels");
+  const arma::Mat<size_t>& testLabels =
+      IO::GetParam<arma::Mat<size_t>>("test_labels");
+  BOOST_REQUIRE_EQUAL(trainLabels.n_cols, 800);
+  BOOST_REQUIRE_EQUAL(testLabels.n_cols, 200);
+  BOOST_REQUIRE_EQUAL(arma::accu(trainLabels), 80);
+  BOOST_REQUIRE_EQUAL(arma::accu(testLabels), 20);
+  BOOST_REQUIRE_EQUAL(IO::GetParam<arma::mat>("training").n_cols, 800);
+  BOOST_REQUIRE_EQUAL(IO::GetParam<arma::mat>("test").n_cols, 200);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -12,6 +12,7 @@
 #include <mlpack/core/math/clamp.hpp>
 #include <mlpack/core/math/random.hpp>
 #include <mlpack/core/math/range.hpp>
+#include <mlpack/core/math/quantile_sketch.hpp>
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
 
@@ -1009,4 +1010,69 @@ BOOST_AUTO_TEST_CASE(InplaceSparseShuffleWeightsTest)
   }
 }
 
+/**
+ * Make sure that the quantiles estimated by QuantileSketch have a small rank
+ * error, whether the values are inserted into one sketch or into several
+ * sketches that are merged.
+ */
+BOOST_AUTO_TEST_CASE(QuantileSketchTest)
+{
+  arma::vec values = arma::square(arma::randu<arma::vec>(100000));
+  arma::vec sorted = arma::sort(values);
+
+  math::QuantileSketch<> sketch;
+  std::vector<math::QuantileSketch<>> parts(4);
+  for (size_t i = 0; i < values.n_elem; ++i)
+  {
+    sketch.Insert(values[i]);
+    parts[i % 4].Insert(values[i]);
+  }
+  for (size_t i = 1; i < parts.size(); ++i)
+    parts[0].Merge(parts[i]);
+
+  BOOST_REQUIRE_EQUAL(sketch.Count(), values.n_elem);
+  BOOST_REQUIRE_EQUAL(parts[0].Count(), values.n_elem);
+  BOOST_REQUIRE_LT(sketch.Size(), 1000);
+  BOOST_REQUIRE_EQUAL(sketch.Quantile(0.0), sorted[0]);
+  BOOST_REQUIRE_EQUAL(sketch.Quantile(1.0), sorted[sorted.n_elem - 1]);
+
+  const arma::vec q("0.01 0.1 0.25 0.5 0.75 0.9 0.99");
+  arma::vec quantiles, mergedQuantiles;
+  sketch.Quantiles(q, quantiles);
+  parts[0].Quantiles(q, mergedQuantiles);
+  for (size_t i = 0; i < q.n_elem; ++i)
+  {
+    // The rank of each estimated quantile must be within 2% of the true one.
+    const double rank = (double) (std::upper_bound(sorted.begin(),
+        sorted.end(), quantiles[i]) - sorted.begin());
+    const double mergedRank = (double) (std::upper_bound(sorted.begin(),
+        sorted.end(), mergedQuantiles[i]) - sorted.begin());
+    BOOST_REQUIRE_SMALL(rank / values.n_elem - q[i], 0.02);
+    BOOST_REQUIRE_SMALL(mergedRank / values.n_elem - q[i], 0.02);
+
+    const double estimatedRank =
+        sketch.Rank(sorted[(size_t) (q[i] * values.n_elem)]);
+    BOOST_REQUIRE_SMALL(estimatedRank / values.n_elem - q[i], 0.02);
+  }
+}
+
+/**
+ * Make sure that QuantileSketch is exact when it holds few values.
+ */
+BOOST_AUTO_TEST_CASE(QuantileSketchExactTest)
+{
+  math::QuantileSketch<> sketch;
+  for (size_t i = 100; i > 0; --i)
+    sketch.Insert((double) i);
+
+  BOOST_REQUIRE_EQUAL(sketch.Quantile(0.5), 50.0);
+  BOOST_REQUIRE_EQUAL(sketch.Quantile(0.25), 25.0);
+  BOOST_REQUIRE_EQUAL(sketch.Rank(10.0), 10.0);
+  BOOST_REQUIRE_EQUAL(sketch.Min(), 1.0);
+  BOOST_REQUIRE_EQUAL(sketch.Max(), 100.0);
+
+  math::QuantileSketch<> empty;
+  BOOST_REQUIRE_THROW(empty.Quantile(0.5), std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
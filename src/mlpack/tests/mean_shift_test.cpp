@@ -165,4 +165,56 @@ BOOST_AUTO_TEST_CASE(GaussianClustering)
   BOOST_REQUIRE_EQUAL(success, true);
 }
 
+/**
+ * Make sure that each centroid returned when every point is a seed is a fixed
+ * point of the mean shift (up to the convergence tolerance), and that no two
+ * centroids are within the radius of each other, with and without a kernel.
+ */
+BOOST_AUTO_TEST_CASE(MeanShiftFixedPointTest)
+{
+  arma::mat dataset(2, 600);
+  dataset.cols(0, 299) = arma::randn<arma::mat>(2, 300);
+  dataset.cols(300, 599) = arma::randn<arma::mat>(2, 300);
+  dataset(0, arma::span(300, 599)) += 10.0;
+  const double radius = 2.0;
+
+  arma::Row<size_t> assignments;
+  arma::mat centroids;
+  MeanShift<> meanShift(radius);
+  meanShift.Cluster(dataset, assignments, centroids, true, false);
+  BOOST_REQUIRE_EQUAL(assignments.n_elem, dataset.n_cols);
+  BOOST_REQUIRE_GE(centroids.n_cols, 2);
+
+  for (size_t i = 0; i < centroids.n_cols; ++i)
+  {
+    // Compute one more step of the mean shift by brute force.
+    arma::vec mean(2, arma::fill::zeros);
+    size_t count = 0;
+    for (size_t j = 0; j < dataset.n_cols; ++j)
+    {
+      if (arma::norm(dataset.col(j) - centroids.col(i)) <= radius)
+      {
+        mean += dataset.col(j);
+        ++count;
+      }
+    }
+    BOOST_REQUIRE_GT(count, 0);
+    mean /= count;
+
+    BOOST_REQUIRE_LT(arma::norm(mean - centroids.col(i)), 1e-3 * radius);
+    for (size_t j = i + 1; j < centroids.n_cols; ++j)
+      BOOST_REQUIRE_GE(arma::norm(centroids.col(i) - centroids.col(j)), radius);
+  }
+
+  // With a kernel, the centroids should still be apart.
+  MeanShift<true> kernelMeanShift(radius);
+  kernelMeanShift.Cluster(dataset, assignments, centroids);
+  BOOST_REQUIRE_GE(centroids.n_cols, 2);
+  for (size_t i = 0; i < centroids.n_cols; ++i)
+  {
+    for (size_t j = i + 1; j < centroids.n_cols; ++j)
+      BOOST_REQUIRE_GE(arma::norm(centroids.col(i) - centroids.col(j)), radius);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
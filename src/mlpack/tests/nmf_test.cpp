@@ -16,6 +16,7 @@
 #include <mlpack/methods/amf/update_rules/nmf_mult_div.hpp>
 #include <mlpack/methods/amf/update_rules/nmf_als.hpp>
 #include <mlpack/methods/amf/update_rules/nmf_mult_dist.hpp>
+#include <mlpack/methods/amf/update_rules/sparse_als.hpp>
 
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
@@ -305,4 +306,132 @@ BOOST_AUTO_TEST_CASE(NonNegNMFALSTest)
       && arma::all(arma::vectorise(h) >= 0));
 }
 
+/**
+ * Make sure that each row of W and column of H found by SparseALSUpdate is the
+ * solution of the regularized least squares problem over the observed entries.
+ */
+BOOST_AUTO_TEST_CASE(SparseALSUpdateReferenceTest)
+{
+  const size_t r = 3;
+  const double lambda = 0.1;
+
+  sp_mat v;
+  v.sprandu(12, 8, 0.4);
+  // Ensure there is at least one nonzero element in every row and column.
+  for (size_t i = 0; i < 12; ++i)
+    v(i, i % 8) += 0.5;
+
+  mat w = randu<mat>(12, r);
+  mat h = randu<mat>(r, 8);
+
+  SparseALSUpdate update(lambda);
+  update.Initialize(v, r);
+
+  // Check the update of H against a dense solve for each column.
+  mat newH(h);
+  update.HUpdate(v, w, newH);
+  for (size_t j = 0; j < v.n_cols; ++j)
+  {
+    const vec column(mat(v.col(j)));
+    const uvec observed = find(column != 0);
+    const mat wObserved = w.rows(observed);
+    const vec vObserved = column.elem(observed);
+    const mat gram = wObserved.t() * wObserved +
+        lambda * observed.n_elem * eye<mat>(r, r);
+    const vec expected = solve(gram, wObserved.t() * vObserved);
+
+    for (size_t k = 0; k < r; ++k)
+      BOOST_REQUIRE_CLOSE(newH(k, j), expected(k), 1e-5);
+  }
+
+  // Check the update of W against a dense solve for each row.
+  mat newW(w);
+  update.WUpdate(v, newW, newH);
+  for (size_t i = 0; i < v.n_rows; ++i)
+  {
+    const vec row(mat(v.row(i)).t());
+    const uvec observed = find(row != 0);
+    const mat hObserved = newH.cols(observed);
+    const vec vObserved = row.elem(observed);
+    const mat gram = hObserved * hObserved.t() +
+        lambda * observed.n_elem * eye<mat>(r, r);
+    const vec expected = solve(gram, hObserved * vObserved);
+
+    for (size_t k = 0; k < r; ++k)
+      BOOST_REQUIRE_CLOSE(newW(i, k), expected(k), 1e-5);
+  }
+}
+
+/**
+ * Make sure that SparseALSUpdate does not fail when lambda is zero and some
+ * columns have fewer observations than the rank.
+ */
+BOOST_AUTO_TEST_CASE(SparseALSUpdateZeroLambdaTest)
+{
+  const size_t r = 4;
+
+  // Column 0 has a single observation; column 2 has none.
+  sp_mat v(6, 3);
+  v(0, 0) = 2.0;
+  for (size_t i = 0; i < 6; ++i)
+    v(i, 1) = i + 1.0;
+
+  mat w = randu<mat>(6, r);
+  mat h = randu<mat>(r, 3);
+
+  SparseALSUpdate update(0.0);
+  update.Initialize(v, r);
+  BOOST_REQUIRE_NO_THROW(update.HUpdate(v, w, h));
+  BOOST_REQUIRE_NO_THROW(update.WUpdate(v, w, h));
+
+  BOOST_REQUIRE(w.is_finite());
+  BOOST_REQUIRE(h.is_finite());
+
+  // A column without observations is zero.
+  for (size_t k = 0; k < r; ++k)
+    BOOST_REQUIRE_SMALL(h(k, 2), 1e-10);
+}
+
+/**
+ * Make sure that AMF with SparseALSUpdate recovers the observed entries of a
+ * low-rank matrix.
+ */
+BOOST_AUTO_TEST_CASE(SparseALSFactorizerTest)
+{
+  const size_t r = 3;
+  mat w = randu<mat>(40, r) + 0.1;
+  mat h = randu<mat>(r, 30) + 0.1;
+  mat dv = w * h;
+
+  // Keep about half of the entries, but at least one in every row and column.
+  sp_mat v(40, 30);
+  for (size_t j = 0; j < dv.n_cols; ++j)
+  {
+    for (size_t i = 0; i < dv.n_rows; ++i)
+    {
+      if (i % 30 == j || math::Random() < 0.5)
+        v(i, j) = dv(i, j);
+    }
+  }
+
+  SimpleResidueTermination srt(1e-10, 500);
+  SparseALSFactorizer als(srt, RandomAcolInitialization<>(),
+      SparseALSUpdate(1e-6));
+
+  mat resultW, resultH;
+  als.Apply(v, r, resultW, resultH);
+  const mat result = resultW * resultH;
+
+  // Compute the relative error at the observed entries.
+  double error = 0.0;
+  double norm = 0.0;
+  for (sp_mat::const_iterator it = v.begin(); it != v.end(); ++it)
+  {
+    error += std::pow(result(it.row(), it.col()) - (*it), 2.0);
+    norm += std::pow(*it, 2.0);
+  }
+
+  BOOST_REQUIRE_SMALL(std::sqrt(error / norm), 1e-2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -245,4 +245,43 @@ BOOST_AUTO_TEST_CASE(SparseTest)
   BOOST_REQUIRE_EQUAL(distances.n_cols, 1000);
 }
 
+/**
+ * Make sure searching many query points at once gives the same results as
+ * searching them one at a time, and that the neighbors are sorted and have no
+ * duplicates.
+ */
+BOOST_AUTO_TEST_CASE(QDAFNBatchTest)
+{
+  arma::mat dataset = arma::randu<arma::mat>(10, 500);
+  arma::mat querySet = arma::randu<arma::mat>(10, 300);
+
+  QDAFN<> qdafn(dataset, 10, 30);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  qdafn.Search(querySet, 5, neighbors, distances);
+
+  for (size_t q = 0; q < querySet.n_cols; ++q)
+  {
+    arma::Mat<size_t> queryNeighbors;
+    arma::mat queryDistances;
+    qdafn.Search(querySet.col(q), 5, queryNeighbors, queryDistances);
+
+    for (size_t i = 0; i < 5; ++i)
+    {
+      BOOST_REQUIRE_EQUAL(neighbors(i, q), queryNeighbors(i, 0));
+      BOOST_REQUIRE_CLOSE(distances(i, q), queryDistances(i, 0), 1e-5);
+
+      const double dist = metric::EuclideanDistance::Evaluate(querySet.col(q),
+          dataset.col(neighbors(i, q)));
+      BOOST_REQUIRE_CLOSE(distances(i, q), dist, 1e-5);
+      if (i > 0)
+      {
+        BOOST_REQUIRE_NE(neighbors(i, q), neighbors(i - 1, q));
+        BOOST_REQUIRE_LE(distances(i, q), distances(i - 1, q));
+      }
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -96,6 +96,52 @@ BOOST_AUTO_TEST_CASE(BootstrapWeightsTest)
   }
 }
 
+/**
+ * Make sure the weighted bootstrap keeps each drawn point once, with a weight
+ * equal to the number of times it was drawn.
+ */
+BOOST_AUTO_TEST_CASE(WeightedBootstrapTest)
+{
+  arma::mat dataset(1, 1000);
+  dataset.row(0) = arma::linspace<arma::rowvec>(1000, 1999, 1000);
+  arma::Row<size_t> labels(1000);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    labels[i] = i % 3;
+  arma::rowvec weights(1000);
+  weights.fill(0.5);
+
+  for (size_t trial = 0; trial < 5; ++trial)
+  {
+    arma::mat bootstrapDataset;
+    arma::Row<size_t> bootstrapLabels;
+    arma::rowvec bootstrapWeights;
+
+    WeightedBootstrap::Sample<true>(dataset, labels, weights,
+        bootstrapDataset, bootstrapLabels, bootstrapWeights);
+
+    BOOST_REQUIRE_LE(bootstrapDataset.n_cols, 1000);
+    BOOST_REQUIRE_EQUAL(bootstrapDataset.n_rows, 1);
+    BOOST_REQUIRE_EQUAL(bootstrapLabels.n_elem, bootstrapDataset.n_cols);
+    BOOST_REQUIRE_EQUAL(bootstrapWeights.n_elem, bootstrapDataset.n_cols);
+
+    // The weights of all points must add up to the size of the sample (times
+    // the original weight).
+    BOOST_REQUIRE_CLOSE(arma::accu(bootstrapWeights), 500.0, 1e-5);
+
+    for (size_t i = 0; i < bootstrapDataset.n_cols; ++i)
+    {
+      // Each point is present once, and in the original order.
+      if (i > 0)
+        BOOST_REQUIRE_GT(bootstrapDataset(0, i), bootstrapDataset(0, i - 1));
+
+      const size_t index = size_t(bootstrapDataset(0, i)) - 1000;
+      BOOST_REQUIRE_LT(index, 1000);
+      BOOST_REQUIRE_EQUAL(bootstrapLabels[i], labels[index]);
+      BOOST_REQUIRE_GE(bootstrapWeights[i], 0.5);
+    }
+  }
+}
+
 /**
  * Make sure an empty forest cannot predict.
  */
@@ -152,6 +198,71 @@ BOOST_AUTO_TEST_CASE(UnweightedNumericLearningTest)
   BOOST_REQUIRE_GE(rfCorrect, size_t(0.7 * testDataset.n_cols));
 }
 
+/**
+ * Test numeric learning with the weighted bootstrap, making sure that we get
+ * better performance than a single decision tree.
+ */
+BOOST_AUTO_TEST_CASE(WeightedBootstrapNumericLearningTest)
+{
+  // Load the vc2 dataset.
+  arma::mat dataset;
+  data::Load("vc2.csv", dataset);
+  arma::Row<size_t> labels;
+  data::Load("vc2_labels.txt", labels);
+
+  // Build a random forest and a decision tree.
+  RandomForest<GiniGain, MultipleRandomDimensionSelect, BestBinaryNumericSplit,
+      AllCategoricalSplit, double, WeightedBootstrap> rf(dataset, labels, 3,
+      20 /* 20 trees */, 1, 1e-7);
+  DecisionTree<> dt(dataset, labels, 3, 5);
+
+  // Get performance statistics on test data.
+  arma::mat testDataset;
+  data::Load("vc2_test.csv", testDataset);
+  arma::Row<size_t> testLabels;
+  data::Load("vc2_test_labels.txt", testLabels);
+
+  arma::Row<size_t> rfPredictions;
+  arma::Row<size_t> dtPredictions;
+
+  rf.Classify(testDataset, rfPredictions);
+  dt.Classify(testDataset, dtPredictions);
+
+  // Calculate the number of correct points.
+  size_t rfCorrect = arma::accu(rfPredictions == testLabels);
+  size_t dtCorrect = arma::accu(dtPredictions == testLabels);
+
+  BOOST_REQUIRE_GE(rfCorrect, dtCorrect * 0.9);
+  BOOST_REQUIRE_GE(rfCorrect, size_t(0.7 * testDataset.n_cols));
+}
+
+/**
+ * Make sure that with the weighted bootstrap, the minimum leaf size counts the
+ * distinct points of each tree's sample and not the draws.
+ */
+BOOST_AUTO_TEST_CASE(WeightedBootstrapMinimumLeafSizeTest)
+{
+  // The classes are split at the middle of the data.  A duplicated bootstrap
+  // sample has about 500 points on each side of the split, but a weighted one
+  // only has about 316 distinct points on each side.
+  arma::mat dataset(1, 1000);
+  dataset.row(0) = arma::linspace<arma::rowvec>(0, 999, 1000);
+  arma::Row<size_t> labels(1000);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    labels[i] = (i < 500) ? 0 : 1;
+
+  RandomForest<> rf(dataset, labels, 2, 10 /* 10 trees */,
+      400 /* minimum leaf size */);
+  RandomForest<GiniGain, MultipleRandomDimensionSelect, BestBinaryNumericSplit,
+      AllCategoricalSplit, double, WeightedBootstrap> weightedRf(dataset,
+      labels, 2, 10 /* 10 trees */, 400 /* minimum leaf size */);
+
+  for (size_t i = 0; i < rf.NumTrees(); ++i)
+    BOOST_REQUIRE_EQUAL(rf.Tree(i).NumChildren(), 2);
+  for (size_t i = 0; i < weightedRf.NumTrees(); ++i)
+    BOOST_REQUIRE_EQUAL(weightedRf.Tree(i).NumChildren(), 0);
+}
+
 /**
  * Test weighted numeric learning, making sure that we get better performance
  * than a single decision tree.
@@ -1696,4 +1696,105 @@ BOOST_AUTO_TEST_CASE(MoveOperatorNaiveTest)
   }
 }
 
+/**
+ * Make sure that the callback overloads of Search() pass the same results as
+ * the vector overloads, with the original indices, in every mode.
+ */
+BOOST_AUTO_TEST_CASE(CallbackSearchTest)
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(3, 300);
+  arma::mat querySet = arma::randu<arma::mat>(3, 200);
+  const math::Range range(0.1, 0.3);
+
+  for (size_t mode = 0; mode < 3; ++mode)
+  {
+    RangeSearch<> rs(referenceSet, mode == 0, mode == 1);
+
+    // Bichromatic search.
+    vector<vector<size_t>> neighbors, callbackNeighbors(querySet.n_cols);
+    vector<vector<double>> distances, callbackDistances(querySet.n_cols);
+    rs.Search(querySet, range, neighbors, distances);
+    auto storeResult = [&](const size_t queryIndex,
+                           const size_t referenceIndex,
+                           const double distance)
+    {
+      callbackNeighbors[queryIndex].push_back(referenceIndex);
+      callbackDistances[queryIndex].push_back(distance);
+    };
+    rs.Search(querySet, range, storeResult);
+
+    vector<vector<pair<double, size_t>>> sorted, callbackSorted;
+    SortResults(neighbors, distances, sorted);
+    SortResults(callbackNeighbors, callbackDistances, callbackSorted);
+    BOOST_REQUIRE(sorted == callbackSorted);
+
+    // Monochromatic search; a point is never its own neighbor.
+    callbackNeighbors.assign(referenceSet.n_cols, vector<size_t>());
+    callbackDistances.assign(referenceSet.n_cols, vector<double>());
+    rs.Search(range, neighbors, distances);
+    rs.Search(range, storeResult);
+
+    SortResults(neighbors, distances, sorted);
+    SortResults(callbackNeighbors, callbackDistances, callbackSorted);
+    BOOST_REQUIRE(sorted == callbackSorted);
+    for (size_t i = 0; i < callbackNeighbors.size(); ++i)
+    {
+      for (size_t j = 0; j < callbackNeighbors[i].size(); ++j)
+        BOOST_REQUIRE_NE(callbackNeighbors[i][j], i);
+    }
+  }
+}
+
+/**
+ * Make sure that the compressed sparse row overloads of Search() return the
+ * same results as the vector overloads.
+ */
+BOOST_AUTO_TEST_CASE(CSRSearchTest)
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(3, 300);
+  arma::mat querySet = arma::randu<arma::mat>(3, 200);
+  const math::Range range(0.0, 0.25);
+
+  RangeSearch<> rs(referenceSet);
+  vector<vector<size_t>> neighbors;
+  vector<vector<double>> distances;
+  arma::Col<size_t> offsets, csrNeighbors;
+  arma::vec csrDistances;
+
+  for (size_t monochromatic = 0; monochromatic < 2; ++monochromatic)
+  {
+    if (monochromatic)
+    {
+      rs.Search(range, neighbors, distances);
+      rs.Search(range, offsets, csrNeighbors, csrDistances);
+    }
+    else
+    {
+      rs.Search(querySet, range, neighbors, distances);
+      rs.Search(querySet, range, offsets, csrNeighbors, csrDistances);
+    }
+
+    BOOST_REQUIRE_EQUAL(offsets.n_elem, neighbors.size() + 1);
+    BOOST_REQUIRE_EQUAL(offsets[0], 0);
+    BOOST_REQUIRE_EQUAL(offsets[neighbors.size()], csrNeighbors.n_elem);
+    BOOST_REQUIRE_EQUAL(csrDistances.n_elem, csrNeighbors.n_elem);
+
+    vector<vector<size_t>> rowNeighbors(neighbors.size());
+    vector<vector<double>> rowDistances(neighbors.size());
+    for (size_t i = 0; i < neighbors.size(); ++i)
+    {
+      for (size_t j = offsets[i]; j < offsets[i + 1]; ++j)
+      {
+        rowNeighbors[i].push_back(csrNeighbors[j]);
+        rowDistances[i].push_back(csrDistances[j]);
+      }
+    }
+
+    vector<vector<pair<double, size_t>>> sorted, csrSorted;
+    SortResults(neighbors, distances, sorted);
+    SortResults(rowNeighbors, rowDistances, csrSorted);
+    BOOST_REQUIRE(sorted == csrSorted);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
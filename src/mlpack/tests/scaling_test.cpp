@@ -15,6 +15,7 @@
 #include <mlpack/core/data/scaler_methods/max_abs_scaler.hpp>
 #include <mlpack/core/data/scaler_methods/standard_scaler.hpp>
 #include <mlpack/core/data/scaler_methods/mean_normalization.hpp>
+#include <mlpack/core/data/scaler_methods/column_statistics.hpp>
 
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
@@ -175,4 +176,85 @@ BOOST_AUTO_TEST_CASE(ZCAWhiteningTest)
   CheckMatrices(dataset, temp);
 }
 
+/**
+ * Make sure that the statistics computed in parallel by ColumnStatistics are
+ * the same as the ones computed by Armadillo, on enough points to be split
+ * into many shards and with a large offset.
+ */
+BOOST_AUTO_TEST_CASE(ColumnStatisticsTest)
+{
+  arma::mat input(7, 5003, arma::fill::randn);
+  input.row(2) += 1e6;
+  input.row(4) *= 1e-3;
+
+  data::ColumnStatistics stats(input);
+
+  BOOST_REQUIRE_EQUAL(stats.NumPoints(), input.n_cols);
+  CheckMatrices(stats.Mean(), arma::mean(input, 1), 1e-7);
+  CheckMatrices(stats.Variance(), arma::var(input, 0, 1), 1e-5);
+  CheckMatrices(stats.StdDev(1), arma::stddev(input, 1, 1), 1e-5);
+  CheckMatrices(stats.Min(), arma::min(input, 1));
+  CheckMatrices(stats.Max(), arma::max(input, 1));
+
+  // A single point has no variance.
+  data::ColumnStatistics single(arma::mat(input.col(0)));
+  CheckMatrices(single.Mean(), input.col(0));
+  CheckMatrices(single.Variance(), arma::vec(7, arma::fill::zeros));
+
+  // Subviews and expressions can be given too.
+  data::ColumnStatistics subview(input.cols(100, 2099));
+  BOOST_REQUIRE_EQUAL(subview.NumPoints(), 2000);
+  CheckMatrices(subview.Mean(), arma::mean(input.cols(100, 2099), 1), 1e-7);
+  CheckMatrices(subview.Max(), arma::max(input.cols(100, 2099), 1));
+  data::ColumnStatistics expression(2.0 * input);
+  CheckMatrices(expression.Mean(), 2.0 * arma::mean(input, 1), 1e-7);
+
+  // A dataset without points has empty statistics, as with Armadillo.
+  data::ColumnStatistics empty(arma::mat(7, 0));
+  BOOST_REQUIRE_EQUAL(empty.NumPoints(), 0);
+  BOOST_REQUIRE_EQUAL(empty.Mean().n_elem, 0);
+  BOOST_REQUIRE_EQUAL(empty.Variance().n_elem, 0);
+
+  // The scalers can be fit on subviews.
+  data::StandardScaler scale;
+  scale.Fit(input.cols(100, 2099));
+  CheckMatrices(scale.ItemMean(), subview.Mean());
+}
+
+/**
+ * Make sure that the scalers give the same results as the Armadillo
+ * expressions they are defined with, both into another matrix and in place.
+ */
+BOOST_AUTO_TEST_CASE(ParallelScalerTransformTest)
+{
+  arma::mat input(5, 2001, arma::fill::randu);
+  input.row(1) *= 100.0;
+  input.row(3).fill(2.0);
+
+  data::StandardScaler scale;
+  scale.Fit(input);
+  arma::vec stddev = arma::stddev(input, 1, 1);
+  stddev(3) = 1.0;
+  arma::mat expected = (input.each_col() - arma::mean(input, 1)).each_col() /
+      stddev;
+
+  arma::mat output;
+  scale.Transform(input, output);
+  CheckMatrices(expected, output);
+
+  arma::mat inPlace(input);
+  scale.Transform(inPlace, inPlace);
+  CheckMatrices(expected, inPlace);
+  scale.InverseTransform(inPlace, inPlace);
+  CheckMatrices(input, inPlace);
+
+  data::MinMaxScaler minMax(-1, 1);
+  minMax.Fit(input);
+  minMax.Transform(input, output);
+  CheckMatrices(arma::min(output, 1), arma::vec("-1 -1 -1 -1 -1"));
+  BOOST_REQUIRE_CLOSE(output.max(), 1.0, 1e-5);
+  minMax.InverseTransform(output, output);
+  CheckMatrices(input, output);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -1053,6 +1053,13 @@ BOOST_AUTO_TEST_CASE(LSHTest)
   BOOST_REQUIRE_EQUAL(lsh.BucketSize(), textLsh.BucketSize());
   BOOST_REQUIRE_EQUAL(lsh.BucketSize(), binaryLsh.BucketSize());
 
+  CheckMatrices(lsh.BucketOffsets(), xmlLsh.BucketOffsets(),
+      textLsh.BucketOffsets(), binaryLsh.BucketOffsets());
+  CheckMatrices(arma::conv_to<arma::Mat<size_t>>::from(lsh.BucketContents()),
+      arma::conv_to<arma::Mat<size_t>>::from(xmlLsh.BucketContents()),
+      arma::conv_to<arma::Mat<size_t>>::from(textLsh.BucketContents()),
+      arma::conv_to<arma::Mat<size_t>>::from(binaryLsh.BucketContents()));
+
   BOOST_REQUIRE_EQUAL(lsh.SecondHashTable().size(),
       xmlLsh.SecondHashTable().size());
   BOOST_REQUIRE_EQUAL(lsh.SecondHashTable().size(),
@@ -215,4 +215,102 @@ BOOST_AUTO_TEST_CASE(SplitLabeledDataLargerTest)
   CheckDuplication(std::get<2>(value), std::get<3>(value));
 }
 
+/**
+ * Make sure that PermuteCols() applies the permutation in place, including
+ * permutations with several cycles and fixed points.
+ */
+BOOST_AUTO_TEST_CASE(PermuteColsTest)
+{
+  mat input(4, 100, arma::fill::randu);
+  // The first ten points are fixed, and the rest are shuffled.
+  const arma::uvec order = arma::join_cols(
+      arma::linspace<arma::uvec>(0, 9, 10),
+      arma::shuffle(arma::linspace<arma::uvec>(10, 99, 90)));
+
+  mat permuted(input);
+  PermuteCols(permuted, order);
+  CheckMatrices(mat(input.cols(order)), permuted);
+
+  Row<size_t> labels = arma::linspace<Row<size_t>>(0, 99, 100);
+  PermuteCols(labels, order);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(labels[i], order[i]);
+
+  BOOST_REQUIRE_THROW(PermuteCols(permuted, arma::uvec(99)),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure that SplitIndices() and StratifiedSplitIndices() give disjoint
+ * sets of the right sizes that cover the dataset.
+ */
+BOOST_AUTO_TEST_CASE(SplitIndicesTest)
+{
+  arma::uvec trainIndices, testIndices;
+  SplitIndices(497, trainIndices, testIndices, 0.3);
+  BOOST_REQUIRE_EQUAL(trainIndices.n_elem, 497 - size_t(0.3 * 497));
+  BOOST_REQUIRE_EQUAL(testIndices.n_elem, size_t(0.3 * 497));
+  arma::uvec all = arma::sort(arma::join_cols(trainIndices, testIndices));
+  for (size_t i = 0; i < all.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(all[i], i);
+
+  // Three classes, of 300, 150 and 50 points.
+  Row<size_t> labels(500);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    labels[i] = (i % 10 < 6) ? 0 : ((i % 10 < 9) ? 1 : 2);
+
+  StratifiedSplitIndices(labels, trainIndices, testIndices, 0.2);
+  BOOST_REQUIRE_EQUAL(trainIndices.n_elem, 400);
+  BOOST_REQUIRE_EQUAL(testIndices.n_elem, 100);
+  const Row<size_t> testLabels = labels.cols(testIndices);
+  BOOST_REQUIRE_EQUAL(arma::accu(testLabels == 0), 60);
+  BOOST_REQUIRE_EQUAL(arma::accu(testLabels == 1), 30);
+  BOOST_REQUIRE_EQUAL(arma::accu(testLabels == 2), 10);
+  all = arma::sort(arma::join_cols(trainIndices, testIndices));
+  for (size_t i = 0; i < all.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(all[i], i);
+
+  // Without shuffling, the last points of each class are the test set.
+  StratifiedSplitIndices(labels, trainIndices, testIndices, 0.2, false);
+  BOOST_REQUIRE_EQUAL(testIndices.n_elem, 100);
+  for (size_t i = 1; i < testIndices.n_elem; ++i)
+    BOOST_REQUIRE_LT(testIndices[i - 1], testIndices[i]);
+  BOOST_REQUIRE_EQUAL(testIndices[0], 400);
+}
+
+/**
+ * Make sure that SplitInPlace() gives the same sets as Split(), and that the
+ * stratified version keeps the class proportions.
+ */
+BOOST_AUTO_TEST_CASE(SplitInPlaceTest)
+{
+  mat input(10, 497, arma::fill::randu);
+  Row<size_t> labels = arma::linspace<Row<size_t>>(0, input.n_cols - 1,
+      input.n_cols);
+
+  mat data(input);
+  Row<size_t> dataLabels(labels);
+  const size_t trainSize = SplitInPlace(data, dataLabels, 0.3);
+  BOOST_REQUIRE_EQUAL(trainSize, 497 - size_t(0.3 * 497));
+  CompareData(input, data, dataLabels);
+  CheckDuplication(dataLabels.cols(0, trainSize - 1),
+      dataLabels.cols(trainSize, data.n_cols - 1));
+
+  // Without shuffling, nothing moves.
+  data = input;
+  BOOST_REQUIRE_EQUAL(SplitInPlace(data, 0.3, false), trainSize);
+  CheckMatrices(input, data);
+
+  // Two classes of 400 and 97 points.
+  Row<size_t> classes(497);
+  for (size_t i = 0; i < classes.n_elem; ++i)
+    classes[i] = (i < 400) ? 0 : 1;
+  data = input;
+  const size_t stratifiedTrainSize = SplitInPlace(data, classes, 0.25, true,
+      true);
+  BOOST_REQUIRE_EQUAL(stratifiedTrainSize, 300 + 73);
+  BOOST_REQUIRE_EQUAL(arma::accu(classes.cols(0, stratifiedTrainSize - 1)),
+      73);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -18,6 +18,7 @@
 #include <mlpack/core/data/string_encoding_policies/dictionary_encoding_policy.hpp>
 #include <mlpack/core/data/string_encoding_policies/bag_of_words_encoding_policy.hpp>
 #include <mlpack/core/data/string_encoding_policies/tf_idf_encoding_policy.hpp>
+#include <mlpack/core/data/string_encoding_policies/feature_hashing_encoding_policy.hpp>
 #include <boost/test/unit_test.hpp>
 #include <memory>
 #include "test_tools.hpp"
@@ -1425,5 +1426,107 @@ BOOST_AUTO_TEST_CASE(SplitByAnyOfTfIdfEncodingSerialization)
   CheckMatrices(output, xmlOutput, textOutput, binaryOutput);
 }
 
+/**
+ * Make sure that encoding into a sparse matrix, which is done in parallel,
+ * gives the same labels and values as encoding into a dense matrix.
+ */
+BOOST_AUTO_TEST_CASE(SparseBagOfWordsTfIdfEncodingTest)
+{
+  // Build a corpus that is big enough to be split into several shards, with
+  // a mix of common and rare tokens.
+  vector<string> input;
+  for (size_t i = 0; i < 2000; ++i)
+  {
+    ostringstream oss;
+    for (size_t j = 0; j < (i * 7) % 23; ++j)
+      oss << "w" << ((j % 3 == 0) ? (i * j) % 997 : (i + j) % 31) << " ";
+    input.push_back(oss.str());
+  }
+
+  SplitByAnyOf tokenizer(" ");
+
+  BagOfWordsEncoding<SplitByAnyOf::TokenType> bowEncoder, denseBowEncoder;
+  arma::sp_mat bowOutput;
+  arma::mat denseBowOutput;
+  bowEncoder.Encode(input, bowOutput, tokenizer);
+  denseBowEncoder.Encode(input, denseBowOutput, tokenizer);
+
+  CheckDictionaries(bowEncoder.Dictionary(), denseBowEncoder.Dictionary());
+  CheckMatrices(arma::mat(bowOutput), denseBowOutput);
+
+  const TfIdfEncodingPolicy::TfTypes tfTypes[] = {
+      TfIdfEncodingPolicy::TfTypes::BINARY,
+      TfIdfEncodingPolicy::TfTypes::RAW_COUNT,
+      TfIdfEncodingPolicy::TfTypes::TERM_FREQUENCY,
+      TfIdfEncodingPolicy::TfTypes::SUBLINEAR_TF };
+  for (const TfIdfEncodingPolicy::TfTypes tfType : tfTypes)
+  {
+    TfIdfEncoding<SplitByAnyOf::TokenType> encoder(tfType, false);
+    TfIdfEncoding<SplitByAnyOf::TokenType> denseEncoder(tfType, false);
+    arma::sp_mat output;
+    arma::mat denseOutput;
+    encoder.Encode(input, output, tokenizer);
+    denseEncoder.Encode(input, denseOutput, tokenizer);
+
+    CheckDictionaries(encoder.Dictionary(), denseEncoder.Dictionary());
+    CheckMatrices(arma::mat(output), denseOutput);
+  }
+}
+
+/**
+ * Test the feature hashing encoding algorithm with each output type, and make
+ * sure that strings encoded separately get the same dimensions.
+ */
+BOOST_AUTO_TEST_CASE(FeatureHashingEncodingTest)
+{
+  using EncoderType = FeatureHashingEncoding<SplitByAnyOf::TokenType>;
+
+  SplitByAnyOf tokenizer(" ,.");
+  EncoderType encoder(32);
+  arma::mat output;
+  arma::sp_mat sparseOutput;
+  vector<vector<double>> vectorOutput;
+
+  encoder.Encode(stringEncodingInput, output, tokenizer);
+  encoder.Encode(stringEncodingInput, sparseOutput, tokenizer);
+  encoder.Encode(stringEncodingInput, vectorOutput, tokenizer);
+
+  // No dictionary is needed.
+  BOOST_REQUIRE_EQUAL(encoder.Dictionary().Size(), 0);
+
+  BOOST_REQUIRE_EQUAL(output.n_rows, 32);
+  BOOST_REQUIRE_EQUAL(output.n_cols, stringEncodingInput.size());
+  CheckMatrices(arma::mat(sparseOutput), output);
+  BOOST_REQUIRE_EQUAL(vectorOutput.size(), output.n_cols);
+  for (size_t i = 0; i < output.n_cols; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(vectorOutput[i].size(), output.n_rows);
+    for (size_t j = 0; j < output.n_rows; ++j)
+      BOOST_REQUIRE_EQUAL(vectorOutput[i][j], output(j, i));
+  }
+
+  // Encoding each string on its own gives the same column.
+  for (size_t i = 0; i < stringEncodingInput.size(); ++i)
+  {
+    arma::mat column;
+    encoder.Encode(vector<string>(1, stringEncodingInput[i]), column,
+        tokenizer);
+    CheckMatrices(column, output.col(i));
+  }
+
+  // Without alternating signs, each column sums to the number of tokens.
+  EncoderType unsignedEncoder(16, false);
+  unsignedEncoder.Encode(stringEncodingInput, output, tokenizer);
+  for (size_t i = 0; i < stringEncodingInput.size(); ++i)
+  {
+    boost::string_view strView(stringEncodingInput[i]);
+    size_t numTokens = 0;
+    while (!tokenizer.IsTokenEmpty(tokenizer(strView)))
+      numTokens++;
+
+    BOOST_REQUIRE_EQUAL(arma::accu(output.col(i)), numTokens);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
 
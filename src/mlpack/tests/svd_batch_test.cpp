@@ -192,4 +192,35 @@ BOOST_AUTO_TEST_CASE(SVDBatchNegativeElementTest)
   BOOST_REQUIRE_CLOSE(arma::norm(test, "fro"), arma::norm(result, "fro"), 9.0);
 }
 
+/**
+ * Make sure the sparse specialization of the update rules gives the same
+ * result as the dense implementation.
+ */
+BOOST_AUTO_TEST_CASE(SVDBatchSparseDenseTest)
+{
+  sp_mat sparseData;
+  sparseData.sprandu(60, 40, 0.2);
+  mat denseData(sparseData);
+
+  mat w1 = randu<mat>(60, 4);
+  mat h1 = randu<mat>(4, 40);
+  mat w2(w1), h2(h1);
+
+  SVDBatchLearning sparseUpdate(0.001, 0.01, 0.01, 0.5);
+  SVDBatchLearning denseUpdate(0.001, 0.01, 0.01, 0.5);
+  sparseUpdate.Initialize(sparseData, 4);
+  denseUpdate.Initialize(denseData, 4);
+
+  for (size_t i = 0; i < 5; ++i)
+  {
+    sparseUpdate.WUpdate(sparseData, w1, h1);
+    sparseUpdate.HUpdate(sparseData, w1, h1);
+    denseUpdate.WUpdate(denseData, w2, h2);
+    denseUpdate.HUpdate(denseData, w2, h2);
+  }
+
+  CheckMatrices(w1, w2, 1e-5);
+  CheckMatrices(h1, h2, 1e-5);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -550,6 +550,105 @@ BOOST_AUTO_TEST_CASE(SVDPlusPlusFunctionParallelOptimize)
   BOOST_REQUIRE_SMALL(relativeError, 1e-2);
 }
 
+// Make a rating dataset from a random low-rank model with user and item
+// biases, and hold out a fifth of the ratings.
+static void LowRankRatings(arma::mat& train, arma::mat& test)
+{
+  const size_t numUsers = 60;
+  const size_t numItems = 40;
+  const size_t rank = 3;
+
+  const arma::mat userFactors = arma::randu(rank, numUsers);
+  const arma::mat itemFactors = arma::randu(rank, numItems);
+  const arma::rowvec userBias = 0.5 * arma::randu<arma::rowvec>(numUsers);
+  const arma::rowvec itemBias = 0.5 * arma::randu<arma::rowvec>(numItems);
+
+  // Every user rates half of the items.
+  arma::mat ratings(3, numUsers * numItems / 2);
+  size_t col = 0;
+  for (size_t user = 0; user < numUsers; ++user)
+  {
+    for (size_t item = user % 2; item < numItems; item += 2)
+    {
+      ratings(0, col) = user;
+      ratings(1, col) = item;
+      ratings(2, col) = 1.0 + userBias[user] + itemBias[item] +
+          arma::dot(userFactors.col(user), itemFactors.col(item));
+      ++col;
+    }
+  }
+
+  ratings = ratings.cols(arma::randperm(ratings.n_cols));
+
+  // Make sure the last user and item are in the training set, so that the
+  // model has the right size.
+  const arma::uvec last = arma::find(ratings.row(0) == numUsers - 1 &&
+      ratings.row(1) == numItems - 1, 1);
+  ratings.swap_cols(0, last[0]);
+
+  const size_t numTest = ratings.n_cols / 5;
+  train = ratings.head_cols(ratings.n_cols - numTest);
+  test = ratings.tail_cols(numTest);
+}
+
+// Make sure that the lock-free parallel SGD path of SVDPlusPlus predicts
+// held-out ratings about as well as the serial SGD path.
+BOOST_AUTO_TEST_CASE(SVDPlusPlusParallelSGDApplyTest)
+{
+  const size_t rank = 3;
+
+  arma::mat train, test;
+  LowRankRatings(train, test);
+
+  // The training ratings are used as implicit data.
+  const arma::mat implicitRatings = train.rows(0, 1);
+  arma::sp_mat implicitData;
+  SVDPlusPlus<>::CleanData(implicitRatings, implicitData, train);
+
+  // Compute the RMSE on the held-out ratings.
+  auto rmse = [&test, &implicitData](const arma::mat& u, const arma::mat& v,
+      const arma::vec& p, const arma::vec& q, const arma::mat& y) -> double
+  {
+    double error = 0.0;
+    for (size_t i = 0; i < test.n_cols; ++i)
+    {
+      const size_t user = test(0, i);
+      const size_t item = test(1, i);
+
+      arma::vec userVec(v.n_rows, arma::fill::zeros);
+      size_t implicitCount = 0;
+      arma::sp_mat::const_iterator it = implicitData.begin_col(user);
+      for (; it != implicitData.end_col(user); ++it)
+      {
+        userVec += y.col(it.row());
+        ++implicitCount;
+      }
+      if (implicitCount != 0)
+        userVec /= std::sqrt(implicitCount);
+      userVec += v.col(user);
+
+      const double prediction = arma::dot(u.row(item), userVec) + p(item) +
+          q(user);
+      error += std::pow(prediction - test(2, i), 2.0);
+    }
+    return std::sqrt(error / test.n_cols);
+  };
+
+  SVDPlusPlus<> serialSVD(50, 0.01, 0.02);
+  arma::mat u, v, y;
+  arma::vec p, q;
+  serialSVD.Apply(train, rank, u, v, p, q, y);
+  const double serialRMSE = rmse(u, v, p, q, y);
+
+  SVDPlusPlus<ens::ParallelSGD<ens::ExponentialBackoff>> parallelSVD(50, 0.01,
+      0.02);
+  parallelSVD.Apply(train, rank, u, v, p, q, y);
+  const double parallelRMSE = rmse(u, v, p, q, y);
+
+  BOOST_REQUIRE_LT(std::abs(parallelRMSE - serialRMSE),
+      0.2 * serialRMSE + 0.02);
+}
+
 #endif
 
 BOOST_AUTO_TEST_SUITE_END();
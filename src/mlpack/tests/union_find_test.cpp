@@ -10,6 +10,7 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include <mlpack/methods/emst/union_find.hpp>
+#include <mlpack/methods/emst/concurrent_union_find.hpp>
 
 #include <mlpack/core.hpp>
 #include <boost/test/unit_test.hpp>
@@ -51,4 +52,43 @@ BOOST_AUTO_TEST_CASE(TestUnion)
   BOOST_REQUIRE(testUnionFind.Find(6) == testUnionFind.Find(3));
 }
 
+/**
+ * Unite random pairs from many threads at once, and make sure the components
+ * are the same as with UnionFind, and that each component is indexed by its
+ * smallest element.
+ */
+BOOST_AUTO_TEST_CASE(ConcurrentUnionFindTest)
+{
+  static const size_t testSize = 5000;
+  arma::Mat<size_t> pairs = arma::randi<arma::Mat<size_t>>(2, 4000,
+      arma::distr_param(0, (int) testSize - 1));
+
+  ConcurrentUnionFind concurrentUnionFind(testSize);
+  BOOST_REQUIRE_EQUAL(concurrentUnionFind.Size(), testSize);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) pairs.n_cols; ++i)
+    concurrentUnionFind.Union(pairs(0, i), pairs(1, i));
+
+  UnionFind testUnionFind(testSize);
+  for (size_t i = 0; i < pairs.n_cols; ++i)
+    testUnionFind.Union(pairs(0, i), pairs(1, i));
+
+  for (size_t i = 0; i < testSize; ++i)
+  {
+    const size_t component = concurrentUnionFind.Find(i);
+    BOOST_REQUIRE_LE(component, i);
+    BOOST_REQUIRE_EQUAL(concurrentUnionFind.Find(component), component);
+    BOOST_REQUIRE_EQUAL(testUnionFind.Find(component), testUnionFind.Find(i));
+  }
+
+  // Every element in the same component of UnionFind must be in the same
+  // component here too.
+  for (size_t i = 0; i < pairs.n_cols; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(concurrentUnionFind.Find(pairs(0, i)),
+        concurrentUnionFind.Find(pairs(1, i)));
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();